@@ -19,16 +19,35 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <assert.h>
 
 #ifdef DR_APPKIT_IMPLEMENTATION
 #ifdef _WIN32
 #include <windows.h>
+#include <psapi.h>
+
+// GetProcessMemoryInfo() lives in psapi.lib on older versions of Windows. Other compilers need to link to it manually.
+#if defined(_MSC_VER)
+#pragma comment(lib, "psapi.lib")
+#endif
 #endif
 
-#ifdef __linux__
+#if defined(__linux__) && !defined(AK_USE_HEADLESS)
 #include <gdk/gdk.h>
 #include <gtk/gtk.h>
+#include <glib-unix.h>
+#include <sys/eventfd.h>
+#endif
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
 #endif
 #endif
 
@@ -0,0 +1,665 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+// The modifiers that make up a stroke. Anything else in the state flags, such as mouse buttons, is ignored.
+#define AK_ACCELERATOR_MODIFIER_MASK    (AK_KEY_STATE_SHIFT_DOWN | AK_KEY_STATE_CTRL_DOWN | AK_KEY_STATE_ALT_DOWN)
+
+// The maximum number of strokes in a single shortcut.
+#define AK_ACCELERATOR_MAX_STROKES      8
+
+typedef struct
+{
+    /// The index of the parent node.
+    uint32_t parentIndex;
+
+    /// The key of the stroke that leads to this node from it's parent.
+    drgui_key key;
+
+    /// The modifiers of the stroke that leads to this node from it's parent.
+    int modifiers;
+
+    /// The action to handle when this node is reached, or 0 if this is only part of a chord.
+    uint32_t actionID;
+
+    /// The number of nodes that have this one as their parent.
+    uint32_t childCount;
+
+} ak_accelerator_node;
+
+typedef struct
+{
+    /// The index of the node the edge starts from.
+    uint32_t parentIndex;
+
+    /// The index of the node the edge leads to. This is 0 for empty slots, which works because the root is never a child.
+    uint32_t childIndex;
+
+    /// The key of the stroke.
+    drgui_key key;
+
+    /// The modifiers of the stroke.
+    int modifiers;
+
+} ak_accelerator_edge;
+
+struct ak_accelerator_table
+{
+    /// The nodes of the trie. The root is always at index 0.
+    ak_accelerator_node* pNodes;
+
+    /// The number of nodes, including the root.
+    uint32_t nodeCount;
+
+    /// The capacity of pNodes.
+    uint32_t nodeBufferCapacity;
+
+
+    /// The hash table of edges. The capacity is always a power of 2.
+    ak_accelerator_edge* pEdges;
+
+    /// The capacity of pEdges.
+    size_t edgeCapacity;
+
+
+    /// The node of the chord that's in progress, or 0 if no chord is in progress.
+    uint32_t pendingNodeIndex;
+
+    /// Incremented whenever a shortcut is bound or the table is cleared.
+    unsigned int generation;
+};
+
+
+typedef struct
+{
+    /// The name of the key as it appears in shortcuts.
+    const char* name;
+
+    /// The key.
+    drgui_key key;
+
+} ak_accelerator_key_name;
+
+// The keys that are referred to by name rather than by their character. The first name for a given key is the one
+// used when generating shortcut text.
+static const ak_accelerator_key_name g_akAcceleratorKeyNames[] =
+{
+    {"Backspace", DRGUI_BACKSPACE},
+    {"Escape",    DRGUI_ESCAPE},
+    {"Esc",       DRGUI_ESCAPE},
+    {"PageUp",    DRGUI_PAGE_UP},
+    {"PageDown",  DRGUI_PAGE_DOWN},
+    {"End",       DRGUI_END},
+    {"Home",      DRGUI_HOME},
+    {"Left",      DRGUI_ARROW_LEFT},
+    {"Up",        DRGUI_ARROW_UP},
+    {"Right",     DRGUI_ARROW_RIGHT},
+    {"Down",      DRGUI_ARROW_DOWN},
+    {"Delete",    DRGUI_DELETE},
+    {"Del",       DRGUI_DELETE},
+#ifdef AK_USE_WIN32
+    {"Tab",       VK_TAB},
+    {"Enter",     VK_RETURN},
+    {"Space",     VK_SPACE},
+    {"Insert",    VK_INSERT},
+    {"F1",        VK_F1},
+    {"F2",        VK_F2},
+    {"F3",        VK_F3},
+    {"F4",        VK_F4},
+    {"F5",        VK_F5},
+    {"F6",        VK_F6},
+    {"F7",        VK_F7},
+    {"F8",        VK_F8},
+    {"F9",        VK_F9},
+    {"F10",       VK_F10},
+    {"F11",       VK_F11},
+    {"F12",       VK_F12},
+#endif
+#ifdef AK_USE_GTK
+    {"Tab",       GDK_KEY_Tab},
+    {"Enter",     GDK_KEY_Return},
+    {"Space",     GDK_KEY_space},
+    {"Insert",    GDK_KEY_Insert},
+    {"F1",        GDK_KEY_F1},
+    {"F2",        GDK_KEY_F2},
+    {"F3",        GDK_KEY_F3},
+    {"F4",        GDK_KEY_F4},
+    {"F5",        GDK_KEY_F5},
+    {"F6",        GDK_KEY_F6},
+    {"F7",        GDK_KEY_F7},
+    {"F8",        GDK_KEY_F8},
+    {"F9",        GDK_KEY_F9},
+    {"F10",       GDK_KEY_F10},
+    {"F11",       GDK_KEY_F11},
+    {"F12",       GDK_KEY_F12},
+#endif
+#ifdef AK_USE_HEADLESS
+    // There are no native key codes with the headless back end so we just use the same ones as GTK.
+    {"Tab",       0xFF09},
+    {"Enter",     0xFF0D},
+    {"Space",     0x0020},
+    {"Insert",    0xFF63},
+    {"F1",        0xFFBE},
+    {"F2",        0xFFBF},
+    {"F3",        0xFFC0},
+    {"F4",        0xFFC1},
+    {"F5",        0xFFC2},
+    {"F6",        0xFFC3},
+    {"F7",        0xFFC4},
+    {"F8",        0xFFC5},
+    {"F9",        0xFFC6},
+    {"F10",       0xFFC7},
+    {"F11",       0xFFC8},
+    {"F12",       0xFFC9},
+#endif
+};
+
+
+// Determines whether or not the given key is one of the modifier keys themselves.
+static bool ak_accelerator_is_modifier_key(drgui_key key)
+{
+    if (key == DRGUI_SHIFT) {
+        return true;
+    }
+
+#ifdef AK_USE_WIN32
+    if (key == VK_CONTROL || key == VK_MENU || key == VK_LWIN || key == VK_RWIN) {
+        return true;
+    }
+#endif
+#ifdef AK_USE_GTK
+    if (key == GDK_KEY_Control_L || key == GDK_KEY_Control_R || key == GDK_KEY_Alt_L || key == GDK_KEY_Alt_R ||
+        key == GDK_KEY_Meta_L    || key == GDK_KEY_Meta_R    || key == GDK_KEY_Super_L || key == GDK_KEY_Super_R) {
+        return true;
+    }
+#endif
+
+    return false;
+}
+
+// Letters are case insensitive, so they're always stored in upper case.
+static drgui_key ak_accelerator_normalize_key(drgui_key key)
+{
+#ifdef AK_USE_WIN32
+    // Win32 always uses the upper case character for letter keys. The lower case range is used by other keys like
+    // VK_F5 so it needs to be left alone.
+    return key;
+#else
+    if (key >= 'a' && key <= 'z') {
+        return key - 'a' + 'A';
+    }
+
+    return key;
+#endif
+}
+
+static drgui_key ak_accelerator_key_from_name(const char* name)
+{
+    assert(name != NULL);
+
+    if (name[0] == '\0') {
+        return 0;
+    }
+
+    if (name[1] == '\0') {
+        char c = name[0];
+        if (c >= 'a' && c <= 'z') {
+            c = c - 'a' + 'A';
+        }
+
+        return (drgui_key)(unsigned char)c;
+    }
+
+    for (size_t i = 0; i < sizeof(g_akAcceleratorKeyNames) / sizeof(g_akAcceleratorKeyNames[0]); ++i)
+    {
+        if (_stricmp(g_akAcceleratorKeyNames[i].name, name) == 0) {
+            return g_akAcceleratorKeyNames[i].key;
+        }
+    }
+
+    return 0;
+}
+
+static void ak_accelerator_append_key_name(drgui_key key, char* textOut, size_t textOutSize)
+{
+    for (size_t i = 0; i < sizeof(g_akAcceleratorKeyNames) / sizeof(g_akAcceleratorKeyNames[0]); ++i)
+    {
+        if (g_akAcceleratorKeyNames[i].key == key) {
+            strcat_s(textOut, textOutSize, g_akAcceleratorKeyNames[i].name);
+            return;
+        }
+    }
+
+    char keyStr[2];
+    keyStr[0] = (char)key;
+    keyStr[1] = '\0';
+    strcat_s(textOut, textOutSize, keyStr);
+}
+
+
+static uint32_t ak_accelerator_hash_edge(uint32_t parentIndex, drgui_key key, int modifiers)
+{
+    uint32_t hash = parentIndex * 0x9E3779B1;
+    hash ^= (uint32_t)key + 0x7F4A7C15 + (hash << 6) + (hash >> 2);
+    hash ^= (uint32_t)modifiers + 0x7F4A7C15 + (hash << 6) + (hash >> 2);
+
+    return hash;
+}
+
+// Looks up the slot for the given edge. If the edge does not exist, the returned slot is the empty one it would go in.
+static ak_accelerator_edge* ak_accelerator_find_edge_slot(ak_accelerator_table* pTable, uint32_t parentIndex, drgui_key key, int modifiers)
+{
+    assert(pTable != NULL);
+    assert(pTable->edgeCapacity > 0);
+
+    size_t mask = pTable->edgeCapacity - 1;
+
+    size_t i = ak_accelerator_hash_edge(parentIndex, key, modifiers) & mask;
+    while (pTable->pEdges[i].childIndex != 0)
+    {
+        ak_accelerator_edge* pEdge = &pTable->pEdges[i];
+        if (pEdge->parentIndex == parentIndex && pEdge->key == key && pEdge->modifiers == modifiers) {
+            break;
+        }
+
+        i = (i + 1) & mask;
+    }
+
+    return &pTable->pEdges[i];
+}
+
+static uint32_t ak_accelerator_find_child(ak_accelerator_table* pTable, uint32_t parentIndex, drgui_key key, int modifiers)
+{
+    assert(pTable != NULL);
+
+    if (pTable->edgeCapacity == 0) {
+        return 0;
+    }
+
+    return ak_accelerator_find_edge_slot(pTable, parentIndex, key, modifiers)->childIndex;
+}
+
+// Finds the child of the given node for the given stroke, creating it if it does not already exist. Returns 0 if
+// memory could not be allocated.
+static uint32_t ak_accelerator_find_or_create_child(ak_accelerator_table* pTable, uint32_t parentIndex, drgui_key key, int modifiers)
+{
+    assert(pTable != NULL);
+
+    uint32_t childIndex = ak_accelerator_find_child(pTable, parentIndex, key, modifiers);
+    if (childIndex != 0) {
+        return childIndex;
+    }
+
+
+    if (pTable->nodeCount == pTable->nodeBufferCapacity)
+    {
+        uint32_t newCapacity = pTable->nodeBufferCapacity * 2;
+        ak_accelerator_node* pNewNodes = realloc(pTable->pNodes, newCapacity * sizeof(*pNewNodes));
+        if (pNewNodes == NULL) {
+            return 0;
+        }
+
+        pTable->pNodes             = pNewNodes;
+        pTable->nodeBufferCapacity = newCapacity;
+    }
+
+    // The table is kept at most 3/4 full so that probe sequences stay short. There is one edge for every node other
+    // than the root.
+    if (pTable->nodeCount * 4 > pTable->edgeCapacity * 3)
+    {
+        size_t newCapacity = (pTable->edgeCapacity == 0) ? 64 : pTable->edgeCapacity * 2;
+        ak_accelerator_edge* pNewEdges = calloc(newCapacity, sizeof(*pNewEdges));
+        if (pNewEdges == NULL) {
+            return 0;
+        }
+
+        ak_accelerator_edge* pOldEdges = pTable->pEdges;
+        size_t oldCapacity = pTable->edgeCapacity;
+
+        pTable->pEdges       = pNewEdges;
+        pTable->edgeCapacity = newCapacity;
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (pOldEdges[i].childIndex != 0) {
+                *ak_accelerator_find_edge_slot(pTable, pOldEdges[i].parentIndex, pOldEdges[i].key, pOldEdges[i].modifiers) = pOldEdges[i];
+            }
+        }
+
+        free(pOldEdges);
+    }
+
+
+    childIndex = pTable->nodeCount;
+    pTable->nodeCount += 1;
+
+    ak_accelerator_node* pChild = &pTable->pNodes[childIndex];
+    pChild->parentIndex = parentIndex;
+    pChild->key         = key;
+    pChild->modifiers   = modifiers;
+    pChild->actionID    = 0;
+    pChild->childCount  = 0;
+
+    pTable->pNodes[parentIndex].childCount += 1;
+
+    ak_accelerator_edge* pEdge = ak_accelerator_find_edge_slot(pTable, parentIndex, key, modifiers);
+    pEdge->parentIndex = parentIndex;
+    pEdge->childIndex  = childIndex;
+    pEdge->key         = key;
+    pEdge->modifiers   = modifiers;
+
+    return childIndex;
+}
+
+// Parses a single stroke, such as "Ctrl+Shift+S". Returns false if the stroke is invalid.
+static bool ak_accelerator_parse_stroke(const char* stroke, size_t strokeLength, drgui_key* pKeyOut, int* pModifiersOut)
+{
+    assert(stroke != NULL);
+    assert(pKeyOut != NULL);
+    assert(pModifiersOut != NULL);
+
+    int modifiers = 0;
+
+    // Every part other than the last is a modifier. The key itself can be "+", so we look for the separator starting
+    // from the second character of each part rather than splitting on every "+".
+    const char* pPart = stroke;
+    const char* pEnd  = stroke + strokeLength;
+    for (;;)
+    {
+        const char* pSeparator = pPart + 1;
+        while (pSeparator < pEnd && *pSeparator != '+') {
+            pSeparator += 1;
+        }
+
+        if (pSeparator > pEnd) {
+            return false;   // Trailing "+".
+        }
+
+        char part[16];
+        size_t partLength = (size_t)(pSeparator - pPart);
+        if (partLength >= sizeof(part)) {
+            return false;
+        }
+
+        memcpy(part, pPart, partLength);
+        part[partLength] = '\0';
+
+        if (pSeparator == pEnd)
+        {
+            drgui_key key = ak_accelerator_key_from_name(part);
+            if (key == 0) {
+                return false;
+            }
+
+            *pKeyOut       = key;
+            *pModifiersOut = modifiers;
+            return true;
+        }
+
+        if (_stricmp(part, "Ctrl") == 0 || _stricmp(part, "Control") == 0) {
+            modifiers |= AK_KEY_STATE_CTRL_DOWN;
+        } else if (_stricmp(part, "Shift") == 0) {
+            modifiers |= AK_KEY_STATE_SHIFT_DOWN;
+        } else if (_stricmp(part, "Alt") == 0) {
+            modifiers |= AK_KEY_STATE_ALT_DOWN;
+        } else {
+            return false;
+        }
+
+        pPart = pSeparator + 1;
+    }
+}
+
+
+ak_accelerator_table* ak_create_accelerator_table()
+{
+    ak_accelerator_table* pTable = malloc(sizeof(*pTable));
+    if (pTable == NULL) {
+        return NULL;
+    }
+
+    pTable->nodeBufferCapacity = 16;
+    pTable->pNodes = malloc(pTable->nodeBufferCapacity * sizeof(*pTable->pNodes));
+    if (pTable->pNodes == NULL) {
+        free(pTable);
+        return NULL;
+    }
+
+    pTable->pEdges           = NULL;
+    pTable->edgeCapacity     = 0;
+    pTable->pendingNodeIndex = 0;
+    pTable->generation       = 0;
+
+    // The root.
+    pTable->nodeCount = 1;
+    memset(&pTable->pNodes[0], 0, sizeof(pTable->pNodes[0]));
+
+    return pTable;
+}
+
+void ak_delete_accelerator_table(ak_accelerator_table* pTable)
+{
+    if (pTable == NULL) {
+        return;
+    }
+
+    free(pTable->pEdges);
+    free(pTable->pNodes);
+    free(pTable);
+}
+
+
+bool ak_accelerator_table_bind(ak_accelerator_table* pTable, const char* shortcut, uint32_t actionID)
+{
+    if (pTable == NULL || shortcut == NULL) {
+        return false;
+    }
+
+    // Each stroke is validated before anything is added to the trie so that an invalid shortcut doesn't leave any
+    // dangling nodes behind.
+    drgui_key keys[AK_ACCELERATOR_MAX_STROKES];
+    int modifiers[AK_ACCELERATOR_MAX_STROKES];
+    size_t strokeCount = 0;
+
+    const char* pStroke = shortcut;
+    for (;;)
+    {
+        while (*pStroke == ' ' || *pStroke == '\t') {
+            pStroke += 1;
+        }
+
+        if (*pStroke == '\0') {
+            break;
+        }
+
+        const char* pStrokeEnd = pStroke;
+        while (*pStrokeEnd != '\0' && *pStrokeEnd != ' ' && *pStrokeEnd != '\t') {
+            pStrokeEnd += 1;
+        }
+
+        if (strokeCount == AK_ACCELERATOR_MAX_STROKES) {
+            return false;
+        }
+
+        if (!ak_accelerator_parse_stroke(pStroke, (size_t)(pStrokeEnd - pStroke), &keys[strokeCount], &modifiers[strokeCount])) {
+            return false;
+        }
+
+        strokeCount += 1;
+        pStroke = pStrokeEnd;
+    }
+
+    if (strokeCount == 0) {
+        return false;
+    }
+
+
+    uint32_t nodeIndex = 0;
+    for (size_t i = 0; i < strokeCount; ++i)
+    {
+        nodeIndex = ak_accelerator_find_or_create_child(pTable, nodeIndex, keys[i], modifiers[i]);
+        if (nodeIndex == 0) {
+            return false;
+        }
+    }
+
+    pTable->pNodes[nodeIndex].actionID = actionID;
+    pTable->pendingNodeIndex = 0;
+    pTable->generation += 1;
+
+    return true;
+}
+
+void ak_accelerator_table_clear(ak_accelerator_table* pTable)
+{
+    if (pTable == NULL) {
+        return;
+    }
+
+    // We keep the memory around since a table is usually cleared just before being rebuilt.
+    if (pTable->pEdges != NULL) {
+        memset(pTable->pEdges, 0, pTable->edgeCapacity * sizeof(*pTable->pEdges));
+    }
+
+    pTable->nodeCount = 1;
+    memset(&pTable->pNodes[0], 0, sizeof(pTable->pNodes[0]));
+
+    pTable->pendingNodeIndex = 0;
+    pTable->generation += 1;
+}
+
+
+ak_accelerator_result ak_accelerator_table_on_key_down(ak_accelerator_table* pTable, drgui_key key, int stateFlags, uint32_t* pActionIDOut)
+{
+    if (pTable == NULL) {
+        return ak_accelerator_result_none;
+    }
+
+    // Pressing a modifier key on it's own does nothing, but needs to be swallowed if a chord is in progress because
+    // it's probably the start of the next stroke.
+    if (ak_accelerator_is_modifier_key(key)) {
+        return (pTable->pendingNodeIndex != 0) ? ak_accelerator_result_pending : ak_accelerator_result_none;
+    }
+
+    uint32_t childIndex = ak_accelerator_find_child(pTable, pTable->pendingNodeIndex, ak_accelerator_normalize_key(key), stateFlags & AK_ACCELERATOR_MODIFIER_MASK);
+    if (childIndex == 0)
+    {
+        if (pTable->pendingNodeIndex != 0) {
+            pTable->pendingNodeIndex = 0;
+            return ak_accelerator_result_cancelled;
+        }
+
+        return ak_accelerator_result_none;
+    }
+
+    ak_accelerator_node* pChild = &pTable->pNodes[childIndex];
+    if (pChild->childCount > 0) {
+        pTable->pendingNodeIndex = childIndex;
+        return ak_accelerator_result_pending;
+    }
+
+    pTable->pendingNodeIndex = 0;
+
+    if (pActionIDOut) {
+        *pActionIDOut = pChild->actionID;
+    }
+
+    return ak_accelerator_result_matched;
+}
+
+void ak_accelerator_table_reset_chord(ak_accelerator_table* pTable)
+{
+    if (pTable == NULL) {
+        return;
+    }
+
+    pTable->pendingNodeIndex = 0;
+}
+
+
+bool ak_accelerator_table_get_shortcut_text(ak_accelerator_table* pTable, uint32_t actionID, char* textOut, size_t textOutSize)
+{
+    if (textOut == NULL || textOutSize == 0) {
+        return false;
+    }
+
+    textOut[0] = '\0';
+
+    if (pTable == NULL || actionID == 0) {
+        return false;
+    }
+
+    for (uint32_t iNode = 1; iNode < pTable->nodeCount; ++iNode)
+    {
+        // Nodes with children are shadowed so they can never be reached.
+        if (pTable->pNodes[iNode].actionID != actionID || pTable->pNodes[iNode].childCount > 0) {
+            continue;
+        }
+
+        // The path from the root needs to be built in reverse.
+        uint32_t path[AK_ACCELERATOR_MAX_STROKES];
+        size_t pathLength = 0;
+        for (uint32_t i = iNode; i != 0 && pathLength < AK_ACCELERATOR_MAX_STROKES; i = pTable->pNodes[i].parentIndex) {
+            path[pathLength++] = i;
+        }
+
+        while (pathLength > 0)
+        {
+            ak_accelerator_node* pNode = &pTable->pNodes[path[--pathLength]];
+
+            if ((pNode->modifiers & AK_KEY_STATE_CTRL_DOWN) != 0) {
+                strcat_s(textOut, textOutSize, "Ctrl+");
+            }
+            if ((pNode->modifiers & AK_KEY_STATE_SHIFT_DOWN) != 0) {
+                strcat_s(textOut, textOutSize, "Shift+");
+            }
+            if ((pNode->modifiers & AK_KEY_STATE_ALT_DOWN) != 0) {
+                strcat_s(textOut, textOutSize, "Alt+");
+            }
+
+            ak_accelerator_append_key_name(pNode->key, textOut, textOutSize);
+
+            if (pathLength > 0) {
+                strcat_s(textOut, textOutSize, " ");
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+unsigned int ak_accelerator_table_get_generation(ak_accelerator_table* pTable)
+{
+    if (pTable == NULL) {
+        return 0;
+    }
+
+    return pTable->generation;
+}
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
@@ -0,0 +1,120 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+//
+// QUICK NOTES
+//
+// - The accelerator table maps sequences of key strokes to action IDs. A single stroke is a key and a combination of
+//   the shift, ctrl and alt modifiers. A sequence of more than one stroke is a chord, such as "Ctrl+K Ctrl+C".
+// - The sequences are stored as a trie. Each node other than the root is the stroke that leads to it from it's parent,
+//   and the edges for every node are stored in a single open-addressing hash table keyed on the (parent, stroke) pair.
+//   Resolving a stroke is therefore a single hash lookup regardless of how many shortcuts there are.
+// - The table keeps track of where it is in a chord between key presses. A shortcut that is a prefix of another, such
+//   as "Ctrl+K" and "Ctrl+K Ctrl+C", is shadowed by the longer one.
+// - Letters are case insensitive. The keys of the platform's modifier keys themselves are ignored so that pressing
+//   ctrl again in the middle of a chord does not break it.
+// - The table is not thread-safe. It is only ever used from the main thread.
+//
+
+#ifndef ak_accelerator_private_h
+#define ak_accelerator_private_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ak_accelerator_table ak_accelerator_table;
+
+typedef enum
+{
+    /// The stroke is not part of any shortcut.
+    ak_accelerator_result_none,
+
+    /// The stroke is the start or middle of a chord. The next stroke is needed to resolve it.
+    ak_accelerator_result_pending,
+
+    /// The stroke completed a shortcut.
+    ak_accelerator_result_matched,
+
+    /// The stroke did not continue the chord that was in progress. The chord has been abandoned.
+    ak_accelerator_result_cancelled
+
+} ak_accelerator_result;
+
+
+/// Creates an empty accelerator table.
+ak_accelerator_table* ak_create_accelerator_table();
+
+/// Deletes the given accelerator table.
+void ak_delete_accelerator_table(ak_accelerator_table* pTable);
+
+
+/// Binds the given shortcut to the given action.
+///
+/// @remarks
+///     The shortcut is a space separated list of strokes, with each stroke being a key name optionally prefixed with
+///     any of "Ctrl+", "Shift+" and "Alt+". Binding a shortcut that's already bound replaces the action.
+///     @par
+///     This will return false if the shortcut could not be parsed.
+bool ak_accelerator_table_bind(ak_accelerator_table* pTable, const char* shortcut, uint32_t actionID);
+
+/// Removes every shortcut from the given table.
+void ak_accelerator_table_clear(ak_accelerator_table* pTable);
+
+
+/// Resolves the given key press against the table.
+///
+/// @remarks
+///     <pActionIDOut> is only set when ak_accelerator_result_matched is returned.
+ak_accelerator_result ak_accelerator_table_on_key_down(ak_accelerator_table* pTable, drgui_key key, int stateFlags, uint32_t* pActionIDOut);
+
+/// Abandons the chord that's in progress, if any.
+void ak_accelerator_table_reset_chord(ak_accelerator_table* pTable);
+
+
+/// Retrieves the display text of the first shortcut that's bound to the given action, such as "Ctrl+S".
+///
+/// @remarks
+///     This returns false and sets <textOut> to an empty string if the action does not have a shortcut. This runs in
+///     linear time and is intended for things like building menus.
+bool ak_accelerator_table_get_shortcut_text(ak_accelerator_table* pTable, uint32_t actionID, char* textOut, size_t textOutSize);
+
+/// Retrieves a counter that is incremented whenever the table is modified.
+///
+/// @remarks
+///     This is used to determine whether or not shortcut text that was generated earlier is stale.
+unsigned int ak_accelerator_table_get_generation(ak_accelerator_table* pTable);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
@@ -0,0 +1,479 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+typedef struct
+{
+    /// The hash of the name.
+    uint32_t hash;
+
+    /// The ID of the name up to it's last dot, or 0 if it does not have one.
+    uint32_t parentID;
+
+    /// The name. This is variable length.
+    char name[1];
+
+} ak_action_name;
+
+typedef struct
+{
+    /// Every interned name, indexed by ID - 1.
+    ak_action_name** ppNames;
+
+    /// The number of interned names.
+    uint32_t nameCount;
+
+    /// The capacity of ppNames.
+    uint32_t nameBufferCapacity;
+
+
+    /// The hash table for looking up an ID by name. Each slot is an ID, with empty slots being 0. The capacity is
+    /// always a power of 2.
+    uint32_t* pNameTable;
+
+    /// The capacity of pNameTable.
+    size_t nameTableCapacity;
+
+} ak_action_name_table;
+
+typedef struct
+{
+    /// The scope of the handler. This is 0 for application-wide handlers.
+    uint32_t scopeID;
+
+    /// The action being handled. This is 0 for empty slots.
+    uint32_t actionID;
+
+    /// The handler.
+    ak_action_handler handler;
+
+} ak_action_handler_entry;
+
+struct ak_action_registry
+{
+    /// The interned action names.
+    ak_action_name_table actions;
+
+    /// The interned scopes. These are kept separate from the action names so that the IDs of the two never overlap.
+    ak_action_name_table scopes;
+
+
+    /// The hash table of handlers. The capacity is always a power of 2.
+    ak_action_handler_entry* pHandlers;
+
+    /// The number of handlers in pHandlers.
+    size_t handlerCount;
+
+    /// The capacity of pHandlers.
+    size_t handlerCapacity;
+};
+
+
+static void ak_action_name_table_init(ak_action_name_table* pTable)
+{
+    assert(pTable != NULL);
+
+    pTable->ppNames            = NULL;
+    pTable->nameCount          = 0;
+    pTable->nameBufferCapacity = 0;
+    pTable->pNameTable         = NULL;
+    pTable->nameTableCapacity  = 0;
+}
+
+static void ak_action_name_table_uninit(ak_action_name_table* pTable)
+{
+    assert(pTable != NULL);
+
+    for (uint32_t i = 0; i < pTable->nameCount; ++i) {
+        free(pTable->ppNames[i]);
+    }
+
+    free(pTable->ppNames);
+    free(pTable->pNameTable);
+}
+
+// Looks up the slot for the given name. If the name has not been interned, the returned slot is the empty one it
+// would go in.
+static uint32_t* ak_action_name_table_find_slot(ak_action_name_table* pTable, const char* name, uint32_t hash)
+{
+    assert(pTable != NULL);
+    assert(pTable->nameTableCapacity > 0);
+
+    size_t mask = pTable->nameTableCapacity - 1;
+
+    size_t i = hash & mask;
+    while (pTable->pNameTable[i] != 0)
+    {
+        ak_action_name* pName = pTable->ppNames[pTable->pNameTable[i] - 1];
+        if (pName->hash == hash && strcmp(pName->name, name) == 0) {
+            break;
+        }
+
+        i = (i + 1) & mask;
+    }
+
+    return &pTable->pNameTable[i];
+}
+
+static uint32_t ak_action_name_table_find(ak_action_name_table* pTable, const char* name)
+{
+    assert(pTable != NULL);
+
+    if (name == NULL || pTable->nameCount == 0) {
+        return 0;
+    }
+
+    return *ak_action_name_table_find_slot(pTable, name, ak_hash_string(name));
+}
+
+static uint32_t ak_action_name_table_intern(ak_action_name_table* pTable, const char* name)
+{
+    assert(pTable != NULL);
+
+    if (name == NULL) {
+        return 0;
+    }
+
+    uint32_t existingID = ak_action_name_table_find(pTable, name);
+    if (existingID != 0) {
+        return existingID;
+    }
+
+
+    // The parent needs to be interned first. This is done before growing the tables because it may grow them too.
+    uint32_t parentID = 0;
+
+    const char* pLastDot = strrchr(name, '.');
+    if (pLastDot != NULL && pLastDot != name)
+    {
+        size_t parentLength = (size_t)(pLastDot - name);
+        char* parentName = malloc(parentLength + 1);
+        if (parentName == NULL) {
+            return 0;
+        }
+
+        memcpy(parentName, name, parentLength);
+        parentName[parentLength] = '\0';
+
+        parentID = ak_action_name_table_intern(pTable, parentName);
+        free(parentName);
+
+        if (parentID == 0) {
+            return 0;
+        }
+    }
+
+
+    if (pTable->nameCount == pTable->nameBufferCapacity)
+    {
+        uint32_t newCapacity = (pTable->nameBufferCapacity == 0) ? 64 : pTable->nameBufferCapacity * 2;
+        ak_action_name** ppNewNames = realloc(pTable->ppNames, newCapacity * sizeof(*ppNewNames));
+        if (ppNewNames == NULL) {
+            return 0;
+        }
+
+        pTable->ppNames            = ppNewNames;
+        pTable->nameBufferCapacity = newCapacity;
+    }
+
+    // The table is kept at most 3/4 full so that probe sequences stay short.
+    if ((pTable->nameCount + 1) * 4 > pTable->nameTableCapacity * 3)
+    {
+        size_t newCapacity = (pTable->nameTableCapacity == 0) ? 128 : pTable->nameTableCapacity * 2;
+        uint32_t* pNewTable = calloc(newCapacity, sizeof(*pNewTable));
+        if (pNewTable == NULL) {
+            return 0;
+        }
+
+        free(pTable->pNameTable);
+        pTable->pNameTable        = pNewTable;
+        pTable->nameTableCapacity = newCapacity;
+
+        for (uint32_t i = 0; i < pTable->nameCount; ++i) {
+            *ak_action_name_table_find_slot(pTable, pTable->ppNames[i]->name, pTable->ppNames[i]->hash) = i + 1;
+        }
+    }
+
+
+    size_t nameLength = strlen(name);
+    ak_action_name* pName = malloc(sizeof(*pName) + nameLength);
+    if (pName == NULL) {
+        return 0;
+    }
+
+    pName->hash     = ak_hash_string(name);
+    pName->parentID = parentID;
+    memcpy(pName->name, name, nameLength + 1);
+
+    pTable->ppNames[pTable->nameCount] = pName;
+    pTable->nameCount += 1;
+
+    *ak_action_name_table_find_slot(pTable, pName->name, pName->hash) = pTable->nameCount;
+
+    return pTable->nameCount;
+}
+
+static ak_action_name* ak_action_name_table_get(ak_action_name_table* pTable, uint32_t id)
+{
+    assert(pTable != NULL);
+
+    if (id == 0 || id > pTable->nameCount) {
+        return NULL;
+    }
+
+    return pTable->ppNames[id - 1];
+}
+
+
+static uint32_t ak_action_registry_hash_handler_key(uint32_t scopeID, uint32_t actionID)
+{
+    uint32_t hash = actionID * 0x9E3779B1;
+    hash ^= scopeID + 0x7F4A7C15 + (hash << 6) + (hash >> 2);
+
+    return hash;
+}
+
+// Looks up the slot for the given handler. If there is no handler, the returned slot is the empty one it would go in.
+static ak_action_handler_entry* ak_action_registry_find_handler_slot(ak_action_registry* pRegistry, uint32_t scopeID, uint32_t actionID)
+{
+    assert(pRegistry != NULL);
+    assert(pRegistry->handlerCapacity > 0);
+
+    size_t mask = pRegistry->handlerCapacity - 1;
+
+    size_t i = ak_action_registry_hash_handler_key(scopeID, actionID) & mask;
+    while (pRegistry->pHandlers[i].actionID != 0)
+    {
+        if (pRegistry->pHandlers[i].actionID == actionID && pRegistry->pHandlers[i].scopeID == scopeID) {
+            break;
+        }
+
+        i = (i + 1) & mask;
+    }
+
+    return &pRegistry->pHandlers[i];
+}
+
+
+ak_action_registry* ak_create_action_registry()
+{
+    ak_action_registry* pRegistry = malloc(sizeof(*pRegistry));
+    if (pRegistry == NULL) {
+        return NULL;
+    }
+
+    ak_action_name_table_init(&pRegistry->actions);
+    ak_action_name_table_init(&pRegistry->scopes);
+
+    pRegistry->pHandlers       = NULL;
+    pRegistry->handlerCount    = 0;
+    pRegistry->handlerCapacity = 0;
+
+    return pRegistry;
+}
+
+void ak_delete_action_registry(ak_action_registry* pRegistry)
+{
+    if (pRegistry == NULL) {
+        return;
+    }
+
+    ak_action_name_table_uninit(&pRegistry->actions);
+    ak_action_name_table_uninit(&pRegistry->scopes);
+
+    free(pRegistry->pHandlers);
+    free(pRegistry);
+}
+
+
+uint32_t ak_action_registry_intern(ak_action_registry* pRegistry, const char* name)
+{
+    if (pRegistry == NULL) {
+        return 0;
+    }
+
+    return ak_action_name_table_intern(&pRegistry->actions, name);
+}
+
+uint32_t ak_action_registry_find(ak_action_registry* pRegistry, const char* name)
+{
+    if (pRegistry == NULL) {
+        return 0;
+    }
+
+    return ak_action_name_table_find(&pRegistry->actions, name);
+}
+
+const char* ak_action_registry_get_name(ak_action_registry* pRegistry, uint32_t id)
+{
+    if (pRegistry == NULL) {
+        return NULL;
+    }
+
+    ak_action_name* pName = ak_action_name_table_get(&pRegistry->actions, id);
+    if (pName == NULL) {
+        return NULL;
+    }
+
+    return pName->name;
+}
+
+uint32_t ak_action_registry_get_parent(ak_action_registry* pRegistry, uint32_t id)
+{
+    if (pRegistry == NULL) {
+        return 0;
+    }
+
+    ak_action_name* pName = ak_action_name_table_get(&pRegistry->actions, id);
+    if (pName == NULL) {
+        return 0;
+    }
+
+    return pName->parentID;
+}
+
+
+uint32_t ak_action_registry_intern_scope(ak_action_registry* pRegistry, const char* scope)
+{
+    if (pRegistry == NULL) {
+        return 0;
+    }
+
+    return ak_action_name_table_intern(&pRegistry->scopes, scope);
+}
+
+uint32_t ak_action_registry_get_scope_parent(ak_action_registry* pRegistry, uint32_t scopeID)
+{
+    if (pRegistry == NULL) {
+        return 0;
+    }
+
+    ak_action_name* pName = ak_action_name_table_get(&pRegistry->scopes, scopeID);
+    if (pName == NULL) {
+        return 0;
+    }
+
+    return pName->parentID;
+}
+
+bool ak_action_registry_set_handler(ak_action_registry* pRegistry, uint32_t scopeID, uint32_t actionID, ak_action_handler_proc proc, void* pUserData)
+{
+    if (pRegistry == NULL || actionID == 0 || actionID > pRegistry->actions.nameCount || scopeID > pRegistry->scopes.nameCount) {
+        return false;
+    }
+
+    if (proc == NULL)
+    {
+        if (pRegistry->handlerCount == 0) {
+            return true;
+        }
+
+        ak_action_handler_entry* pEntry = ak_action_registry_find_handler_slot(pRegistry, scopeID, actionID);
+        if (pEntry->actionID == 0) {
+            return true;
+        }
+
+        // Rather than leaving a tombstone, every entry after the removed one in the same cluster is shifted back if
+        // the hole is between it and it's home slot.
+        size_t mask  = pRegistry->handlerCapacity - 1;
+        size_t iHole = (size_t)(pEntry - pRegistry->pHandlers);
+        for (size_t j = (iHole + 1) & mask; pRegistry->pHandlers[j].actionID != 0; j = (j + 1) & mask)
+        {
+            size_t iHome = ak_action_registry_hash_handler_key(pRegistry->pHandlers[j].scopeID, pRegistry->pHandlers[j].actionID) & mask;
+            if (((j - iHome) & mask) >= ((j - iHole) & mask)) {
+                pRegistry->pHandlers[iHole] = pRegistry->pHandlers[j];
+                iHole = j;
+            }
+        }
+
+        pRegistry->pHandlers[iHole].actionID = 0;
+        pRegistry->handlerCount -= 1;
+
+        return true;
+    }
+
+
+    if (pRegistry->handlerCount > 0)
+    {
+        ak_action_handler_entry* pEntry = ak_action_registry_find_handler_slot(pRegistry, scopeID, actionID);
+        if (pEntry->actionID != 0)
+        {
+            pEntry->handler.proc      = proc;
+            pEntry->handler.pUserData = pUserData;
+            return true;
+        }
+    }
+
+    // The table is kept at most 3/4 full so that probe sequences stay short.
+    if ((pRegistry->handlerCount + 1) * 4 > pRegistry->handlerCapacity * 3)
+    {
+        size_t newCapacity = (pRegistry->handlerCapacity == 0) ? 64 : pRegistry->handlerCapacity * 2;
+        ak_action_handler_entry* pNewHandlers = calloc(newCapacity, sizeof(*pNewHandlers));
+        if (pNewHandlers == NULL) {
+            return false;
+        }
+
+        ak_action_handler_entry* pOldHandlers = pRegistry->pHandlers;
+        size_t oldCapacity = pRegistry->handlerCapacity;
+
+        pRegistry->pHandlers       = pNewHandlers;
+        pRegistry->handlerCapacity = newCapacity;
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (pOldHandlers[i].actionID != 0) {
+                *ak_action_registry_find_handler_slot(pRegistry, pOldHandlers[i].scopeID, pOldHandlers[i].actionID) = pOldHandlers[i];
+            }
+        }
+
+        free(pOldHandlers);
+    }
+
+    ak_action_handler_entry* pEntry = ak_action_registry_find_handler_slot(pRegistry, scopeID, actionID);
+    pEntry->scopeID           = scopeID;
+    pEntry->actionID          = actionID;
+    pEntry->handler.proc      = proc;
+    pEntry->handler.pUserData = pUserData;
+    pRegistry->handlerCount += 1;
+
+    return true;
+}
+
+const ak_action_handler* ak_action_registry_find_handler(ak_action_registry* pRegistry, uint32_t scopeID, uint32_t actionID)
+{
+    if (pRegistry == NULL || pRegistry->handlerCount == 0 || actionID == 0) {
+        return NULL;
+    }
+
+    ak_action_handler_entry* pEntry = ak_action_registry_find_handler_slot(pRegistry, scopeID, actionID);
+    if (pEntry->actionID == 0) {
+        return NULL;
+    }
+
+    return &pEntry->handler;
+}
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
@@ -0,0 +1,130 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+//
+// QUICK NOTES
+//
+// - The action registry interns names into small integer IDs, starting at 1. An ID of 0 is never a valid name. IDs
+//   are never recycled and the names they refer to live for as long as the registry.
+// - Action names and scopes are interned into separate tables, so an action and a scope never share an ID even when
+//   their names overlap. Scopes are tool types, and are used so that a handler can be registered for every tool of a
+//   given type. When a name is interned, the name up to it's last dot is interned as well and becomes it's parent,
+//   which is how sub-types fall back to the handlers of their base types.
+// - Handlers are stored in an open-addressing hash table keyed on the (scope, action) pair. The scope of an
+//   application-wide handler is 0.
+// - The registry is not thread-safe. It is only ever used from the main thread.
+//
+
+#ifndef ak_action_private_h
+#define ak_action_private_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ak_action_registry ak_action_registry;
+
+typedef struct
+{
+    /// The function to call.
+    ak_action_handler_proc proc;
+
+    /// The user data to pass to the function.
+    void* pUserData;
+
+} ak_action_handler;
+
+
+/// Creates an empty action registry.
+ak_action_registry* ak_create_action_registry();
+
+/// Deletes the given action registry.
+void ak_delete_action_registry(ak_action_registry* pRegistry);
+
+
+/// Interns the given name, returning it's ID.
+///
+/// @remarks
+///     If the name has already been interned the existing ID is returned. This will return 0 if memory could not be
+///     allocated.
+uint32_t ak_action_registry_intern(ak_action_registry* pRegistry, const char* name);
+
+/// Finds the ID of the given name without interning it.
+///
+/// @remarks
+///     This will return 0 if the name has not been interned.
+uint32_t ak_action_registry_find(ak_action_registry* pRegistry, const char* name);
+
+/// Retrieves the name that was interned with the given ID.
+///
+/// @remarks
+///     This will return null if the ID is not valid.
+const char* ak_action_registry_get_name(ak_action_registry* pRegistry, uint32_t id);
+
+/// Retrieves the ID of the parent of the given name, which is the name up to it's last dot.
+///
+/// @remarks
+///     This will return 0 if the name does not have a parent.
+uint32_t ak_action_registry_get_parent(ak_action_registry* pRegistry, uint32_t id);
+
+
+/// Interns the given scope, returning it's ID.
+///
+/// @remarks
+///     Scopes have their own IDs which are unrelated to the IDs of action names. This will return 0 if memory could not
+///     be allocated.
+uint32_t ak_action_registry_intern_scope(ak_action_registry* pRegistry, const char* scope);
+
+/// Retrieves the ID of the parent of the given scope, which is the scope up to it's last dot.
+///
+/// @remarks
+///     This will return 0 if the scope does not have a parent.
+uint32_t ak_action_registry_get_scope_parent(ak_action_registry* pRegistry, uint32_t scopeID);
+
+
+/// Sets the handler for the given action in the given scope.
+///
+/// @remarks
+///     <scopeID> is an ID returned by ak_action_registry_intern_scope(), or 0 for the application-wide scope. Setting a
+///     null handler removes it.
+bool ak_action_registry_set_handler(ak_action_registry* pRegistry, uint32_t scopeID, uint32_t actionID, ak_action_handler_proc proc, void* pUserData);
+
+/// Finds the handler for the given action in the given scope.
+///
+/// @remarks
+///     This does not look at parent scopes. Returns null if there is no handler.
+const ak_action_handler* ak_action_registry_find_handler(ak_action_registry* pRegistry, uint32_t scopeID, uint32_t actionID);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
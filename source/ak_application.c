@@ -1,5 +1,17 @@
 // Public domain. See "unlicense" statement at the end of this file.
 
+typedef struct
+{
+    /// The hash of the window's name.
+    uint32_t hash;
+
+    /// The window, or null if the slot is empty.
+    ak_window* pWindow;
+
+} ak_window_name_entry;
+
+typedef struct ak_config_cache_job ak_config_cache_job;
+
 struct ak_application
 {
     /// The name of the application.
@@ -11,9 +23,25 @@ struct ak_application
     /// The log file.
     drfs_file* pLogFile;
 
+    /// The logger that writes messages to the log file on a background thread. This will be null if there is no log
+    /// file or the background thread could not be created, in which case messages are written synchronously.
+    ak_logger* pLogger;
+
     /// The log callback.
     ak_log_proc onLog;
 
+    /// The minimum level of messages that will be posted. Anything below this is discarded before formatting.
+    int logLevel;
+
+    /// The tracer for recording performance traces. Events are only recorded while a trace is being recorded.
+    ak_tracer* pTracer;
+
+    /// The timer that periodically drains the tracer to the trace file. This is null when tracing is stopped.
+    ak_timer* pTraceDrainTimer;
+
+    /// Non-zero while a drain of the tracer is queued or running on a worker thread.
+    volatile size_t isTraceDrainPending;
+
 
     /// The drawing context.
     dr2d_context* pDrawingContext;
@@ -28,6 +56,18 @@ struct ak_application
     /// The application's theme.
     ak_theme theme;
 
+    /// The compiled config. This is kept so that any of it's layouts can be applied later without going back to the
+    /// config file. It's rebuilt whenever a layout that wasn't in it is parsed from pConfig.
+    ak_layout_cache* pCompiledConfig;
+
+    /// The config the compiled config was parsed from. Layouts other than the initial one are only parsed when they
+    /// are first switched to. This is null if the compiled config was loaded from a cache, which has every layout.
+    ak_config* pConfig;
+
+    /// The job that will rewrite the config cache once startup has finished, if any. This is cleared when the job is
+    /// submitted.
+    ak_config_cache_job* pPendingConfigCacheJob;
+
 
     /// The function to call just before the application enters into it's main loop.
     ak_run_proc onRun;
@@ -42,6 +82,10 @@ struct ak_application
     /// A pointer to the function to call when a custom tool needs to be deleted.
     ak_delete_tool_proc onDeleteTool;
 
+    /// A pointer to the function to call to retrieve the title of a tool without creating it. Tools in inactive tabs are
+    /// only deferred with placeholders when this is set.
+    ak_get_tool_title_proc onGetToolTitle;
+
     /// A pointer to the function to call when a key down event needs to be handled.
     ak_application_on_key_down_proc onKeyDown;
 
@@ -66,6 +110,16 @@ struct ak_application
     /// A pointer to the function to call when a command needs to be handled.
     ak_application_on_exec_proc onExec;
 
+    /// The registry of action IDs and the handlers that have been set for them.
+    ak_action_registry* pActionRegistry;
+
+    /// The table of keyboard shortcuts. This is resolved before key presses are posted to the GUI.
+    ak_accelerator_table* pAcceleratorTable;
+
+    /// Set when a key press is swallowed by the shortcut table so that the printable key events it generates are
+    /// swallowed as well. This is cleared by the next key press or release.
+    bool isPrintableKeySuppressed;
+
 
     /// We need to keep track of every existing window that is owned by the application. We implement this as a linked list, with this item being the first. The
     /// first window is considered to be the primary window.
@@ -74,12 +128,168 @@ struct ak_application
     /// The window that previously had the keyboard focus. This is only used for auto-hiding management of popup windows.
     ak_window* pPrevFocusedWindow;
 
+    /// A hash table mapping window names to windows. This uses open addressing with linear probing. Windows without a
+    /// name are not included.
+    ak_window_name_entry* pWindowsByName;
+
+    /// The number of windows in the name table.
+    size_t windowsByNameCount;
+
+    /// The capacity of the name table. This is always 0 or a power of 2.
+    size_t windowsByNameCapacity;
+
+    /// The cached primary window. This is only valid when isPrimaryWindowStale is false.
+    ak_window* pPrimaryWindow;
+
+    /// Set whenever a window is added to or removed from the application's window tree, at which point the primary
+    /// window needs to be looked up again.
+    bool isPrimaryWindowStale;
+
+    /// The popup windows that are currently visible, in the order they were shown. There's rarely more than a few of
+    /// these so it's just a flat array.
+    ak_window** ppVisiblePopups;
+
+    /// The number of visible popup windows.
+    size_t visiblePopupCount;
+
+    /// The capacity of the visible popup buffer.
+    size_t visiblePopupCapacity;
+
+
+    /// A hash table of every panel type that has been interned. This uses open addressing with linear probing. Atoms
+    /// are never removed, so there's no need for tombstones.
+    ak_panel_type_atom** ppPanelTypeAtoms;
+
+    /// The number of atoms in the panel type table.
+    size_t panelTypeAtomCount;
+
+    /// The capacity of the panel type table. This is always 0 or a power of 2.
+    size_t panelTypeAtomCapacity;
+
+
+    /// Every active timer, stored as a binary min-heap ordered by deadline. Every timer is driven by a single platform
+    /// timer which is armed for the deadline of the timer at the top of the heap.
+    ak_timer** ppTimerHeap;
+
+    /// The number of timers in the heap.
+    size_t timerCount;
+
+    /// The capacity of the timer heap.
+    size_t timerHeapCapacity;
+
+    /// The window in microseconds within which timer deadlines are coalesced.
+    uint64_t timerSlackInMicroseconds;
+
+    /// The deadline the platform timer is currently armed for. This is 0 when it is not armed.
+    uint64_t armedTimerDeadline;
+
+    /// The timer whose callback is currently being run. This is used to handle the case where a timer is deleted from
+    /// inside it's own callback.
+    ak_timer* pDispatchingTimer;
+
+    /// Set to true when the timer that is being dispatched is deleted by it's callback.
+    bool wasDispatchingTimerDeleted;
+
+
+    /// The interval at which placeholder tools are replaced with real tools after startup. 0 if disabled.
+    unsigned int toolPrecreationIntervalInMilliseconds;
+
+    /// The timer that replaces placeholder tools in the background. This is null when it's not running.
+    ak_timer* pToolPrecreationTimer;
+
+    /// The placeholder tools that are waiting to be replaced, in the order they were attached to their panels.
+    ak_placeholder_queue placeholderQueue;
+
+
+    /// The number of minutes a tool needs to have been inactive for before it's hibernated. 0 if disabled.
+    unsigned int toolHibernationInactiveTimeInMinutes;
+
+    /// The memory usage of the process in bytes above which every inactive tool is hibernated. 0 if disabled.
+    size_t toolHibernationMemoryThreshold;
+
+    /// The folder the state of hibernated tools is written to. This is an empty string if the state is kept in memory.
+    char toolHibernationFolderPath[DRFS_MAX_PATH];
+
+    /// The number of hibernation files that have been named so far. This is used to give each file a unique name.
+    unsigned int toolHibernationFileCounter;
+
+    /// The timer that applies the hibernation policy. This is null when the policy is disabled.
+    ak_timer* pToolHibernationTimer;
+
+
+    /// The application's statistics. The window totals are updated by the windows themselves.
+    ak_application_stats stats;
+
+    /// The timings of each phase of the application's startup.
+    ak_startup_stats startupStats;
+
+    /// The time ak_create_application() was called. The time to first paint is measured from here.
+    uint64_t createTime;
+
+    /// Set once the first paint of the primary window has completed, at which point startup is considered complete.
+    bool isStartupComplete;
+
+    /// Whether or not a summary of the startup timings should be logged when startup completes.
+    bool logStartupSummary;
+
+
+    /// The number of calls to ak_begin_batch_update() that have not yet been matched by ak_end_batch_update().
+    unsigned int batchUpdateDepth;
+
+
+    /// The worker thread pool.
+    ak_thread_pool* pThreadPool;
+
+    /// The lock protecting the main thread queue.
+    ak_mutex mainThreadQueueLock;
+
+    /// The work items that have been posted to the main thread and are waiting to be run.
+    ak_work_item* pMainThreadQueue;
+
+    /// The number of items in the main thread queue.
+    size_t mainThreadQueueCount;
+
+    /// The capacity of the main thread queue.
+    size_t mainThreadQueueCapacity;
+
+    /// The buffer the main thread queue is swapped with when it's drained. This allows new items to be posted while
+    /// a batch is being run without needing to hold the lock.
+    ak_work_item* pMainThreadBatch;
+
+    /// The capacity of the main thread batch buffer.
+    size_t mainThreadBatchCapacity;
+
+    /// Whether or not a batch of main thread work items is being run. This is used to defer drains that are triggered
+    /// by the items themselves, such as from a nested event loop.
+    bool isDrainingMainThreadQueue;
+
 
     // Platform Specific.
 #ifdef AK_USE_WIN32
-    /// The window to associate timers with.
+    /// The window to associate timers with. This is also used for waking up the main loop when work is posted to the
+    /// main thread.
     HWND hTimerWnd;
 #endif
+#ifdef AK_USE_GTK
+    /// The ID of the GLib source driving the application's timers.
+    guint timerSourceID;
+
+    /// The eventfd for waking up the main loop when work is posted to the main thread.
+    int mainThreadWakeFD;
+
+    /// The ID of the GLib source watching the wake eventfd.
+    guint mainThreadWakeSourceID;
+#endif
+#ifdef AK_USE_HEADLESS
+    /// The event for waking up the main loop when work is posted to the main thread.
+    ak_event mainThreadWakeEvent;
+
+    /// Whether or not a quit message has been posted.
+    bool isQuitMessagePosted;
+
+    /// The exit code that was passed to ak_post_quit_message().
+    int exitCode;
+#endif
 
 
     /// The size of the extra data, in bytes.
@@ -90,34 +300,145 @@ struct ak_application
 };
 
 
+/// Loads the config and runs the onRun handler. Returns 0 if successful, or the error code to return from ak_run_application().
+static int ak_start_application(ak_application* pApplication);
+
 /// Enter's into the main application loop.
 static int ak_main_loop(ak_application* pApplication);
 
 /// Loads and apply's the main config.
 static bool ak_load_and_apply_config(ak_application* pApplication);
 
-/// Applies the given config to the given application object.
-static bool ak_apply_config(ak_application* pApplication, ak_config* pConfig);
+/// Loads the config file at the given path, using the compiled version next to it if it's up to date.
+static ak_layout_cache* ak_load_config_file(ak_application* pApplication, const char* configPath);
 
-/// Applies the given layout object to the given application object.
-static bool ak_apply_layout(ak_application* pApplication, ak_layout* pLayout, drgui_element* pElement);
+/// Parses and compiles the given config script, taking ownership of <pConfigText> which must have been allocated with
+/// malloc(). Only the initial layout is parsed and compiled. The rest are parsed by ak_switch_layout() as they're
+/// needed. If <configPath> and <cachePath> are not null, a complete compiled config is saved to <cachePath> in the
+/// background once startup has finished.
+static ak_layout_cache* ak_parse_and_compile_config(ak_application* pApplication, char* pConfigText, size_t configTextSize, const char* configPath, const char* cachePath);
+
+/// Parses the given layout from the application's config and rebuilds the compiled config to include it.
+static bool ak_load_config_layout(ak_application* pApplication, const char* layoutName);
+
+/// Submits the pending config cache job, if any, to the thread pool.
+static void ak_submit_config_cache_job(ak_application* pApplication);
+
+/// Applies the given compiled config to the given application object.
+static bool ak_apply_config(ak_application* pApplication, ak_layout_cache* pConfig);
+
+/// Applies the layout item at the given node of a compiled config to the given application object.
+static bool ak_apply_layout(ak_application* pApplication, ak_layout_cache* pConfig, uint32_t nodeIndex, drgui_element* pElement);
+
+/// Sets the type of a panel that's being created or updated from a layout.
+static void ak_apply_panel_type(ak_application* pApplication, drgui_element* pPanel, const char* panelType);
 
 /// Recursively deletes the tools that are within the given panel.
 static void ak_delete_tools_recursive(ak_application* pApplication, drgui_element* pPanel);
 
+/// Arms the platform timer for the deadline of the timer at the top of the heap.
+static void ak_rearm_timers(ak_application* pApplication);
+
+/// Disarms the platform timer.
+static void ak_disarm_timers(ak_application* pApplication);
+
+/// Runs every work item that has been posted to the main thread.
+static void ak_drain_main_thread_queue(ak_application* pApplication);
+
 
 #ifdef AK_USE_WIN32
+/// The message that's posted to the timer window when work is posted to the main thread.
+#define AK_WM_MAIN_THREAD_WORK  (WM_USER + 1)
+
 static LRESULT TimerWindowProcWin32(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
+    if (msg == AK_WM_MAIN_THREAD_WORK) {
+        ak_drain_main_thread_queue((ak_application*)lParam);
+        return 0;
+    }
+
     return DefWindowProc(hWnd, msg, wParam, lParam);
 }
 #endif
 
+#ifdef AK_USE_GTK
+static gboolean ak_main_thread_wake_proc_gtk(gint fd, GIOCondition condition, gpointer pUserData)
+{
+    (void)condition;
+
+    ak_application* pApplication = pUserData;
+    if (pApplication == NULL) {
+        return true;
+    }
+
+    // The counter needs to be reset or else the source will keep firing.
+    uint64_t value;
+    if (read(fd, &value, sizeof(value)) < 0) {
+        // Nothing to read. The queue was probably drained by an earlier wake up.
+    }
+
+    ak_drain_main_thread_queue(pApplication);
+    return true;
+}
+#endif
+
+// Opens a file called "<application name><n><extension>" in the log folder for writing, where <n> is the first number
+// between 0 and 9 that works. Several instances of the same application may be running at once, in which case the
+// files of the earlier instances will still be open. The path of the file is written to <pathOut> if it's not null.
+static drfs_file* ak_open_file_in_log_folder(ak_application* pApplication, const char* extension, char* pathOut, size_t pathOutSize)
+{
+    assert(pApplication != NULL);
+    assert(extension != NULL);
+
+    char logDirPath[DRFS_MAX_PATH];
+    if (!ak_get_log_file_folder_path(pApplication, logDirPath, sizeof(logDirPath))) {
+        return NULL;
+    }
+
+    const unsigned int maxAttempts = 10;
+
+    char path[DRFS_MAX_PATH];
+    for (unsigned int iAttempt = 0; iAttempt < maxAttempts; ++iAttempt)
+    {
+        char istr[16];
+        snprintf(istr, 16, "%d", iAttempt);
+
+        strcpy_s(path, sizeof(path), logDirPath);
+        drpath_append(path, sizeof(path), drpath_file_name(pApplication->name));
+        strcat_s(path, sizeof(path), istr);
+        strcat_s(path, sizeof(path), extension);
+
+        drfs_file* pFile;
+        if (drfs_open(pApplication->pVFS, path, DRFS_WRITE | DRFS_TRUNCATE, &pFile) == drfs_success) {
+            // We were able to open the file, so return here.
+            if (pathOut != NULL) {
+                strcpy_s(pathOut, pathOutSize, path);
+            }
+
+            return pFile;
+        }
+    }
+
+    return NULL;
+}
+
 ak_application* ak_create_application(const char* pName, size_t extraDataSize, const void* pExtraData)
 {
+    uint64_t createTime = ak_get_time_in_microseconds();
+    uint64_t processUptime = ak_get_process_uptime_in_microseconds();
+
     ak_application* pApplication = malloc(sizeof(ak_application) + extraDataSize - sizeof(pApplication->pExtraData));
     if (pApplication != NULL)
     {
+        // Startup timings. These are set first so that everything else in here can be timed.
+        memset(&pApplication->startupStats, 0, sizeof(pApplication->startupStats));
+        pApplication->startupStats.processStartToCreateTimeInMicroseconds = processUptime;
+        pApplication->createTime        = createTime;
+        pApplication->isStartupComplete = false;
+        pApplication->logStartupSummary = false;
+        pApplication->batchUpdateDepth  = 0;
+
+
         // Name.
         if (pName != NULL) {
             strcpy_s(pApplication->name, sizeof(pApplication->name), pName);
@@ -135,46 +456,44 @@ ak_application* ak_create_application(const char* pName, size_t extraDataSize, c
 
 
         // Logging
-        pApplication->onLog = NULL;
+        pApplication->onLog    = NULL;
+        pApplication->logLevel = AK_DEFAULT_LOG_LEVEL;
 
-        char logDirPath[DRFS_MAX_PATH];
-        if (ak_get_log_file_folder_path(pApplication, logDirPath, sizeof(logDirPath)))
-        {
-            const unsigned int maxAttempts = 10;
+        char logFilePath[DRFS_MAX_PATH];
+        pApplication->pLogFile = ak_open_file_in_log_folder(pApplication, ".log", logFilePath, sizeof(logFilePath));
 
-            char path[DRFS_MAX_PATH];
-            for (unsigned int iAttempt = 0; iAttempt < maxAttempts; ++iAttempt)
-            {
-                char istr[16];
-                snprintf(istr, 16, "%d", iAttempt);
-
-                strcpy_s(path, sizeof(path), logDirPath);
-                drpath_append(path, sizeof(path), drpath_file_name(pApplication->name));
-                strcat_s(path, sizeof(path), istr);
-                strcat_s(path, sizeof(path), ".log");
-
-                pApplication->pLogFile;
-                if (drfs_open(pApplication->pVFS, path, DRFS_WRITE | DRFS_TRUNCATE, &pApplication->pLogFile) == drfs_success) {
-                    // We were able to open the log file, so break here.
-                    break;
-                }
-            }
-        }
-        else
+        pApplication->pLogger = NULL;
+        if (pApplication->pLogFile != NULL)
         {
-            pApplication->pLogFile = NULL;
+            ak_log_flush_policy flushPolicy;
+            flushPolicy.flags                  = AK_LOG_FLUSH_ON_INTERVAL | AK_LOG_FLUSH_ON_SIZE | AK_LOG_FLUSH_ON_WARNING | AK_LOG_FLUSH_ON_ERROR;
+            flushPolicy.intervalInMilliseconds = AK_DEFAULT_LOG_FLUSH_INTERVAL;
+            flushPolicy.sizeThresholdInBytes   = AK_DEFAULT_LOG_FLUSH_THRESHOLD;
+            pApplication->pLogger = ak_create_logger(pApplication->pLogFile, logFilePath, flushPolicy);
         }
 
+        pApplication->startupStats.fileSystemAndLogTimeInMicroseconds = ak_get_time_in_microseconds() - createTime;
+
+
+        // Tracing. The trace file is not opened until tracing is started.
+        pApplication->pTracer             = ak_create_tracer();
+        pApplication->pTraceDrainTimer    = NULL;
+        pApplication->isTraceDrainPending = 0;
+
 
 
         // GUI.
+        uint64_t drawingContextStartTime = ak_get_time_in_microseconds();
 #ifdef AK_USE_WIN32
         pApplication->pDrawingContext = dr2d_create_context_gdi();
 #endif
-#ifdef AK_USE_GTK
+#if defined(AK_USE_GTK) || defined(AK_USE_HEADLESS)
         pApplication->pDrawingContext = dr2d_create_context_cairo();
 #endif
         if (pApplication->pDrawingContext == NULL) {
+            ak_delete_tracer(pApplication->pTracer);
+            ak_delete_logger(pApplication->pLogger);
+            drfs_close(pApplication->pLogFile);
             free(pApplication);
             return NULL;
         }
@@ -182,15 +501,23 @@ ak_application* ak_create_application(const char* pName, size_t extraDataSize, c
         pApplication->pGUI = drgui_create_context_dr_2d(pApplication->pDrawingContext);
         if (pApplication->pGUI == NULL) {
             dr2d_delete_context(pApplication->pDrawingContext);
+            ak_delete_tracer(pApplication->pTracer);
+            ak_delete_logger(pApplication->pLogger);
+            drfs_close(pApplication->pLogFile);
             free(pApplication);
             return NULL;
         }
 
         pApplication->pImageLibrary = ak_create_image_library(pApplication->pGUI);
 
+        pApplication->startupStats.drawingContextTimeInMicroseconds = ak_get_time_in_microseconds() - drawingContextStartTime;
+
 
         // Theme.
         memset(&pApplication->theme, 0, sizeof(pApplication->theme));
+        pApplication->pCompiledConfig        = NULL;
+        pApplication->pConfig                = NULL;
+        pApplication->pPendingConfigCacheJob = NULL;
 
 
         // Callbacks.
@@ -198,6 +525,7 @@ ak_application* ak_create_application(const char* pName, size_t extraDataSize, c
         pApplication->onGetDefaultConfig = NULL;
         pApplication->onCreateTool       = NULL;
         pApplication->onDeleteTool       = NULL;
+        pApplication->onGetToolTitle     = NULL;
         pApplication->onKeyDown          = NULL;
         pApplication->onKeyUp            = NULL;
         pApplication->onToolActivated    = NULL;
@@ -206,12 +534,84 @@ ak_application* ak_create_application(const char* pName, size_t extraDataSize, c
         pApplication->onExec             = NULL;
 
 
+        // Actions. A failure here is not fatal. Actions will just be passed straight to onHandleAction.
+        pApplication->pActionRegistry = ak_create_action_registry();
+        pApplication->pAcceleratorTable = ak_create_accelerator_table();
+        pApplication->isPrintableKeySuppressed = false;
+
+
         // Windows.
-        pApplication->pFirstWindow       = NULL;
-        pApplication->pPrevFocusedWindow = NULL;
+        pApplication->pFirstWindow          = NULL;
+        pApplication->pPrevFocusedWindow    = NULL;
+        pApplication->pWindowsByName        = NULL;
+        pApplication->windowsByNameCount    = 0;
+        pApplication->windowsByNameCapacity = 0;
+        pApplication->pPrimaryWindow        = NULL;
+        pApplication->isPrimaryWindowStale  = false;
+        pApplication->ppVisiblePopups       = NULL;
+        pApplication->visiblePopupCount     = 0;
+        pApplication->visiblePopupCapacity  = 0;
+
+
+        // Panels.
+        pApplication->ppPanelTypeAtoms      = NULL;
+        pApplication->panelTypeAtomCount    = 0;
+        pApplication->panelTypeAtomCapacity = 0;
+
+
+        // Threading.
+        pApplication->pThreadPool               = NULL;
+        pApplication->pMainThreadQueue          = NULL;
+        pApplication->mainThreadQueueCount      = 0;
+        pApplication->mainThreadQueueCapacity   = 0;
+        pApplication->pMainThreadBatch          = NULL;
+        pApplication->mainThreadBatchCapacity   = 0;
+        pApplication->isDrainingMainThreadQueue = false;
+        ak_init_mutex(&pApplication->mainThreadQueueLock);
+
+
+        // Timers.
+        pApplication->ppTimerHeap                = NULL;
+        pApplication->timerCount                 = 0;
+        pApplication->timerHeapCapacity          = 0;
+        pApplication->timerSlackInMicroseconds   = AK_DEFAULT_TIMER_SLACK * 1000;
+        pApplication->armedTimerDeadline         = 0;
+        pApplication->pDispatchingTimer          = NULL;
+        pApplication->wasDispatchingTimerDeleted = false;
+
+        // Tool pre-creation.
+        pApplication->toolPrecreationIntervalInMilliseconds = 0;
+        pApplication->pToolPrecreationTimer                 = NULL;
+        pApplication->placeholderQueue.pFirstTool           = NULL;
+        pApplication->placeholderQueue.pLastTool            = NULL;
+
+        // Tool hibernation.
+        pApplication->toolHibernationInactiveTimeInMinutes = 0;
+        pApplication->toolHibernationMemoryThreshold       = 0;
+        pApplication->toolHibernationFolderPath[0]         = '\0';
+        pApplication->toolHibernationFileCounter           = 0;
+        pApplication->pToolHibernationTimer                = NULL;
+
+
+        // Statistics.
+        memset(&pApplication->stats, 0, sizeof(pApplication->stats));
 
 
         // Platform Specific
+#ifdef AK_USE_GTK
+        pApplication->timerSourceID = 0;
+
+        pApplication->mainThreadWakeSourceID = 0;
+        pApplication->mainThreadWakeFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (pApplication->mainThreadWakeFD != -1) {
+            pApplication->mainThreadWakeSourceID = g_unix_fd_add(pApplication->mainThreadWakeFD, G_IO_IN, ak_main_thread_wake_proc_gtk, pApplication);
+        }
+#endif
+#ifdef AK_USE_HEADLESS
+        ak_init_event(&pApplication->mainThreadWakeEvent);
+        pApplication->isQuitMessagePosted = false;
+        pApplication->exitCode            = 0;
+#endif
 #ifdef AK_USE_WIN32
         pApplication->hTimerWnd = NULL;
 
@@ -235,6 +635,10 @@ ak_application* ak_create_application(const char* pName, size_t extraDataSize, c
         }
 
 
+        // Worker threads. This is done last so that no work can be run against a partially constructed application.
+        pApplication->pThreadPool = ak_create_thread_pool(pApplication, AK_WORKER_THREAD_COUNT);
+
+
         // Everything looks good at this point, so now is a good time to setup the window system. This is the part that makes
         // ak_create_application() not thread safe.
         ak_init_platform();
@@ -253,28 +657,96 @@ void ak_delete_application(ak_application* pApplication)
         return;
     }
 
+    // Worker threads need to be shut down before anything else because they may reference windows, tools, etc. They
+    // can also post work to the main thread, so anything still in the main thread queue needs to be run afterwards.
+    ak_delete_thread_pool(pApplication->pThreadPool);
+    while (pApplication->mainThreadQueueCount > 0) {
+        ak_drain_main_thread_queue(pApplication);
+    }
+
+
     // If there is an element with keyboard or mouse focus, dr_gui will release the focus which in turn triggers an event handler. It's possible
     // these event handlers could reference the theme, so we want to explicitly release capture before deleting the theme.
     drgui_release_keyboard(pApplication->pGUI);
     drgui_release_mouse(pApplication->pGUI);
 
 
+    // Tool pre-creation and hibernation reference panels so they need to be stopped before the windows are deleted.
+    ak_delete_timer(pApplication->pToolPrecreationTimer);
+    pApplication->pToolPrecreationTimer = NULL;
+
+    ak_delete_timer(pApplication->pToolHibernationTimer);
+    pApplication->pToolHibernationTimer = NULL;
+
+    // Anything the trace drain timer hasn't written out yet is written when tracing is stopped further down.
+    ak_delete_timer(pApplication->pTraceDrainTimer);
+    pApplication->pTraceDrainTimer = NULL;
+
     // Windows need to be deleted.
     ak_delete_all_application_windows(pApplication);
+    free(pApplication->pWindowsByName);
+    free(pApplication->ppVisiblePopups);
+
+    // Panel types. Every panel has been deleted by this point so nothing is referencing these anymore.
+    for (size_t i = 0; i < pApplication->panelTypeAtomCapacity; ++i) {
+        free(pApplication->ppPanelTypeAtoms[i]);
+    }
+    free(pApplication->ppPanelTypeAtoms);
+
+    // Actions.
+    ak_delete_accelerator_table(pApplication->pAcceleratorTable);
+    ak_delete_action_registry(pApplication->pActionRegistry);
 
     // Theme.
     ak_theme_unload(&pApplication->theme);
 
+    // Config. The cache job will only still be pending if the application was closed before it's first paint.
+    free(pApplication->pPendingConfigCacheJob);
+    pApplication->pPendingConfigCacheJob = NULL;
+
+    if (pApplication->pConfig != NULL) {
+        ak_uninit_config(pApplication->pConfig);
+        free(pApplication->pConfig);
+        pApplication->pConfig = NULL;
+    }
+
+    ak_delete_layout_cache(pApplication->pCompiledConfig);
+
     // GUI.
     drgui_delete_context(pApplication->pGUI);
     dr2d_delete_context(pApplication->pDrawingContext);
 
-    // Logs.
+    // Tracing. This is done after the worker threads have been shut down so that nothing is still recording events.
+    ak_stop_tracing(pApplication);
+    ak_delete_tracer(pApplication->pTracer);
+
+    // Logs. The logger needs to be deleted before closing the file so that any pending messages are written out.
+    ak_delete_logger(pApplication->pLogger);
     drfs_close(pApplication->pLogFile);
 
     // File system.
     drfs_delete_context(pApplication->pVFS);
 
+    // Timers. The timers themselves are owned by whoever created them, but the platform timer driving them is ours.
+    ak_disarm_timers(pApplication);
+    free(pApplication->ppTimerHeap);
+
+    // Main thread queue.
+#ifdef AK_USE_GTK
+    if (pApplication->mainThreadWakeSourceID != 0) {
+        g_source_remove(pApplication->mainThreadWakeSourceID);
+    }
+    if (pApplication->mainThreadWakeFD != -1) {
+        close(pApplication->mainThreadWakeFD);
+    }
+#endif
+#ifdef AK_USE_HEADLESS
+    ak_uninit_event(&pApplication->mainThreadWakeEvent);
+#endif
+    free(pApplication->pMainThreadQueue);
+    free(pApplication->pMainThreadBatch);
+    ak_uninit_mutex(&pApplication->mainThreadQueueLock);
+
 
 #ifdef AK_USE_WIN32
     // The timer window.
@@ -297,17 +769,9 @@ int ak_run_application(ak_application* pApplication)
         return -1;
     }
 
-    // The first thing to do when running the application is to load the default config and apply it. If a config
-    // file cannot be found, a default config will be requested. If the default config fails, the config will fail
-    // and an error code will be returned.
-    if (!ak_load_and_apply_config(pApplication)) {
-        return -2;
-    }
-
-    // After we've loaded and applied the config, but before entering the main loop, we need to let the host application
-    // do some custom initialization which we'll achieve via a callback function.
-    if (pApplication->onRun) {
-        pApplication->onRun(pApplication);
+    int result = ak_start_application(pApplication);
+    if (result != 0) {
+        return result;
     }
 
     // At this point the config should be loaded. Now we just enter the main loop.
@@ -327,6 +791,12 @@ void ak_post_quit_message(ak_application* pApplication, int exitCode)
 #ifdef AK_USE_GTK
     ak_gtk_post_quit_message(exitCode);
 #endif
+
+#ifdef AK_USE_HEADLESS
+    pApplication->isQuitMessagePosted = true;
+    pApplication->exitCode            = exitCode;
+    ak_signal_event(&pApplication->mainThreadWakeEvent);
+#endif
 }
 
 
@@ -424,15 +894,19 @@ ak_theme* ak_get_application_theme(ak_application* pApplication)
 }
 
 
-void ak_log(ak_application* pApplication, const char* message)
+/// Posts a log message that has already been tagged with it's level and category.
+static void ak_post_log_message(ak_application* pApplication, int level, const char* message)
 {
     if (pApplication == NULL) {
         return;
     }
 
 
-    // Log file.
-    if (pApplication->pLogFile != NULL) {
+    // Log file. This is normally done on the logger's background thread, but if that failed to initialize we just
+    // fall back to writing directly to the file.
+    if (pApplication->pLogger != NULL) {
+        ak_logger_post(pApplication->pLogger, level, message);
+    } else if (pApplication->pLogFile != NULL) {
         char dateTime[64];
         dr_datetime_short(dr_now(), dateTime, sizeof(dateTime));
 
@@ -450,51 +924,152 @@ void ak_log(ak_application* pApplication, const char* message)
     }
 }
 
-void ak_logf(ak_application* pApplication, const char* format, ...)
+/// Writes the level and category tags of a log message to the given buffer and returns the length of the string.
+///
+/// @remarks
+///     Info level messages are not tagged so that ak_log() output stays the same as it's always been.
+static size_t ak_format_log_prefix(int level, const char* category, char* bufferOut, size_t bufferOutSize)
+{
+    assert(bufferOut != NULL);
+    assert(bufferOutSize > 0);
+
+    const char* levelTag = "";
+    switch (level)
+    {
+        case AK_LOG_LEVEL_TRACE:   levelTag = "[TRACE] ";   break;
+        case AK_LOG_LEVEL_DEBUG:   levelTag = "[DEBUG] ";   break;
+        case AK_LOG_LEVEL_WARNING: levelTag = "[WARNING] "; break;
+        case AK_LOG_LEVEL_ERROR:   levelTag = "[ERROR] ";   break;
+        default: break;
+    }
+
+    int length;
+    if (category != NULL) {
+        length = snprintf(bufferOut, bufferOutSize, "%s[%s] ", levelTag, category);
+    } else {
+        length = snprintf(bufferOut, bufferOutSize, "%s", levelTag);
+    }
+
+    if (length < 0) {
+        bufferOut[0] = '\0';
+        return 0;
+    }
+
+    return ((size_t)length < bufferOutSize) ? (size_t)length : bufferOutSize - 1;
+}
+
+/// Posts a formatted log message with the given level and category.
+static void ak_log_messagev(ak_application* pApplication, int level, const char* category, const char* format, va_list args)
+{
+    if (!ak_is_log_level_enabled(pApplication, level)) {
+        return;
+    }
+
+    // The tags and the message are formatted into the same buffer in one go.
+    char msg[AK_MAX_LOG_MESSAGE_LENGTH];
+    size_t prefixLength = ak_format_log_prefix(level, category, msg, sizeof(msg));
+    vsnprintf(msg + prefixLength, sizeof(msg) - prefixLength, format, args);
+
+    ak_post_log_message(pApplication, level, msg);
+}
+
+void ak_log_message(ak_application* pApplication, int level, const char* category, const char* message)
+{
+    if (!ak_is_log_level_enabled(pApplication, level) || message == NULL) {
+        return;
+    }
+
+    char prefix[128];
+    if (ak_format_log_prefix(level, category, prefix, sizeof(prefix)) == 0) {
+        ak_post_log_message(pApplication, level, message);
+    } else {
+        char msg[AK_MAX_LOG_MESSAGE_LENGTH];
+        snprintf(msg, sizeof(msg), "%s%s", prefix, message);
+
+        ak_post_log_message(pApplication, level, msg);
+    }
+}
+
+void ak_log_messagef(ak_application* pApplication, int level, const char* category, const char* format, ...)
 {
     va_list args;
     va_start(args, format);
     {
-        char msg[4096];
-        vsnprintf(msg, sizeof(msg), format, args);
-
-        ak_log(pApplication, msg);
+        ak_log_messagev(pApplication, level, category, format, args);
     }
     va_end(args);
 }
 
-void ak_warning(ak_application* pApplication, const char* message)
+void ak_set_log_level(ak_application* pApplication, int level)
+{
+    if (pApplication == NULL) {
+        return;
+    }
+
+    pApplication->logLevel = level;
+}
+
+int ak_get_log_level(ak_application* pApplication)
+{
+    if (pApplication == NULL) {
+        return AK_DEFAULT_LOG_LEVEL;
+    }
+
+    return pApplication->logLevel;
+}
+
+bool ak_is_log_level_enabled(ak_application* pApplication, int level)
+{
+    if (pApplication == NULL) {
+        return false;
+    }
+
+    return level >= AK_MIN_LOG_LEVEL && level >= pApplication->logLevel;
+}
+
+
+// The names are in parentheses so that they are still defined when AK_MIN_LOG_LEVEL replaces them with macros.
+void (ak_log)(ak_application* pApplication, const char* message)
 {
-    ak_logf(pApplication, "[WARNING] %s", message);
+    ak_log_message(pApplication, AK_LOG_LEVEL_INFO, NULL, message);
 }
 
-void ak_warningf(ak_application* pApplication, const char* format, ...)
+void (ak_logf)(ak_application* pApplication, const char* format, ...)
 {
     va_list args;
     va_start(args, format);
     {
-        char msg[4096];
-        vsnprintf(msg, sizeof(msg), format, args);
-
-        ak_warning(pApplication, msg);
+        ak_log_messagev(pApplication, AK_LOG_LEVEL_INFO, NULL, format, args);
     }
     va_end(args);
 }
 
-void ak_error(ak_application* pApplication, const char* message)
+void (ak_warning)(ak_application* pApplication, const char* message)
 {
-    ak_logf(pApplication, "[ERROR] %s", message);
+    ak_log_message(pApplication, AK_LOG_LEVEL_WARNING, NULL, message);
 }
 
-void ak_errorf(ak_application* pApplication, const char* format, ...)
+void (ak_warningf)(ak_application* pApplication, const char* format, ...)
 {
     va_list args;
     va_start(args, format);
     {
-        char msg[4096];
-        vsnprintf(msg, sizeof(msg), format, args);
+        ak_log_messagev(pApplication, AK_LOG_LEVEL_WARNING, NULL, format, args);
+    }
+    va_end(args);
+}
+
+void (ak_error)(ak_application* pApplication, const char* message)
+{
+    ak_log_message(pApplication, AK_LOG_LEVEL_ERROR, NULL, message);
+}
 
-        ak_error(pApplication, msg);
+void (ak_errorf)(ak_application* pApplication, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    {
+        ak_log_messagev(pApplication, AK_LOG_LEVEL_ERROR, NULL, format, args);
     }
     va_end(args);
 }
@@ -517,6 +1092,35 @@ ak_log_proc ak_get_log_callback(ak_application* pApplication)
     return pApplication->onLog;
 }
 
+void ak_set_log_flush_policy(ak_application* pApplication, ak_log_flush_policy policy)
+{
+    if (pApplication == NULL) {
+        return;
+    }
+
+    ak_logger_set_flush_policy(pApplication->pLogger, policy);
+}
+
+ak_log_flush_policy ak_get_log_flush_policy(ak_application* pApplication)
+{
+    if (pApplication == NULL) {
+        ak_log_flush_policy policy;
+        memset(&policy, 0, sizeof(policy));
+        return policy;
+    }
+
+    return ak_logger_get_flush_policy(pApplication->pLogger);
+}
+
+void ak_flush_log(ak_application* pApplication)
+{
+    if (pApplication == NULL) {
+        return;
+    }
+
+    ak_logger_flush(pApplication->pLogger);
+}
+
 bool ak_get_log_file_folder_path(ak_application* pApplication, char* pathOut, size_t pathOutSize)
 {
     if (pApplication == NULL) {
@@ -612,19 +1216,41 @@ ak_window* ak_get_element_window(drgui_element* pElement)
         return NULL;
     }
 
-    return ak_get_panel_window(drgui_find_top_level_element(pElement));
-}
+    // Panels in the main hierarchy and the tools attached to them have their window cached, so the search stops at
+    // the first one of those. Usually that's the element itself or it's tool. Panels inside tools don't have a cached
+    // window so the search carries on past them. The root panel of every window has one, so this only gets all the way
+    // to the top for elements that aren't in a window.
+    for (drgui_element* pAncestor = pElement; pAncestor != NULL; pAncestor = pAncestor->pParent)
+    {
+        ak_window* pWindow = NULL;
+        if (ak_is_panel(pAncestor)) {
+            pWindow = ak_panel_get_cached_window(pAncestor);
+        } else if (ak_is_tool(pAncestor)) {
+            pWindow = ak_get_tool_cached_window(pAncestor);
+        }
 
-ak_window* ak_get_window_by_name(ak_application* pApplication, const char* pName)
-{
-    if (pApplication == NULL) {
-        return NULL;
+        if (pWindow != NULL) {
+            return pWindow;
+        }
+    }
+
+    return NULL;
+}
+
+ak_window* ak_get_window_by_name(ak_application* pApplication, const char* pName)
+{
+    if (pApplication == NULL || pName == NULL || pName[0] == '\0' || pApplication->windowsByNameCount == 0) {
+        return NULL;
     }
 
-    for (ak_window* pWindow = ak_get_first_window(pApplication); pWindow != NULL; pWindow = ak_get_next_window(pApplication, pWindow))
+    uint32_t hash = ak_hash_string(pName);
+    size_t mask = pApplication->windowsByNameCapacity - 1;
+
+    for (size_t i = hash & mask; pApplication->pWindowsByName[i].pWindow != NULL; i = (i + 1) & mask)
     {
-        if (strcmp(ak_get_window_name(pWindow), pName) == 0) {
-            return pWindow;
+        ak_window_name_entry* pEntry = &pApplication->pWindowsByName[i];
+        if (pEntry->hash == hash && strcmp(ak_get_window_name(pEntry->pWindow), pName) == 0) {
+            return pEntry->pWindow;
         }
     }
 
@@ -675,14 +1301,25 @@ ak_window* ak_get_next_window(ak_application* pApplication, ak_window* pWindow)
 
 ak_window* ak_get_primary_window(ak_application* pApplication)
 {
-    for (ak_window* pWindow = ak_get_first_window(pApplication); pWindow != NULL; pWindow = ak_get_next_window(pApplication, pWindow))
+    if (pApplication == NULL) {
+        return NULL;
+    }
+
+    if (pApplication->isPrimaryWindowStale)
     {
-        if (ak_get_window_type(pWindow) == ak_window_type_application) {
-            return pWindow;
+        pApplication->pPrimaryWindow = NULL;
+        for (ak_window* pWindow = ak_get_first_window(pApplication); pWindow != NULL; pWindow = ak_get_next_window(pApplication, pWindow))
+        {
+            if (ak_get_window_type(pWindow) == ak_window_type_application) {
+                pApplication->pPrimaryWindow = pWindow;
+                break;
+            }
         }
+
+        pApplication->isPrimaryWindowStale = false;
     }
 
-    return NULL;
+    return pApplication->pPrimaryWindow;
 }
 
 
@@ -743,30 +1380,90 @@ drgui_element* ak_get_next_panel(ak_application* pApplication, drgui_element* pP
 }
 
 
-drgui_element* ak_find_first_panel_by_type(ak_application* pApplication, const char* pPanelType)
+// Retrieves the atom after <pAtom> in a pre-order traversal of the sub-types of <pRootAtom>.
+static ak_panel_type_atom* ak_get_next_panel_type_atom(ak_panel_type_atom* pAtom, ak_panel_type_atom* pRootAtom)
 {
-    for (drgui_element* pPanel = ak_get_first_panel(pApplication); pPanel != NULL; pPanel = ak_get_next_panel(pApplication, pPanel))
+    assert(pAtom != NULL);
+    assert(pRootAtom != NULL);
+
+    if (pAtom->pFirstChild != NULL) {
+        return pAtom->pFirstChild;
+    }
+
+    for (; pAtom != pRootAtom; pAtom = pAtom->pParent)
     {
-        if (ak_panel_is_of_type(pPanel, pPanelType)) {
-            return pPanel;
+        if (pAtom->pNextSibling != NULL) {
+            return pAtom->pNextSibling;
         }
     }
 
     return NULL;
 }
 
-drgui_element* ak_find_next_panel_by_type(ak_application* pApplication, drgui_element* pPanel, const char* pPanelType)
+// Retrieves the first panel of the type of <pAtom>, or any of it's sub-types, starting from <pAtom> and continuing in
+// the order of ak_get_next_panel_type_atom().
+static drgui_element* ak_find_first_panel_from_type_atom(ak_panel_type_atom* pAtom, ak_panel_type_atom* pRootAtom)
 {
-    for (drgui_element* pNextPanel = ak_get_next_panel(pApplication, pPanel); pNextPanel != NULL; pNextPanel = ak_get_next_panel(pApplication, pNextPanel))
+    for (; pAtom != NULL; pAtom = ak_get_next_panel_type_atom(pAtom, pRootAtom))
     {
-        if (ak_panel_is_of_type(pNextPanel, pPanelType)) {
-            return pNextPanel;
+        if (pAtom->pFirstPanel != NULL) {
+            return pAtom->pFirstPanel;
         }
     }
 
     return NULL;
 }
 
+drgui_element* ak_find_first_panel_by_type(ak_application* pApplication, const char* pPanelType)
+{
+    if (pApplication == NULL || pPanelType == NULL) {
+        return NULL;
+    }
+
+    ak_panel_type_atom* pAtom = ak_application_find_panel_type(pApplication, pPanelType);
+    if (pAtom == NULL) {
+        return NULL;
+    }
+
+    return ak_find_first_panel_from_type_atom(pAtom, pAtom);
+}
+
+drgui_element* ak_find_next_panel_by_type(ak_application* pApplication, drgui_element* pPanel, const char* pPanelType)
+{
+    if (pApplication == NULL || pPanel == NULL || pPanelType == NULL) {
+        return NULL;
+    }
+
+    ak_panel_type_atom* pRootAtom = ak_application_find_panel_type(pApplication, pPanelType);
+    if (pRootAtom == NULL) {
+        return NULL;
+    }
+
+    // <pPanel> should have been returned by a previous call to ak_find_first_panel_by_type() or this function, in
+    // which case it's atom will be a sub-type of the root atom. If it's not, we start from the beginning.
+    ak_panel_type_atom* pAtom = ak_panel_get_type_atom(pPanel);
+    ak_panel_type_atom* pAncestorAtom = pAtom;
+    while (pAncestorAtom != NULL && pAncestorAtom != pRootAtom) {
+        pAncestorAtom = pAncestorAtom->pParent;
+    }
+
+    if (pAncestorAtom == NULL) {
+        return ak_find_first_panel_from_type_atom(pRootAtom, pRootAtom);
+    }
+
+    drgui_element* pNextPanel = ak_panel_get_next_panel_of_same_type(pPanel);
+    if (pNextPanel != NULL) {
+        return pNextPanel;
+    }
+
+    pAtom = ak_get_next_panel_type_atom(pAtom, pRootAtom);
+    if (pAtom == NULL) {
+        return NULL;
+    }
+
+    return ak_find_first_panel_from_type_atom(pAtom, pRootAtom);
+}
+
 
 void ak_set_on_run(ak_application* pApplication, ak_run_proc proc)
 {
@@ -825,6 +1522,169 @@ ak_delete_tool_proc ak_get_on_delete_tool(ak_application* pApplication)
 }
 
 
+void ak_set_on_get_tool_title(ak_application* pApplication, ak_get_tool_title_proc proc)
+{
+    if (pApplication == NULL) {
+        return;
+    }
+
+    pApplication->onGetToolTitle = proc;
+}
+
+ak_get_tool_title_proc ak_get_on_get_tool_title(ak_application* pApplication)
+{
+    if (pApplication == NULL) {
+        return NULL;
+    }
+
+    return pApplication->onGetToolTitle;
+}
+
+
+static void ak_on_tool_precreation_timer(ak_timer* pTimer, void* pUserData)
+{
+    ak_application* pApplication = pUserData;
+    assert(pApplication != NULL);
+
+    // Only one tool is created per tick so that the main loop is never blocked for long. Pre-creation stops once there
+    // are no placeholders left, or if a tool fails to be created, in which case it'll be tried again when it's tab is
+    // activated. It's started again when another placeholder is queued.
+    //
+    // An active placeholder is one whose real tool already failed to be created when it's tab was activated, so it's
+    // dropped from the queue rather than tried again here. Each placeholder only leaves the queue once, so the loop is
+    // constant time when spread over every tick.
+    drgui_element* pPlaceholder;
+    do
+    {
+        pPlaceholder = ak_dequeue_placeholder_tool(pApplication);
+    } while (pPlaceholder != NULL && pPlaceholder == ak_panel_get_active_tool(ak_get_tool_panel(pPlaceholder)));
+
+    if (pPlaceholder != NULL && ak_panel_realize_tool(ak_get_tool_panel(pPlaceholder), pPlaceholder) != pPlaceholder) {
+        return;
+    }
+
+    ak_delete_timer(pTimer);
+    pApplication->pToolPrecreationTimer = NULL;
+}
+
+/// Starts replacing placeholder tools in the background if it's enabled and startup has completed.
+static void ak_start_tool_precreation(ak_application* pApplication)
+{
+    assert(pApplication != NULL);
+
+    if (pApplication->toolPrecreationIntervalInMilliseconds == 0 || !pApplication->isStartupComplete || pApplication->pToolPrecreationTimer != NULL) {
+        return;
+    }
+
+    pApplication->pToolPrecreationTimer = ak_create_timer(pApplication, pApplication->toolPrecreationIntervalInMilliseconds, ak_on_tool_precreation_timer, pApplication);
+}
+
+void ak_set_tool_precreation_interval(ak_application* pApplication, unsigned int intervalInMilliseconds)
+{
+    if (pApplication == NULL) {
+        return;
+    }
+
+    pApplication->toolPrecreationIntervalInMilliseconds = intervalInMilliseconds;
+
+    // The timer is restarted so the new interval takes effect straight away.
+    ak_delete_timer(pApplication->pToolPrecreationTimer);
+    pApplication->pToolPrecreationTimer = NULL;
+
+    ak_start_tool_precreation(pApplication);
+}
+
+
+static void ak_on_tool_hibernation_timer(ak_timer* pTimer, void* pUserData)
+{
+    (void)pTimer;
+
+    ak_application* pApplication = pUserData;
+    assert(pApplication != NULL);
+
+    // When the process is using too much memory every inactive tool is hibernated, no matter how recently it was used.
+    uint64_t minInactiveTime;
+    if (pApplication->toolHibernationMemoryThreshold > 0 && ak_get_process_memory_usage() > pApplication->toolHibernationMemoryThreshold) {
+        minInactiveTime = 0;
+    } else if (pApplication->toolHibernationInactiveTimeInMinutes > 0) {
+        minInactiveTime = (uint64_t)pApplication->toolHibernationInactiveTimeInMinutes * 60 * 1000000;
+    } else {
+        return;
+    }
+
+    uint64_t now = ak_get_time_in_microseconds();
+    for (drgui_element* pPanel = ak_get_first_panel(pApplication); pPanel != NULL; pPanel = ak_get_next_panel(pApplication, pPanel))
+    {
+        drgui_element* pActiveTool = ak_panel_get_active_tool(pPanel);
+        for (drgui_element* pTool = ak_panel_get_first_tool(pPanel); pTool != NULL; pTool = ak_panel_get_next_tool(pPanel, pTool))
+        {
+            if (pTool == pActiveTool || ak_is_tool_hibernating(pTool)) {
+                continue;
+            }
+
+            uint64_t deactivationTime = ak_get_tool_deactivation_time(pTool);
+            if (now >= deactivationTime && now - deactivationTime >= minInactiveTime) {
+                ak_hibernate_tool(pTool);
+            }
+        }
+    }
+}
+
+void ak_set_tool_hibernation_policy(ak_application* pApplication, unsigned int inactiveTimeInMinutes, size_t memoryThresholdInBytes)
+{
+    if (pApplication == NULL) {
+        return;
+    }
+
+    pApplication->toolHibernationInactiveTimeInMinutes = inactiveTimeInMinutes;
+    pApplication->toolHibernationMemoryThreshold       = memoryThresholdInBytes;
+
+    // The timer only needs to run while the policy is enabled.
+    if (inactiveTimeInMinutes > 0 || memoryThresholdInBytes > 0)
+    {
+        if (pApplication->pToolHibernationTimer == NULL) {
+            pApplication->pToolHibernationTimer = ak_create_timer(pApplication, AK_TOOL_HIBERNATION_CHECK_INTERVAL, ak_on_tool_hibernation_timer, pApplication);
+        }
+    }
+    else
+    {
+        ak_delete_timer(pApplication->pToolHibernationTimer);
+        pApplication->pToolHibernationTimer = NULL;
+    }
+}
+
+void ak_set_tool_hibernation_folder(ak_application* pApplication, const char* folderPath)
+{
+    if (pApplication == NULL) {
+        return;
+    }
+
+    // Paths that are too long are treated as if there's no folder so that state is never written somewhere unexpected.
+    if (folderPath == NULL || strcpy_s(pApplication->toolHibernationFolderPath, sizeof(pApplication->toolHibernationFolderPath), folderPath) != 0) {
+        pApplication->toolHibernationFolderPath[0] = '\0';
+    }
+}
+
+bool ak_application_get_tool_hibernation_file_path(ak_application* pApplication, char* pathOut, size_t pathOutSize)
+{
+    assert(pApplication != NULL);
+    assert(pathOut != NULL);
+
+    if (pApplication->toolHibernationFolderPath[0] == '\0') {
+        return false;
+    }
+
+    char fileName[32];
+    snprintf(fileName, sizeof(fileName), "tool%u.state", pApplication->toolHibernationFileCounter++);
+
+    if (strcpy_s(pathOut, pathOutSize, pApplication->toolHibernationFolderPath) != 0) {
+        return false;
+    }
+
+    return drpath_append(pathOut, (unsigned int)pathOutSize, fileName);
+}
+
+
 drgui_element* ak_create_tool_by_type_and_attributes(ak_application* pApplication, ak_window* pWindow, const char* type, const char* attributes)
 {
     if (pApplication == NULL || type == NULL) {
@@ -836,11 +1696,17 @@ drgui_element* ak_create_tool_by_type_and_attributes(ak_application* pApplicatio
 
     // At this point we know the tool type is not a built-in so we need to give the host application a chance to
     // instantiate it in case it's a custom tool type.
+    drgui_element* pTool = NULL;
     if (pApplication->onCreateTool) {
-        return pApplication->onCreateTool(pApplication, pWindow, type, attributes);
+        pTool = pApplication->onCreateTool(pApplication, pWindow, type, attributes);
     }
 
-    return NULL;
+    // The tool remembers what it was created from so it can be reused when switching to another layout.
+    if (pTool != NULL) {
+        ak_set_tool_layout_info(pTool, type, attributes);
+    }
+
+    return pTool;
 }
 
 bool ak_application_delete_tool(ak_application* pApplication, drgui_element* pTool, bool force)
@@ -849,7 +1715,18 @@ bool ak_application_delete_tool(ak_application* pApplication, drgui_element* pTo
         return false;
     }
 
-    // First check for built-in tools.
+    // First check for built-in tools. Placeholders are created by the application itself, so the host application
+    // never needs to know about them.
+    if (ak_is_placeholder_tool(pTool))
+    {
+        drgui_element* pPanel = ak_get_tool_panel(pTool);
+        if (pPanel != NULL) {
+            ak_panel_detach_tool(pPanel, pTool);
+        }
+
+        ak_delete_tool(pTool);
+        return true;
+    }
 
 
     // At this point we know the tool type is not a built-in so we need to give the host application a chance to
@@ -934,9 +1811,128 @@ void ak_handle_action(ak_application* pApplication, const char* pActionName)
         return;
     }
 
+    // If the action has not been registered there can't be a handler for it so we can go straight to the callback.
+    ak_action_id actionID = ak_action_registry_find(pApplication->pActionRegistry, pActionName);
+    if (actionID != 0) {
+        ak_handle_action_by_id(pApplication, actionID);
+        return;
+    }
+
     if (pApplication->onHandleAction) {
+        uint64_t traceBeginTime = ak_trace_begin(pApplication);
+        pApplication->onHandleAction(pApplication, pActionName);
+        ak_trace_end(pApplication, traceBeginTime, "ak_handle_action", AK_TRACE_CATEGORY_ACTION, pActionName);
+    }
+}
+
+void ak_handle_action_by_id(ak_application* pApplication, ak_action_id actionID)
+{
+    if (pApplication == NULL) {
+        return;
+    }
+
+    const char* pActionName = ak_action_registry_get_name(pApplication->pActionRegistry, actionID);
+    if (pActionName == NULL) {
+        return;
+    }
+
+    const ak_action_handler* pHandler = ak_action_registry_find_handler(pApplication->pActionRegistry, 0, actionID);
+    if (pHandler != NULL)
+    {
+        uint64_t traceBeginTime = ak_trace_begin(pApplication);
+        pHandler->proc(pApplication, NULL, actionID, pHandler->pUserData);
+        ak_trace_end(pApplication, traceBeginTime, "ak_handle_action", AK_TRACE_CATEGORY_ACTION, pActionName);
+    }
+    else if (pApplication->onHandleAction)
+    {
+        uint64_t traceBeginTime = ak_trace_begin(pApplication);
         pApplication->onHandleAction(pApplication, pActionName);
+        ak_trace_end(pApplication, traceBeginTime, "ak_handle_action", AK_TRACE_CATEGORY_ACTION, pActionName);
+    }
+}
+
+
+ak_action_id ak_register_action(ak_application* pApplication, const char* pActionName)
+{
+    if (pApplication == NULL) {
+        return 0;
+    }
+
+    return ak_action_registry_intern(pApplication->pActionRegistry, pActionName);
+}
+
+ak_action_id ak_find_action(ak_application* pApplication, const char* pActionName)
+{
+    if (pApplication == NULL) {
+        return 0;
+    }
+
+    return ak_action_registry_find(pApplication->pActionRegistry, pActionName);
+}
+
+const char* ak_get_action_name(ak_application* pApplication, ak_action_id actionID)
+{
+    if (pApplication == NULL) {
+        return NULL;
+    }
+
+    return ak_action_registry_get_name(pApplication->pActionRegistry, actionID);
+}
+
+bool ak_set_action_handler(ak_application* pApplication, ak_action_id actionID, ak_action_handler_proc proc, void* pUserData)
+{
+    if (pApplication == NULL) {
+        return false;
+    }
+
+    return ak_action_registry_set_handler(pApplication->pActionRegistry, 0, actionID, proc, pUserData);
+}
+
+bool ak_set_tool_type_action_handler(ak_application* pApplication, const char* toolType, ak_action_id actionID, ak_action_handler_proc proc, void* pUserData)
+{
+    if (pApplication == NULL || toolType == NULL || toolType[0] == '\0') {
+        return false;
+    }
+
+    uint32_t toolTypeID = ak_action_registry_intern_scope(pApplication->pActionRegistry, toolType);
+    if (toolTypeID == 0) {
+        return false;
+    }
+
+    return ak_action_registry_set_handler(pApplication->pActionRegistry, toolTypeID, actionID, proc, pUserData);
+}
+
+
+bool ak_bind_shortcut(ak_application* pApplication, const char* shortcut, ak_action_id actionID)
+{
+    if (pApplication == NULL || ak_action_registry_get_name(pApplication->pActionRegistry, actionID) == NULL) {
+        return false;
     }
+
+    return ak_accelerator_table_bind(pApplication->pAcceleratorTable, shortcut, actionID);
+}
+
+void ak_clear_shortcuts(ak_application* pApplication)
+{
+    if (pApplication == NULL) {
+        return;
+    }
+
+    ak_accelerator_table_clear(pApplication->pAcceleratorTable);
+}
+
+bool ak_get_action_shortcut_text(ak_application* pApplication, ak_action_id actionID, char* textOut, size_t textOutSize)
+{
+    if (pApplication == NULL)
+    {
+        if (textOut != NULL && textOutSize > 0) {
+            textOut[0] = '\0';
+        }
+
+        return false;
+    }
+
+    return ak_accelerator_table_get_shortcut_text(pApplication->pAcceleratorTable, actionID, textOut, textOutSize);
 }
 
 
@@ -961,7 +1957,11 @@ int ak_exec(ak_application* pApplication, const char* cmd)
     }
 
     if (pApplication->onExec) {
-        return pApplication->onExec(pApplication, cmd);
+        uint64_t traceBeginTime = ak_trace_begin(pApplication);
+        int result = pApplication->onExec(pApplication, cmd);
+        ak_trace_end(pApplication, traceBeginTime, "ak_exec", AK_TRACE_CATEGORY_ACTION, cmd);
+
+        return result;
     }
 
     return 0;
@@ -969,14 +1969,11 @@ int ak_exec(ak_application* pApplication, const char* cmd)
 
 
 //// Timers ////
-#ifdef AK_USE_WIN32
+
 struct ak_timer
 {
-    /// The value returned by SetTimer().
-    UINT_PTR tagWin32;
-
-    /// The window associated with the timer.
-    HWND hWnd;
+    /// The application that owns the timer.
+    ak_application* pApplication;
 
     /// The timeout in milliseconds.
     unsigned int timeoutInMilliseconds;
@@ -986,93 +1983,191 @@ struct ak_timer
 
     /// The user data passed to ak_create_timer().
     void* pUserData;
+
+    /// The time in microseconds at which the timer is next due to fire.
+    uint64_t deadline;
+
+    /// The index of the timer in the application's timer heap.
+    size_t heapIndex;
+
+    /// The number of times the timer has fired since the stats were last reset.
+    unsigned int fireCount;
+
+    /// The sum of the lateness of every fire since the stats were last reset, in microseconds.
+    uint64_t totalLatenessInMicroseconds;
+
+    /// The largest lateness since the stats were last reset, in microseconds.
+    uint64_t maxLatenessInMicroseconds;
 };
 
-static VOID CALLBACK ak_timer_proc_win32(HWND hWnd, UINT uMsg, UINT_PTR idEvent, DWORD dwTime)
+/// Retrieves the period of the given timer in microseconds. This is never 0 so that a timer with a timeout of 0 can't
+/// stall the main loop.
+static uint64_t ak_timer_get_period(ak_timer* pTimer)
 {
-    (void)hWnd;
-    (void)uMsg;
-    (void)dwTime;
+    assert(pTimer != NULL);
 
-    ak_timer* pTimer = (ak_timer*)idEvent;
-    if (pTimer == NULL) {
-        assert(false);
+    if (pTimer->timeoutInMilliseconds == 0) {
+        return 1000;
     }
 
-    if (pTimer->callback != NULL) {
-        pTimer->callback(pTimer, pTimer->pUserData);
-    }
+    return (uint64_t)pTimer->timeoutInMilliseconds * 1000;
 }
 
+static void ak_timer_heap_swap(ak_application* pApplication, size_t indexA, size_t indexB)
+{
+    assert(pApplication != NULL);
 
-ak_timer* ak_create_timer(ak_application* pApplication, unsigned int timeoutInMilliseconds, ak_timer_proc callback, void* pUserData)
+    ak_timer* pTimerA = pApplication->ppTimerHeap[indexA];
+    ak_timer* pTimerB = pApplication->ppTimerHeap[indexB];
+
+    pApplication->ppTimerHeap[indexA] = pTimerB;
+    pApplication->ppTimerHeap[indexB] = pTimerA;
+    pTimerB->heapIndex = indexA;
+    pTimerA->heapIndex = indexB;
+}
+
+static void ak_timer_heap_sift_up(ak_application* pApplication, size_t index)
 {
-    if (pApplication == NULL) {
-        return NULL;
+    assert(pApplication != NULL);
+
+    while (index > 0)
+    {
+        size_t parentIndex = (index - 1) / 2;
+        if (pApplication->ppTimerHeap[parentIndex]->deadline <= pApplication->ppTimerHeap[index]->deadline) {
+            break;
+        }
+
+        ak_timer_heap_swap(pApplication, index, parentIndex);
+        index = parentIndex;
     }
+}
 
-    ak_timer* pTimer = malloc(sizeof(*pTimer));
-    if (pTimer == NULL) {
-        return NULL;
+static void ak_timer_heap_sift_down(ak_application* pApplication, size_t index)
+{
+    assert(pApplication != NULL);
+
+    for (;;)
+    {
+        size_t smallestIndex = index;
+        size_t leftIndex     = index*2 + 1;
+        size_t rightIndex    = index*2 + 2;
+
+        if (leftIndex < pApplication->timerCount && pApplication->ppTimerHeap[leftIndex]->deadline < pApplication->ppTimerHeap[smallestIndex]->deadline) {
+            smallestIndex = leftIndex;
+        }
+        if (rightIndex < pApplication->timerCount && pApplication->ppTimerHeap[rightIndex]->deadline < pApplication->ppTimerHeap[smallestIndex]->deadline) {
+            smallestIndex = rightIndex;
+        }
+
+        if (smallestIndex == index) {
+            break;
+        }
+
+        ak_timer_heap_swap(pApplication, index, smallestIndex);
+        index = smallestIndex;
     }
+}
 
-    // On Win32 we need to associate the timer with a window.
-    pTimer->tagWin32 = SetTimer(pApplication->hTimerWnd, (UINT_PTR)pTimer, timeoutInMilliseconds, ak_timer_proc_win32);
-    if (pTimer->tagWin32 == 0) {
-        free(pTimer);
-        return NULL;
+static bool ak_timer_heap_push(ak_application* pApplication, ak_timer* pTimer)
+{
+    assert(pApplication != NULL);
+    assert(pTimer != NULL);
+
+    if (pApplication->timerCount == pApplication->timerHeapCapacity)
+    {
+        size_t newCapacity = (pApplication->timerHeapCapacity == 0) ? 16 : pApplication->timerHeapCapacity*2;
+        ak_timer** ppNewHeap = realloc(pApplication->ppTimerHeap, newCapacity * sizeof(*ppNewHeap));
+        if (ppNewHeap == NULL) {
+            return false;
+        }
+
+        pApplication->ppTimerHeap       = ppNewHeap;
+        pApplication->timerHeapCapacity = newCapacity;
     }
 
-    pTimer->hWnd                  = pApplication->hTimerWnd;
-    pTimer->timeoutInMilliseconds = timeoutInMilliseconds;
-    pTimer->callback              = callback;
-    pTimer->pUserData             = pUserData;
+    pTimer->heapIndex = pApplication->timerCount;
+    pApplication->ppTimerHeap[pApplication->timerCount] = pTimer;
+    pApplication->timerCount += 1;
 
-    return pTimer;
+    ak_timer_heap_sift_up(pApplication, pTimer->heapIndex);
+    return true;
 }
 
-void ak_delete_timer(ak_timer* pTimer)
+static void ak_timer_heap_remove(ak_application* pApplication, ak_timer* pTimer)
 {
-    if (pTimer == NULL) {
-        return;
+    assert(pApplication != NULL);
+    assert(pTimer != NULL);
+    assert(pTimer->heapIndex < pApplication->timerCount);
+    assert(pApplication->ppTimerHeap[pTimer->heapIndex] == pTimer);
+
+    size_t index     = pTimer->heapIndex;
+    size_t lastIndex = pApplication->timerCount - 1;
+    if (index != lastIndex) {
+        ak_timer_heap_swap(pApplication, index, lastIndex);
     }
 
-    KillTimer(pTimer->hWnd, pTimer->tagWin32);
-    free(pTimer);
-}
-#endif
+    pApplication->timerCount -= 1;
+    pTimer->heapIndex = (size_t)-1;
 
-#ifdef AK_USE_GTK
-#include <gtk/gtk.h>
+    if (index < pApplication->timerCount) {
+        ak_timer_heap_sift_up(pApplication, index);
+        ak_timer_heap_sift_down(pApplication, pApplication->ppTimerHeap[index]->heapIndex);
+    }
+}
 
-struct ak_timer
+/// Fires every timer that is due, including those that are due within the slack window.
+static void ak_dispatch_timers(ak_application* pApplication)
 {
-    /// The GTK timer ID.
-    guint timerID;
+    assert(pApplication != NULL);
 
-    /// The timeout in milliseconds.
-    unsigned int timeoutInMilliseconds;
+    uint64_t now = ak_get_time_in_microseconds();
+    uint64_t fireUntil = now + pApplication->timerSlackInMicroseconds;
 
-    /// The callback function.
-    ak_timer_proc callback;
+    while (pApplication->timerCount > 0)
+    {
+        ak_timer* pTimer = pApplication->ppTimerHeap[0];
+        if (pTimer->deadline > fireUntil) {
+            break;
+        }
 
-    /// The user data passed to ak_create_timer().
-    void* pUserData;
-};
+        // The timer is taken out of the heap while it's callback is running which makes it safe for the callback to
+        // delete any timer, including itself.
+        ak_timer_heap_remove(pApplication, pTimer);
 
-static gboolean ak_timer_proc_gtk(gpointer data)
-{
-    ak_timer* pTimer = (ak_timer*)data;
-    if (pTimer == NULL) {
-        assert(false);
-        return 0;
-    }
+        uint64_t lateness = (now > pTimer->deadline) ? now - pTimer->deadline : 0;
+        pTimer->fireCount += 1;
+        pApplication->stats.timerFireCount += 1;
+        pTimer->totalLatenessInMicroseconds += lateness;
+        if (pTimer->maxLatenessInMicroseconds < lateness) {
+            pTimer->maxLatenessInMicroseconds = lateness;
+        }
 
-    if (pTimer->callback != NULL) {
-        pTimer->callback(pTimer, pTimer->pUserData);
-    }
+        pApplication->pDispatchingTimer          = pTimer;
+        pApplication->wasDispatchingTimerDeleted = false;
+        {
+            if (pTimer->callback != NULL) {
+                uint64_t traceBeginTime = ak_trace_begin(pApplication);
+                pTimer->callback(pTimer, pTimer->pUserData);
+                ak_trace_end(pApplication, traceBeginTime, "timer", AK_TRACE_CATEGORY_TIMER, NULL);
+            }
+        }
+        pApplication->pDispatchingTimer = NULL;
 
-    return true;
+        if (pApplication->wasDispatchingTimerDeleted) {
+            free(pTimer);
+            continue;
+        }
+
+        // The next deadline is based on the previous one so that the timer doesn't drift. If we've fallen so far behind
+        // that the next deadline has already passed we just skip ahead rather than firing a burst of catch-up events.
+        uint64_t period = ak_timer_get_period(pTimer);
+        pTimer->deadline += period;
+        if (pTimer->deadline <= now) {
+            pTimer->deadline = now + period;
+        }
+
+        ak_timer_heap_push(pApplication, pTimer);
+    }
 }
 
 
@@ -1087,11 +2182,20 @@ ak_timer* ak_create_timer(ak_application* pApplication, unsigned int timeoutInMi
         return NULL;
     }
 
-    pTimer->timerID               = g_timeout_add(timeoutInMilliseconds, ak_timer_proc_gtk, pTimer);
+    pTimer->pApplication          = pApplication;
     pTimer->timeoutInMilliseconds = timeoutInMilliseconds;
     pTimer->callback              = callback;
     pTimer->pUserData             = pUserData;
+    pTimer->deadline              = ak_get_time_in_microseconds() + ak_timer_get_period(pTimer);
+    pTimer->heapIndex             = (size_t)-1;
+    ak_reset_timer_stats(pTimer);
 
+    if (!ak_timer_heap_push(pApplication, pTimer)) {
+        free(pTimer);
+        return NULL;
+    }
+
+    ak_rearm_timers(pApplication);
     return pTimer;
 }
 
@@ -1101,593 +2205,2649 @@ void ak_delete_timer(ak_timer* pTimer)
         return;
     }
 
-    g_source_remove(pTimer->timerID);
+    ak_application* pApplication = pTimer->pApplication;
+    assert(pApplication != NULL);
+
+    // If the timer is being deleted from inside it's own callback it will not be in the heap. It'll be freed when the
+    // callback returns.
+    if (pApplication->pDispatchingTimer == pTimer) {
+        pApplication->wasDispatchingTimerDeleted = true;
+        return;
+    }
+
+    ak_timer_heap_remove(pApplication, pTimer);
     free(pTimer);
+
+    // We don't want to re-arm while timers are being dispatched because that'll be done at the end anyway.
+    if (pApplication->pDispatchingTimer == NULL) {
+        ak_rearm_timers(pApplication);
+    }
 }
-#endif
 
+ak_timer_stats ak_get_timer_stats(ak_timer* pTimer)
+{
+    ak_timer_stats stats;
+    memset(&stats, 0, sizeof(stats));
 
+    if (pTimer == NULL) {
+        return stats;
+    }
 
-///////////////////////////////////////////////////////////////////////////////
-//
-// Private APIs
-//
-///////////////////////////////////////////////////////////////////////////////
+    stats.fireCount = pTimer->fireCount;
+    if (pTimer->fireCount > 0) {
+        stats.averageLatenessInMilliseconds = (pTimer->totalLatenessInMicroseconds / (double)pTimer->fireCount) / 1000.0;
+    }
+    stats.maxLatenessInMilliseconds = pTimer->maxLatenessInMicroseconds / 1000.0;
 
-static int ak_main_loop(ak_application* pApplication)
+    return stats;
+}
+
+void ak_reset_timer_stats(ak_timer* pTimer)
 {
-#ifdef AK_USE_WIN32
-    (void)pApplication;
+    if (pTimer == NULL) {
+        return;
+    }
 
-    MSG msg;
-    BOOL bRet;
-    while ((bRet = GetMessage(&msg, NULL, 0, 0)) != 0)
-    {
-        if (bRet == -1)
-        {
-            // Unknown error.
-            return -42;
-        }
+    pTimer->fireCount                   = 0;
+    pTimer->totalLatenessInMicroseconds = 0;
+    pTimer->maxLatenessInMicroseconds   = 0;
+}
 
-        TranslateMessage(&msg);
-        DispatchMessageA(&msg);
+void ak_set_timer_slack(ak_application* pApplication, unsigned int slackInMilliseconds)
+{
+    if (pApplication == NULL) {
+        return;
     }
 
-    return 0;
-#endif
+    pApplication->timerSlackInMicroseconds = (uint64_t)slackInMilliseconds * 1000;
+}
 
-#ifdef AK_USE_GTK
-    (void)pApplication;
-    gtk_main();
-    return 0;   // TODO: Return proper error codes.
-#endif
+unsigned int ak_get_timer_slack(ak_application* pApplication)
+{
+    if (pApplication == NULL) {
+        return 0;
+    }
+
+    return (unsigned int)(pApplication->timerSlackInMicroseconds / 1000);
 }
 
-static void ak_on_config_error(void* pUserData, const char* message)
+
+#ifdef AK_USE_WIN32
+static VOID CALLBACK ak_timer_proc_win32(HWND hWnd, UINT uMsg, UINT_PTR idEvent, DWORD dwTime)
 {
-    ak_application* pApplication = pUserData;
-    assert(pApplication != NULL);
+    (void)uMsg;
+    (void)dwTime;
+
+    ak_application* pApplication = (ak_application*)idEvent;
+    if (pApplication == NULL) {
+        assert(false);
+        return;
+    }
 
-    ak_errorf(pApplication, "[CONFIG] %s", message);
+    // The platform timer is one-shot from our point of view. It'll be re-armed for the next deadline below.
+    KillTimer(hWnd, idEvent);
+    pApplication->armedTimerDeadline = 0;
+
+    ak_dispatch_timers(pApplication);
+    ak_rearm_timers(pApplication);
 }
 
-static bool ak_load_and_apply_config(ak_application* pApplication)
+static void ak_rearm_timers(ak_application* pApplication)
 {
     assert(pApplication != NULL);
 
-
-    // We load the theme first because it contains the data we need for drawing the window which will be shown when the
-    // main config is applied.
-    char themePath[DRFS_MAX_PATH];
-    if (ak_get_theme_file_path(pApplication, themePath, sizeof(themePath))) {
-        ak_theme_load_from_file(pApplication, &pApplication->theme, themePath);
+    if (pApplication->timerCount == 0) {
+        ak_disarm_timers(pApplication);
+        return;
     }
 
+    uint64_t deadline = pApplication->ppTimerHeap[0]->deadline;
+    if (deadline == pApplication->armedTimerDeadline) {
+        return;     // Already armed for this deadline.
+    }
 
-    // We first need to try and open the config file. If we can't find it we need to try and load the default config. If both
-    // fail, we need to return false.
-    char configPath[DRFS_MAX_PATH];
-    if (ak_get_config_file_path(pApplication, configPath, sizeof(configPath)))
-    {
-        drfs_file* pConfigFile;
-        if (drfs_open(ak_get_application_vfs(pApplication), configPath, DRFS_READ, &pConfigFile) == drfs_success)
-        {
-            ak_config config;
-            if (ak_parse_config_from_file(&config, pConfigFile, ak_on_config_error, pApplication))
-            {
-                bool result = ak_apply_config(pApplication, &config);
+    uint64_t now = ak_get_time_in_microseconds();
+    UINT delayInMilliseconds = (deadline > now) ? (UINT)((deadline - now + 999) / 1000) : 0;
 
-                ak_uninit_config(&config);
-                return result;
-            }
-        }
+    // Calling SetTimer() with an existing ID will replace the existing timer.
+    if (SetTimer(pApplication->hTimerWnd, (UINT_PTR)pApplication, delayInMilliseconds, ak_timer_proc_win32) != 0) {
+        pApplication->armedTimerDeadline = deadline;
     }
+}
 
+static void ak_disarm_timers(ak_application* pApplication)
+{
+    assert(pApplication != NULL);
 
-    // If we get here we want to try loading the default config.
-    if (pApplication->onGetDefaultConfig)
-    {
-        ak_config config;
-        if (ak_parse_config_from_string(&config, pApplication->onGetDefaultConfig(pApplication), ak_on_config_error, pApplication))
-        {
-            bool result = ak_apply_config(pApplication, &config);
+    if (pApplication->armedTimerDeadline != 0) {
+        KillTimer(pApplication->hTimerWnd, (UINT_PTR)pApplication);
+        pApplication->armedTimerDeadline = 0;
+    }
+}
+#endif
 
-            ak_uninit_config(&config);
-            return result;
-        }
+#ifdef AK_USE_GTK
+static gboolean ak_timer_proc_gtk(gpointer data)
+{
+    ak_application* pApplication = (ak_application*)data;
+    if (pApplication == NULL) {
+        assert(false);
+        return false;
     }
 
+    // Returning false below will remove the source. It'll be re-armed for the next deadline.
+    pApplication->timerSourceID      = 0;
+    pApplication->armedTimerDeadline = 0;
+
+    ak_dispatch_timers(pApplication);
+    ak_rearm_timers(pApplication);
 
-    // If we get here, both configs have failed to load.
     return false;
 }
 
-static bool ak_apply_config(ak_application* pApplication, ak_config* pConfig)
+static void ak_rearm_timers(ak_application* pApplication)
 {
     assert(pApplication != NULL);
-    assert(pConfig      != NULL);
 
-    // We need to find the initial layout object.
-    ak_layout* pInitialLayout = ak_config_find_root_layout_by_name(pConfig, pConfig->currentLayoutName);
-    if (pInitialLayout == NULL) {
-        pInitialLayout = pConfig->pRootLayout->pFirstChild;
+    if (pApplication->timerCount == 0) {
+        ak_disarm_timers(pApplication);
+        return;
+    }
 
-        if (pInitialLayout == NULL) {
-            return false;
-        }
+    uint64_t deadline = pApplication->ppTimerHeap[0]->deadline;
+    if (deadline == pApplication->armedTimerDeadline) {
+        return;     // Already armed for this deadline.
     }
 
-    return ak_apply_layout(pApplication, pInitialLayout, NULL);
+    ak_disarm_timers(pApplication);
+
+    uint64_t now = ak_get_time_in_microseconds();
+    guint delayInMilliseconds = (deadline > now) ? (guint)((deadline - now + 999) / 1000) : 0;
+
+    pApplication->timerSourceID      = g_timeout_add(delayInMilliseconds, ak_timer_proc_gtk, pApplication);
+    pApplication->armedTimerDeadline = deadline;
 }
 
-static bool ak_apply_layout(ak_application* pApplication, ak_layout* pLayout, drgui_element* pWorkingPanel)
+static void ak_disarm_timers(ak_application* pApplication)
 {
     assert(pApplication != NULL);
-    assert(pLayout      != NULL);
-
-    if (strcmp(pLayout->type, AK_LAYOUT_TYPE_LAYOUT) == 0)
-    {
-        // It's a root level layout object - we just iterate over every child and call this function recursively.
-        assert(pWorkingPanel == NULL);
 
-        for (ak_layout* pChild = pLayout->pFirstChild; pChild != NULL; pChild = pChild->pNextSibling)
-        {
-            if (!ak_apply_layout(pApplication, pChild, pWorkingPanel))
-            {
-                return false;
-            }
-        }
+    if (pApplication->timerSourceID != 0) {
+        g_source_remove(pApplication->timerSourceID);
+        pApplication->timerSourceID = 0;
     }
-    else if (strcmp(pLayout->type, AK_LAYOUT_TYPE_WINDOW) == 0)
-    {
-        // It's an application window.
-        ak_window* pParentWindow = ak_get_element_window(pWorkingPanel);
 
-        ak_window* pWindow = ak_create_window(pApplication, ak_window_type_application, pParentWindow, 0, NULL);
-        if (pWindow == NULL) {
-            return false;
-        }
+    pApplication->armedTimerDeadline = 0;
+}
+#endif
 
-        // We need to parse the attributes.
-        ak_window_layout_attributes attr;
-        if (!ak_parse_window_layout_attributes(pLayout->attributes, &attr)) {
-            return false;
-        }
+#ifdef AK_USE_HEADLESS
+// There's no platform timer when running headless. Due timers are dispatched by ak_headless_pump() and the main loop
+// uses the armed deadline to work out how long it can sleep for.
+static void ak_rearm_timers(ak_application* pApplication)
+{
+    assert(pApplication != NULL);
 
-        ak_set_window_name(pWindow, attr.name);
-        ak_set_window_title(pWindow, attr.title);
-        ak_set_window_position(pWindow, attr.posX, attr.posY);
-        ak_set_window_size(pWindow, attr.width, attr.height);
+    if (pApplication->timerCount == 0) {
+        ak_disarm_timers(pApplication);
+        return;
+    }
 
-        if (attr.maximized) {
-            ak_show_window_maximized(pWindow);
-        } else {
-            ak_show_window(pWindow);
-        }
+    pApplication->armedTimerDeadline = pApplication->ppTimerHeap[0]->deadline;
+}
 
+static void ak_disarm_timers(ak_application* pApplication)
+{
+    assert(pApplication != NULL);
+    pApplication->armedTimerDeadline = 0;
+}
+#endif
 
-        // There should only be one child item, and it should be a panel. If not, it's an error.
-        if (pLayout->pFirstChild == NULL) {
-            return false;
-        }
 
-        return ak_apply_layout(pApplication, pLayout->pFirstChild, ak_get_window_panel(pWindow));
+
+//// Threading ////
+
+bool ak_submit_work(ak_application* pApplication, ak_work_proc proc, void* pUserData)
+{
+    if (pApplication == NULL || proc == NULL) {
+        return false;
     }
-    else if (strcmp(pLayout->type, AK_LAYOUT_TYPE_PANEL) == 0)
-    {
-        // It's a panel. If it's a split panel we just split it and load the next two panels which correspond to the two split partitions. If
-        // it's not split, we just leave it be and iterate over what should be a list of tools.
 
-        ak_panel_layout_attributes attr;
-        if (!ak_parse_panel_layout_attributes(pLayout->attributes, &attr)) {
-            return false;
-        }
+    return ak_thread_pool_submit(pApplication->pThreadPool, proc, pUserData);
+}
 
-        // We only set the panel type for panels that are not the top-level panel.
-        if (pWorkingPanel != ak_get_window_panel(ak_get_panel_window(pWorkingPanel))) {
-            if (attr.type[0] != '\0') {
-                ak_panel_set_type(pWorkingPanel, attr.type);
-            }
-        } else {
-            if (attr.type[0] != '\0') {
-                ak_warning(pApplication, "Attempting to set panel type of a top-level panel which is illegal.");
-            }
-        }
+/// Wakes up the main loop so that it drains the main thread queue.
+static void ak_wake_main_thread(ak_application* pApplication)
+{
+    assert(pApplication != NULL);
 
+#ifdef AK_USE_WIN32
+    PostMessageA(pApplication->hTimerWnd, AK_WM_MAIN_THREAD_WORK, 0, (LPARAM)pApplication);
+#endif
+#ifdef AK_USE_GTK
+    uint64_t value = 1;
+    if (write(pApplication->mainThreadWakeFD, &value, sizeof(value)) < 0) {
+        // The counter is saturated which means a wake up is already pending.
+    }
+#endif
+#ifdef AK_USE_HEADLESS
+    ak_signal_event(&pApplication->mainThreadWakeEvent);
+#endif
+}
 
-        if (attr.splitAxis == ak_panel_split_axis_none)
-        {
-            // It's not a split panel which means the next items should be just a list of tools.
-            for (ak_layout* pChild = pLayout->pFirstChild; pChild != NULL; pChild = pChild->pNextSibling)
-            {
-                if (!ak_apply_layout(pApplication, pChild, pWorkingPanel))
-                {
-                    return false;
-                }
-            }
-        }
-        else
+bool ak_post_to_main_thread(ak_application* pApplication, ak_work_proc proc, void* pUserData)
+{
+    if (pApplication == NULL || proc == NULL) {
+        return false;
+    }
+
+    bool wasEmpty;
+    ak_lock_mutex(&pApplication->mainThreadQueueLock);
+    {
+        if (pApplication->mainThreadQueueCount == pApplication->mainThreadQueueCapacity)
         {
-            // It's a split panel which means there should be two children. If not, it's an error.
-            ak_layout* pChildLayout1 = pLayout->pFirstChild;
-            if (pChildLayout1 == NULL) {
+            size_t newCapacity = (pApplication->mainThreadQueueCapacity == 0) ? 64 : pApplication->mainThreadQueueCapacity*2;
+            ak_work_item* pNewQueue = realloc(pApplication->pMainThreadQueue, newCapacity * sizeof(*pNewQueue));
+            if (pNewQueue == NULL) {
+                ak_unlock_mutex(&pApplication->mainThreadQueueLock);
                 return false;
             }
 
-            ak_layout* pChildLayout2 = pChildLayout1->pNextSibling;
-            if (pChildLayout2 == NULL) {
-                return false;
-            }
+            pApplication->pMainThreadQueue        = pNewQueue;
+            pApplication->mainThreadQueueCapacity = newCapacity;
+        }
 
+        wasEmpty = pApplication->mainThreadQueueCount == 0;
 
-            if (!ak_panel_split(pWorkingPanel, attr.splitAxis, attr.splitPos)) {
-                return false;
-            }
+        pApplication->pMainThreadQueue[pApplication->mainThreadQueueCount].proc      = proc;
+        pApplication->pMainThreadQueue[pApplication->mainThreadQueueCount].pUserData = pUserData;
+        pApplication->mainThreadQueueCount += 1;
+    }
+    ak_unlock_mutex(&pApplication->mainThreadQueueLock);
 
 
-            return ak_apply_layout(pApplication, pChildLayout1, ak_panel_get_split_panel_1(pWorkingPanel)) && ak_apply_layout(pApplication, pChildLayout2, ak_panel_get_split_panel_2(pWorkingPanel));
-        }
+    // The main loop only needs to be woken up for the first item of a batch. Everything posted before the batch is
+    // drained will be picked up by the same wake up.
+    if (wasEmpty) {
+        ak_wake_main_thread(pApplication);
+    }
+
+    return true;
+}
+
+unsigned int ak_get_worker_thread_count(ak_application* pApplication)
+{
+    if (pApplication == NULL) {
+        return 0;
+    }
+
+    return ak_thread_pool_get_thread_count(pApplication->pThreadPool);
+}
+
+
+
+//// Statistics ////
+
+ak_application_stats ak_get_application_stats(ak_application* pApplication)
+{
+    ak_application_stats stats;
+    if (pApplication == NULL) {
+        memset(&stats, 0, sizeof(stats));
+        return stats;
+    }
+
+    return pApplication->stats;
+}
+
+void ak_reset_application_stats(ak_application* pApplication)
+{
+    if (pApplication == NULL) {
+        return;
+    }
+
+    memset(&pApplication->stats, 0, sizeof(pApplication->stats));
+
+    for (ak_window* pWindow = ak_get_application_first_window(pApplication); pWindow != NULL; pWindow = ak_get_application_next_window(pApplication, pWindow)) {
+        ak_reset_window_stats(pWindow);
     }
-    else if (strcmp(pLayout->type, AK_LAYOUT_TYPE_TOOL) == 0)
+}
+
+const char* ak_event_type_to_string(ak_event_type type)
+{
+    switch (type)
     {
-        // It's a tool. Tools are instantiated based on it's type and attributes. The type is the first token in the config script's
-        // attribute list and the attributes is the remainder.
-        //
-        // When instantiating tools, we don't actually fail - we just silently ignore it. Thus, we never return false at this point.
+    case ak_event_type_close:                 return "close";
+    case ak_event_type_hide:                  return "hide";
+    case ak_event_type_show:                  return "show";
+    case ak_event_type_activate:              return "activate";
+    case ak_event_type_deactivate:            return "deactivate";
+    case ak_event_type_focus:                 return "focus";
+    case ak_event_type_unfocus:               return "unfocus";
+    case ak_event_type_mouse_enter:           return "mouse_enter";
+    case ak_event_type_mouse_leave:           return "mouse_leave";
+    case ak_event_type_mouse_move:            return "mouse_move";
+    case ak_event_type_mouse_button_down:     return "mouse_button_down";
+    case ak_event_type_mouse_button_up:       return "mouse_button_up";
+    case ak_event_type_mouse_button_dblclick: return "mouse_button_dblclick";
+    case ak_event_type_mouse_wheel:           return "mouse_wheel";
+    case ak_event_type_key_down:              return "key_down";
+    case ak_event_type_key_up:                return "key_up";
+    case ak_event_type_printable_key_down:    return "printable_key_down";
+
+    case ak_event_type_count:
+    default: break;
+    }
 
-        char toolType[AK_MAX_WINDOW_NAME_LENGTH];
-        const char* toolAttributes = dr_first_non_whitespace(dr_next_token(pLayout->attributes, toolType, sizeof(toolType)));
-        if (toolAttributes != NULL)
-        {
-            drgui_element* pTool = ak_create_tool_by_type_and_attributes(pApplication, ak_get_element_window(pWorkingPanel), toolType, toolAttributes);
-            if (pTool != NULL) {
-                if (ak_panel_attach_tool(pWorkingPanel, pTool)) {
-                    drgui_show(pTool);
-                }
-            }
-        }
+    return "unknown";
+}
+
+
+
+//// Tracing ////
+
+/// Called on a worker thread to write out the events that have been recorded since the last drain.
+static void ak_drain_trace(ak_application* pApplication, void* pUserData)
+{
+    (void)pUserData;
+
+    ak_tracer_drain(pApplication->pTracer);
+    ak_atomic_store(&pApplication->isTraceDrainPending, 0);
+}
+
+static void ak_on_trace_drain_timer(ak_timer* pTimer, void* pUserData)
+{
+    (void)pTimer;
+
+    ak_application* pApplication = pUserData;
+    assert(pApplication != NULL);
+
+    // If the previous drain is still running it'll pick up anything this one would have.
+    if (!ak_atomic_compare_exchange(&pApplication->isTraceDrainPending, 0, 1)) {
+        return;
+    }
+
+    if (!ak_submit_work(pApplication, ak_drain_trace, NULL)) {
+        ak_atomic_store(&pApplication->isTraceDrainPending, 0);
+    }
+}
+
+bool ak_start_tracing(ak_application* pApplication)
+{
+    if (pApplication == NULL || pApplication->pTracer == NULL || ak_tracer_is_enabled(pApplication->pTracer)) {
+        return false;
+    }
+
+    drfs_file* pFile = ak_open_file_in_log_folder(pApplication, ".trace.json", NULL, 0);
+    if (pFile == NULL) {
+        ak_log_warning(pApplication, NULL, "Failed to open trace file.");
+        return false;
+    }
+
+    if (!ak_tracer_start(pApplication->pTracer, pFile)) {
+        drfs_close(pFile);
+        return false;
+    }
+
+    // Events are written out periodically so that a long trace does not hold everything in memory until it's stopped.
+    // The writing itself is done on a worker thread.
+    pApplication->pTraceDrainTimer = ak_create_timer(pApplication, AK_TRACE_DRAIN_INTERVAL, ak_on_trace_drain_timer, pApplication);
+    if (pApplication->pTraceDrainTimer == NULL) {
+        ak_log_warning(pApplication, NULL, "Failed to create trace drain timer. Events will be written when tracing is stopped.");
     }
 
     return true;
 }
 
-static void ak_delete_tools_recursive(ak_application* pApplication, drgui_element* pPanel)
+void ak_stop_tracing(ak_application* pApplication)
 {
-    if (pApplication == NULL || pPanel == NULL) {
+    if (pApplication == NULL) {
         return;
     }
 
-    // If it's split, we call this recursively.
-    if (ak_panel_get_split_axis(pPanel) != ak_panel_split_axis_none)
-    {
-        ak_delete_tools_recursive(pApplication, ak_panel_get_split_panel_1(pPanel));
-        ak_delete_tools_recursive(pApplication, ak_panel_get_split_panel_2(pPanel));
+    ak_delete_timer(pApplication->pTraceDrainTimer);
+    pApplication->pTraceDrainTimer = NULL;
+
+    // A drain that's still queued does nothing once the tracer has been stopped.
+    drfs_close(ak_tracer_stop(pApplication->pTracer));
+}
+
+bool ak_is_tracing(ak_application* pApplication)
+{
+    if (pApplication == NULL) {
+        return false;
     }
-    else
-    {
-        drgui_element* pFirstTool = NULL;
-        while ((pFirstTool = ak_panel_get_first_tool(pPanel)) != NULL)
-        {
-            ak_application_delete_tool(pApplication, pFirstTool, true);    // "true" means to force deletion of the tool.
 
-            // As a safety precaution to avoid an infinite loop, if the first tool was not detached we'll forcefully detach it.
-            if (pFirstTool == ak_panel_get_first_tool(pPanel)) {
-                ak_panel_detach_tool(pPanel, pFirstTool);
-            }
-        }
+    return ak_tracer_is_enabled(pApplication->pTracer);
+}
+
+uint64_t ak_trace_begin(ak_application* pApplication)
+{
+    if (!ak_is_tracing(pApplication)) {
+        return 0;
+    }
+
+    return ak_get_time_in_microseconds();
+}
+
+void ak_trace_end(ak_application* pApplication, uint64_t beginTime, const char* name, const char* category, const char* detail)
+{
+    if (pApplication == NULL || beginTime == 0) {
+        return;
+    }
+
+    ak_tracer_record(pApplication->pTracer, name, category, detail, beginTime, ak_get_time_in_microseconds());
+}
+
+
+
+//// Startup ////
+
+ak_startup_stats ak_get_startup_stats(ak_application* pApplication)
+{
+    ak_startup_stats stats;
+    if (pApplication == NULL) {
+        memset(&stats, 0, sizeof(stats));
+        return stats;
+    }
+
+    return pApplication->startupStats;
+}
+
+void ak_set_log_startup_summary(ak_application* pApplication, bool enabled)
+{
+    if (pApplication == NULL) {
+        return;
+    }
+
+    pApplication->logStartupSummary = enabled;
+}
+
+
+
+#ifdef AK_USE_HEADLESS
+//// Headless ////
+
+int ak_headless_start_application(ak_application* pApplication)
+{
+    if (pApplication == NULL) {
+        return -1;
+    }
+
+    return ak_start_application(pApplication);
+}
+
+bool ak_headless_pump(ak_application* pApplication)
+{
+    if (pApplication == NULL) {
+        return false;
+    }
+
+    ak_drain_main_thread_queue(pApplication);
+
+    if (pApplication->armedTimerDeadline != 0 && pApplication->armedTimerDeadline <= ak_get_time_in_microseconds() + pApplication->timerSlackInMicroseconds) {
+        pApplication->armedTimerDeadline = 0;
+        ak_dispatch_timers(pApplication);
+        ak_rearm_timers(pApplication);
     }
+
+    // Painting is done last so that it reflects everything that was done above.
+    ak_headless_paint_windows(pApplication);
+
+    return !pApplication->isQuitMessagePosted;
 }
 
+int ak_headless_get_exit_code(ak_application* pApplication)
+{
+    if (pApplication == NULL) {
+        return 0;
+    }
 
+    return pApplication->exitCode;
+}
+#endif
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-// Private APIs Declared in ak_application_private.h
+// Private APIs
 //
 ///////////////////////////////////////////////////////////////////////////////
 
-ak_window* ak_get_application_first_window(ak_application* pApplication)
+static int ak_main_loop(ak_application* pApplication)
+{
+#ifdef AK_USE_WIN32
+    (void)pApplication;
+
+    MSG msg;
+    BOOL bRet;
+    while ((bRet = GetMessage(&msg, NULL, 0, 0)) != 0)
+    {
+        if (bRet == -1)
+        {
+            // Unknown error.
+            return -42;
+        }
+
+        TranslateMessage(&msg);
+        DispatchMessageA(&msg);
+    }
+
+    return 0;
+#endif
+
+#ifdef AK_USE_GTK
+    (void)pApplication;
+    gtk_main();
+    return 0;   // TODO: Return proper error codes.
+#endif
+
+#ifdef AK_USE_HEADLESS
+    while (ak_headless_pump(pApplication))
+    {
+        // Sleep until the next timer is due or something is posted to the main thread. Events injected from another
+        // thread need to go through ak_post_to_main_thread() which is what wakes us up.
+        unsigned int timeoutInMilliseconds = AK_INFINITE;
+        if (pApplication->armedTimerDeadline != 0)
+        {
+            uint64_t now = ak_get_time_in_microseconds();
+            timeoutInMilliseconds = (pApplication->armedTimerDeadline > now) ? (unsigned int)((pApplication->armedTimerDeadline - now + 999) / 1000) : 0;
+        }
+
+        if (timeoutInMilliseconds > 0) {
+            ak_wait_event(&pApplication->mainThreadWakeEvent, timeoutInMilliseconds);
+        }
+    }
+
+    return pApplication->exitCode;
+#endif
+}
+
+static int ak_start_application(ak_application* pApplication)
 {
     assert(pApplication != NULL);
-    return pApplication->pFirstWindow;
+
+    // The first thing to do when running the application is to load the default config and apply it. If a config
+    // file cannot be found, a default config will be requested. If the default config fails, the config will fail
+    // and an error code will be returned.
+    uint64_t traceBeginTime = ak_trace_begin(pApplication);
+    bool result = ak_load_and_apply_config(pApplication);
+    ak_trace_end(pApplication, traceBeginTime, "ak_load_and_apply_config", AK_TRACE_CATEGORY_STARTUP, NULL);
+
+    if (!result) {
+        return -2;
+    }
+
+    // After we've loaded and applied the config, but before entering the main loop, we need to let the host application
+    // do some custom initialization which we'll achieve via a callback function.
+    if (pApplication->onRun) {
+        uint64_t onRunStartTime = ak_get_time_in_microseconds();
+        pApplication->onRun(pApplication);
+        uint64_t onRunEndTime = ak_get_time_in_microseconds();
+
+        pApplication->startupStats.onRunTimeInMicroseconds = onRunEndTime - onRunStartTime;
+        ak_trace_record(pApplication, "onRun", AK_TRACE_CATEGORY_STARTUP, NULL, onRunStartTime, onRunEndTime);
+    }
+
+    return 0;
 }
 
-ak_window* ak_get_application_next_non_child_window(ak_application* pApplication, ak_window* pWindow)
+static void ak_on_config_error(void* pUserData, const char* message)
 {
-    if (pApplication == NULL || pWindow == NULL) {
-        return NULL;
+    ak_application* pApplication = pUserData;
+    assert(pApplication != NULL);
+
+    ak_log_message(pApplication, AK_LOG_LEVEL_ERROR, AK_LOG_CATEGORY_CONFIG, message);
+}
+
+static bool ak_load_and_apply_config(ak_application* pApplication)
+{
+    assert(pApplication != NULL);
+
+
+    // We load the theme first because it contains the data we need for drawing the window which will be shown when the
+    // main config is applied.
+    char themePath[DRFS_MAX_PATH];
+    if (ak_get_theme_file_path(pApplication, themePath, sizeof(themePath))) {
+        uint64_t themeLoadStartTime = ak_get_time_in_microseconds();
+        ak_theme_load_from_file(pApplication, &pApplication->theme, themePath);
+        uint64_t themeLoadEndTime = ak_get_time_in_microseconds();
+
+        pApplication->startupStats.themeLoadTimeInMicroseconds = themeLoadEndTime - themeLoadStartTime;
+        ak_trace_record(pApplication, "ak_theme_load_from_file", AK_TRACE_CATEGORY_STARTUP, NULL, themeLoadStartTime, themeLoadEndTime);
+    }
+
+
+    // We first need to try and load the config file. If we can't find it we need to try and load the default config. If both
+    // fail, we need to return false.
+    char configPath[DRFS_MAX_PATH];
+    if (ak_get_config_file_path(pApplication, configPath, sizeof(configPath)))
+    {
+        uint64_t parseStartTime = ak_get_time_in_microseconds();
+        ak_layout_cache* pConfig = ak_load_config_file(pApplication, configPath);
+        pApplication->startupStats.configParseTimeInMicroseconds += ak_get_time_in_microseconds() - parseStartTime;
+
+        if (pConfig != NULL)
+        {
+            pApplication->pCompiledConfig = pConfig;
+            return ak_apply_config(pApplication, pConfig);
+        }
+    }
+
+
+    // If we get here we want to try loading the default config.
+    if (pApplication->onGetDefaultConfig)
+    {
+        const char* defaultConfig = pApplication->onGetDefaultConfig(pApplication);
+        uint64_t parseStartTime = ak_get_time_in_microseconds();
+
+        // The config takes ownership of the text it's parsed from, so the default config needs to be copied.
+        ak_layout_cache* pConfig = NULL;
+        if (defaultConfig != NULL)
+        {
+            size_t defaultConfigLength = strlen(defaultConfig);
+
+            char* pConfigText = malloc(defaultConfigLength + 1);
+            if (pConfigText != NULL) {
+                memcpy(pConfigText, defaultConfig, defaultConfigLength + 1);
+                pConfig = ak_parse_and_compile_config(pApplication, pConfigText, defaultConfigLength, NULL, NULL);
+            }
+        }
+
+        pApplication->startupStats.configParseTimeInMicroseconds += ak_get_time_in_microseconds() - parseStartTime;
+
+        if (pConfig != NULL)
+        {
+            pApplication->pCompiledConfig = pConfig;
+            return ak_apply_config(pApplication, pConfig);
+        }
+    }
+
+
+    // If we get here, both configs have failed to load.
+    return false;
+}
+
+/// Reads the whole of the given file into a null terminated buffer allocated with malloc(). The null terminator is not
+/// included in <pSizeOut>.
+static char* ak_read_config_file(drfs_context* pVFS, const char* path, size_t* pSizeOut)
+{
+    assert(pVFS     != NULL);
+    assert(path     != NULL);
+    assert(pSizeOut != NULL);
+
+    drfs_file* pFile;
+    if (drfs_open(pVFS, path, DRFS_READ, &pFile) != drfs_success) {
+        return NULL;
+    }
+
+    uint64_t fileSize = drfs_size(pFile);
+    if (fileSize >= SIZE_MAX) {
+        drfs_close(pFile);
+        return NULL;
+    }
+
+    char* pData = malloc((size_t)fileSize + 1);
+    if (pData == NULL) {
+        drfs_close(pFile);
+        return NULL;
+    }
+
+    size_t bytesRead;
+    drfs_result result = drfs_read(pFile, pData, (size_t)fileSize, &bytesRead);
+    drfs_close(pFile);
+
+    if (result != drfs_success) {
+        free(pData);
+        return NULL;
+    }
+
+    pData[bytesRead] = '\0';
+
+    *pSizeOut = bytesRead;
+    return pData;
+}
+
+static ak_layout_cache* ak_load_config_file(ak_application* pApplication, const char* configPath)
+{
+    assert(pApplication != NULL);
+    assert(configPath   != NULL);
+
+    drfs_context* pVFS = ak_get_application_vfs(pApplication);
+
+    drfs_file_info configInfo;
+    if (drfs_get_file_info(pVFS, configPath, &configInfo) != drfs_success) {
+        return NULL;
+    }
+
+    // The compiled config is stored next to the config itself.
+    char cachePath[DRFS_MAX_PATH];
+    if (strcpy_s(cachePath, sizeof(cachePath), configPath) != 0 || strcat_s(cachePath, sizeof(cachePath), ".cache") != 0) {
+        cachePath[0] = '\0';
+    }
+
+
+    // If the modification time and size of the config are the same as when the cache was compiled, the config is
+    // assumed to be unchanged and doesn't even need to be read.
+    ak_layout_cache* pCache = NULL;
+    uint64_t cacheSourceModifiedTime = 0;
+    uint64_t cacheSourceSize = 0;
+    uint32_t cacheSourceHash = 0;
+
+    if (cachePath[0] != '\0')
+    {
+        pCache = ak_load_layout_cache(pVFS, cachePath);
+        if (pCache != NULL)
+        {
+            ak_layout_cache_get_source_info(pCache, &cacheSourceModifiedTime, &cacheSourceSize, &cacheSourceHash);
+            if (cacheSourceModifiedTime == configInfo.lastModifiedTime && cacheSourceSize == configInfo.sizeInBytes) {
+                pApplication->startupStats.isConfigFromCache = true;
+                return pCache;
+            }
+        }
+    }
+
+
+    // The file is read once into a buffer that's handed straight to the parser, which parses it in place.
+    size_t configTextSize;
+    char* pConfigText = ak_read_config_file(pVFS, configPath, &configTextSize);
+    if (pConfigText == NULL) {
+        ak_delete_layout_cache(pCache);
+        return NULL;
+    }
+
+    uint32_t configHash = ak_hash_string(pConfigText);
+
+    // The config might have only been touched, in which case the contents will be the same and the cache can still be
+    // used. The cache is re-saved so that the next run can take the quicker path above.
+    if (pCache != NULL && cacheSourceHash == configHash && cacheSourceSize == configInfo.sizeInBytes)
+    {
+        free(pConfigText);
+
+        ak_layout_cache_set_source_info(pCache, configInfo.lastModifiedTime, configInfo.sizeInBytes, configHash);
+        ak_save_layout_cache(pCache, pVFS, cachePath);
+
+        pApplication->startupStats.isConfigFromCache = true;
+        return pCache;
+    }
+
+    ak_delete_layout_cache(pCache);
+    pCache = NULL;
+
+
+    // If we get here the cache is missing or stale and the config needs to be parsed and compiled again.
+    return ak_parse_and_compile_config(pApplication, pConfigText, configTextSize, configPath, (cachePath[0] != '\0') ? cachePath : NULL);
+}
+
+
+/// A job that parses every layout of a config and saves the result to it's cache on a worker thread.
+struct ak_config_cache_job
+{
+    /// The config file to parse.
+    char configPath[DRFS_MAX_PATH];
+
+    /// The file to save the compiled config to.
+    char cachePath[DRFS_MAX_PATH];
+
+    /// Whether or not the parser reported any errors.
+    bool hasErrors;
+};
+
+static void ak_on_config_cache_job_error(void* pUserData, const char* message)
+{
+    (void)message;
+
+    // Errors have already been reported by the main thread when the layout they belong to was parsed, or will be when
+    // it's switched to, so all that matters here is that the cache should not be saved.
+    ak_config_cache_job* pJob = pUserData;
+    assert(pJob != NULL);
+
+    pJob->hasErrors = true;
+}
+
+/// Called on a worker thread to parse and compile every layout of a config and save it to the cache.
+///
+/// @remarks
+///     The config file is read again rather than sharing the main thread's config, which is still being parsed lazily.
+///     The application's VFS is only used on the main thread, so the job uses it's own.
+static void ak_run_config_cache_job(ak_application* pApplication, void* pUserData)
+{
+    (void)pApplication;
+
+    ak_config_cache_job* pJob = pUserData;
+    assert(pJob != NULL);
+
+    drfs_context* pVFS = drfs_create_context();
+    if (pVFS == NULL) {
+        free(pJob);
+        return;
+    }
+
+    drfs_file_info configInfo;
+    size_t configTextSize;
+    char* pConfigText = NULL;
+    if (drfs_get_file_info(pVFS, pJob->configPath, &configInfo) == drfs_success) {
+        pConfigText = ak_read_config_file(pVFS, pJob->configPath, &configTextSize);
+    }
+
+    if (pConfigText != NULL)
+    {
+        uint32_t configHash = ak_hash_string(pConfigText);
+
+        // The cache is only saved if every layout parsed without errors so that the errors are reported again the next
+        // time the config is loaded.
+        ak_config config;
+        if (ak_parse_config_from_buffer(&config, pConfigText, configTextSize, ak_on_config_cache_job_error, pJob))
+        {
+            if (ak_config_load_all_layouts(&config) && !pJob->hasErrors)
+            {
+                ak_layout_cache* pCache = ak_compile_layout_cache(&config);
+                if (pCache != NULL) {
+                    ak_layout_cache_set_source_info(pCache, configInfo.lastModifiedTime, configInfo.sizeInBytes, configHash);
+                    ak_save_layout_cache(pCache, pVFS, pJob->cachePath);
+                    ak_delete_layout_cache(pCache);
+                }
+            }
+
+            ak_uninit_config(&config);
+        }
+    }
+
+    drfs_delete_context(pVFS);
+    free(pJob);
+}
+
+static void ak_submit_config_cache_job(ak_application* pApplication)
+{
+    assert(pApplication != NULL);
+
+    ak_config_cache_job* pJob = pApplication->pPendingConfigCacheJob;
+    if (pJob == NULL) {
+        return;
+    }
+
+    pApplication->pPendingConfigCacheJob = NULL;
+
+    // The cache is only an optimization for the next run, so it's not worth blocking the main thread for if the job
+    // can't be submitted.
+    if (!ak_submit_work(pApplication, ak_run_config_cache_job, pJob)) {
+        free(pJob);
+    }
+}
+
+static ak_layout_cache* ak_parse_and_compile_config(ak_application* pApplication, char* pConfigText, size_t configTextSize, const char* configPath, const char* cachePath)
+{
+    assert(pApplication          != NULL);
+    assert(pApplication->pConfig == NULL);
+    assert(pConfigText           != NULL);
+
+    ak_config* pConfig = malloc(sizeof(*pConfig));
+    if (pConfig == NULL) {
+        free(pConfigText);
+        return NULL;
+    }
+
+    if (!ak_parse_config_from_buffer(pConfig, pConfigText, configTextSize, ak_on_config_error, pApplication)) {
+        free(pConfig);
+        return NULL;
+    }
+
+    // This only includes the initial layout, which is all that's needed to get the application started.
+    ak_layout_cache* pCache = ak_compile_layout_cache(pConfig);
+    if (pCache == NULL) {
+        ak_error(pApplication, "Failed to compile config.");
+        ak_uninit_config(pConfig);
+        free(pConfig);
+        return NULL;
+    }
+
+    // The config is kept so that the rest of the layouts can be parsed when they're first switched to.
+    pApplication->pConfig = pConfig;
+
+
+    // The cache needs every layout, which would be too slow to do now, so it's rewritten in the background later.
+    if (configPath != NULL && cachePath != NULL)
+    {
+        ak_config_cache_job* pJob = calloc(1, sizeof(*pJob));
+        if (pJob != NULL)
+        {
+            if (strcpy_s(pJob->configPath, sizeof(pJob->configPath), configPath) == 0 && strcpy_s(pJob->cachePath, sizeof(pJob->cachePath), cachePath) == 0) {
+                pApplication->pPendingConfigCacheJob = pJob;
+            } else {
+                free(pJob);
+            }
+        }
+    }
+
+    return pCache;
+}
+
+static bool ak_load_config_layout(ak_application* pApplication, const char* layoutName)
+{
+    assert(pApplication          != NULL);
+    assert(pApplication->pConfig != NULL);
+    assert(layoutName            != NULL);
+
+    // Any errors will have been reported through ak_on_config_error().
+    if (ak_config_find_root_layout_by_name(pApplication->pConfig, layoutName) == NULL) {
+        return false;
+    }
+
+    // The layouts that were already loaded are compiled again along with the new one. That's cheap compared to
+    // parsing, which is only ever done once per layout.
+    ak_layout_cache* pCache = ak_compile_layout_cache(pApplication->pConfig);
+    if (pCache == NULL) {
+        ak_error(pApplication, "Failed to compile config.");
+        return false;
+    }
+
+    ak_delete_layout_cache(pApplication->pCompiledConfig);
+    pApplication->pCompiledConfig = pCache;
+
+    return true;
+}
+
+static bool ak_apply_config(ak_application* pApplication, ak_layout_cache* pConfig)
+{
+    assert(pApplication != NULL);
+    assert(pConfig      != NULL);
+
+    // We need to find the initial layout object.
+    uint32_t initialLayoutIndex = ak_layout_cache_find_layout(pConfig, ak_layout_cache_get_initial_layout_name(pConfig));
+    if (initialLayoutIndex == (uint32_t)-1) {
+        if (ak_layout_cache_get_node_count(pConfig) == 0) {
+            return false;
+        }
+
+        initialLayoutIndex = 0;
+    }
+
+    // Shortcuts. A bad shortcut is not fatal.
+    for (uint32_t i = 0; i < ak_layout_cache_get_shortcut_count(pConfig); ++i)
+    {
+        const ak_layout_cache_shortcut* pShortcut = ak_layout_cache_get_shortcut(pConfig, i);
+        const char* keys       = ak_layout_cache_get_string(pConfig, pShortcut->keys);
+        const char* actionName = ak_layout_cache_get_string(pConfig, pShortcut->actionName);
+
+        if (!ak_bind_shortcut(pApplication, keys, ak_register_action(pApplication, actionName))) {
+            ak_warningf(pApplication, "Failed to bind shortcut \"%s\" to action \"%s\".", keys, actionName);
+        }
+    }
+
+    uint64_t layoutApplyStartTime = ak_get_time_in_microseconds();
+    ak_begin_batch_update(pApplication);
+    bool result = ak_apply_layout(pApplication, pConfig, initialLayoutIndex, NULL);
+    ak_end_batch_update(pApplication);
+    uint64_t layoutApplyEndTime = ak_get_time_in_microseconds();
+
+    pApplication->startupStats.layoutApplyTimeInMicroseconds += layoutApplyEndTime - layoutApplyStartTime;
+    ak_trace_record(pApplication, "ak_apply_layout", AK_TRACE_CATEGORY_STARTUP, ak_layout_cache_get_string(pConfig, ak_layout_cache_get_node(pConfig, initialLayoutIndex)->name), layoutApplyStartTime, layoutApplyEndTime);
+
+    return result;
+}
+
+static void ak_apply_panel_type(ak_application* pApplication, drgui_element* pPanel, const char* panelType)
+{
+    assert(pApplication != NULL);
+    assert(panelType    != NULL);
+
+    // We only set the panel type for panels that are not the top-level panel.
+    if (pPanel != ak_get_window_panel(ak_get_panel_window(pPanel))) {
+        const char* currentType = ak_panel_get_type(pPanel);
+        if (currentType == NULL || strcmp(currentType, panelType) != 0) {
+            ak_panel_set_type(pPanel, panelType);
+        }
+    } else {
+        if (panelType[0] != '\0') {
+            ak_warning(pApplication, "Attempting to set panel type of a top-level panel which is illegal.");
+        }
+    }
+}
+
+/// Finds the last Tool item with a type among the children of the given panel node.
+///
+/// @remarks
+///     This is the tool that ends up active when the layout is applied. This returns (uint32_t)-1 if there isn't one.
+static uint32_t ak_find_active_tool_node(ak_layout_cache* pConfig, uint32_t nodeIndex)
+{
+    assert(pConfig != NULL);
+
+    const ak_layout_cache_node* pNode = ak_layout_cache_get_node(pConfig, nodeIndex);
+
+    uint32_t iActiveTool = (uint32_t)-1;
+    uint32_t iChild = nodeIndex + 1;
+    for (uint32_t i = 0; i < pNode->childCount; ++i)
+    {
+        const ak_layout_cache_node* pChild = ak_layout_cache_get_node(pConfig, iChild);
+        if (pChild->type == ak_layout_cache_node_type_tool && ak_layout_cache_get_string(pConfig, pChild->name)[0] != '\0') {
+            iActiveTool = iChild;
+        }
+
+        iChild += pChild->subtreeSize;
+    }
+
+    return iActiveTool;
+}
+
+/// Attaches a tool that has been created or reused for a layout to the given panel. A tool that fails to be attached
+/// is deleted.
+static void ak_attach_layout_tool(ak_application* pApplication, drgui_element* pPanel, drgui_element* pTool, bool activate)
+{
+    assert(pApplication != NULL);
+    assert(pTool        != NULL);
+
+    // Activating the tool shows it. If it's a placeholder it's replaced with the real tool and deleted in the process,
+    // so <pTool> must not be used after it's been attached.
+    if (activate) {
+        if (ak_panel_attach_tool(pPanel, pTool)) {
+            return;
+        }
+    } else {
+        if (ak_panel_attach_inactive_tool(pPanel, pTool)) {
+            return;
+        }
+    }
+
+    ak_application_delete_tool(pApplication, pTool, true);
+}
+
+/// Creates a tool for a layout and attaches it to the given panel.
+///
+/// @remarks
+///     Tools that are not activated are created as placeholders if the host application can give us their title.
+static void ak_create_and_attach_layout_tool(ak_application* pApplication, drgui_element* pPanel, const char* type, const char* attributes, bool activate)
+{
+    assert(pApplication != NULL);
+    assert(type         != NULL);
+
+    drgui_element* pTool = NULL;
+    if (!activate && pApplication->onGetToolTitle != NULL)
+    {
+        char title[256];
+        title[0] = '\0';
+        if (pApplication->onGetToolTitle(pApplication, type, attributes, title, sizeof(title))) {
+            pTool = ak_create_placeholder_tool(pApplication, type, attributes, title);
+        }
+    }
+
+    if (pTool == NULL) {
+        pTool = ak_create_tool_by_type_and_attributes(pApplication, ak_get_panel_window(pPanel), type, attributes);
+        if (pTool == NULL) {
+            return;
+        }
+    }
+
+    ak_attach_layout_tool(pApplication, pPanel, pTool, activate);
+}
+
+/// Activates the first tool of the given panel if none of it's tools are active.
+///
+/// @remarks
+///     This is needed when the tool that was meant to be activated by a layout failed to be created.
+static void ak_ensure_active_layout_tool(drgui_element* pPanel)
+{
+    assert(pPanel != NULL);
+
+    if (ak_panel_get_active_tool(pPanel) == NULL && ak_panel_get_first_tool(pPanel) != NULL) {
+        ak_panel_activate_tool(pPanel, ak_panel_get_first_tool(pPanel));
+    }
+}
+
+static bool ak_apply_layout(ak_application* pApplication, ak_layout_cache* pConfig, uint32_t nodeIndex, drgui_element* pWorkingPanel)
+{
+    assert(pApplication != NULL);
+    assert(pConfig      != NULL);
+
+    // The attributes of every node have already been parsed when the config was compiled. The first child of a node
+    // is always the one straight after it, and the next sibling is one sub-tree along.
+    const ak_layout_cache_node* pNode = ak_layout_cache_get_node(pConfig, nodeIndex);
+
+    if (pNode->type == ak_layout_cache_node_type_layout)
+    {
+        // It's a root level layout object - we just iterate over every child and call this function recursively.
+        assert(pWorkingPanel == NULL);
+
+        uint32_t iChild = nodeIndex + 1;
+        for (uint32_t i = 0; i < pNode->childCount; ++i)
+        {
+            if (!ak_apply_layout(pApplication, pConfig, iChild, pWorkingPanel))
+            {
+                return false;
+            }
+
+            iChild += ak_layout_cache_get_node(pConfig, iChild)->subtreeSize;
+        }
+    }
+    else if (pNode->type == ak_layout_cache_node_type_window)
+    {
+        // It's an application window.
+        ak_window* pParentWindow = ak_get_panel_window(pWorkingPanel);
+
+        ak_window* pWindow = ak_create_window(pApplication, ak_window_type_application, pParentWindow, 0, NULL);
+        if (pWindow == NULL) {
+            return false;
+        }
+
+        ak_set_window_name(pWindow, ak_layout_cache_get_string(pConfig, pNode->name));
+        ak_set_window_title(pWindow, ak_layout_cache_get_string(pConfig, pNode->text));
+        ak_set_window_position(pWindow, pNode->posX, pNode->posY);
+        ak_set_window_size(pWindow, pNode->width, pNode->height);
+
+        if (pNode->isMaximized) {
+            ak_show_window_maximized(pWindow);
+        } else {
+            ak_show_window(pWindow);
+        }
+
+
+        // There should only be one child item, and it should be a panel. If not, it's an error.
+        if (pNode->childCount == 0) {
+            return false;
+        }
+
+        return ak_apply_layout(pApplication, pConfig, nodeIndex + 1, ak_get_window_panel(pWindow));
+    }
+    else if (pNode->type == ak_layout_cache_node_type_panel)
+    {
+        // It's a panel. If it's a split panel we just split it and load the next two panels which correspond to the two split partitions. If
+        // it's not split, we just leave it be and iterate over what should be a list of tools.
+        ak_apply_panel_type(pApplication, pWorkingPanel, ak_layout_cache_get_string(pConfig, pNode->name));
+
+
+        if (pNode->splitAxis == ak_panel_split_axis_none)
+        {
+            // It's not a split panel which means the next items should be just a list of tools. Only the last tool is
+            // activated, so it's the only one that needs to be created straight away.
+            uint32_t iActiveTool = ak_find_active_tool_node(pConfig, nodeIndex);
+
+            uint32_t iChild = nodeIndex + 1;
+            for (uint32_t i = 0; i < pNode->childCount; ++i)
+            {
+                const ak_layout_cache_node* pChild = ak_layout_cache_get_node(pConfig, iChild);
+                if (pChild->type == ak_layout_cache_node_type_tool)
+                {
+                    const char* toolType = ak_layout_cache_get_string(pConfig, pChild->name);
+                    if (toolType[0] != '\0') {
+                        ak_create_and_attach_layout_tool(pApplication, pWorkingPanel, toolType, ak_layout_cache_get_string(pConfig, pChild->text), iChild == iActiveTool);
+                    }
+                }
+                else
+                {
+                    if (!ak_apply_layout(pApplication, pConfig, iChild, pWorkingPanel))
+                    {
+                        return false;
+                    }
+                }
+
+                iChild += pChild->subtreeSize;
+            }
+
+            ak_ensure_active_layout_tool(pWorkingPanel);
+        }
+        else
+        {
+            // It's a split panel which means there should be two children. If not, it's an error.
+            if (pNode->childCount < 2) {
+                return false;
+            }
+
+            uint32_t iChild1 = nodeIndex + 1;
+            uint32_t iChild2 = iChild1 + ak_layout_cache_get_node(pConfig, iChild1)->subtreeSize;
+
+
+            if (!ak_panel_split(pWorkingPanel, (ak_panel_split_axis)pNode->splitAxis, pNode->splitPos)) {
+                return false;
+            }
+
+
+            return ak_apply_layout(pApplication, pConfig, iChild1, ak_panel_get_split_panel_1(pWorkingPanel)) && ak_apply_layout(pApplication, pConfig, iChild2, ak_panel_get_split_panel_2(pWorkingPanel));
+        }
+    }
+    else if (pNode->type == ak_layout_cache_node_type_tool)
+    {
+        // It's a tool. Tools are instantiated based on it's type and attributes.
+        //
+        // When instantiating tools, we don't actually fail - we just silently ignore it. Thus, we never return false at this point.
+        const char* toolType = ak_layout_cache_get_string(pConfig, pNode->name);
+        if (toolType[0] != '\0') {
+            ak_create_and_attach_layout_tool(pApplication, pWorkingPanel, toolType, ak_layout_cache_get_string(pConfig, pNode->text), true);
+        }
+    }
+    else
+    {
+        // The attributes of the item failed to parse when the config was compiled.
+        return false;
+    }
+
+    return true;
+}
+
+static void ak_delete_tools_recursive(ak_application* pApplication, drgui_element* pPanel)
+{
+    if (pApplication == NULL || pPanel == NULL) {
+        return;
+    }
+
+    // If it's split, we call this recursively.
+    if (ak_panel_get_split_axis(pPanel) != ak_panel_split_axis_none)
+    {
+        ak_delete_tools_recursive(pApplication, ak_panel_get_split_panel_1(pPanel));
+        ak_delete_tools_recursive(pApplication, ak_panel_get_split_panel_2(pPanel));
+    }
+    else
+    {
+        // The active tool is deactivated first so that deleting it does not activate another tool, which would create it
+        // for nothing if it's a placeholder.
+        if (ak_panel_get_first_tool(pPanel) != NULL) {
+            ak_panel_activate_tool(pPanel, NULL);
+        }
+
+        drgui_element* pFirstTool = NULL;
+        while ((pFirstTool = ak_panel_get_first_tool(pPanel)) != NULL)
+        {
+            ak_application_delete_tool(pApplication, pFirstTool, true);    // "true" means to force deletion of the tool.
+
+            // As a safety precaution to avoid an infinite loop, if the first tool was not detached we'll forcefully detach it.
+            if (pFirstTool == ak_panel_get_first_tool(pPanel)) {
+                ak_panel_detach_tool(pPanel, pFirstTool);
+            }
+        }
+    }
+}
+
+
+/// A window or tool that existed when a layout switch was started and which may be reused by the new layout.
+typedef struct
+{
+    /// The window or tool.
+    void* pObject;
+
+    /// The panel the tool was attached to when the switch started. This is null for windows.
+    drgui_element* pOriginalPanel;
+
+    /// Whether or not the new layout is using it.
+    bool isClaimed;
+
+} ak_layout_switch_item;
+
+typedef struct
+{
+    /// The application whose layout is being switched.
+    ak_application* pApplication;
+
+    /// The compiled config containing the layout being switched to.
+    ak_layout_cache* pConfig;
+
+    /// The top level application windows that existed when the switch started.
+    ak_layout_switch_item* pWindows;
+    size_t windowCount;
+    size_t windowCapacity;
+
+    /// The tools that existed when the switch started.
+    ak_layout_switch_item* pTools;
+    size_t toolCount;
+    size_t toolCapacity;
+
+} ak_layout_switch;
+
+static bool ak_layout_switch_add_item(ak_layout_switch_item** ppItems, size_t* pCount, size_t* pCapacity, void* pObject, drgui_element* pOriginalPanel)
+{
+    assert(ppItems   != NULL);
+    assert(pCount    != NULL);
+    assert(pCapacity != NULL);
+
+    if (*pCount == *pCapacity)
+    {
+        size_t newCapacity = (*pCapacity == 0) ? 16 : *pCapacity * 2;
+        ak_layout_switch_item* pNewItems = realloc(*ppItems, newCapacity * sizeof(*pNewItems));
+        if (pNewItems == NULL) {
+            return false;
+        }
+
+        *ppItems   = pNewItems;
+        *pCapacity = newCapacity;
+    }
+
+    (*ppItems)[*pCount].pObject        = pObject;
+    (*ppItems)[*pCount].pOriginalPanel = pOriginalPanel;
+    (*ppItems)[*pCount].isClaimed      = false;
+    *pCount += 1;
+
+    return true;
+}
+
+static bool ak_layout_switch_gather_tools(ak_layout_switch* pSwitch, drgui_element* pPanel)
+{
+    assert(pSwitch != NULL);
+    assert(pPanel  != NULL);
+
+    if (ak_panel_is_split(pPanel)) {
+        return ak_layout_switch_gather_tools(pSwitch, ak_panel_get_split_panel_1(pPanel)) && ak_layout_switch_gather_tools(pSwitch, ak_panel_get_split_panel_2(pPanel));
+    }
+
+    for (drgui_element* pTool = ak_panel_get_first_tool(pPanel); pTool != NULL; pTool = ak_panel_get_next_tool(pPanel, pTool))
+    {
+        if (!ak_layout_switch_add_item(&pSwitch->pTools, &pSwitch->toolCount, &pSwitch->toolCapacity, pTool, pPanel)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void ak_layout_switch_claim_tool(ak_layout_switch* pSwitch, drgui_element* pTool)
+{
+    assert(pSwitch != NULL);
+
+    for (size_t i = 0; i < pSwitch->toolCount; ++i)
+    {
+        if (pSwitch->pTools[i].pObject == pTool) {
+            pSwitch->pTools[i].isClaimed = true;
+            return;
+        }
+    }
+}
+
+/// Finds an existing tool that was created from the given type and attributes and claims it. Tools that were originally
+/// in <pPanel> are preferred so that they stay where they are when possible.
+static drgui_element* ak_layout_switch_claim_matching_tool(ak_layout_switch* pSwitch, drgui_element* pPanel, const char* type, const char* attributes)
+{
+    assert(pSwitch != NULL);
+
+    ak_layout_switch_item* pMatch = NULL;
+    for (size_t i = 0; i < pSwitch->toolCount; ++i)
+    {
+        ak_layout_switch_item* pItem = &pSwitch->pTools[i];
+        if (!pItem->isClaimed && ak_is_tool_from_layout(pItem->pObject, type, attributes))
+        {
+            if (pMatch == NULL || pItem->pOriginalPanel == pPanel) {
+                pMatch = pItem;
+            }
+
+            if (pMatch->pOriginalPanel == pPanel) {
+                break;
+            }
+        }
+    }
+
+    if (pMatch == NULL) {
+        return NULL;
+    }
+
+    pMatch->isClaimed = true;
+    return pMatch->pObject;
+}
+
+/// Detaches every tool within the given panel without deleting them. They are either claimed by another panel or
+/// deleted when the switch is finished.
+static void ak_layout_switch_detach_tools_recursive(drgui_element* pPanel)
+{
+    assert(pPanel != NULL);
+
+    if (ak_panel_is_split(pPanel))
+    {
+        ak_layout_switch_detach_tools_recursive(ak_panel_get_split_panel_1(pPanel));
+        ak_layout_switch_detach_tools_recursive(ak_panel_get_split_panel_2(pPanel));
+    }
+    else
+    {
+        ak_panel_detach_all_tools(pPanel);
+    }
+}
+
+/// Determines whether or not the tools in the given panel are exactly what the given panel node asks for.
+static bool ak_layout_switch_are_tools_unchanged(ak_layout_switch* pSwitch, uint32_t nodeIndex, drgui_element* pPanel)
+{
+    assert(pSwitch != NULL);
+    assert(pPanel  != NULL);
+
+    // Tools are prepended when they're attached, so the panel's tools are in the reverse order of the layout.
+    drgui_element* pExistingTool = NULL;
+    for (drgui_element* pTool = ak_panel_get_first_tool(pPanel); pTool != NULL; pTool = ak_panel_get_next_tool(pPanel, pTool)) {
+        pExistingTool = pTool;
+    }
+
+    const ak_layout_cache_node* pNode = ak_layout_cache_get_node(pSwitch->pConfig, nodeIndex);
+
+    uint32_t iChild = nodeIndex + 1;
+    for (uint32_t i = 0; i < pNode->childCount; ++i)
+    {
+        const ak_layout_cache_node* pChild = ak_layout_cache_get_node(pSwitch->pConfig, iChild);
+        iChild += pChild->subtreeSize;
+
+        if (pChild->type != ak_layout_cache_node_type_tool) {
+            return false;
+        }
+
+        const char* toolType = ak_layout_cache_get_string(pSwitch->pConfig, pChild->name);
+        if (toolType[0] == '\0') {
+            continue;
+        }
+
+        if (pExistingTool == NULL || !ak_is_tool_from_layout(pExistingTool, toolType, ak_layout_cache_get_string(pSwitch->pConfig, pChild->text))) {
+            return false;
+        }
+
+        pExistingTool = pExistingTool->pPrevSibling;
+    }
+
+    return pExistingTool == NULL;
+}
+
+static bool ak_layout_switch_panel(ak_layout_switch* pSwitch, uint32_t nodeIndex, drgui_element* pPanel)
+{
+    assert(pSwitch != NULL);
+    assert(pPanel  != NULL);
+
+    const ak_layout_cache_node* pNode = ak_layout_cache_get_node(pSwitch->pConfig, nodeIndex);
+    if (pNode->type != ak_layout_cache_node_type_panel) {
+        return false;
+    }
+
+    ak_apply_panel_type(pSwitch->pApplication, pPanel, ak_layout_cache_get_string(pSwitch->pConfig, pNode->name));
+
+
+    if (pNode->splitAxis != ak_panel_split_axis_none)
+    {
+        if (pNode->childCount < 2) {
+            return false;
+        }
+
+        // The panel only needs to be re-split if the split has changed. If it wasn't split before, it's tools need to
+        // be moved out of the way first.
+        if (!ak_panel_is_split(pPanel)) {
+            ak_layout_switch_detach_tools_recursive(pPanel);
+        }
+
+        if (ak_panel_get_split_axis(pPanel) != (ak_panel_split_axis)pNode->splitAxis || ak_panel_get_split_pos(pPanel) != pNode->splitPos) {
+            if (!ak_panel_split(pPanel, (ak_panel_split_axis)pNode->splitAxis, pNode->splitPos)) {
+                return false;
+            }
+        }
+
+        uint32_t iChild1 = nodeIndex + 1;
+        uint32_t iChild2 = iChild1 + ak_layout_cache_get_node(pSwitch->pConfig, iChild1)->subtreeSize;
+
+        return ak_layout_switch_panel(pSwitch, iChild1, ak_panel_get_split_panel_1(pPanel)) && ak_layout_switch_panel(pSwitch, iChild2, ak_panel_get_split_panel_2(pPanel));
+    }
+
+
+    // It's a list of tools. If the panel is currently split, the child panels are removed, but their tools are kept
+    // around in case they can be used somewhere else.
+    if (ak_panel_is_split(pPanel)) {
+        ak_layout_switch_detach_tools_recursive(pPanel);
+        ak_panel_unsplit(pPanel);
+    }
+
+    if (ak_layout_switch_are_tools_unchanged(pSwitch, nodeIndex, pPanel))
+    {
+        for (drgui_element* pTool = ak_panel_get_first_tool(pPanel); pTool != NULL; pTool = ak_panel_get_next_tool(pPanel, pTool)) {
+            ak_layout_switch_claim_tool(pSwitch, pTool);
+        }
+
+        return true;
+    }
+
+
+    // The tools are re-attached in the order they appear in the layout so that the panel ends up the same as it would
+    // if the layout were applied from scratch. As with ak_apply_layout(), tools that fail to be created are ignored and
+    // only the last tool is activated.
+    ak_layout_switch_detach_tools_recursive(pPanel);
+
+    uint32_t iActiveTool = ak_find_active_tool_node(pSwitch->pConfig, nodeIndex);
+
+    uint32_t iChild = nodeIndex + 1;
+    for (uint32_t i = 0; i < pNode->childCount; ++i)
+    {
+        uint32_t iTool = iChild;
+        const ak_layout_cache_node* pChild = ak_layout_cache_get_node(pSwitch->pConfig, iChild);
+        iChild += pChild->subtreeSize;
+
+        if (pChild->type != ak_layout_cache_node_type_tool) {
+            return false;
+        }
+
+        const char* toolType       = ak_layout_cache_get_string(pSwitch->pConfig, pChild->name);
+        const char* toolAttributes = ak_layout_cache_get_string(pSwitch->pConfig, pChild->text);
+        if (toolType[0] == '\0') {
+            continue;
+        }
+
+        drgui_element* pTool = ak_layout_switch_claim_matching_tool(pSwitch, pPanel, toolType, toolAttributes);
+        if (pTool != NULL) {
+            ak_attach_layout_tool(pSwitch->pApplication, pPanel, pTool, iTool == iActiveTool);
+        } else {
+            ak_create_and_attach_layout_tool(pSwitch->pApplication, pPanel, toolType, toolAttributes, iTool == iActiveTool);
+        }
+    }
+
+    ak_ensure_active_layout_tool(pPanel);
+
+    return true;
+}
+
+static bool ak_layout_switch_window(ak_layout_switch* pSwitch, uint32_t nodeIndex)
+{
+    assert(pSwitch != NULL);
+
+    const ak_layout_cache_node* pNode = ak_layout_cache_get_node(pSwitch->pConfig, nodeIndex);
+    if (pNode->type != ak_layout_cache_node_type_window) {
+        return false;
+    }
+
+    // Windows are matched by name. Unnamed windows are matched with the first unclaimed window that is also unnamed.
+    const char* name = ak_layout_cache_get_string(pSwitch->pConfig, pNode->name);
+
+    ak_window* pWindow = NULL;
+    for (size_t i = 0; i < pSwitch->windowCount; ++i)
+    {
+        if (!pSwitch->pWindows[i].isClaimed && strcmp(ak_get_window_name(pSwitch->pWindows[i].pObject), name) == 0) {
+            pWindow = pSwitch->pWindows[i].pObject;
+            pSwitch->pWindows[i].isClaimed = true;
+            break;
+        }
+    }
+
+    if (pWindow == NULL)
+    {
+        pWindow = ak_create_window(pSwitch->pApplication, ak_window_type_application, NULL, 0, NULL);
+        if (pWindow == NULL) {
+            return false;
+        }
+
+        ak_set_window_name(pWindow, name);
+        ak_set_window_position(pWindow, pNode->posX, pNode->posY);
+        ak_set_window_size(pWindow, pNode->width, pNode->height);
+    }
+    else if (!pNode->isMaximized)
+    {
+        // The geometry of a reused window is only touched if it's changed.
+        int posX;
+        int posY;
+        ak_get_window_position(pWindow, &posX, &posY);
+        if (posX != pNode->posX || posY != pNode->posY) {
+            ak_set_window_position(pWindow, pNode->posX, pNode->posY);
+        }
+
+        int width;
+        int height;
+        ak_get_window_size(pWindow, &width, &height);
+        if (width != (int)pNode->width || height != (int)pNode->height) {
+            ak_set_window_size(pWindow, pNode->width, pNode->height);
+        }
+    }
+
+    ak_set_window_title(pWindow, ak_layout_cache_get_string(pSwitch->pConfig, pNode->text));
+
+    if (pNode->isMaximized) {
+        ak_show_window_maximized(pWindow);
+    } else {
+        ak_show_window(pWindow);
+    }
+
+
+    // There should only be one child item, and it should be a panel. If not, it's an error.
+    if (pNode->childCount == 0) {
+        return false;
+    }
+
+    return ak_layout_switch_panel(pSwitch, nodeIndex + 1, ak_get_window_panel(pWindow));
+}
+
+bool ak_switch_layout(ak_application* pApplication, const char* layoutName)
+{
+    if (pApplication == NULL || layoutName == NULL) {
+        return false;
+    }
+
+    if (pApplication->pCompiledConfig == NULL) {
+        return false;
+    }
+
+    // The layout may not have been parsed yet if the compiled config came from the config itself rather than a cache.
+    uint32_t layoutIndex = ak_layout_cache_find_layout(pApplication->pCompiledConfig, layoutName);
+    if (layoutIndex == (uint32_t)-1 && pApplication->pConfig != NULL && ak_load_config_layout(pApplication, layoutName)) {
+        layoutIndex = ak_layout_cache_find_layout(pApplication->pCompiledConfig, layoutName);
+    }
+
+    ak_layout_cache* pConfig = pApplication->pCompiledConfig;
+    if (layoutIndex == (uint32_t)-1) {
+        ak_warningf(pApplication, "Layout \"%s\" does not exist.", layoutName);
+        return false;
+    }
+
+    uint64_t switchStartTime = ak_get_time_in_microseconds();
+
+
+    // Everything that currently exists is recorded first so that it can be matched up with the items of the new layout.
+    ak_layout_switch layoutSwitch;
+    memset(&layoutSwitch, 0, sizeof(layoutSwitch));
+    layoutSwitch.pApplication = pApplication;
+    layoutSwitch.pConfig      = pConfig;
+
+    bool result = true;
+    for (ak_window* pWindow = pApplication->pFirstWindow; pWindow != NULL && result; pWindow = ak_get_next_sibling_window(pWindow))
+    {
+        if (ak_get_window_type(pWindow) == ak_window_type_application) {
+            result =
+                ak_layout_switch_add_item(&layoutSwitch.pWindows, &layoutSwitch.windowCount, &layoutSwitch.windowCapacity, pWindow, NULL) &&
+                ak_layout_switch_gather_tools(&layoutSwitch, ak_get_window_panel(pWindow));
+        }
+    }
+
+    if (!result) {
+        free(layoutSwitch.pWindows);
+        free(layoutSwitch.pTools);
+        return false;
+    }
+
+
+    ak_begin_batch_update(pApplication);
+
+    const ak_layout_cache_node* pLayoutNode = ak_layout_cache_get_node(pConfig, layoutIndex);
+
+    uint32_t iChild = layoutIndex + 1;
+    for (uint32_t i = 0; i < pLayoutNode->childCount && result; ++i)
+    {
+        result = ak_layout_switch_window(&layoutSwitch, iChild);
+        iChild += ak_layout_cache_get_node(pConfig, iChild)->subtreeSize;
+    }
+
+
+    // Anything that wasn't reused is deleted. Tools need to be deleted before the windows they're in.
+    for (size_t i = 0; i < layoutSwitch.toolCount; ++i)
+    {
+        if (!layoutSwitch.pTools[i].isClaimed)
+        {
+            drgui_element* pTool = layoutSwitch.pTools[i].pObject;
+            drgui_element* pToolPanel = ak_get_tool_panel(pTool);
+
+            ak_application_delete_tool(pApplication, pTool, true);    // "true" means to force deletion of the tool.
+
+            // As with ak_delete_tools_recursive(), make sure the tool is detached even if it wasn't deleted. The tool
+            // can't be dereferenced here since it may have been deleted.
+            if (pToolPanel != NULL)
+            {
+                for (drgui_element* pRemainingTool = ak_panel_get_first_tool(pToolPanel); pRemainingTool != NULL; pRemainingTool = ak_panel_get_next_tool(pToolPanel, pRemainingTool))
+                {
+                    if (pRemainingTool == pTool) {
+                        ak_panel_detach_tool(pToolPanel, pTool);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < layoutSwitch.windowCount; ++i)
+    {
+        if (!layoutSwitch.pWindows[i].isClaimed) {
+            ak_delete_window(layoutSwitch.pWindows[i].pObject);
+        }
+    }
+
+    free(layoutSwitch.pWindows);
+    free(layoutSwitch.pTools);
+
+    ak_end_batch_update(pApplication);
+
+
+    ak_trace_record(pApplication, "ak_switch_layout", AK_TRACE_CATEGORY_LAYOUT, layoutName, switchStartTime, ak_get_time_in_microseconds());
+    return result;
+}
+
+static void ak_drain_main_thread_queue(ak_application* pApplication)
+{
+    assert(pApplication != NULL);
+
+    // A work item can end up draining the queue itself, such as by running a nested event loop. Doing so would swap the
+    // buffers again while the batch below is still being run from one of them, so nested drains are deferred until the
+    // current batch has finished.
+    if (pApplication->isDrainingMainThreadQueue) {
+        return;
+    }
+
+    // The queue is swapped with the batch buffer so that the items can be run without holding the lock. Anything
+    // that's posted while the batch is running will go into the next batch.
+    ak_work_item* pBatch;
+    size_t batchCount;
+    ak_lock_mutex(&pApplication->mainThreadQueueLock);
+    {
+        pBatch     = pApplication->pMainThreadQueue;
+        batchCount = pApplication->mainThreadQueueCount;
+
+        size_t batchCapacity = pApplication->mainThreadQueueCapacity;
+        pApplication->pMainThreadQueue        = pApplication->pMainThreadBatch;
+        pApplication->mainThreadQueueCapacity = pApplication->mainThreadBatchCapacity;
+        pApplication->mainThreadQueueCount    = 0;
+        pApplication->pMainThreadBatch        = pBatch;
+        pApplication->mainThreadBatchCapacity = batchCapacity;
+    }
+    ak_unlock_mutex(&pApplication->mainThreadQueueLock);
+
+    pApplication->isDrainingMainThreadQueue = true;
+    {
+        for (size_t i = 0; i < batchCount; ++i) {
+            pBatch[i].proc(pApplication, pBatch[i].pUserData);
+        }
+    }
+    pApplication->isDrainingMainThreadQueue = false;
+
+
+    // The wake up for anything that was posted while the batch was running may have been consumed by a deferred drain,
+    // in which case the main loop needs to be woken up again.
+    bool isQueueEmpty;
+    ak_lock_mutex(&pApplication->mainThreadQueueLock);
+    {
+        isQueueEmpty = pApplication->mainThreadQueueCount == 0;
+    }
+    ak_unlock_mutex(&pApplication->mainThreadQueueLock);
+
+    if (!isQueueEmpty) {
+        ak_wake_main_thread(pApplication);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Private APIs Declared in ak_application_private.h
+//
+///////////////////////////////////////////////////////////////////////////////
+
+ak_window* ak_get_application_first_window(ak_application* pApplication)
+{
+    assert(pApplication != NULL);
+    return pApplication->pFirstWindow;
+}
+
+ak_window* ak_get_application_next_non_child_window(ak_application* pApplication, ak_window* pWindow)
+{
+    if (pApplication == NULL || pWindow == NULL) {
+        return NULL;
+    }
+
+    ak_window* pNextSibling = ak_get_next_sibling_window(pWindow);
+    if (pNextSibling != NULL) {
+        return pNextSibling;
+    }
+
+    return ak_get_application_next_non_child_window(pApplication, ak_get_parent_window(pWindow));
+}
+
+ak_window* ak_get_application_next_window(ak_application* pApplication, ak_window* pWindow)
+{
+    assert(pApplication != NULL);
+    assert(pWindow != NULL);
+
+    ak_window* pFirstChild = ak_get_first_child_window(pWindow);
+    if (pFirstChild != NULL) {
+        return pFirstChild;
+    }
+
+    return ak_get_application_next_non_child_window(pApplication, pWindow);
+}
+
+
+void ak_application_on_close_window(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    ak_window_count_event(pWindow, ak_event_type_close);
+    ak_window_on_close(pWindow);
+}
+
+bool ak_application_on_hide_window(ak_window* pWindow, unsigned int flags)
+{
+    assert(pWindow != NULL);
+
+    ak_window_count_event(pWindow, ak_event_type_hide);
+    if (!ak_window_on_hide(pWindow, flags)) {
+        return false;
+    }
+
+    ak_application_untrack_visible_popup(pWindow);
+    return true;
+}
+
+bool ak_application_on_show_window(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    ak_window_count_event(pWindow, ak_event_type_show);
+    if (!ak_window_on_show(pWindow)) {
+        return false;
+    }
+
+    if (ak_get_window_type(pWindow) == ak_window_type_popup) {
+        ak_application_track_visible_popup(pWindow);
+    }
+
+    return true;
+}
+
+void ak_application_on_activate_window(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    ak_window_count_event(pWindow, ak_event_type_activate);
+    ak_window_on_activate(pWindow);
+}
+
+void ak_application_on_deactivate_window(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    ak_window_count_event(pWindow, ak_event_type_deactivate);
+    ak_window_on_deactivate(pWindow);
+    //ak_application_hide_non_ancestor_popups(pWindow);
+}
+
+void ak_application_on_focus_window(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    ak_window_count_event(pWindow, ak_event_type_focus);
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    assert(pApplication != NULL);
+
+    pApplication->pPrevFocusedWindow = NULL;
+}
+
+void ak_application_on_unfocus_window(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    ak_window_count_event(pWindow, ak_event_type_unfocus);
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    assert(pApplication != NULL);
+
+    pApplication->pPrevFocusedWindow = pWindow;
+
+    // Popup window's that lose focus need to be hidden.
+    if (ak_get_window_type(pWindow) == ak_window_type_popup) {
+        ak_hide_window(pWindow, AK_AUTO_HIDE_FROM_LOST_FOCUS);
+    }
+}
+
+void ak_application_on_mouse_enter(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    uint64_t traceBeginTime = ak_trace_begin(pApplication);
+
+    ak_window_count_event(pWindow, ak_event_type_mouse_enter);
+    ak_window_on_mouse_enter(pWindow);
+
+    ak_trace_end(pApplication, traceBeginTime, "mouse_enter", AK_TRACE_CATEGORY_INPUT, NULL);
+}
+
+void ak_application_on_mouse_leave(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    uint64_t traceBeginTime = ak_trace_begin(pApplication);
+
+    ak_window_count_event(pWindow, ak_event_type_mouse_leave);
+    ak_window_on_mouse_leave(pWindow);
+
+    // Let the GUI know about the event.
+    drgui_post_inbound_event_mouse_leave(ak_get_window_panel(pWindow));
+
+    ak_trace_end(pApplication, traceBeginTime, "mouse_leave", AK_TRACE_CATEGORY_INPUT, NULL);
+}
+
+void ak_application_on_mouse_move(ak_window* pWindow, int relativeMousePosX, int relativeMousePosY, int stateFlags)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    uint64_t traceBeginTime = ak_trace_begin(pApplication);
+
+    ak_window_count_event(pWindow, ak_event_type_mouse_move);
+
+    // Let the GUI know about the event.
+    drgui_post_inbound_event_mouse_move(ak_get_window_panel(pWindow), relativeMousePosX, relativeMousePosY, stateFlags);
+
+    ak_trace_end(pApplication, traceBeginTime, "mouse_move", AK_TRACE_CATEGORY_INPUT, NULL);
+}
+
+void ak_application_on_mouse_button_down(ak_window* pWindow, int mouseButton, int relativeMousePosX, int relativeMousePosY, int stateFlags)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    uint64_t traceBeginTime = ak_trace_begin(pApplication);
+
+    ak_window_count_event(pWindow, ak_event_type_mouse_button_down);
+    ak_window_on_mouse_button_down(pWindow, mouseButton, relativeMousePosX, relativeMousePosY);
+
+    // Any popup window that is not an ancestor of the input window needs to be hidden.
+    ak_application_hide_non_ancestor_popups(pWindow);
+
+    // Let the GUI know about the event.
+    drgui_post_inbound_event_mouse_button_down(ak_get_window_panel(pWindow), mouseButton, relativeMousePosX, relativeMousePosY, stateFlags);
+
+    ak_trace_end(pApplication, traceBeginTime, "mouse_button_down", AK_TRACE_CATEGORY_INPUT, NULL);
+}
+
+void ak_application_on_mouse_button_up(ak_window* pWindow, int mouseButton, int relativeMousePosX, int relativeMousePosY, int stateFlags)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    uint64_t traceBeginTime = ak_trace_begin(pApplication);
+
+    ak_window_count_event(pWindow, ak_event_type_mouse_button_up);
+    ak_window_on_mouse_button_up(pWindow, mouseButton, relativeMousePosX, relativeMousePosY);
+
+    // Let the GUI know about the event.
+    drgui_post_inbound_event_mouse_button_up(ak_get_window_panel(pWindow), mouseButton, relativeMousePosX, relativeMousePosY, stateFlags);
+
+    ak_trace_end(pApplication, traceBeginTime, "mouse_button_up", AK_TRACE_CATEGORY_INPUT, NULL);
+}
+
+void ak_application_on_mouse_button_dblclick(ak_window* pWindow, int mouseButton, int relativeMousePosX, int relativeMousePosY, int stateFlags)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    uint64_t traceBeginTime = ak_trace_begin(pApplication);
+
+    ak_window_count_event(pWindow, ak_event_type_mouse_button_dblclick);
+    ak_window_on_mouse_button_dblclick(pWindow, mouseButton, relativeMousePosX, relativeMousePosY);
+
+    // Let the GUI know about the event.
+    drgui_post_inbound_event_mouse_button_dblclick(ak_get_window_panel(pWindow), mouseButton, relativeMousePosX, relativeMousePosY, stateFlags);
+
+    ak_trace_end(pApplication, traceBeginTime, "mouse_button_dblclick", AK_TRACE_CATEGORY_INPUT, NULL);
+}
+
+void ak_application_on_mouse_wheel(ak_window* pWindow, int delta, int relativeMousePosX, int relativeMousePosY, int stateFlags)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    uint64_t traceBeginTime = ak_trace_begin(pApplication);
+
+    ak_window_count_event(pWindow, ak_event_type_mouse_wheel);
+    ak_window_on_mouse_wheel(pWindow, delta, relativeMousePosX, relativeMousePosY);
+
+    // Let the GUI know about the event.
+    drgui_post_inbound_event_mouse_wheel(ak_get_window_panel(pWindow), delta, relativeMousePosX, relativeMousePosY, stateFlags);
+
+    ak_trace_end(pApplication, traceBeginTime, "mouse_wheel", AK_TRACE_CATEGORY_INPUT, NULL);
+}
+
+void ak_application_on_key_down(ak_window* pWindow, drgui_key key, int stateFlags)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    uint64_t traceBeginTime = ak_trace_begin(pApplication);
+
+    ak_window_count_event(pWindow, ak_event_type_key_down);
+    ak_window_on_key_down(pWindow, key, stateFlags);
+
+    // Shortcuts are resolved before anything else sees the key. A key that is part of a shortcut, including one that
+    // breaks a chord, is swallowed along with the printable key event that follows it, if any.
+    if (pApplication != NULL)
+    {
+        pApplication->isPrintableKeySuppressed = false;
+
+        ak_action_id actionID = 0;
+        ak_accelerator_result result = ak_accelerator_table_on_key_down(pApplication->pAcceleratorTable, key, stateFlags, &actionID);
+        if (result != ak_accelerator_result_none)
+        {
+            pApplication->isPrintableKeySuppressed = true;
+
+            if (result == ak_accelerator_result_matched) {
+                ak_handle_action_by_id(pApplication, actionID);
+            }
+
+            ak_trace_end(pApplication, traceBeginTime, "key_down", AK_TRACE_CATEGORY_INPUT, NULL);
+            return;
+        }
+    }
+
+    drgui_post_inbound_event_key_down(ak_get_window_panel(pWindow)->pContext, key, stateFlags);
+
+    if (pApplication != NULL && pApplication->onKeyDown) {
+        pApplication->onKeyDown(pApplication, pWindow, key, stateFlags);
+    }
+
+    ak_trace_end(pApplication, traceBeginTime, "key_down", AK_TRACE_CATEGORY_INPUT, NULL);
+}
+
+void ak_application_on_key_up(ak_window* pWindow, drgui_key key, int stateFlags)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    uint64_t traceBeginTime = ak_trace_begin(pApplication);
+
+    ak_window_count_event(pWindow, ak_event_type_key_up);
+    ak_window_on_key_up(pWindow, key, stateFlags);
+
+    if (pApplication != NULL) {
+        pApplication->isPrintableKeySuppressed = false;
+    }
+
+    drgui_post_inbound_event_key_up(ak_get_window_panel(pWindow)->pContext, key, stateFlags);
+
+    if (pApplication != NULL && pApplication->onKeyUp) {
+        pApplication->onKeyUp(pApplication, pWindow, key, stateFlags);
+    }
+
+    ak_trace_end(pApplication, traceBeginTime, "key_up", AK_TRACE_CATEGORY_INPUT, NULL);
+}
+
+void ak_application_on_printable_key_down(ak_window* pWindow, unsigned int character, int stateFlags)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    uint64_t traceBeginTime = ak_trace_begin(pApplication);
+
+    ak_window_count_event(pWindow, ak_event_type_printable_key_down);
+    ak_window_on_printable_key_down(pWindow, character, stateFlags);
+
+    // The key that generated this was swallowed by a shortcut, so the character must not be typed either.
+    if (pApplication == NULL || !pApplication->isPrintableKeySuppressed) {
+        drgui_post_inbound_event_printable_key_down(ak_get_window_panel(pWindow)->pContext, character, stateFlags);
+    }
+
+    ak_trace_end(pApplication, traceBeginTime, "printable_key_down", AK_TRACE_CATEGORY_INPUT, NULL);
+}
+
+
+void ak_application_on_panel_activated(ak_application* pApplication, drgui_element* pPanel)
+{
+    if (pApplication == NULL || pPanel == NULL) {
+        return;
+    }
+
+    if (pApplication->onPanelActivated) {
+        pApplication->onPanelActivated(pApplication, pPanel);
+    }
+}
+
+void ak_application_on_panel_deactivated(ak_application* pApplication, drgui_element* pPanel)
+{
+    if (pApplication == NULL || pPanel == NULL) {
+        return;
+    }
+
+    if (pApplication->onPanelDeactivated) {
+        pApplication->onPanelDeactivated(pApplication, pPanel);
+    }
+}
+
+
+void ak_application_on_tool_activated(ak_application* pApplication, drgui_element* pTool)
+{
+    if (pApplication == NULL || pTool == NULL) {
+        return;
+    }
+
+    if (pApplication->onToolActivated) {
+        pApplication->onToolActivated(pApplication, pTool);
+    }
+}
+
+void ak_application_on_tool_deactivated(ak_application* pApplication, drgui_element* pTool)
+{
+    if (pApplication == NULL || pTool == NULL) {
+        return;
+    }
+
+    // This is what the hibernation policy measures how long the tool has been inactive for.
+    ak_set_tool_deactivation_time(pTool, ak_get_time_in_microseconds());
+
+    if (pApplication->onToolDeactivated) {
+        pApplication->onToolDeactivated(pApplication, pTool);
+    }
+}
+
+
+void ak_application_track_top_level_window(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    assert(pApplication != NULL);
+
+    if (pApplication->pFirstWindow != NULL)
+    {
+        ak_set_prev_sibling_window(pApplication->pFirstWindow, pWindow);
+        ak_set_next_sibling_window(pWindow, pApplication->pFirstWindow);
+    }
+
+    pApplication->pFirstWindow = pWindow;
+
+    ak_application_index_window(pWindow);
+}
+
+void ak_application_untrack_top_level_window(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    assert(pApplication != NULL);
+
+    if (pApplication->pFirstWindow != NULL)
+    {
+        if (pApplication->pFirstWindow == pWindow) {
+            pApplication->pFirstWindow = ak_get_next_sibling_window(pWindow);
+        }
+
+        if (ak_get_next_sibling_window(pWindow) != NULL) {
+            ak_set_prev_sibling_window(ak_get_next_sibling_window(pWindow), ak_get_prev_sibling_window(pWindow));
+        }
+
+        if (ak_get_prev_sibling_window(pWindow) != NULL) {
+            ak_set_next_sibling_window(ak_get_prev_sibling_window(pWindow), ak_get_next_sibling_window(pWindow));
+        }
+
+        ak_set_next_sibling_window(pWindow, NULL);
+        ak_set_prev_sibling_window(pWindow, NULL);
+    }
+
+    ak_application_unindex_window(pWindow);
+}
+
+
+// Inserts an entry into the name table without checking the capacity.
+static void ak_application_insert_window_name_entry(ak_application* pApplication, ak_window_name_entry entry)
+{
+    assert(pApplication != NULL);
+    assert(pApplication->windowsByNameCount < pApplication->windowsByNameCapacity);
+
+    size_t mask = pApplication->windowsByNameCapacity - 1;
+
+    size_t i = entry.hash & mask;
+    while (pApplication->pWindowsByName[i].pWindow != NULL) {
+        i = (i + 1) & mask;
+    }
+
+    pApplication->pWindowsByName[i] = entry;
+    pApplication->windowsByNameCount += 1;
+}
+
+void ak_application_index_window(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    assert(pApplication != NULL);
+
+    pApplication->isPrimaryWindowStale = true;
+
+    const char* pName = ak_get_window_name(pWindow);
+    if (pName[0] == '\0') {
+        return;
+    }
+
+    // The table is kept at most 3/4 full so that probe sequences stay short.
+    if ((pApplication->windowsByNameCount + 1) * 4 > pApplication->windowsByNameCapacity * 3)
+    {
+        size_t newCapacity = (pApplication->windowsByNameCapacity == 0) ? 16 : pApplication->windowsByNameCapacity * 2;
+        ak_window_name_entry* pNewEntries = calloc(newCapacity, sizeof(*pNewEntries));
+        if (pNewEntries == NULL) {
+            return;
+        }
+
+        ak_window_name_entry* pOldEntries = pApplication->pWindowsByName;
+        size_t oldCapacity = pApplication->windowsByNameCapacity;
+
+        pApplication->pWindowsByName        = pNewEntries;
+        pApplication->windowsByNameCapacity = newCapacity;
+        pApplication->windowsByNameCount    = 0;
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (pOldEntries[i].pWindow != NULL) {
+                ak_application_insert_window_name_entry(pApplication, pOldEntries[i]);
+            }
+        }
+
+        free(pOldEntries);
+    }
+
+    ak_window_name_entry entry;
+    entry.hash    = ak_hash_string(pName);
+    entry.pWindow = pWindow;
+    ak_application_insert_window_name_entry(pApplication, entry);
+}
+
+void ak_application_unindex_window(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    assert(pApplication != NULL);
+
+    pApplication->isPrimaryWindowStale = true;
+
+    const char* pName = ak_get_window_name(pWindow);
+    if (pName[0] == '\0' || pApplication->windowsByNameCount == 0) {
+        return;
+    }
+
+    size_t mask = pApplication->windowsByNameCapacity - 1;
+
+    size_t i = ak_hash_string(pName) & mask;
+    while (pApplication->pWindowsByName[i].pWindow != pWindow)
+    {
+        if (pApplication->pWindowsByName[i].pWindow == NULL) {
+            return;     // Not in the table.
+        }
+
+        i = (i + 1) & mask;
     }
 
-    ak_window* pNextSibling = ak_get_next_sibling_window(pWindow);
-    if (pNextSibling != NULL) {
-        return pNextSibling;
+    // Rather than leaving a tombstone, every entry after the removed one in the same cluster is shifted back if the
+    // hole is between it and it's home slot.
+    size_t iHole = i;
+    for (size_t j = (iHole + 1) & mask; pApplication->pWindowsByName[j].pWindow != NULL; j = (j + 1) & mask)
+    {
+        size_t iHome = pApplication->pWindowsByName[j].hash & mask;
+        if (((j - iHome) & mask) >= ((j - iHole) & mask)) {
+            pApplication->pWindowsByName[iHole] = pApplication->pWindowsByName[j];
+            iHole = j;
+        }
     }
 
-    return ak_get_application_next_non_child_window(pApplication, ak_get_parent_window(pWindow));
+    pApplication->pWindowsByName[iHole].pWindow = NULL;
+    pApplication->windowsByNameCount -= 1;
 }
 
-ak_window* ak_get_application_next_window(ak_application* pApplication, ak_window* pWindow)
+
+// Retrieves the index of the given window in the visible popup set, or -1 if it's not in there.
+static int ak_application_find_visible_popup(ak_application* pApplication, ak_window* pWindow)
 {
     assert(pApplication != NULL);
-    assert(pWindow != NULL);
 
-    ak_window* pFirstChild = ak_get_first_child_window(pWindow);
-    if (pFirstChild != NULL) {
-        return pFirstChild;
+    for (size_t i = 0; i < pApplication->visiblePopupCount; ++i)
+    {
+        if (pApplication->ppVisiblePopups[i] == pWindow) {
+            return (int)i;
+        }
     }
 
-    return ak_get_application_next_non_child_window(pApplication, pWindow);
+    return -1;
 }
 
-
-void ak_application_on_close_window(ak_window* pWindow)
+void ak_application_track_visible_popup(ak_window* pWindow)
 {
     assert(pWindow != NULL);
 
-    ak_window_on_close(pWindow);
-}
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    assert(pApplication != NULL);
 
-bool ak_application_on_hide_window(ak_window* pWindow, unsigned int flags)
-{
-    assert(pWindow != NULL);
+    // Windows can be shown while they're already visible, in which case they'll already be in the set.
+    if (ak_application_find_visible_popup(pApplication, pWindow) != -1) {
+        return;
+    }
 
-    return ak_window_on_hide(pWindow, flags);
-}
+    if (pApplication->visiblePopupCount == pApplication->visiblePopupCapacity)
+    {
+        size_t newCapacity = (pApplication->visiblePopupCapacity == 0) ? 4 : pApplication->visiblePopupCapacity * 2;
+        ak_window** ppNewPopups = realloc(pApplication->ppVisiblePopups, newCapacity * sizeof(*ppNewPopups));
+        if (ppNewPopups == NULL) {
+            return;     // Out of memory. The popup just won't be auto-hidden.
+        }
 
-bool ak_application_on_show_window(ak_window* pWindow)
-{
-    assert(pWindow != NULL);
+        pApplication->ppVisiblePopups      = ppNewPopups;
+        pApplication->visiblePopupCapacity = newCapacity;
+    }
 
-    return ak_window_on_show(pWindow);
+    pApplication->ppVisiblePopups[pApplication->visiblePopupCount] = pWindow;
+    pApplication->visiblePopupCount += 1;
 }
 
-void ak_application_on_activate_window(ak_window* pWindow)
+void ak_application_untrack_visible_popup(ak_window* pWindow)
 {
     assert(pWindow != NULL);
 
-    ak_window_on_activate(pWindow);
-}
+    ak_application* pApplication = ak_get_window_application(pWindow);
+    assert(pApplication != NULL);
 
-void ak_application_on_deactivate_window(ak_window* pWindow)
-{
-    assert(pWindow != NULL);
+    int index = ak_application_find_visible_popup(pApplication, pWindow);
+    if (index == -1) {
+        return;
+    }
 
-    ak_window_on_deactivate(pWindow);
-    //ak_application_hide_non_ancestor_popups(pWindow);
+    // The order needs to be preserved so that ak_application_hide_non_ancestor_popups() hides the most recent ones first.
+    for (size_t i = (size_t)index + 1; i < pApplication->visiblePopupCount; ++i) {
+        pApplication->ppVisiblePopups[i - 1] = pApplication->ppVisiblePopups[i];
+    }
+
+    pApplication->visiblePopupCount -= 1;
 }
 
-void ak_application_on_focus_window(ak_window* pWindow)
+void ak_application_hide_non_ancestor_popups(ak_window* pWindow)
 {
     assert(pWindow != NULL);
 
     ak_application* pApplication = ak_get_window_application(pWindow);
     assert(pApplication != NULL);
 
-    pApplication->pPrevFocusedWindow = NULL;
+    // Hiding a popup will remove it from the visible set, and the on_hide event handlers are free to show, hide or
+    // delete other popups, so the set is re-checked after every hide rather than iterated directly. Popups are hidden
+    // in the reverse order they were shown so that nested popups are hidden before their parents.
+    size_t i = pApplication->visiblePopupCount;
+    while (i > 0)
+    {
+        i -= 1;
+
+        ak_window* pOtherWindow = pApplication->ppVisiblePopups[i];
+        if (pOtherWindow != pWindow && !ak_is_window_ancestor(pOtherWindow, pWindow))
+        {
+            ak_hide_window(pOtherWindow, AK_AUTO_HIDE_FROM_LOST_FOCUS);
+
+            if (i > pApplication->visiblePopupCount) {
+                i = pApplication->visiblePopupCount;
+            }
+        }
+    }
 }
 
-void ak_application_on_unfocus_window(ak_window* pWindow)
-{
-    assert(pWindow != NULL);
 
-    ak_application* pApplication = ak_get_window_application(pWindow);
+// Looks up the slot for the given panel type. If the type has not been interned, the returned slot is the empty one
+// it would go in.
+static ak_panel_type_atom** ak_application_find_panel_type_slot(ak_application* pApplication, const char* type, uint32_t hash)
+{
     assert(pApplication != NULL);
+    assert(pApplication->panelTypeAtomCapacity > 0);
 
-    pApplication->pPrevFocusedWindow = pWindow;
+    size_t mask = pApplication->panelTypeAtomCapacity - 1;
 
-    // Popup window's that lose focus need to be hidden.
-    if (ak_get_window_type(pWindow) == ak_window_type_popup) {
-        ak_hide_window(pWindow, AK_AUTO_HIDE_FROM_LOST_FOCUS);
+    size_t i = hash & mask;
+    while (pApplication->ppPanelTypeAtoms[i] != NULL)
+    {
+        if (pApplication->ppPanelTypeAtoms[i]->hash == hash && strcmp(pApplication->ppPanelTypeAtoms[i]->type, type) == 0) {
+            break;
+        }
+
+        i = (i + 1) & mask;
     }
+
+    return &pApplication->ppPanelTypeAtoms[i];
 }
 
-void ak_application_on_mouse_enter(ak_window* pWindow)
+ak_panel_type_atom* ak_application_intern_panel_type(ak_application* pApplication, const char* type)
 {
-    assert(pWindow != NULL);
+    assert(pApplication != NULL);
+    assert(type != NULL);
 
-    ak_window_on_mouse_enter(pWindow);
-}
+    ak_panel_type_atom* pExistingAtom = ak_application_find_panel_type(pApplication, type);
+    if (pExistingAtom != NULL) {
+        return pExistingAtom;
+    }
 
-void ak_application_on_mouse_leave(ak_window* pWindow)
-{
-    assert(pWindow != NULL);
 
-    ak_window_on_mouse_leave(pWindow);
+    // The parent type needs to be interned first. This is done before growing the table because it may grow it too.
+    ak_panel_type_atom* pParentAtom = NULL;
 
-    // Let the GUI know about the event.
-    drgui_post_inbound_event_mouse_leave(ak_get_window_panel(pWindow));
-}
+    const char* pLastDot = strrchr(type, '.');
+    if (pLastDot != NULL && pLastDot != type)
+    {
+        size_t parentLength = (size_t)(pLastDot - type);
+        char* parentType = malloc(parentLength + 1);
+        if (parentType == NULL) {
+            return NULL;
+        }
 
-void ak_application_on_mouse_move(ak_window* pWindow, int relativeMousePosX, int relativeMousePosY, int stateFlags)
-{
-    assert(pWindow != NULL);
+        memcpy(parentType, type, parentLength);
+        parentType[parentLength] = '\0';
 
-    // Let the GUI know about the event.
-    drgui_post_inbound_event_mouse_move(ak_get_window_panel(pWindow), relativeMousePosX, relativeMousePosY, stateFlags);
-}
+        pParentAtom = ak_application_intern_panel_type(pApplication, parentType);
+        free(parentType);
 
-void ak_application_on_mouse_button_down(ak_window* pWindow, int mouseButton, int relativeMousePosX, int relativeMousePosY, int stateFlags)
-{
-    assert(pWindow != NULL);
+        if (pParentAtom == NULL) {
+            return NULL;
+        }
+    }
 
-    ak_window_on_mouse_button_down(pWindow, mouseButton, relativeMousePosX, relativeMousePosY);
 
-    // Any popup window that is not an ancestor of the input window needs to be hidden.
-    ak_application_hide_non_ancestor_popups(pWindow);
+    // The table is kept at most 3/4 full so that probe sequences stay short.
+    if ((pApplication->panelTypeAtomCount + 1) * 4 > pApplication->panelTypeAtomCapacity * 3)
+    {
+        size_t newCapacity = (pApplication->panelTypeAtomCapacity == 0) ? 32 : pApplication->panelTypeAtomCapacity * 2;
+        ak_panel_type_atom** ppNewAtoms = calloc(newCapacity, sizeof(*ppNewAtoms));
+        if (ppNewAtoms == NULL) {
+            return NULL;
+        }
 
-    // Let the GUI know about the event.
-    drgui_post_inbound_event_mouse_button_down(ak_get_window_panel(pWindow), mouseButton, relativeMousePosX, relativeMousePosY, stateFlags);
+        ak_panel_type_atom** ppOldAtoms = pApplication->ppPanelTypeAtoms;
+        size_t oldCapacity = pApplication->panelTypeAtomCapacity;
+
+        pApplication->ppPanelTypeAtoms      = ppNewAtoms;
+        pApplication->panelTypeAtomCapacity = newCapacity;
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (ppOldAtoms[i] != NULL) {
+                *ak_application_find_panel_type_slot(pApplication, ppOldAtoms[i]->type, ppOldAtoms[i]->hash) = ppOldAtoms[i];
+            }
+        }
+
+        free(ppOldAtoms);
+    }
+
+
+    size_t typeLength = strlen(type);
+    ak_panel_type_atom* pAtom = malloc(sizeof(*pAtom) + typeLength);
+    if (pAtom == NULL) {
+        return NULL;
+    }
+
+    pAtom->hash         = ak_hash_string(type);
+    pAtom->pParent      = pParentAtom;
+    pAtom->pFirstChild  = NULL;
+    pAtom->pNextSibling = NULL;
+    pAtom->pFirstPanel  = NULL;
+    pAtom->pLastPanel   = NULL;
+    memcpy(pAtom->type, type, typeLength + 1);
+
+    if (pParentAtom != NULL) {
+        pAtom->pNextSibling = pParentAtom->pFirstChild;
+        pParentAtom->pFirstChild = pAtom;
+    }
+
+    *ak_application_find_panel_type_slot(pApplication, type, pAtom->hash) = pAtom;
+    pApplication->panelTypeAtomCount += 1;
+
+    return pAtom;
 }
 
-void ak_application_on_mouse_button_up(ak_window* pWindow, int mouseButton, int relativeMousePosX, int relativeMousePosY, int stateFlags)
+ak_panel_type_atom* ak_application_find_panel_type(ak_application* pApplication, const char* type)
 {
-    assert(pWindow != NULL);
+    assert(pApplication != NULL);
+    assert(type != NULL);
 
-    ak_window_on_mouse_button_up(pWindow, mouseButton, relativeMousePosX, relativeMousePosY);
+    if (pApplication->panelTypeAtomCount == 0) {
+        return NULL;
+    }
 
-    // Let the GUI know about the event.
-    drgui_post_inbound_event_mouse_button_up(ak_get_window_panel(pWindow), mouseButton, relativeMousePosX, relativeMousePosY, stateFlags);
+    return *ak_application_find_panel_type_slot(pApplication, type, ak_hash_string(type));
 }
 
-void ak_application_on_mouse_button_dblclick(ak_window* pWindow, int mouseButton, int relativeMousePosX, int relativeMousePosY, int stateFlags)
+
+uint32_t ak_hash_string(const char* str)
 {
-    assert(pWindow != NULL);
+    assert(str != NULL);
 
-    ak_window_on_mouse_button_dblclick(pWindow, mouseButton, relativeMousePosX, relativeMousePosY);
+    uint32_t hash = 2166136261u;
+    while (*str != '\0') {
+        hash ^= (unsigned char)*str++;
+        hash *= 16777619u;
+    }
 
-    // Let the GUI know about the event.
-    drgui_post_inbound_event_mouse_button_dblclick(ak_get_window_panel(pWindow), mouseButton, relativeMousePosX, relativeMousePosY, stateFlags);
+    return hash;
 }
 
-void ak_application_on_mouse_wheel(ak_window* pWindow, int delta, int relativeMousePosX, int relativeMousePosY, int stateFlags)
+uint32_t ak_hash_string_n(const char* str, size_t length)
 {
-    assert(pWindow != NULL);
+    assert(str != NULL || length == 0);
 
-    ak_window_on_mouse_wheel(pWindow, delta, relativeMousePosX, relativeMousePosY);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= (unsigned char)str[i];
+        hash *= 16777619u;
+    }
 
-    // Let the GUI know about the event.
-    drgui_post_inbound_event_mouse_wheel(ak_get_window_panel(pWindow), delta, relativeMousePosX, relativeMousePosY, stateFlags);
+    return hash;
 }
 
-void ak_application_on_key_down(ak_window* pWindow, drgui_key key, int stateFlags)
+uint32_t ak_application_intern_tool_type(ak_application* pApplication, const char* type)
 {
-    assert(pWindow != NULL);
-
-    ak_window_on_key_down(pWindow, key, stateFlags);
-    drgui_post_inbound_event_key_down(ak_get_window_panel(pWindow)->pContext, key, stateFlags);
+    assert(pApplication != NULL);
 
-    ak_application* pApplication = ak_get_window_application(pWindow);
-    if (pApplication != NULL && pApplication->onKeyDown) {
-        pApplication->onKeyDown(pApplication, pWindow, key, stateFlags);
+    if (type == NULL || type[0] == '\0') {
+        return 0;
     }
+
+    return ak_action_registry_intern_scope(pApplication->pActionRegistry, type);
 }
 
-void ak_application_on_key_up(ak_window* pWindow, drgui_key key, int stateFlags)
+bool ak_application_handle_tool_action(ak_application* pApplication, drgui_element* pTool, uint32_t toolTypeID, ak_action_id actionID)
 {
-    assert(pWindow != NULL);
+    assert(pApplication != NULL);
+    assert(pTool != NULL);
 
-    ak_window_on_key_up(pWindow, key, stateFlags);
-    drgui_post_inbound_event_key_up(ak_get_window_panel(pWindow)->pContext, key, stateFlags);
+    // The most specific type wins, so we start at the tool's own type and work our way up to the base types.
+    for (uint32_t scopeID = toolTypeID; scopeID != 0; scopeID = ak_action_registry_get_scope_parent(pApplication->pActionRegistry, scopeID))
+    {
+        const ak_action_handler* pHandler = ak_action_registry_find_handler(pApplication->pActionRegistry, scopeID, actionID);
+        if (pHandler != NULL)
+        {
+            uint64_t traceBeginTime = ak_trace_begin(pApplication);
+            pHandler->proc(pApplication, pTool, actionID, pHandler->pUserData);
+            ak_trace_end(pApplication, traceBeginTime, "ak_tool_handle_action", AK_TRACE_CATEGORY_ACTION, ak_action_registry_get_name(pApplication->pActionRegistry, actionID));
 
-    ak_application* pApplication = ak_get_window_application(pWindow);
-    if (pApplication != NULL && pApplication->onKeyUp) {
-        pApplication->onKeyUp(pApplication, pWindow, key, stateFlags);
+            return true;
+        }
     }
+
+    return false;
 }
 
-void ak_application_on_printable_key_down(ak_window* pWindow, unsigned int character, int stateFlags)
+unsigned int ak_application_get_shortcut_generation(ak_application* pApplication)
 {
-    assert(pWindow != NULL);
+    assert(pApplication != NULL);
 
-    ak_window_on_printable_key_down(pWindow, character, stateFlags);
-    drgui_post_inbound_event_printable_key_down(ak_get_window_panel(pWindow)->pContext, character, stateFlags);
+    return ak_accelerator_table_get_generation(pApplication->pAcceleratorTable);
 }
 
 
-void ak_application_on_panel_activated(ak_application* pApplication, drgui_element* pPanel)
+ak_window_stats* ak_get_application_window_stats_totals(ak_application* pApplication)
 {
-    if (pApplication == NULL || pPanel == NULL) {
-        return;
-    }
+    assert(pApplication != NULL);
+    return &pApplication->stats.windows;
+}
 
-    if (pApplication->onPanelActivated) {
-        pApplication->onPanelActivated(pApplication, pPanel);
-    }
+ak_placeholder_queue* ak_get_application_placeholder_queue(ak_application* pApplication)
+{
+    assert(pApplication != NULL);
+    return &pApplication->placeholderQueue;
 }
 
-void ak_application_on_panel_deactivated(ak_application* pApplication, drgui_element* pPanel)
+void ak_application_on_placeholder_queued(ak_application* pApplication)
 {
-    if (pApplication == NULL || pPanel == NULL) {
-        return;
-    }
+    assert(pApplication != NULL);
 
-    if (pApplication->onPanelDeactivated) {
-        pApplication->onPanelDeactivated(pApplication, pPanel);
-    }
+    // This does nothing until startup has finished, or if the timer is already running.
+    ak_start_tool_precreation(pApplication);
 }
 
+void ak_application_count_panel_layout(ak_application* pApplication)
+{
+    assert(pApplication != NULL);
+    pApplication->stats.panelLayoutCount += 1;
+}
 
-void ak_application_on_tool_activated(ak_application* pApplication, drgui_element* pTool)
+void ak_trace_record(ak_application* pApplication, const char* name, const char* category, const char* detail, uint64_t beginTime, uint64_t endTime)
 {
-    if (pApplication == NULL || pTool == NULL) {
+    assert(pApplication != NULL);
+    ak_tracer_record(pApplication->pTracer, name, category, detail, beginTime, endTime);
+}
+
+void ak_begin_batch_update(ak_application* pApplication)
+{
+    if (pApplication == NULL) {
         return;
     }
 
-    if (pApplication->onToolActivated) {
-        pApplication->onToolActivated(pApplication, pTool);
-    }
+    pApplication->batchUpdateDepth += 1;
 }
 
-void ak_application_on_tool_deactivated(ak_application* pApplication, drgui_element* pTool)
+void ak_end_batch_update(ak_application* pApplication)
 {
-    if (pApplication == NULL || pTool == NULL) {
+    if (pApplication == NULL || pApplication->batchUpdateDepth == 0) {
         return;
     }
 
-    if (pApplication->onToolDeactivated) {
-        pApplication->onToolDeactivated(pApplication, pTool);
+    pApplication->batchUpdateDepth -= 1;
+    if (pApplication->batchUpdateDepth > 0) {
+        return;
     }
-}
 
+    // Windows may have been painted during the batch, in which case their layout was skipped and there may not be
+    // another paint to pick it up. Updating the layout now invalidates anything that changes.
+    for (ak_window* pWindow = ak_get_first_window(pApplication); pWindow != NULL; pWindow = ak_get_next_window(pApplication, pWindow)) {
+        ak_update_window_layout(pWindow);
+    }
+}
 
-void ak_application_track_top_level_window(ak_window* pWindow)
+bool ak_application_is_in_batch_update(ak_application* pApplication)
 {
-    assert(pWindow != NULL);
-
-    ak_application* pApplication = ak_get_window_application(pWindow);
     assert(pApplication != NULL);
-
-    if (pApplication->pFirstWindow != NULL)
-    {
-        ak_set_prev_sibling_window(pApplication->pFirstWindow, pWindow);
-        ak_set_next_sibling_window(pWindow, pApplication->pFirstWindow);
-    }
-
-    pApplication->pFirstWindow = pWindow;
+    return pApplication->batchUpdateDepth > 0;
 }
 
-void ak_application_untrack_top_level_window(ak_window* pWindow)
+
+void ak_application_on_window_painted(ak_window* pWindow, uint64_t paintEndTime)
 {
     assert(pWindow != NULL);
 
     ak_application* pApplication = ak_get_window_application(pWindow);
     assert(pApplication != NULL);
 
-    if (pApplication->pFirstWindow != NULL)
-    {
-        if (pApplication->pFirstWindow == pWindow) {
-            pApplication->pFirstWindow = ak_get_next_sibling_window(pWindow);
-        }
-
-        if (ak_get_next_sibling_window(pWindow) != NULL) {
-            ak_set_prev_sibling_window(ak_get_next_sibling_window(pWindow), ak_get_prev_sibling_window(pWindow));
-        }
-
-        if (ak_get_prev_sibling_window(pWindow) != NULL) {
-            ak_set_next_sibling_window(ak_get_prev_sibling_window(pWindow), ak_get_next_sibling_window(pWindow));
-        }
-
-        ak_set_next_sibling_window(pWindow, NULL);
-        ak_set_prev_sibling_window(pWindow, NULL);
+    if (pApplication->isStartupComplete || pWindow != ak_get_primary_window(pApplication)) {
+        return;
     }
-}
-
 
-void ak_application_hide_non_ancestor_popups(ak_window* pWindow)
-{
-    assert(pWindow != NULL);
+    pApplication->isStartupComplete = true;
 
-    ak_application* pApplication = ak_get_window_application(pWindow);
-    assert(pApplication != NULL);
+    ak_startup_stats* pStats = &pApplication->startupStats;
+    pStats->createToFirstPaintTimeInMicroseconds = paintEndTime - pApplication->createTime;
+    if (pStats->processStartToCreateTimeInMicroseconds > 0) {
+        pStats->processStartToFirstPaintTimeInMicroseconds = pStats->processStartToCreateTimeInMicroseconds + pStats->createToFirstPaintTimeInMicroseconds;
+    }
 
-    for (ak_window* pOtherWindow = ak_get_first_window(pApplication); pOtherWindow != NULL; pOtherWindow = ak_get_next_window(pApplication, pOtherWindow))
-    {
-        if (pOtherWindow != pWindow && ak_get_window_type(pOtherWindow) == ak_window_type_popup && !ak_is_window_ancestor(pOtherWindow, pWindow))
-        {
-            ak_hide_window(pOtherWindow, AK_AUTO_HIDE_FROM_LOST_FOCUS);
-        }
+    ak_trace_record(pApplication, "first_paint", AK_TRACE_CATEGORY_STARTUP, NULL, pApplication->createTime, paintEndTime);
+
+    // Placeholder tools are left alone until now so that creating them does not get in the way of the first paint. The
+    // same goes for rewriting the config cache.
+    ak_start_tool_precreation(pApplication);
+    ak_submit_config_cache_job(pApplication);
+
+    if (pApplication->logStartupSummary) {
+        ak_log_info(pApplication, AK_LOG_CATEGORY_STARTUP,
+            "First paint after %.1fms (%.1fms since process start). Process start to create: %.1fms, VFS and log: %.1fms, drawing context: %.1fms, theme: %.1fms, config parse: %.1fms%s, layout: %.1fms, onRun: %.1fms",
+            pStats->createToFirstPaintTimeInMicroseconds       / 1000.0,
+            pStats->processStartToFirstPaintTimeInMicroseconds / 1000.0,
+            pStats->processStartToCreateTimeInMicroseconds     / 1000.0,
+            pStats->fileSystemAndLogTimeInMicroseconds         / 1000.0,
+            pStats->drawingContextTimeInMicroseconds           / 1000.0,
+            pStats->themeLoadTimeInMicroseconds                / 1000.0,
+            pStats->configParseTimeInMicroseconds              / 1000.0,
+            pStats->isConfigFromCache ? " (cached)" : "",
+            pStats->layoutApplyTimeInMicroseconds              / 1000.0,
+            pStats->onRunTimeInMicroseconds                    / 1000.0);
     }
 }
 
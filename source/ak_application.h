@@ -22,6 +22,7 @@ typedef void           (* ak_log_proc)           (ak_application* pApplication,
 typedef const char*    (* ak_layout_config_proc) (ak_application* pApplication);
 typedef drgui_element* (* ak_create_tool_proc)   (ak_application* pApplication, ak_window* pWindow, const char* type, const char* attributes);
 typedef bool           (* ak_delete_tool_proc)   (ak_application* pApplication, drgui_element* pTool, bool force);
+typedef bool           (* ak_get_tool_title_proc)(ak_application* pApplication, const char* type, const char* attributes, char* titleOut, size_t titleOutSize);
 
 typedef void (* ak_application_on_key_down_proc)         (ak_application* pApplication, ak_window* pWindow, drgui_key key, int stateFlags);
 typedef void (* ak_application_on_key_up_proc)           (ak_application* pApplication, ak_window* pWindow, drgui_key key, int stateFlags);
@@ -33,6 +34,160 @@ typedef void (* ak_application_on_handle_action_proc)    (ak_application* pAppli
 typedef int  (* ak_application_on_exec_proc)             (ak_application* pApplication, const char* cmd);
 
 typedef void (* ak_timer_proc)(ak_timer* pTimer, void* pUserData);
+typedef void (* ak_work_proc) (ak_application* pApplication, void* pUserData);
+
+typedef uint32_t ak_action_id;
+typedef void (* ak_action_handler_proc)(ak_application* pApplication, drgui_element* pTool, ak_action_id actionID, void* pUserData);
+
+
+typedef struct
+{
+    /// The number of times the timer has fired.
+    unsigned int fireCount;
+
+    /// The average amount of time between the timer's deadline and the time it was actually fired, in milliseconds.
+    double averageLatenessInMilliseconds;
+
+    /// The largest amount of time between the timer's deadline and the time it was actually fired, in milliseconds.
+    double maxLatenessInMilliseconds;
+
+} ak_timer_stats;
+
+/// The types of window events that are counted by the application's statistics.
+typedef enum
+{
+    ak_event_type_close,
+    ak_event_type_hide,
+    ak_event_type_show,
+    ak_event_type_activate,
+    ak_event_type_deactivate,
+    ak_event_type_focus,
+    ak_event_type_unfocus,
+    ak_event_type_mouse_enter,
+    ak_event_type_mouse_leave,
+    ak_event_type_mouse_move,
+    ak_event_type_mouse_button_down,
+    ak_event_type_mouse_button_up,
+    ak_event_type_mouse_button_dblclick,
+    ak_event_type_mouse_wheel,
+    ak_event_type_key_down,
+    ak_event_type_key_up,
+    ak_event_type_printable_key_down,
+
+    ak_event_type_count     // <-- The number of event types. Not an event type itself.
+
+} ak_event_type;
+
+typedef struct
+{
+    /// The number of times the window has been painted.
+    uint64_t paintCount;
+
+    /// The total amount of time spent drawing the GUI to the window's surface, in microseconds.
+    uint64_t paintTimeInMicroseconds;
+
+    /// The total amount of time spent copying the window's surface to the screen, in microseconds. This is always 0
+    /// on platforms where the GUI is drawn directly to the window.
+    uint64_t blitTimeInMicroseconds;
+
+    /// The number of dirty rectangles that have been posted to the window.
+    uint64_t dirtyRectCount;
+
+    /// The number of times the window's surface has been recreated as a result of the window being resized.
+    uint64_t surfaceRecreationCount;
+
+    /// The number of events that have been dispatched to the window, indexed by ak_event_type.
+    uint64_t eventCounts[ak_event_type_count];
+
+} ak_window_stats;
+
+typedef struct
+{
+    /// The sum of the statistics of every window, including windows that have since been deleted.
+    ak_window_stats windows;
+
+    /// The number of timer callbacks that have been fired.
+    uint64_t timerFireCount;
+
+    /// The number of times a panel has laid out it's split panels, or it's tab bar and tool container. This should not
+    /// change when the mouse is just moving over the application.
+    uint64_t panelLayoutCount;
+
+} ak_application_stats;
+
+typedef struct
+{
+    /// The time between the process starting and ak_create_application() being called. This is 0 if the platform
+    /// can't tell us when the process started.
+    uint64_t processStartToCreateTimeInMicroseconds;
+
+    /// The time spent creating the virtual file system and opening the log file, including every attempt at finding a
+    /// log file name that isn't already in use.
+    uint64_t fileSystemAndLogTimeInMicroseconds;
+
+    /// The time spent creating the drawing and GUI contexts.
+    uint64_t drawingContextTimeInMicroseconds;
+
+    /// The time spent loading the theme, including the default fonts.
+    uint64_t themeLoadTimeInMicroseconds;
+
+    /// The time spent parsing the config. This includes the default config if the config file failed to load.
+    uint64_t configParseTimeInMicroseconds;
+
+    /// Whether or not the config was loaded from it's compiled cache rather than being parsed.
+    bool isConfigFromCache;
+
+    /// The time spent applying the initial layout.
+    uint64_t layoutApplyTimeInMicroseconds;
+
+    /// The time spent in the application's onRun callback.
+    uint64_t onRunTimeInMicroseconds;
+
+    /// The time between ak_create_application() being called and the first paint of the primary window completing.
+    /// This is 0 until the first paint has completed.
+    uint64_t createToFirstPaintTimeInMicroseconds;
+
+    /// The time between the process starting and the first paint of the primary window completing. This is 0 until
+    /// the first paint has completed, or if the platform can't tell us when the process started.
+    uint64_t processStartToFirstPaintTimeInMicroseconds;
+
+} ak_startup_stats;
+
+
+// Log categories. A category is a short tag that's placed in front of the message. These are the ones used by the library
+// itself, but applications are free to use their own.
+#define AK_LOG_CATEGORY_CONFIG      "CONFIG"
+#define AK_LOG_CATEGORY_WINDOW      "WINDOW"
+#define AK_LOG_CATEGORY_INPUT       "INPUT"
+#define AK_LOG_CATEGORY_STARTUP     "STARTUP"
+
+// Log flush flags. These control when the log file is flushed to disk.
+#define AK_LOG_FLUSH_ON_INTERVAL    (1 << 0)        // Flush at a fixed interval.
+#define AK_LOG_FLUSH_ON_SIZE        (1 << 1)        // Flush when the amount of unflushed data reaches a threshold.
+#define AK_LOG_FLUSH_ON_WARNING     (1 << 2)        // Flush as soon as a warning or error is posted.
+#define AK_LOG_FLUSH_ON_ERROR       (1 << 3)        // Flush as soon as an error is posted.
+#define AK_LOG_FLUSH_ON_CRASH       (1 << 4)        // Write pending messages if the process crashes. Installs process-wide crash handlers.
+
+// Trace categories. These are used to group trace events in the trace viewer.
+#define AK_TRACE_CATEGORY_STARTUP   "startup"
+#define AK_TRACE_CATEGORY_PAINT     "paint"
+#define AK_TRACE_CATEGORY_INPUT     "input"
+#define AK_TRACE_CATEGORY_TIMER     "timer"
+#define AK_TRACE_CATEGORY_ACTION    "action"
+#define AK_TRACE_CATEGORY_LAYOUT    "layout"
+
+typedef struct
+{
+    /// A combination of the AK_LOG_FLUSH_ON_* flags.
+    unsigned int flags;
+
+    /// The interval in milliseconds at which the log file is flushed when AK_LOG_FLUSH_ON_INTERVAL is set.
+    unsigned int intervalInMilliseconds;
+
+    /// The number of unflushed bytes that will trigger a flush when AK_LOG_FLUSH_ON_SIZE is set.
+    size_t sizeThresholdInBytes;
+
+} ak_log_flush_policy;
 
 
 /// Creates a new application object.
@@ -87,6 +242,38 @@ void ak_post_quit_message(ak_application* pApplication, int exitCode);
 /// Destroys every window in the application.
 void ak_delete_all_application_windows(ak_application* pApplication);
 
+/// Switches to the layout with the given name.
+///
+/// @remarks
+///     Rather than tearing everything down and applying the new layout from scratch, the new layout is compared with
+///     the windows, panels and tools that already exist. Windows are reused if they have the same name, tools are
+///     reused if they were created from the same type and attributes, and panels are only re-split if their split
+///     has changed. Tools are moved between panels rather than being recreated. Anything that's not needed by the new
+///     layout is deleted.
+///     @par
+///     Only top level application windows are considered part of the layout.
+///     @par
+///     If the layout hasn't been used before it may need to be parsed from the config first, in which case any errors
+///     in it are reported at this point.
+bool ak_switch_layout(ak_application* pApplication, const char* layoutName);
+
+
+/// Begins a batch of updates to the layout of the application's windows.
+///
+/// @remarks
+///     Panels are normally laid out just before their window is painted. Between this and ak_end_batch_update() they
+///     are not laid out at all, even if a window is painted, so that a bulk operation such as applying a layout or
+///     attaching many tools results in exactly one layout and one repaint.
+///     @par
+///     Batches can be nested. The layout is only updated when the outermost batch ends.
+void ak_begin_batch_update(ak_application* pApplication);
+
+/// Ends a batch of updates that was started with ak_begin_batch_update().
+///
+/// @remarks
+///     When the outermost batch ends, the layout of every window is updated straight away.
+void ak_end_batch_update(ak_application* pApplication);
+
 
 /// Retrieves the name of the application.
 ///
@@ -117,10 +304,71 @@ ak_image_library* ak_get_image_library(ak_application* pApplication);
 ak_theme* ak_get_application_theme(ak_application* pApplication);
 
 
-/// Posts a log message.
+/// Posts a log message with the given level and category.
+///
+/// @remarks
+///     <level> is one of the AK_LOG_LEVEL_* constants defined in ak_build_config.h. <category> can be null.
+///     @par
+///     Consider using the ak_log_trace(), ak_log_debug(), etc. macros instead which are compiled out entirely when
+///     the level is below AK_MIN_LOG_LEVEL, and do not evaluate their arguments when the level is disabled at run time.
+void ak_log_message(ak_application* pApplication, int level, const char* category, const char* message);
+
+/// Posts a formatted log message with the given level and category.
+///
+/// @remarks
+///     The message is not formatted if the level is disabled.
+void ak_log_messagef(ak_application* pApplication, int level, const char* category, const char* format, ...);
+
+/// Sets the minimum level of messages that will be posted.
+///
+/// @remarks
+///     This cannot enable messages below AK_MIN_LOG_LEVEL since those are removed at compile time.
+void ak_set_log_level(ak_application* pApplication, int level);
+
+/// Retrieves the minimum level of messages that will be posted.
+int ak_get_log_level(ak_application* pApplication);
+
+/// Determines whether or not messages of the given level will be posted.
+bool ak_is_log_level_enabled(ak_application* pApplication, int level);
+
+#define AK_LOG_MESSAGE_IF_ENABLED(pApplication, level, category, ...) \
+    do { if (ak_is_log_level_enabled((pApplication), (level))) { ak_log_messagef((pApplication), (level), (category), __VA_ARGS__); } } while (0)
+
+#if AK_MIN_LOG_LEVEL <= AK_LOG_LEVEL_TRACE
+#define ak_log_trace(pApplication, category, ...) AK_LOG_MESSAGE_IF_ENABLED(pApplication, AK_LOG_LEVEL_TRACE, category, __VA_ARGS__)
+#else
+#define ak_log_trace(pApplication, category, ...) ((void)0)
+#endif
+
+#if AK_MIN_LOG_LEVEL <= AK_LOG_LEVEL_DEBUG
+#define ak_log_debug(pApplication, category, ...) AK_LOG_MESSAGE_IF_ENABLED(pApplication, AK_LOG_LEVEL_DEBUG, category, __VA_ARGS__)
+#else
+#define ak_log_debug(pApplication, category, ...) ((void)0)
+#endif
+
+#if AK_MIN_LOG_LEVEL <= AK_LOG_LEVEL_INFO
+#define ak_log_info(pApplication, category, ...) AK_LOG_MESSAGE_IF_ENABLED(pApplication, AK_LOG_LEVEL_INFO, category, __VA_ARGS__)
+#else
+#define ak_log_info(pApplication, category, ...) ((void)0)
+#endif
+
+#if AK_MIN_LOG_LEVEL <= AK_LOG_LEVEL_WARNING
+#define ak_log_warning(pApplication, category, ...) AK_LOG_MESSAGE_IF_ENABLED(pApplication, AK_LOG_LEVEL_WARNING, category, __VA_ARGS__)
+#else
+#define ak_log_warning(pApplication, category, ...) ((void)0)
+#endif
+
+#if AK_MIN_LOG_LEVEL <= AK_LOG_LEVEL_ERROR
+#define ak_log_error(pApplication, category, ...) AK_LOG_MESSAGE_IF_ENABLED(pApplication, AK_LOG_LEVEL_ERROR, category, __VA_ARGS__)
+#else
+#define ak_log_error(pApplication, category, ...) ((void)0)
+#endif
+
+
+/// Posts an info level log message.
 void ak_log(ak_application* pApplication, const char* message);
 
-/// Posts a formatted log message.
+/// Posts a formatted info level log message.
 void ak_logf(ak_application* pApplication, const char* format, ...);
 
 /// Posts a warning to the log.
@@ -135,12 +383,56 @@ void ak_error(ak_application* pApplication, const char* message);
 /// Posts a formatted error log message.
 void ak_errorf(ak_application* pApplication, const char* format, ...);
 
+// The functions above respect AK_MIN_LOG_LEVEL in the same way as the ak_log_info(), etc. macros. When their level is
+// below it they are replaced with nothing, so their arguments are not evaluated and the message is never formatted.
+#if AK_MIN_LOG_LEVEL > AK_LOG_LEVEL_INFO
+#define ak_log(pApplication, message) ((void)0)
+#define ak_logf(pApplication, ...) ((void)0)
+#endif
+
+#if AK_MIN_LOG_LEVEL > AK_LOG_LEVEL_WARNING
+#define ak_warning(pApplication, message) ((void)0)
+#define ak_warningf(pApplication, ...) ((void)0)
+#endif
+
+#if AK_MIN_LOG_LEVEL > AK_LOG_LEVEL_ERROR
+#define ak_error(pApplication, message) ((void)0)
+#define ak_errorf(pApplication, ...) ((void)0)
+#endif
+
 /// Sets the function to call when a log message is posted.
 void ak_set_log_callback(ak_application* pApplication, ak_log_proc proc);
 
 /// Retrieves a pointer to the log callback function, if any.
 ak_log_proc ak_get_log_callback(ak_application* pApplication);
 
+/// Sets the policy controlling when the log file is flushed.
+///
+/// @remarks
+///     Log messages are written to the log file on a background thread. The flush policy controls how long a message
+///     can sit in memory before it hits the disk. Regardless of the policy, every message is written and flushed when
+///     the application is deleted.
+///     @par
+///     Messages still in memory when the process crashes are only written if AK_LOG_FLUSH_ON_CRASH is set. The first time
+///     it's set, handlers for SIGSEGV, SIGABRT, SIGBUS, SIGFPE and SIGILL (or an unhandled exception filter on Win32) are
+///     installed for the whole process. They chain to whatever was installed before them, but they are never removed.
+///     This is a best effort thing - if the background thread is in the middle of writing when the crash happens, the
+///     pending messages are lost.
+///     @par
+///     The default policy flushes every AK_DEFAULT_LOG_FLUSH_INTERVAL milliseconds, whenever AK_DEFAULT_LOG_FLUSH_THRESHOLD
+///     bytes have been posted, and immediately for warnings and errors. It does not include AK_LOG_FLUSH_ON_CRASH so that
+///     it doesn't interfere with the host application's own crash handling.
+void ak_set_log_flush_policy(ak_application* pApplication, ak_log_flush_policy policy);
+
+/// Retrieves the policy controlling when the log file is flushed.
+ak_log_flush_policy ak_get_log_flush_policy(ak_application* pApplication);
+
+/// Writes every pending log message to the log file and flushes it.
+///
+/// @remarks
+///     This is synchronous.
+void ak_flush_log(ak_application* pApplication);
+
 
 /// Retrieves the path of the directory that contains the log file.
 bool ak_get_log_file_folder_path(ak_application* pApplication, char* pathOut, size_t pathOutSize);
@@ -165,10 +457,15 @@ ak_layout_config_proc ak_get_on_default_config(ak_application* pApplication);
 /// Retrieves the window that the given element is contained in.
 ///
 /// @remarks
-///     This runs in linear time.
+///     This uses the window cached on the nearest panel or tool that has one, which is usually the element itself or
+///     it's parent tool. Only elements that aren't inside a panel in the main hierarchy need to go up to the root.
 ak_window* ak_get_element_window(drgui_element* pElement);
 
-/// Retrieves the first occurance of the window with the given name.
+/// Retrieves the window with the given name.
+///
+/// @remarks
+///     This is a hash table lookup. If more than one window has the same name, which one is returned is undefined.
+///     Windows without a name cannot be retrieved with this.
 ak_window* ak_get_window_by_name(ak_application* pApplication, const char* pName);
 
 
@@ -182,6 +479,8 @@ ak_window* ak_get_next_window(ak_application* pApplication, ak_window* pWindow);
 ///
 /// @remarks
 ///     The primary window is the first application window that was created.
+///     @par
+///     This is cached, and only looked up again after a window has been created or deleted.
 ak_window* ak_get_primary_window(ak_application* pApplication);
 
 
@@ -200,14 +499,20 @@ drgui_element* ak_get_next_panel(ak_application* pApplication, drgui_element* pP
 /// Retrieves a pointer to the panel with the given type.
 ///
 /// @remarks
-///     This is a slow recursive function.
+///     Panels are indexed by type so this does not need to search the panel hierarchy. Sub-types are included, so
+///     searching for "My.Panel" will also find panels of type "My.Panel.Type".
 ///     @par
 ///     This will only find panels that are part of the main hierarchy and will not find those that are part of custom tools.
+///     @par
+///     Only types that were set with ak_panel_set_type() are indexed.
 drgui_element* ak_find_first_panel_by_type(ak_application* pApplication, const char* pPanelType);
 
 /// Retrieves a pointer to the next panel with the given type.
 ///
 /// @remarks
+///     Panels of the same exact type are returned in the order their types were set, with each sub-type after the type
+///     it's derived from. This is not necessarily the same order as ak_get_next_panel().
+///     @par
 ///     This will only find panels that are part of the main hierarchy and will not find those that are part of custom tools.
 drgui_element* ak_find_next_panel_by_type(ak_application* pApplication, drgui_element* pPanel, const char* pPanelType);
 
@@ -238,6 +543,47 @@ void ak_set_on_delete_tool(ak_application* pApplication, ak_delete_tool_proc pro
 /// Retrieves a pointer to the callback function that is called when a custom tool needs to be deleted.
 ak_delete_tool_proc ak_get_on_delete_tool(ak_application* pApplication);
 
+/// Sets the callback function to call to retrieve the title of a tool without creating it.
+///
+/// @remarks
+///     When this is set, tools in inactive tabs are not created when a layout is applied. Instead, a placeholder is
+///     given the title returned by this callback, and the tool is created with the onCreateTool callback when it's
+///     tab is first activated. Return false to have the tool created straight away as normal.
+void ak_set_on_get_tool_title(ak_application* pApplication, ak_get_tool_title_proc proc);
+
+/// Retrieves a pointer to the callback function that is called to retrieve the title of a tool without creating it.
+ak_get_tool_title_proc ak_get_on_get_tool_title(ak_application* pApplication);
+
+/// Sets the interval at which placeholder tools are replaced with real tools in the background.
+///
+/// @remarks
+///     Once startup has completed, one placeholder is replaced every <intervalInMilliseconds> so that tools are ready
+///     before their tabs are activated, without slowing down the first paint. Set this to 0, which is the default, to
+///     only create tools when their tabs are activated.
+///     @par
+///     Placeholders are replaced in the order they were attached to their panels, including those from layouts that
+///     are switched to later.
+void ak_set_tool_precreation_interval(ak_application* pApplication, unsigned int intervalInMilliseconds);
+
+/// Sets the policy for hibernating tools that are not active.
+///
+/// @remarks
+///     Tools that have not been active for <inactiveTimeInMinutes> are hibernated with ak_hibernate_tool(). When the
+///     memory used by the process goes above <memoryThresholdInBytes>, every tool that's not active is hibernated
+///     regardless of how long it's been inactive for. Set either of these to 0 to disable it. Both are 0 by default.
+///     @par
+///     The policy is checked every AK_TOOL_HIBERNATION_CHECK_INTERVAL milliseconds. Only tools that have set both an
+///     onHibernate and an onRestore callback are hibernated.
+void ak_set_tool_hibernation_policy(ak_application* pApplication, unsigned int inactiveTimeInMinutes, size_t memoryThresholdInBytes);
+
+/// Sets the folder the state of hibernated tools is written to.
+///
+/// @remarks
+///     Set this to null, which is the default, to keep the state in memory. The folder is created if it does not
+///     exist. It should not be shared with other instances of the application, since each instance names it's files
+///     the same way.
+void ak_set_tool_hibernation_folder(ak_application* pApplication, const char* folderPath);
+
 
 /// Creates a tool from it's type and attributes.
 ///
@@ -287,8 +633,77 @@ void ak_set_on_tool_deactivated(ak_application* pApplication, ak_application_on_
 void ak_set_on_handle_action(ak_application* pApplication, ak_application_on_handle_action_proc proc);
 
 /// Handles the given action.
+///
+/// @remarks
+///     If a handler has been set for the action with ak_set_action_handler() it will be called. Otherwise the action
+///     is passed to the function that was set with ak_set_on_handle_action().
 void ak_handle_action(ak_application* pApplication, const char* pActionName);
 
+/// Handles the action with the given ID.
+///
+/// @remarks
+///     This is the same as ak_handle_action(), only that the name does not need to be looked up.
+void ak_handle_action_by_id(ak_application* pApplication, ak_action_id actionID);
+
+
+/// Registers the given action, returning it's ID.
+///
+/// @remarks
+///     Registering the same name more than once returns the same ID. An ID is never 0 unless there was an error.
+///     @par
+///     Actions are intended to be registered once at start up, with the ID then being used for dispatching so that
+///     the name never needs to be looked at.
+ak_action_id ak_register_action(ak_application* pApplication, const char* pActionName);
+
+/// Retrieves the ID of the given action without registering it.
+///
+/// @remarks
+///     This will return 0 if the action has not been registered.
+ak_action_id ak_find_action(ak_application* pApplication, const char* pActionName);
+
+/// Retrieves the name of the action with the given ID.
+const char* ak_get_action_name(ak_application* pApplication, ak_action_id actionID);
+
+/// Sets the application-wide handler for the given action.
+///
+/// @remarks
+///     Set <proc> to null to remove the handler. The pTool argument of an application-wide handler is always null.
+bool ak_set_action_handler(ak_application* pApplication, ak_action_id actionID, ak_action_handler_proc proc, void* pUserData);
+
+/// Sets the handler for the given action for tools of the given type.
+///
+/// @remarks
+///     This is used when an action is sent to a tool with ak_tool_handle_action(). A handler for a base type is used
+///     for sub-types that don't have their own, so a handler for "Editor.Text" will also handle actions for tools of
+///     type "Editor.Text.CPP".
+///     @par
+///     Set <proc> to null to remove the handler.
+bool ak_set_tool_type_action_handler(ak_application* pApplication, const char* toolType, ak_action_id actionID, ak_action_handler_proc proc, void* pUserData);
+
+
+/// Binds a keyboard shortcut to the given action.
+///
+/// @remarks
+///     The shortcut is a space separated list of key strokes. Each stroke is a key optionally prefixed with any of
+///     "Ctrl+", "Shift+" and "Alt+", such as "Ctrl+S". More than one stroke makes a chord, such as "Ctrl+K Ctrl+C".
+///     Keys are either a single character or one of the named keys, such as "F5", "Delete" or "PageUp".
+///     @par
+///     Shortcuts are resolved before a key press is posted to the GUI and the onKeyDown callback, in which case the
+///     action is handled with ak_handle_action_by_id() and the key press goes no further.
+///     @par
+///     Shortcuts can also be declared in the config with 'Shortcut "Ctrl+K Ctrl+C" Edit.Comment'.
+bool ak_bind_shortcut(ak_application* pApplication, const char* shortcut, ak_action_id actionID);
+
+/// Removes every keyboard shortcut.
+void ak_clear_shortcuts(ak_application* pApplication);
+
+/// Retrieves the display text of the shortcut bound to the given action, such as "Ctrl+S".
+///
+/// @remarks
+///     This returns false and sets <textOut> to an empty string if the action does not have a shortcut. Use
+///     ak_mi_set_action() to have this done automatically for menu items.
+bool ak_get_action_shortcut_text(ak_application* pApplication, ak_action_id actionID, char* textOut, size_t textOutSize);
+
 
 /// Sets the function to call when a command needs to be executed.
 void ak_set_on_exec(ak_application* pApplication, ak_application_on_exec_proc proc);
@@ -305,11 +720,135 @@ int ak_exec(ak_application* pApplication, const char* cmd);
 ///
 /// @remarks
 ///     The given callback function will be called from the main application loop.
+///     @par
+///     Every timer of an application is driven by a single platform timer which is armed for the nearest deadline.
+///     Timers whose deadlines fall within the application's timer slack of each other are fired together. See
+///     ak_set_timer_slack().
+///     @par
+///     Timers must be deleted before the application that owns them.
 ak_timer* ak_create_timer(ak_application* pApplication, unsigned int timeoutInMilliseconds, ak_timer_proc callback, void* pUserData);
 
 /// Deletes the given timer.
+///
+/// @remarks
+///     It is safe to delete a timer from inside it's own callback.
 void ak_delete_timer(ak_timer* pTimer);
 
+/// Retrieves statistics about how accurately the given timer has been firing.
+ak_timer_stats ak_get_timer_stats(ak_timer* pTimer);
+
+/// Resets the statistics of the given timer.
+void ak_reset_timer_stats(ak_timer* pTimer);
+
+/// Sets the window in milliseconds within which timer deadlines are coalesced.
+///
+/// @remarks
+///     When a timer is fired, any other timer whose deadline is within this many milliseconds is fired at the same time
+///     rather than waking up the main loop again a moment later. Set this to 0 to disable coalescing.
+void ak_set_timer_slack(ak_application* pApplication, unsigned int slackInMilliseconds);
+
+/// Retrieves the window in milliseconds within which timer deadlines are coalesced.
+unsigned int ak_get_timer_slack(ak_application* pApplication);
+
+
+/// Submits a function to be run on one of the application's worker threads.
+///
+/// @remarks
+///     This is thread-safe and can be called from inside a work item in order to split work up further.
+///     @par
+///     The application owns a pool of AK_WORKER_THREAD_COUNT worker threads, which by default is the number of logical
+///     processors. Use ak_post_to_main_thread() to marshal results back to the GUI.
+///     @par
+///     Every submitted work item is guaranteed to run before ak_delete_application() returns.
+bool ak_submit_work(ak_application* pApplication, ak_work_proc proc, void* pUserData);
+
+/// Posts a function to be run on the main thread.
+///
+/// @remarks
+///     This is thread-safe. The function will be called from the main application loop. Posted functions are run in
+///     batches, in the order they were posted.
+///     @par
+///     Any function that is still waiting to be run when the application is deleted is run from inside
+///     ak_delete_application(), before any windows are deleted.
+bool ak_post_to_main_thread(ak_application* pApplication, ak_work_proc proc, void* pUserData);
+
+/// Retrieves the number of worker threads owned by the application.
+unsigned int ak_get_worker_thread_count(ak_application* pApplication);
+
+
+/// Retrieves the application's statistics.
+///
+/// @remarks
+///     The counters are updated from the main thread without any locking, so this should be called from the main
+///     thread as well. Updating them is cheap enough that they're always enabled.
+///     @par
+///     Use ak_get_window_stats() to retrieve the statistics of an individual window.
+ak_application_stats ak_get_application_stats(ak_application* pApplication);
+
+/// Resets the statistics of the application and every one of it's windows.
+///
+/// @remarks
+///     This is intended for sampling, such as resetting the counters after reading them once per second.
+void ak_reset_application_stats(ak_application* pApplication);
+
+/// Retrieves the name of the given event type, for display purposes.
+const char* ak_event_type_to_string(ak_event_type type);
+
+
+/// Retrieves the timings of each phase of the application's startup.
+///
+/// @remarks
+///     Startup is considered complete when the first paint of the primary window has completed. Phases that haven't
+///     been reached yet are 0.
+///     @par
+///     Unlike the other statistics, these are not affected by ak_reset_application_stats().
+ak_startup_stats ak_get_startup_stats(ak_application* pApplication);
+
+/// Sets whether or not a summary of the startup timings is logged when startup completes.
+///
+/// @remarks
+///     This is disabled by default. The summary is logged at the info level with the AK_LOG_CATEGORY_STARTUP category.
+///     This must be called before ak_run_application() to have any effect.
+void ak_set_log_startup_summary(ak_application* pApplication, bool enabled);
+
+
+/// Starts recording a trace of the application.
+///
+/// @remarks
+///     The trace is written to a file called "<application name><n>.trace.json" in the same folder as the log file,
+///     where <n> is the same kind of number that is used for the log file. The file is in the Chrome trace event
+///     format and can be opened with chrome://tracing or Perfetto.
+///     @par
+///     Events are buffered in memory and only written when tracing is stopped. Tracing is stopped automatically when
+///     the application is deleted.
+///     @par
+///     Returns false if tracing has already been started or the file could not be opened.
+bool ak_start_tracing(ak_application* pApplication);
+
+/// Stops recording a trace of the application and writes it to the trace file.
+void ak_stop_tracing(ak_application* pApplication);
+
+/// Determines whether or not a trace is being recorded.
+bool ak_is_tracing(ak_application* pApplication);
+
+/// Marks the beginning of a traced scope.
+///
+/// @remarks
+///     The return value is the time the scope began, or 0 if tracing is disabled. This should be passed to
+///     ak_trace_end() when the scope ends.
+///     @par
+///     This can be called from any thread.
+uint64_t ak_trace_begin(ak_application* pApplication);
+
+/// Marks the end of a traced scope that was started with ak_trace_begin().
+///
+/// @remarks
+///     <name> and <category> are not copied, so they should be string literals. <detail> is copied, but truncated to
+///     AK_MAX_TRACE_DETAIL_LENGTH characters, and can be null.
+///     @par
+///     This does nothing if <beginTime> is 0, which is what ak_trace_begin() returns when tracing is disabled.
+void ak_trace_end(ak_application* pApplication, uint64_t beginTime, const char* name, const char* category, const char* detail);
+
 
 #ifdef __cplusplus
 }
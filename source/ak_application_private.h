@@ -9,6 +9,42 @@ extern "C" {
 
 typedef struct ak_application ak_application;
 typedef struct ak_window ak_window;
+typedef struct ak_panel_type_atom ak_panel_type_atom;
+typedef struct ak_placeholder_queue ak_placeholder_queue;
+
+struct ak_panel_type_atom
+{
+    /// The hash of the type string.
+    uint32_t hash;
+
+    /// The atom of the parent type. For "My.Panel.Type" this is the atom for "My.Panel". This is null for types without
+    /// a dot.
+    ak_panel_type_atom* pParent;
+
+    /// The first atom whose parent is this one.
+    ak_panel_type_atom* pFirstChild;
+
+    /// The next atom with the same parent.
+    ak_panel_type_atom* pNextSibling;
+
+    /// The first panel in the main hierarchy with exactly this type. The rest are linked through the panels themselves.
+    drgui_element* pFirstPanel;
+
+    /// The last panel in the main hierarchy with exactly this type.
+    drgui_element* pLastPanel;
+
+    /// The type string. This is allocated along with the atom.
+    char type[1];
+};
+
+struct ak_placeholder_queue
+{
+    /// The placeholder that will be replaced with it's real tool next. The rest are linked through the tools themselves.
+    drgui_element* pFirstTool;
+
+    /// The placeholder that was queued most recently.
+    drgui_element* pLastTool;
+};
 
 
 /// Retrieves the first window in the main linked list.
@@ -112,11 +148,124 @@ void ak_application_track_top_level_window(ak_window* pWindow);
 ///     This is called by delete_window().
 void ak_application_untrack_top_level_window(ak_window* pWindow);
 
+/// Adds the given window to the application's name index.
+///
+/// @remarks
+///     This is called when a window is added to the window tree and after it's been renamed. Top level windows are
+///     indexed by ak_application_track_top_level_window().
+void ak_application_index_window(ak_window* pWindow);
+
+/// Removes the given window from the application's name index.
+///
+/// @remarks
+///     This is called when a window is removed from the window tree and before it's renamed. This does nothing if the
+///     window is not in the index.
+void ak_application_unindex_window(ak_window* pWindow);
+
 
-/// Hides every popup window that is not an ancestor of the given window.
+/// Adds the given popup window to the set of visible popups.
+///
+/// @remarks
+///     This is called by ak_application_on_show_window() and does nothing if the window is already in the set.
+void ak_application_track_visible_popup(ak_window* pWindow);
+
+/// Removes the given window from the set of visible popups.
+///
+/// @remarks
+///     This is called when a window is hidden or deleted. This does nothing if the window is not in the set.
+void ak_application_untrack_visible_popup(ak_window* pWindow);
+
+/// Hides every visible popup window that is not an ancestor of the given window.
 void ak_application_hide_non_ancestor_popups(ak_window* pWindow);
 
 
+/// Retrieves the atom for the given panel type, creating it if it does not already exist.
+///
+/// @remarks
+///     Atoms are never deleted while the application is alive, so the returned pointer can be held onto.
+ak_panel_type_atom* ak_application_intern_panel_type(ak_application* pApplication, const char* type);
+
+/// Retrieves the atom for the given panel type, or null if no panel has ever had that type.
+ak_panel_type_atom* ak_application_find_panel_type(ak_application* pApplication, const char* type);
+
+
+/// Calculates a 32-bit FNV-1a hash of the given string.
+uint32_t ak_hash_string(const char* str);
+
+/// Calculates a 32-bit FNV-1a hash of the given string, which does not need to be null terminated.
+///
+/// @remarks
+///     This gives the same result as ak_hash_string() for the same characters.
+uint32_t ak_hash_string_n(const char* str, size_t length);
+
+
+/// Interns the given tool type so it can be used as the scope of action handlers.
+///
+/// @remarks
+///     This returns 0 if <type> is null or empty.
+uint32_t ak_application_intern_tool_type(ak_application* pApplication, const char* type);
+
+/// Calls the handler for the given action for the given tool type or the nearest of it's base types.
+///
+/// @remarks
+///     This returns false if there is no handler, in which case the caller should fall back to the tool's own handler.
+bool ak_application_handle_tool_action(ak_application* pApplication, drgui_element* pTool, uint32_t toolTypeID, ak_action_id actionID);
+
+/// Retrieves a counter that is incremented whenever a shortcut is bound or the shortcuts are cleared.
+///
+/// @remarks
+///     This is used by menus to know when the shortcut text of their items needs to be regenerated.
+unsigned int ak_application_get_shortcut_generation(ak_application* pApplication);
+
+
+/// Retrieves a pointer to the running totals of the statistics of every window.
+///
+/// @remarks
+///     This is updated by the window alongside it's own statistics.
+ak_window_stats* ak_get_application_window_stats_totals(ak_application* pApplication);
+
+/// Retrieves the queue of placeholder tools that are waiting to be replaced with their real tool in the background.
+///
+/// @remarks
+///     This is maintained by tools as placeholders are attached to and detached from panels.
+ak_placeholder_queue* ak_get_application_placeholder_queue(ak_application* pApplication);
+
+/// Called by a tool when it's been added to the application's placeholder queue.
+void ak_application_on_placeholder_queued(ak_application* pApplication);
+
+/// Counts a panel layout against the application's statistics.
+void ak_application_count_panel_layout(ak_application* pApplication);
+
+
+/// Records a trace event for which the begin and end times are already known.
+///
+/// @remarks
+///     This does nothing if tracing is disabled. See ak_trace_end() for the rules on <name>, <category> and <detail>.
+void ak_trace_record(ak_application* pApplication, const char* name, const char* category, const char* detail, uint64_t beginTime, uint64_t endTime);
+
+
+/// Determines whether or not a batch update is in progress.
+///
+/// @remarks
+///     Windows do not update their layout while this returns true.
+bool ak_application_is_in_batch_update(ak_application* pApplication);
+
+
+/// Called by a window whenever it has finished painting.
+///
+/// @remarks
+///     This is used for detecting the first paint of the primary window which marks the end of startup.
+void ak_application_on_window_painted(ak_window* pWindow, uint64_t paintEndTime);
+
+
+/// Retrieves the path of a new file to write the state of a hibernated tool to.
+///
+/// @remarks
+///     This returns false if the application does not have a hibernation folder, in which case the state should be
+///     kept in memory.
+bool ak_application_get_tool_hibernation_file_path(ak_application* pApplication, char* pathOut, size_t pathOutSize);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,14 +19,6 @@
 #define AK_MAX_WINDOW_TITLE_LENGTH      128
 #endif
 
-#ifndef AK_MAX_LAYOUT_NAME_LENGTH
-#define AK_MAX_LAYOUT_NAME_LENGTH       64
-#endif
-
-#ifndef AK_MAX_LAYOUT_ATTRIB_LENGTH
-#define AK_MAX_LAYOUT_ATTRIB_LENGTH     256
-#endif
-
 #ifndef AK_MAX_PANEL_TYPE_LENGTH
 #define AK_MAX_PANEL_TYPE_LENGTH        64
 #endif
@@ -35,6 +27,90 @@
 #define AK_MAX_TOOL_TYPE_LENGTH         64
 #endif
 
+#ifndef AK_MAX_TOOL_ATTRIBUTES_LENGTH
+#define AK_MAX_TOOL_ATTRIBUTES_LENGTH   256
+#endif
+
+#ifndef AK_MAX_SHORTCUT_LENGTH
+#define AK_MAX_SHORTCUT_LENGTH          64
+#endif
+
+#ifndef AK_MAX_ACTION_NAME_LENGTH
+#define AK_MAX_ACTION_NAME_LENGTH       128
+#endif
+
+// The size in bytes of each block of memory holding a config's layout items and strings. Anything bigger than this gets
+// a block of it's own.
+#ifndef AK_CONFIG_BLOCK_SIZE
+#define AK_CONFIG_BLOCK_SIZE            16384
+#endif
+
+// The number of worker threads owned by each application. When set to 0, the number of logical processors is used.
+#ifndef AK_WORKER_THREAD_COUNT
+#define AK_WORKER_THREAD_COUNT          0
+#endif
+
+// The default window in milliseconds within which timer deadlines are coalesced so they can be fired together.
+#ifndef AK_DEFAULT_TIMER_SLACK
+#define AK_DEFAULT_TIMER_SLACK          2
+#endif
+
+// The interval in milliseconds at which the application checks for tools to hibernate when a hibernation policy is set.
+#ifndef AK_TOOL_HIBERNATION_CHECK_INTERVAL
+#define AK_TOOL_HIBERNATION_CHECK_INTERVAL  30000
+#endif
+
+// Log levels. Messages below AK_MIN_LOG_LEVEL are compiled out entirely when posted with the ak_log_trace(), ak_log_debug(),
+// etc. family of macros. Messages below the application's run-time level (see ak_set_log_level()) are discarded before
+// any formatting takes place.
+#define AK_LOG_LEVEL_TRACE              0
+#define AK_LOG_LEVEL_DEBUG              1
+#define AK_LOG_LEVEL_INFO               2
+#define AK_LOG_LEVEL_WARNING            3
+#define AK_LOG_LEVEL_ERROR              4
+
+#ifndef AK_MIN_LOG_LEVEL
+#define AK_MIN_LOG_LEVEL                AK_LOG_LEVEL_TRACE
+#endif
+
+#ifndef AK_DEFAULT_LOG_LEVEL
+#define AK_DEFAULT_LOG_LEVEL            AK_LOG_LEVEL_INFO
+#endif
+
+// The number of entries in the log's ring buffer. This must be a power of 2.
+#ifndef AK_LOG_RING_BUFFER_SIZE
+#define AK_LOG_RING_BUFFER_SIZE         256
+#endif
+
+// The maximum length of a log message, including it's level and category tags and the null terminator. This is the size
+// of each entry in the log's ring buffer. Longer messages are truncated.
+#ifndef AK_MAX_LOG_MESSAGE_LENGTH
+#define AK_MAX_LOG_MESSAGE_LENGTH       4096
+#endif
+
+#ifndef AK_DEFAULT_LOG_FLUSH_INTERVAL
+#define AK_DEFAULT_LOG_FLUSH_INTERVAL   250
+#endif
+
+#ifndef AK_DEFAULT_LOG_FLUSH_THRESHOLD
+#define AK_DEFAULT_LOG_FLUSH_THRESHOLD  16384
+#endif
+
+// The number of events in each chunk of a thread's trace buffer.
+#ifndef AK_TRACE_CHUNK_SIZE
+#define AK_TRACE_CHUNK_SIZE             1024
+#endif
+
+// The interval in milliseconds at which recorded trace events are written to the trace file while tracing.
+#ifndef AK_TRACE_DRAIN_INTERVAL
+#define AK_TRACE_DRAIN_INTERVAL         1000
+#endif
+
+// The maximum length of the detail string attached to a trace event, including the null terminator. Longer strings are truncated.
+#ifndef AK_MAX_TRACE_DETAIL_LENGTH
+#define AK_MAX_TRACE_DETAIL_LENGTH      48
+#endif
+
 
 
 
@@ -45,7 +121,15 @@
 //
 // This section should not be configured by hand, unless it's for the development of the library itself.
 
+// AK_USE_HEADLESS can be defined before including dr_appkit.h to run without a windowing system. Windows are drawn to
+// in-memory surfaces and events are injected through the ak_headless_*() APIs. This uses dr_2d's cairo back end.
+#if defined(AK_USE_HEADLESS)
 #if defined(_WIN32)
+#define AK_USE_WIN32_THREADS
+#else
+#define AK_USE_POSIX_THREADS
+#endif
+#elif defined(_WIN32)
 #define AK_USE_WIN32
 #define AK_USE_WIN32_THREADS
 #elif defined(__APPLE__) && defined(__MACH__)
@@ -135,6 +135,54 @@ void ak_clipboard_free_text(char* text)
 #endif
 
 
+#ifdef AK_USE_HEADLESS
+// There is no system clipboard when running headless so we just keep a copy of the text in memory. This is only
+// visible to the running process.
+static char* g_AKHeadlessClipboardText = NULL;
+
+bool ak_clipboard_set_text(const char* text, size_t textLength)
+{
+    if (textLength == (size_t)-1) {
+        textLength = strlen(text);
+    }
+
+    char* newText = malloc(textLength + 1);
+    if (newText == NULL) {
+        return false;
+    }
+
+    memcpy(newText, text, textLength);
+    newText[textLength] = '\0';
+
+    free(g_AKHeadlessClipboardText);
+    g_AKHeadlessClipboardText = newText;
+
+    return true;
+}
+
+char* ak_clipboard_get_text()
+{
+    if (g_AKHeadlessClipboardText == NULL) {
+        return NULL;
+    }
+
+    size_t textLength = strlen(g_AKHeadlessClipboardText);
+    char* result = malloc(textLength + 1);
+    if (result == NULL) {
+        return NULL;
+    }
+
+    memcpy(result, g_AKHeadlessClipboardText, textLength + 1);
+    return result;
+}
+
+void ak_clipboard_free_text(char* text)
+{
+    free(text);
+}
+#endif
+
+
 /*
 This is free and unencumbered software released into the public domain.
 
@@ -1,36 +1,247 @@
 // Public domain. See "unlicense" statement at the end of this file.
 
+struct ak_config_block
+{
+    /// The block that was allocated before this one.
+    ak_config_block* pPrevBlock;
+
+    /// The size in bytes of the block's data, which comes straight after this structure.
+    size_t size;
+
+    /// The number of bytes of the block's data that have been allocated.
+    size_t used;
+};
+
+struct ak_config_lazy_layout
+{
+    /// The root level layout item. This has no children until it's been loaded.
+    ak_layout* pLayout;
+
+    /// The offset in the script of the line after the one that opened the layout.
+    size_t offset;
+
+    /// The size in bytes of the layout's contents. This includes the closing tag, if there is one, so that it's
+    /// validated when the layout is parsed.
+    size_t size;
+
+    /// The line number of the line at <offset>. This is used for error reporting.
+    unsigned int firstLine;
+
+    /// Whether or not the layout has been parsed.
+    bool isLoaded;
+
+    /// Whether or not an error was found when the layout was parsed.
+    bool hasError;
+};
+
+// Allocates memory from the given config's blocks. This memory is not freed until the config is uninitialized.
+static void* ak_config_alloc(ak_config* pConfig, size_t size, size_t alignment)
+{
+    assert(pConfig != NULL);
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    ak_config_block* pBlock = pConfig->pCurrentBlock;
+    if (pBlock != NULL)
+    {
+        size_t offset = (pBlock->used + (alignment - 1)) & ~(alignment - 1);
+        if (offset + size <= pBlock->size) {
+            pBlock->used = offset + size;
+            return (char*)(pBlock + 1) + offset;
+        }
+    }
+
+
+    // If we get here there's not enough room in the current block. Large allocations get a block of their own which is
+    // put behind the current one so that the space left in the current one can still be used.
+    bool isDedicated = size > AK_CONFIG_BLOCK_SIZE / 4;
+
+    size_t blockSize = isDedicated ? size : AK_CONFIG_BLOCK_SIZE;
+    ak_config_block* pNewBlock = malloc(sizeof(*pNewBlock) + blockSize);
+    if (pNewBlock == NULL) {
+        return NULL;
+    }
+
+    pNewBlock->size = blockSize;
+    pNewBlock->used = size;
+
+    if (isDedicated && pBlock != NULL) {
+        pNewBlock->pPrevBlock = pBlock->pPrevBlock;
+        pBlock->pPrevBlock = pNewBlock;
+    } else {
+        pNewBlock->pPrevBlock = pBlock;
+        pConfig->pCurrentBlock = pNewBlock;
+    }
+
+    return pNewBlock + 1;
+}
+
+// Looks up the slot for the given string. If the string has not been interned, the returned slot is the empty one it
+// would go in. The string does not need to be null terminated.
+static const char** ak_config_find_string_slot(ak_config* pConfig, const char* str, size_t length, uint32_t hash)
+{
+    assert(pConfig != NULL);
+    assert(pConfig->stringTableCapacity > 0);
+
+    size_t mask = pConfig->stringTableCapacity - 1;
+
+    size_t i = hash & mask;
+    while (pConfig->ppStrings[i] != NULL)
+    {
+        if (strncmp(pConfig->ppStrings[i], str, length) == 0 && pConfig->ppStrings[i][length] == '\0') {
+            break;
+        }
+
+        i = (i + 1) & mask;
+    }
+
+    return &pConfig->ppStrings[i];
+}
+
+// Retrieves the config's null terminated copy of the given string, adding it if it's not already there. Returns null if
+// we run out of memory.
+static const char* ak_config_intern_string(ak_config* pConfig, const char* str, size_t length)
+{
+    assert(pConfig != NULL);
+    assert(str     != NULL);
+
+    if (length == 0) {
+        return "";
+    }
+
+    // Keep the table at most 3/4 full.
+    if ((pConfig->stringCount + 1) * 4 > pConfig->stringTableCapacity * 3)
+    {
+        size_t newCapacity = (pConfig->stringTableCapacity == 0) ? 64 : pConfig->stringTableCapacity * 2;
+        const char** ppNewStrings = calloc(newCapacity, sizeof(*ppNewStrings));
+        if (ppNewStrings == NULL) {
+            return NULL;
+        }
+
+        const char** ppOldStrings = pConfig->ppStrings;
+        size_t oldCapacity = pConfig->stringTableCapacity;
+
+        pConfig->ppStrings           = ppNewStrings;
+        pConfig->stringTableCapacity = newCapacity;
+
+        for (size_t i = 0; i < oldCapacity; ++i)
+        {
+            if (ppOldStrings[i] != NULL) {
+                size_t oldLength = strlen(ppOldStrings[i]);
+                *ak_config_find_string_slot(pConfig, ppOldStrings[i], oldLength, ak_hash_string_n(ppOldStrings[i], oldLength)) = ppOldStrings[i];
+            }
+        }
+
+        free(ppOldStrings);
+    }
+
+
+    const char** ppSlot = ak_config_find_string_slot(pConfig, str, length, ak_hash_string_n(str, length));
+    if (*ppSlot != NULL) {
+        return *ppSlot;
+    }
+
+    char* pCopy = ak_config_alloc(pConfig, length + 1, 1);
+    if (pCopy == NULL) {
+        return NULL;
+    }
+
+    memcpy(pCopy, str, length);
+    pCopy[length] = '\0';
+
+    *ppSlot = pCopy;
+    pConfig->stringCount += 1;
+
+    return pCopy;
+}
+
+
+typedef struct
+{
+    /// A pointer to the start of the string. This is not null terminated.
+    const char* str;
+
+    /// The length of the string.
+    size_t length;
+
+} ak_config_slice;
+
+static bool ak_config_slice_equals(ak_config_slice slice, const char* str)
+{
+    return strncmp(slice.str, str, slice.length) == 0 && str[slice.length] == '\0';
+}
+
+// Copies the given slice to a null terminated buffer, truncating it if it's too long.
+static void ak_config_slice_copy(ak_config_slice slice, char* dst, size_t dstSize)
+{
+    assert(dst != NULL);
+    assert(dstSize > 0);
+
+    size_t length = (slice.length < dstSize) ? slice.length : dstSize - 1;
+    memcpy(dst, slice.str, length);
+    dst[length] = '\0';
+}
+
+static bool ak_config_is_whitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
 /// Determines whether or not the given string is a layout item tag.
-static bool ak_is_layout_item_tag(const char* tag)
+static bool ak_is_layout_item_tag(ak_config_slice tag)
 {
     return
-        strcmp(tag, AK_LAYOUT_TYPE_LAYOUT) == 0 ||
-        strcmp(tag, AK_LAYOUT_TYPE_WINDOW) == 0 ||
-        strcmp(tag, AK_LAYOUT_TYPE_PANEL)  == 0 ||
-        strcmp(tag, AK_LAYOUT_TYPE_TOOL)   == 0;
+        ak_config_slice_equals(tag, AK_LAYOUT_TYPE_LAYOUT) ||
+        ak_config_slice_equals(tag, AK_LAYOUT_TYPE_WINDOW) ||
+        ak_config_slice_equals(tag, AK_LAYOUT_TYPE_PANEL)  ||
+        ak_config_slice_equals(tag, AK_LAYOUT_TYPE_TOOL);
 }
 
-typedef struct
+// Creates a layout item whose type and attributes are not null terminated.
+static ak_layout* ak_config_create_layout_from_slices(ak_config* pConfig, ak_config_slice type, ak_config_slice attributes, ak_layout* pParent)
 {
-    /// A pointer to the file to read from. Null if the file is not being used for parsing.
-    drfs_file* pFile;
+    assert(pConfig != NULL);
+
+    ak_layout* pLayout = ak_config_alloc(pConfig, sizeof(*pLayout), sizeof(void*));
+    if (pLayout == NULL) {
+        return NULL;
+    }
 
-    /// The string to read the script from. Not used if the script is being read from the file.
-    const char* configString;
+    pLayout->type       = ak_config_intern_string(pConfig, type.str, type.length);
+    pLayout->attributes = ak_config_intern_string(pConfig, attributes.str, attributes.length);
+    if (pLayout->type == NULL || pLayout->attributes == NULL) {
+        return NULL;
+    }
 
-    /// The size of the config string. Not used if script is being read from a file instead of the string.
-    size_t configStringLength;
+    pLayout->pParent      = NULL;
+    pLayout->pFirstChild  = NULL;
+    pLayout->pLastChild   = NULL;
+    pLayout->pNextSibling = NULL;
+    pLayout->pPrevSibling = NULL;
 
+    if (pParent != NULL) {
+        ak_append_layout(pLayout, pParent);
+    }
+
+    return pLayout;
+}
 
+typedef struct
+{
     /// A pointer to the config object to load the data into.
     ak_config* pConfig;
 
     /// A pointer to the layout object that's currently getting parsed.
     ak_layout* pCurrentLayout;
 
+    /// The line that's currently being parsed, starting at 1. This is used for error reporting.
+    unsigned int currentLine;
+
     /// Tracks whether or not an error has been found.
     bool foundError;
 
+    /// Whether or not root level layouts should be recorded to be parsed later rather than being parsed now.
+    bool isIndexing;
+
     /// The function to call when an error occurs.
     ak_on_config_error_proc onError;
 
@@ -39,68 +250,82 @@ typedef struct
 
 } ak_config_parse_context;
 
-static size_t ak_config_on_read_from_file_proc(void* pUserData, void* pDataOut, size_t bytesToRead)
+static void ak_config_on_error(ak_config_parse_context* pContext, const char* message)
 {
-    ak_config_parse_context* pContext = pUserData;
     assert(pContext != NULL);
 
-    size_t bytesRead;
-    if (drfs_read(pContext->pFile, pDataOut, bytesToRead, &bytesRead) == drfs_success) {
-        return bytesRead;
-    }
+    if (pContext->onError)
+    {
+        char msg[4096];
+        snprintf(msg, sizeof(msg), "(Line %u) %s", pContext->currentLine, message);
 
-    return 0;
+        pContext->onError(pContext->pOnErrorUserData, msg);
+    }
 }
 
-static size_t ak_config_on_read_from_string_proc(void* pUserData, void* pDataOut, size_t bytesToRead)
+static void ak_config_on_pair(ak_config_parse_context* pContext, ak_config_slice key, ak_config_slice value)
 {
-    ak_config_parse_context* pContext = pUserData;
     assert(pContext != NULL);
 
-    if (bytesToRead > pContext->configStringLength) {
-        bytesToRead = pContext->configStringLength;
+    // If we've previously found an error, just skip everything.
+    if (pContext->foundError) {
+        return;
     }
 
-    if (bytesToRead > 0)
-    {
-        memcpy(pDataOut, pContext->configString, bytesToRead);
 
-        pContext->configString       += bytesToRead;
-        pContext->configStringLength -= bytesToRead;
+    if (ak_config_slice_equals(key, "InitialLayout"))
+    {
+        ak_config_slice_copy(value, pContext->pConfig->currentLayoutName, sizeof(pContext->pConfig->currentLayoutName));
+        return;
     }
 
-    return bytesToRead;
-}
+    if (ak_config_slice_equals(key, "Shortcut"))
+    {
+        // This is rare enough that it's not worth tokenizing the slice directly.
+        char valueStr[AK_MAX_SHORTCUT_LENGTH + AK_MAX_ACTION_NAME_LENGTH + 8];
+        ak_config_slice_copy(value, valueStr, sizeof(valueStr));
+
+        ak_config_shortcut shortcut;
+        const char* nextValue = dr_next_token(valueStr, shortcut.keys, sizeof(shortcut.keys));
+        if (nextValue != NULL) {
+            nextValue = dr_next_token(nextValue, shortcut.actionName, sizeof(shortcut.actionName));
+        }
 
-static void ak_config_on_pair(void* pUserData, const char* key, const char* value)
-{
-    //printf("PAIR: [%s] [%s]\n", key, value);
+        if (nextValue == NULL)
+        {
+            ak_config_on_error(pContext, "Shortcut is missing it's keys or action.");
+            return;     // Not fatal. The shortcut is just skipped.
+        }
 
-    ak_config_parse_context* pContext = pUserData;
-    assert(pContext != NULL);
+        ak_config* pConfig = pContext->pConfig;
+        if (pConfig->shortcutCount == pConfig->shortcutBufferSize)
+        {
+            size_t newBufferSize = (pConfig->shortcutBufferSize == 0) ? 16 : pConfig->shortcutBufferSize * 2;
+            ak_config_shortcut* pNewShortcuts = realloc(pConfig->pShortcuts, newBufferSize * sizeof(*pNewShortcuts));
+            if (pNewShortcuts == NULL)
+            {
+                ak_config_on_error(pContext, "Failed to allocate memory for shortcut.");
+                pContext->foundError = true;
+                return;
+            }
 
-    // If we've previously found an error, just skip everything.
-    if (pContext->foundError) {
-        return;
-    }
+            pConfig->pShortcuts         = pNewShortcuts;
+            pConfig->shortcutBufferSize = newBufferSize;
+        }
 
+        pConfig->pShortcuts[pConfig->shortcutCount] = shortcut;
+        pConfig->shortcutCount += 1;
 
-    if (strcmp(key, "InitialLayout") == 0)
-    {
-        strcpy_s(pContext->pConfig->currentLayoutName, sizeof(pContext->pConfig->currentLayoutName), value);
         return;
     }
 
     if (ak_is_layout_item_tag(key))
     {
         // We're starting a new layout item.
-        ak_layout* pNewLayout = ak_create_layout(key, value, pContext->pCurrentLayout);
+        ak_layout* pNewLayout = ak_config_create_layout_from_slices(pContext->pConfig, key, value, pContext->pCurrentLayout);
         if (pNewLayout == NULL)
         {
-            if (pContext->onError) {
-                pContext->onError(pContext->pOnErrorUserData, "Failed to allocate memory for layout object.");
-            }
-
+            ak_config_on_error(pContext, "Failed to allocate memory for layout object.");
             pContext->foundError = true;
             return;
         }
@@ -110,24 +335,24 @@ static void ak_config_on_pair(void* pUserData, const char* key, const char* valu
         return;
     }
 
-    if (key[0] == '/')
+    if (key.str[0] == '/')
     {
         // We're ending a layout item. We want to do a validation step here. If it's a mismatched tag we need to fail.
-        if (ak_is_layout_item_tag(key + 1))
+        ak_config_slice tag;
+        tag.str    = key.str + 1;
+        tag.length = key.length - 1;
+
+        if (ak_is_layout_item_tag(tag))
         {
             if (pContext->pCurrentLayout != NULL)
             {
                 // Validation.
-                if (strcmp(pContext->pCurrentLayout->type, key + 1) != 0)
+                if (!ak_config_slice_equals(tag, pContext->pCurrentLayout->type))
                 {
                     // Tag mismatch.
-                    if (pContext->onError)
-                    {
-                        char msg[4096];
-                        snprintf(msg, sizeof(msg), "Tag mismatch. Expecting /%s but got %s", pContext->pCurrentLayout->type, key);
-
-                        pContext->onError(pContext->pOnErrorUserData, msg);
-                    }
+                    char msg[256];
+                    snprintf(msg, sizeof(msg), "Tag mismatch. Expecting /%s but got %.*s", pContext->pCurrentLayout->type, (int)key.length, key.str);
+                    ak_config_on_error(pContext, msg);
 
                     pContext->foundError = true;
                     return;
@@ -143,76 +368,354 @@ static void ak_config_on_pair(void* pUserData, const char* key, const char* valu
     }
 }
 
-static void ak_config_on_error(void* pUserData, const char* message, unsigned int line)
+// Retrieves the key of the line running from pLine to pLineEnd. Returns false if the line is blank or entirely a
+// comment. On output, pValueStart points to the first character after the key.
+static bool ak_config_get_line_key(const char* pLine, const char* pLineEnd, ak_config_slice* pKeyOut, const char** pValueStartOut)
+{
+    assert(pKeyOut != NULL);
+    assert(pValueStartOut != NULL);
+
+    const char* pChar = pLine;
+    while (pChar < pLineEnd && ak_config_is_whitespace(*pChar)) {
+        pChar += 1;
+    }
+
+    if (pChar == pLineEnd || *pChar == '#') {
+        return false;
+    }
+
+    pKeyOut->str = pChar;
+    while (pChar < pLineEnd && !ak_config_is_whitespace(*pChar) && *pChar != '#') {
+        pChar += 1;
+    }
+    pKeyOut->length = (size_t)(pChar - pKeyOut->str);
+
+    *pValueStartOut = pChar;
+    return true;
+}
+
+// Retrieves the value of a line, given the first character after the key. The value is the rest of the line, minus any
+// leading and trailing whitespace. A '#' starts a comment, unless it's inside a double-quoted string.
+static ak_config_slice ak_config_get_line_value(const char* pValueStart, const char* pLineEnd)
+{
+    const char* pChar = pValueStart;
+    while (pChar < pLineEnd && ak_config_is_whitespace(*pChar)) {
+        pChar += 1;
+    }
+
+    ak_config_slice value;
+    value.str = pChar;
+
+    bool isInString = false;
+    while (pChar < pLineEnd && (isInString || *pChar != '#'))
+    {
+        if (*pChar == '"') {
+            isInString = !isInString;
+        }
+
+        pChar += 1;
+    }
+
+    while (pChar > value.str && ak_config_is_whitespace(pChar[-1])) {
+        pChar -= 1;
+    }
+    value.length = (size_t)(pChar - value.str);
+
+    return value;
+}
+
+// Retrieves the end of the line starting at pLine, which is either the new-line character or the end of the data.
+static const char* ak_config_find_line_end(const char* pLine, const char* pEnd)
+{
+    const char* pLineEnd = memchr(pLine, '\n', (size_t)(pEnd - pLine));
+    if (pLineEnd == NULL) {
+        pLineEnd = pEnd;
+    }
+
+    return pLineEnd;
+}
+
+// Records a root level layout without parsing it. pBody points to the line after the one that opened the layout. This
+// returns a pointer to the line after the layout's closing tag.
+static const char* ak_config_defer_layout(ak_config_parse_context* pContext, ak_config_slice key, ak_config_slice value, const char* pBody, const char* pEnd)
 {
-    ak_config_parse_context* pContext = pUserData;
     assert(pContext != NULL);
 
-    if (pContext->onError)
+    ak_config* pConfig = pContext->pConfig;
+    if (pConfig->lazyLayoutCount == pConfig->lazyLayoutBufferSize)
     {
-        char msg[4096];
-        snprintf(msg, sizeof(msg), "(Line %d) %s", line, message);
+        size_t newBufferSize = (pConfig->lazyLayoutBufferSize == 0) ? 16 : pConfig->lazyLayoutBufferSize * 2;
+        ak_config_lazy_layout* pNewLazyLayouts = realloc(pConfig->pLazyLayouts, newBufferSize * sizeof(*pNewLazyLayouts));
+        if (pNewLazyLayouts == NULL) {
+            ak_config_on_error(pContext, "Failed to allocate memory for layout object.");
+            pContext->foundError = true;
+            return pEnd;
+        }
 
-        pContext->onError(pContext->pOnErrorUserData, msg);
+        pConfig->pLazyLayouts         = pNewLazyLayouts;
+        pConfig->lazyLayoutBufferSize = newBufferSize;
+    }
+
+    ak_layout* pLayout = ak_config_create_layout_from_slices(pConfig, key, value, pConfig->pRootLayout);
+    if (pLayout == NULL) {
+        ak_config_on_error(pContext, "Failed to allocate memory for layout object.");
+        pContext->foundError = true;
+        return pEnd;
+    }
+
+
+    // The only thing we care about on this pass is where the layout ends, so only Layout tags are looked at. Anything
+    // else, including mismatched tags, is dealt with when the layout is parsed properly.
+    unsigned int firstLine = pContext->currentLine + 1;
+    unsigned int depth = 1;
+
+    const char* pLine = pBody;
+    const char* pBodyEnd = pEnd;
+    while (pLine < pEnd)
+    {
+        const char* pLineEnd = ak_config_find_line_end(pLine, pEnd);
+        pContext->currentLine += 1;
+
+        ak_config_slice lineKey;
+        const char* pValueStart;
+        if (ak_config_get_line_key(pLine, pLineEnd, &lineKey, &pValueStart))
+        {
+            if (ak_config_slice_equals(lineKey, AK_LAYOUT_TYPE_LAYOUT)) {
+                depth += 1;
+            } else if (ak_config_slice_equals(lineKey, "/" AK_LAYOUT_TYPE_LAYOUT)) {
+                depth -= 1;
+            }
+
+            if (depth == 0) {
+                pBodyEnd = pLineEnd;
+                pLine = pLineEnd + 1;
+                break;
+            }
+        }
+
+        pLine = pLineEnd + 1;
     }
+
+
+    ak_config_lazy_layout* pLazyLayout = &pConfig->pLazyLayouts[pConfig->lazyLayoutCount];
+    pLazyLayout->pLayout   = pLayout;
+    pLazyLayout->offset    = (pBody < pBodyEnd) ? (size_t)(pBody - pConfig->pSource) : 0;
+    pLazyLayout->size      = (pBody < pBodyEnd) ? (size_t)(pBodyEnd - pBody) : 0;
+    pLazyLayout->firstLine = firstLine;
+    pLazyLayout->isLoaded  = false;
+    pLazyLayout->hasError  = false;
+    pConfig->lazyLayoutCount += 1;
+
+    return pLine;
 }
 
+// Parses a config script that's entirely in memory. The script does not need to be null terminated, but it must not
+// contain any null characters since every string comparison relies on that.
+//
+// Each line is a key/value pair. Keys and values are passed around as slices of the original data, so nothing is
+// copied unless it's stored.
+static void ak_config_parse_buffer(ak_config_parse_context* pContext, const char* pData, size_t dataSize)
+{
+    assert(pContext != NULL);
+    assert(pData != NULL || dataSize == 0);
+
+    const char* pEnd = pData + dataSize;
+    const char* pLine = pData;
 
-bool ak_parse_config_from_file(ak_config* pConfig, drfs_file* pFile, ak_on_config_error_proc onError, void* pOnErrorUserData)
+    while (pLine < pEnd && !pContext->foundError)
+    {
+        const char* pLineEnd = ak_config_find_line_end(pLine, pEnd);
+
+        ak_config_slice key;
+        const char* pValueStart;
+        if (ak_config_get_line_key(pLine, pLineEnd, &key, &pValueStart))
+        {
+            ak_config_slice value = ak_config_get_line_value(pValueStart, pLineEnd);
+
+            if (pContext->isIndexing && pContext->pCurrentLayout == pContext->pConfig->pRootLayout && ak_config_slice_equals(key, AK_LAYOUT_TYPE_LAYOUT))
+            {
+                pLine = ak_config_defer_layout(pContext, key, value, pLineEnd + 1, pEnd);
+                pContext->currentLine += 1;
+                continue;
+            }
+
+            ak_config_on_pair(pContext, key, value);
+        }
+
+        pLine = pLineEnd + 1;
+        pContext->currentLine += 1;
+    }
+}
+
+// Finds the lazily loaded layout that the given root level layout item was created for.
+static ak_config_lazy_layout* ak_config_find_lazy_layout(ak_config* pConfig, ak_layout* pLayout)
 {
-    if (pConfig == NULL || pFile == NULL) {
+    assert(pConfig != NULL);
+
+    for (size_t i = 0; i < pConfig->lazyLayoutCount; ++i)
+    {
+        if (pConfig->pLazyLayouts[i].pLayout == pLayout) {
+            return &pConfig->pLazyLayouts[i];
+        }
+    }
+
+    return NULL;
+}
+
+static bool ak_config_load_lazy_layout(ak_config* pConfig, ak_config_lazy_layout* pLazyLayout)
+{
+    assert(pConfig != NULL);
+    assert(pLazyLayout != NULL);
+
+    if (pLazyLayout->isLoaded) {
+        return !pLazyLayout->hasError;
+    }
+
+    assert(pConfig->pSource != NULL || pLazyLayout->size == 0);
+
+    ak_config_parse_context context;
+    memset(&context, 0, sizeof(context));
+    context.pConfig          = pConfig;
+    context.pCurrentLayout   = pLazyLayout->pLayout;
+    context.currentLine      = pLazyLayout->firstLine;
+    context.onError          = pConfig->onError;
+    context.pOnErrorUserData = pConfig->pOnErrorUserData;
+    ak_config_parse_buffer(&context, pConfig->pSource + pLazyLayout->offset, pLazyLayout->size);
+
+    pLazyLayout->isLoaded = true;
+    pLazyLayout->hasError = context.foundError;
+
+    return !pLazyLayout->hasError;
+}
+
+// Frees the copy of the script if every layout has been loaded.
+static void ak_config_release_source_if_unused(ak_config* pConfig)
+{
+    assert(pConfig != NULL);
+
+    for (size_t i = 0; i < pConfig->lazyLayoutCount; ++i)
+    {
+        if (!pConfig->pLazyLayouts[i].isLoaded) {
+            return;
+        }
+    }
+
+    free(pConfig->pSource);
+    pConfig->pSource = NULL;
+}
+
+bool ak_parse_config_from_buffer(ak_config* pConfig, char* pData, size_t dataSize, ak_on_config_error_proc onError, void* pOnErrorUserData)
+{
+    if (pData == NULL) {
+        return false;
+    }
+
+    if (pConfig == NULL) {
+        free(pData);
         return false;
     }
 
     if (!ak_init_config(pConfig)) {
+        free(pData);
         return false;
     }
 
+    pConfig->pSource          = pData;
+    pConfig->onError          = onError;
+    pConfig->pOnErrorUserData = pOnErrorUserData;
+
+    // A null character is treated as the end of the script.
+    const char* pNull = memchr(pData, '\0', dataSize);
+    if (pNull != NULL) {
+        dataSize = (size_t)(pNull - pData);
+    }
+
 
     ak_config_parse_context context;
     memset(&context, 0, sizeof(context));
-    context.pFile            = pFile;
     context.pConfig          = pConfig;
     context.pCurrentLayout   = pConfig->pRootLayout;
+    context.currentLine      = 1;
+    context.isIndexing       = true;
     context.onError          = onError;
     context.pOnErrorUserData = pOnErrorUserData;
-    dr_parse_key_value_pairs(ak_config_on_read_from_file_proc, ak_config_on_pair, ak_config_on_error, &context);
+    ak_config_parse_buffer(&context, pData, dataSize);
 
     if (context.foundError) {
         ak_uninit_config(pConfig);
         return false;
     }
 
+
+    // The initial layout is the only one that's parsed straight away. If there isn't one by that name, the application
+    // falls back to the first item, so that's the one that's loaded instead.
+    ak_config_lazy_layout* pInitialLayout = NULL;
+    for (size_t i = 0; i < pConfig->lazyLayoutCount; ++i)
+    {
+        if (strcmp(pConfig->pLazyLayouts[i].pLayout->attributes, pConfig->currentLayoutName) == 0) {
+            pInitialLayout = &pConfig->pLazyLayouts[i];
+            break;
+        }
+    }
+
+    if (pInitialLayout == NULL) {
+        pInitialLayout = ak_config_find_lazy_layout(pConfig, pConfig->pRootLayout->pFirstChild);
+    }
+
+    if (pInitialLayout != NULL && !ak_config_load_lazy_layout(pConfig, pInitialLayout)) {
+        ak_uninit_config(pConfig);
+        return false;
+    }
+
+    ak_config_release_source_if_unused(pConfig);
     return true;
 }
 
-bool ak_parse_config_from_string(ak_config* pConfig, const char* configString, ak_on_config_error_proc onError, void* pOnErrorUserData)
+
+bool ak_parse_config_from_file(ak_config* pConfig, drfs_file* pFile, ak_on_config_error_proc onError, void* pOnErrorUserData)
 {
-    if (pConfig == NULL || configString == NULL) {
+    if (pConfig == NULL || pFile == NULL) {
         return false;
     }
 
-    if (!ak_init_config(pConfig)) {
+    // The whole file is read in one go so it can be parsed in place.
+    uint64_t fileSize = drfs_size(pFile);
+    if (fileSize > SIZE_MAX) {
+        return false;
+    }
+
+    char* pData = malloc((fileSize > 0) ? (size_t)fileSize : 1);
+    if (pData == NULL) {
         return false;
     }
 
+    size_t bytesRead;
+    if (drfs_read(pFile, pData, (size_t)fileSize, &bytesRead) != drfs_success) {
+        free(pData);
+        return false;
+    }
 
-    ak_config_parse_context context;
-    memset(&context, 0, sizeof(context));
-    context.configString       = configString;
-    context.configStringLength = (unsigned int)strlen(configString);
-    context.pConfig            = pConfig;
-    context.pCurrentLayout     = pConfig->pRootLayout;
-    context.onError            = onError;
-    context.pOnErrorUserData   = pOnErrorUserData;
-    dr_parse_key_value_pairs(ak_config_on_read_from_string_proc, ak_config_on_pair, NULL, &context);
+    return ak_parse_config_from_buffer(pConfig, pData, bytesRead, onError, pOnErrorUserData);
+}
 
-    if (context.foundError) {
-        ak_uninit_config(pConfig);
+bool ak_parse_config_from_string(ak_config* pConfig, const char* configString, ak_on_config_error_proc onError, void* pOnErrorUserData)
+{
+    if (pConfig == NULL || configString == NULL) {
         return false;
     }
 
-    return true;
+    // The config needs it's own copy in case there are layouts that get parsed later. It's freed straight away if there
+    // aren't any.
+    size_t length = strlen(configString);
+
+    char* pData = malloc(length + 1);
+    if (pData == NULL) {
+        return false;
+    }
+
+    memcpy(pData, configString, length + 1);
+
+    return ak_parse_config_from_buffer(pConfig, pData, length, onError, pOnErrorUserData);
 }
 
 
@@ -224,8 +727,9 @@ bool ak_init_config(ak_config* pConfig)
 
     memset(pConfig, 0, sizeof(*pConfig));
 
-    pConfig->pRootLayout = ak_create_layout(NULL, NULL, NULL);
+    pConfig->pRootLayout = ak_config_create_layout(pConfig, NULL, NULL, NULL);
     if (pConfig->pRootLayout == NULL) {
+        ak_uninit_config(pConfig);
         return false;
     }
 
@@ -238,17 +742,45 @@ void ak_uninit_config(ak_config* pConfig)
         return;
     }
 
-    // The layout object needs to be deleted recursively.
-    ak_delete_layout(pConfig->pRootLayout);
+    // Every layout item and string is freed along with the blocks they were allocated from.
+    ak_config_block* pBlock = pConfig->pCurrentBlock;
+    while (pBlock != NULL)
+    {
+        ak_config_block* pPrevBlock = pBlock->pPrevBlock;
+        free(pBlock);
+        pBlock = pPrevBlock;
+    }
+
+    free(pConfig->ppStrings);
+    free(pConfig->pShortcuts);
+    free(pConfig->pLazyLayouts);
+    free(pConfig->pSource);
 
     // Clear the config to 0.
     memset(pConfig, 0, sizeof(*pConfig));
 }
 
 
+ak_layout* ak_config_create_layout(ak_config* pConfig, const char* type, const char* attributes, ak_layout* pParent)
+{
+    if (pConfig == NULL) {
+        return NULL;
+    }
+
+    ak_config_slice typeSlice;
+    typeSlice.str    = (type != NULL) ? type : "";
+    typeSlice.length = strlen(typeSlice.str);
+
+    ak_config_slice attributesSlice;
+    attributesSlice.str    = (attributes != NULL) ? attributes : "";
+    attributesSlice.length = strlen(attributesSlice.str);
+
+    return ak_config_create_layout_from_slices(pConfig, typeSlice, attributesSlice, pParent);
+}
+
 ak_layout* ak_config_find_root_layout_by_name(ak_config* pConfig, const char* layoutName)
 {
-    if (pConfig != NULL || layoutName == NULL) {
+    if (pConfig == NULL || layoutName == NULL) {
         return NULL;
     }
 
@@ -259,14 +791,58 @@ ak_layout* ak_config_find_root_layout_by_name(ak_config* pConfig, const char* la
     // Only searching root level layouts. The name of a root level layout object is defined by the attribute.
     for (ak_layout* pLayout = pConfig->pRootLayout->pFirstChild; pLayout != NULL; pLayout = pLayout->pNextSibling)
     {
-        if (strcmp(pLayout->type, "Layout") == 0 && strcmp(pLayout->attributes, layoutName) == 0) {
-            return pLayout;
+        if (strcmp(pLayout->type, AK_LAYOUT_TYPE_LAYOUT) == 0 && strcmp(pLayout->attributes, layoutName) == 0) {
+            return ak_config_load_layout(pConfig, pLayout) ? pLayout : NULL;
         }
     }
 
     return NULL;
 }
 
+bool ak_config_load_layout(ak_config* pConfig, ak_layout* pLayout)
+{
+    if (pConfig == NULL || pLayout == NULL) {
+        return false;
+    }
+
+    ak_config_lazy_layout* pLazyLayout = ak_config_find_lazy_layout(pConfig, pLayout);
+    if (pLazyLayout == NULL) {
+        return true;
+    }
+
+    bool result = ak_config_load_lazy_layout(pConfig, pLazyLayout);
+    ak_config_release_source_if_unused(pConfig);
+
+    return result;
+}
+
+bool ak_config_load_all_layouts(ak_config* pConfig)
+{
+    if (pConfig == NULL) {
+        return false;
+    }
+
+    bool result = true;
+    for (size_t i = 0; i < pConfig->lazyLayoutCount; ++i)
+    {
+        if (!ak_config_load_lazy_layout(pConfig, &pConfig->pLazyLayouts[i])) {
+            result = false;
+        }
+    }
+
+    ak_config_release_source_if_unused(pConfig);
+    return result;
+}
+
+bool ak_config_is_layout_loaded(ak_config* pConfig, ak_layout* pLayout)
+{
+    if (pConfig == NULL || pLayout == NULL) {
+        return false;
+    }
+
+    ak_config_lazy_layout* pLazyLayout = ak_config_find_lazy_layout(pConfig, pLayout);
+    return pLazyLayout == NULL || (pLazyLayout->isLoaded && !pLazyLayout->hasError);
+}
 
 
 /*
@@ -9,6 +9,19 @@ extern "C" {
 
 typedef void (* ak_on_config_error_proc)(void* pUserData, const char* message);
 
+typedef struct
+{
+    /// The keys making up the shortcut, such as "Ctrl+S" or "Ctrl+K Ctrl+C".
+    char keys[AK_MAX_SHORTCUT_LENGTH];
+
+    /// The name of the action the shortcut is bound to.
+    char actionName[AK_MAX_ACTION_NAME_LENGTH];
+
+} ak_config_shortcut;
+
+typedef struct ak_config_block ak_config_block;
+typedef struct ak_config_lazy_layout ak_config_lazy_layout;
+
 typedef struct ak_config ak_config;
 struct ak_config
 {
@@ -17,12 +30,76 @@ struct ak_config
 
     /// The root layout item. This is anonymous and is only used for hierarchy management.
     ak_layout* pRootLayout;
+
+    /// The keyboard shortcuts, in the order they appear in the script. These are declared like so:
+    ///
+    /// Shortcut "Ctrl+K Ctrl+C" Edit.Comment
+    ak_config_shortcut* pShortcuts;
+
+    /// The number of shortcuts in pShortcuts.
+    size_t shortcutCount;
+
+    /// The capacity of pShortcuts.
+    size_t shortcutBufferSize;
+
+
+    /// [Internal Use Only] The block that layout items and strings are currently being allocated from. Every block
+    /// is linked to the one before it and they are all freed in one go by ak_uninit_config().
+    ak_config_block* pCurrentBlock;
+
+    /// [Internal Use Only] The hash table of interned strings. Every string in the config is stored once, no matter
+    /// how many items use it. The capacity is always 0 or a power of 2.
+    const char** ppStrings;
+
+    /// [Internal Use Only] The number of strings in ppStrings.
+    size_t stringCount;
+
+    /// [Internal Use Only] The capacity of ppStrings.
+    size_t stringTableCapacity;
+
+
+    /// [Internal Use Only] The root level layouts that have been found, but not necessarily parsed. These are in the
+    /// order they appear in the script.
+    ak_config_lazy_layout* pLazyLayouts;
+
+    /// [Internal Use Only] The number of items in pLazyLayouts.
+    size_t lazyLayoutCount;
+
+    /// [Internal Use Only] The capacity of pLazyLayouts.
+    size_t lazyLayoutBufferSize;
+
+    /// [Internal Use Only] A copy of the script. This is kept for as long as there are layouts that have not been
+    /// parsed.
+    char* pSource;
+
+    /// [Internal Use Only] The error callback that was passed to the parser. This is used when a layout is parsed on
+    /// demand.
+    ak_on_config_error_proc onError;
+
+    /// [Internal Use Only] The user data to pass to onError.
+    void* pOnErrorUserData;
 };
 
 /// Parses a config script from a file.
+///
+/// @remarks
+///     Only the initial layout is parsed straight away. Every other root level layout is found on a quick first pass
+///     and is not parsed until it's needed, which is when it's retrieved with ak_config_find_root_layout_by_name() or
+///     loaded with ak_config_load_layout(). Errors in those layouts are not reported until then.
 bool ak_parse_config_from_file(ak_config* pConfig, drfs_file* pFile, ak_on_config_error_proc onError, void* pOnErrorUserData);
 
+/// Parses a config script from a buffer that was allocated with malloc(), taking ownership of it.
+///
+/// @remarks
+///     The script is parsed in place. The buffer is freed by the config once every layout has been parsed, or straight
+///     away if this fails, so it must not be used by the caller afterwards. See ak_parse_config_from_file() for details.
+bool ak_parse_config_from_buffer(ak_config* pConfig, char* pData, size_t dataSize, ak_on_config_error_proc onError, void* pOnErrorUserData);
+
 /// Parses a config script from a string.
+///
+/// @remarks
+///     The string is copied if there are layouts that need to be parsed later. Use ak_parse_config_from_buffer() to
+///     avoid the copy. See ak_parse_config_from_file() for details.
 bool ak_parse_config_from_string(ak_config* pConfig, const char* configString, ak_on_config_error_proc onError, void* pOnErrorUserData);
 
 
@@ -33,9 +110,36 @@ bool ak_init_config(ak_config* pConfig);
 void ak_uninit_config(ak_config* pConfig);
 
 
+/// Creates a layout item that's owned by the given config.
+///
+/// @remarks
+///     The item and it's strings are allocated from the config's own memory, so it must not be deleted with
+///     ak_delete_layout(). It will be freed along with everything else in the config by ak_uninit_config().
+ak_layout* ak_config_create_layout(ak_config* pConfig, const char* type, const char* attributes, ak_layout* pParent);
+
+
 /// Finds the first occurance of a root level layout with the given name.
+///
+/// @remarks
+///     The layout is parsed if it hasn't been already. This returns null if it could not be parsed.
 ak_layout* ak_config_find_root_layout_by_name(ak_config* pConfig, const char* layoutName);
 
+/// Parses the given root level layout if it hasn't been already.
+///
+/// @remarks
+///     This returns false if the layout could not be parsed, in which case the error callback that was passed to the
+///     parser will have been called. Layouts that weren't created by the parser are always considered to be loaded.
+bool ak_config_load_layout(ak_config* pConfig, ak_layout* pLayout);
+
+/// Parses every root level layout that hasn't been already.
+///
+/// @remarks
+///     This returns false if any layout could not be parsed. The others are still loaded.
+bool ak_config_load_all_layouts(ak_config* pConfig);
+
+/// Determines whether or not the given root level layout has been parsed without errors.
+bool ak_config_is_layout_loaded(ak_config* pConfig, ak_layout* pLayout);
+
 
 #ifdef __cplusplus
 }
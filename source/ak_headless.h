@@ -0,0 +1,148 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+//
+// QUICK NOTES
+//
+// - The headless back end is enabled by defining AK_USE_HEADLESS before including dr_appkit.h. It's intended for
+//   automated testing and benchmarking where a windowing system is either unavailable or undesirable.
+// - Windows are drawn to in-memory cairo image surfaces. Nothing is ever presented to the screen.
+// - There is no input from the user. Instead, events are injected with the ak_headless_inject_*() APIs. These are
+//   dispatched synchronously in exactly the same way as they would be by a real windowing system.
+// - Painting is not done as a result of a dirty region being posted. Instead, invalidated windows are painted by
+//   ak_headless_pump() which also runs due timers and anything posted with ak_post_to_main_thread().
+// - ak_run_application() works as normal, in which case the main loop will just keep pumping until a quit message is
+//   posted. To control the loop manually, use ak_headless_start_application() and then call ak_headless_pump() in a
+//   loop, injecting events in between.
+// - Every API here must be called from the main thread.
+//
+
+#ifndef ak_headless_h
+#define ak_headless_h
+
+#ifdef AK_USE_HEADLESS
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ak_window ak_window;
+typedef struct ak_application ak_application;
+
+/// Loads the application's config and calls it's onRun handler, but does not enter the main loop.
+///
+/// @remarks
+///     This is the same as ak_run_application(), only that control is returned straight to the caller afterwards. Use
+///     ak_headless_pump() to drive the application from there.
+///     @par
+///     The return value is 0 if successful, or the same error code that ak_run_application() would return.
+int ak_headless_start_application(ak_application* pApplication);
+
+/// Runs every pending main thread work item and due timer, and then paints every invalidated window.
+///
+/// @remarks
+///     This does not block.
+///     @par
+///     Returns false if a quit message has been posted, in which case the caller should stop pumping.
+bool ak_headless_pump(ak_application* pApplication);
+
+/// Retrieves the exit code that was passed to ak_post_quit_message().
+int ak_headless_get_exit_code(ak_application* pApplication);
+
+
+/// Injects a mouse enter event.
+void ak_headless_inject_mouse_enter(ak_window* pWindow);
+
+/// Injects a mouse leave event.
+void ak_headless_inject_mouse_leave(ak_window* pWindow);
+
+/// Injects a mouse move event.
+///
+/// @remarks
+///     A mouse enter event will be injected first if the cursor is not already over the window.
+void ak_headless_inject_mouse_move(ak_window* pWindow, int mousePosX, int mousePosY, int stateFlags);
+
+/// Injects a mouse button down event.
+void ak_headless_inject_mouse_button_down(ak_window* pWindow, int mouseButton, int mousePosX, int mousePosY, int stateFlags);
+
+/// Injects a mouse button up event.
+void ak_headless_inject_mouse_button_up(ak_window* pWindow, int mouseButton, int mousePosX, int mousePosY, int stateFlags);
+
+/// Injects a mouse button double-click event.
+void ak_headless_inject_mouse_button_dblclick(ak_window* pWindow, int mouseButton, int mousePosX, int mousePosY, int stateFlags);
+
+/// Injects a mouse wheel event.
+void ak_headless_inject_mouse_wheel(ak_window* pWindow, int delta, int mousePosX, int mousePosY, int stateFlags);
+
+/// Injects a key down event.
+///
+/// @remarks
+///     This does not inject a printable key event. Use ak_headless_inject_printable_key_down() for text input.
+void ak_headless_inject_key_down(ak_window* pWindow, drgui_key key, int stateFlags);
+
+/// Injects a key up event.
+void ak_headless_inject_key_up(ak_window* pWindow, drgui_key key, int stateFlags);
+
+/// Injects a printable key event.
+void ak_headless_inject_printable_key_down(ak_window* pWindow, unsigned int character, int stateFlags);
+
+/// Gives the given window the keyboard focus.
+///
+/// @remarks
+///     The window that currently has the focus, if any, will be sent an unfocus event first.
+void ak_headless_inject_focus(ak_window* pWindow);
+
+/// Injects an event as if the user had pressed the close button on the window's title bar.
+void ak_headless_inject_close(ak_window* pWindow);
+
+
+/// Determines whether or not the given window has a region that has been invalidated but not yet painted.
+bool ak_headless_is_window_dirty(ak_window* pWindow);
+
+/// Retrieves a pointer to the pixels of the given window's surface.
+///
+/// @remarks
+///     The pixels are in cairo's CAIRO_FORMAT_ARGB32 format, which is 32-bit premultiplied ARGB in native byte order.
+///     Rows are <*pStrideOut> bytes apart.
+///     @par
+///     The returned pointer is invalidated when the window is resized or deleted.
+const void* ak_headless_get_window_image_data(ak_window* pWindow, int* pWidthOut, int* pHeightOut, int* pStrideOut);
+
+/// Retrieves the cursor that has been set on the given window.
+ak_cursor_type ak_headless_get_window_cursor(ak_window* pWindow);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //!AK_USE_HEADLESS
+
+#endif
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
@@ -84,21 +84,27 @@ void ak_prepend_layout(ak_layout* pChild, ak_layout* pParent)
 
 ak_layout* ak_create_layout(const char* type, const char* attributes, ak_layout* pParent)
 {
-    ak_layout* pLayout = malloc(sizeof(*pLayout));
+    if (type == NULL) {
+        type = "";
+    }
+
+    if (attributes == NULL) {
+        attributes = "";
+    }
+
+    // The strings are stored straight after the item.
+    size_t typeSize       = strlen(type) + 1;
+    size_t attributesSize = strlen(attributes) + 1;
+
+    ak_layout* pLayout = malloc(sizeof(*pLayout) + typeSize + attributesSize);
     if (pLayout != NULL)
     {
-        if (type != NULL) {
-            strcpy_s(pLayout->type, sizeof(pLayout->type), type);
-        } else {
-            pLayout->type[0] = '\0';
-        }
-
-        if (attributes != NULL) {
-            strcpy_s(pLayout->attributes, sizeof(pLayout->attributes), attributes);
-        } else {
-            pLayout->attributes[0] = '\0';
-        }
+        char* pStrings = (char*)(pLayout + 1);
+        memcpy(pStrings, type, typeSize);
+        memcpy(pStrings + typeSize, attributes, attributesSize);
 
+        pLayout->type         = pStrings;
+        pLayout->attributes   = pStrings + typeSize;
         pLayout->pParent      = NULL;
         pLayout->pFirstChild  = NULL;
         pLayout->pLastChild   = NULL;
@@ -15,11 +15,12 @@ extern "C" {
 typedef struct ak_layout ak_layout;
 struct ak_layout
 {
-    /// The type of the layout item.
-    char type[AK_MAX_LAYOUT_NAME_LENGTH];
+    /// The type of the layout item. This is never null.
+    const char* type;
 
-    /// The attributes of the layout item as a string. The format of this string depends on the item type.
-    char attributes[AK_MAX_LAYOUT_ATTRIB_LENGTH];
+    /// The attributes of the layout item as a string. The format of this string depends on the item type. This is never
+    /// null.
+    const char* attributes;
 
 
     /// A pointer to the parent item.
@@ -52,9 +53,17 @@ void ak_prepend_layout(ak_layout* pChild, ak_layout* pParent);
 
 
 /// Creates a new layout item.
+///
+/// @remarks
+///     The type and attribute strings are copied into the same allocation as the item itself. Use
+///     ak_config_create_layout() to create an item that's owned by a config.
 ak_layout* ak_create_layout(const char* type, const char* attributes, ak_layout* pParent);
 
 /// Deletes the given layout object.
+///
+/// @remarks
+///     This must only be used with items created by ak_create_layout(). Items owned by a config are freed with the
+///     config itself in ak_uninit_config().
 void ak_delete_layout(ak_layout* pLayout);
 
 
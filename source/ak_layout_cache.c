@@ -0,0 +1,655 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+// "AKLC" in little endian. A cache written on a machine with a different byte order will fail to validate.
+#define AK_LAYOUT_CACHE_MAGIC       0x434C4B41
+
+// This needs to be incremented whenever the layout of the header, nodes or shortcuts changes.
+#define AK_LAYOUT_CACHE_VERSION     1
+
+struct ak_layout_cache
+{
+    /// Always AK_LAYOUT_CACHE_MAGIC.
+    uint32_t magic;
+
+    /// Always AK_LAYOUT_CACHE_VERSION.
+    uint32_t version;
+
+    /// The modification time of the config the cache was compiled from.
+    uint64_t sourceModifiedTime;
+
+    /// The size in bytes of the config the cache was compiled from.
+    uint64_t sourceSizeInBytes;
+
+    /// The hash of the contents of the config the cache was compiled from.
+    uint32_t sourceHash;
+
+    /// The size in bytes of the whole cache, including this header.
+    uint32_t totalSize;
+
+    /// The offset of the name of the initial layout in the string table.
+    uint32_t initialLayoutName;
+
+    /// The number of shortcuts.
+    uint32_t shortcutCount;
+
+    /// The offset in bytes of the shortcuts from the start of the cache.
+    uint32_t shortcutsOffset;
+
+    /// The number of nodes.
+    uint32_t nodeCount;
+
+    /// The offset in bytes of the nodes from the start of the cache.
+    uint32_t nodesOffset;
+
+    /// The offset in bytes of the string table from the start of the cache.
+    uint32_t stringsOffset;
+
+    /// The size in bytes of the string table.
+    uint32_t stringsSize;
+
+    /// Unused. Keeps the header a multiple of 8 bytes.
+    uint32_t reserved;
+};
+
+typedef struct
+{
+    /// The nodes that have been compiled so far.
+    ak_layout_cache_node* pNodes;
+
+    /// The number of nodes in pNodes.
+    uint32_t nodeCount;
+
+    /// The capacity of pNodes.
+    uint32_t nodeCapacity;
+
+
+    /// The string table.
+    char* pStrings;
+
+    /// The size in bytes of the string table.
+    uint32_t stringsSize;
+
+    /// The capacity of pStrings.
+    uint32_t stringsCapacity;
+
+
+    /// The hash table for de-duplicating strings. Each slot is the offset of a string plus 1, with empty slots being 0.
+    /// The capacity is always a power of 2.
+    uint32_t* pStringTable;
+
+    /// The number of strings in pStringTable.
+    uint32_t stringCount;
+
+    /// The capacity of pStringTable.
+    uint32_t stringTableCapacity;
+
+} ak_layout_cache_builder;
+
+
+static void ak_layout_cache_builder_uninit(ak_layout_cache_builder* pBuilder)
+{
+    assert(pBuilder != NULL);
+
+    free(pBuilder->pNodes);
+    free(pBuilder->pStrings);
+    free(pBuilder->pStringTable);
+}
+
+// Looks up the slot for the given string. If the string is not in the table, the returned slot is the empty one it
+// would go in.
+static uint32_t* ak_layout_cache_builder_find_string_slot(ak_layout_cache_builder* pBuilder, const char* str, uint32_t hash)
+{
+    assert(pBuilder != NULL);
+    assert(pBuilder->stringTableCapacity > 0);
+
+    uint32_t mask = pBuilder->stringTableCapacity - 1;
+
+    uint32_t i = hash & mask;
+    while (pBuilder->pStringTable[i] != 0)
+    {
+        if (strcmp(pBuilder->pStrings + pBuilder->pStringTable[i] - 1, str) == 0) {
+            break;
+        }
+
+        i = (i + 1) & mask;
+    }
+
+    return &pBuilder->pStringTable[i];
+}
+
+// Adds a string to the string table if it's not already in there and returns it's offset, or (uint32_t)-1 if we run
+// out of memory.
+static uint32_t ak_layout_cache_builder_add_string(ak_layout_cache_builder* pBuilder, const char* str)
+{
+    assert(pBuilder != NULL);
+    assert(str      != NULL);
+
+    if (str[0] == '\0') {
+        return 0;
+    }
+
+    // Keep the table at most 3/4 full.
+    if ((pBuilder->stringCount + 1) * 4 > pBuilder->stringTableCapacity * 3)
+    {
+        uint32_t newCapacity = (pBuilder->stringTableCapacity == 0) ? 64 : pBuilder->stringTableCapacity * 2;
+        uint32_t* pNewTable = calloc(newCapacity, sizeof(*pNewTable));
+        if (pNewTable == NULL) {
+            return (uint32_t)-1;
+        }
+
+        uint32_t* pOldTable = pBuilder->pStringTable;
+        uint32_t oldCapacity = pBuilder->stringTableCapacity;
+
+        pBuilder->pStringTable        = pNewTable;
+        pBuilder->stringTableCapacity = newCapacity;
+
+        for (uint32_t i = 0; i < oldCapacity; ++i)
+        {
+            if (pOldTable[i] != 0) {
+                const char* oldStr = pBuilder->pStrings + pOldTable[i] - 1;
+                *ak_layout_cache_builder_find_string_slot(pBuilder, oldStr, ak_hash_string(oldStr)) = pOldTable[i];
+            }
+        }
+
+        free(pOldTable);
+    }
+
+
+    uint32_t hash = ak_hash_string(str);
+    uint32_t* pSlot = ak_layout_cache_builder_find_string_slot(pBuilder, str, hash);
+    if (*pSlot != 0) {
+        return *pSlot - 1;
+    }
+
+    size_t length = strlen(str) + 1;
+    if (pBuilder->stringsSize + length > pBuilder->stringsCapacity)
+    {
+        size_t newCapacity = pBuilder->stringsCapacity * 2;
+        if (newCapacity < pBuilder->stringsSize + length) {
+            newCapacity = pBuilder->stringsSize + length;
+        }
+
+        if (newCapacity > UINT32_MAX) {
+            return (uint32_t)-1;
+        }
+
+        char* pNewStrings = realloc(pBuilder->pStrings, newCapacity);
+        if (pNewStrings == NULL) {
+            return (uint32_t)-1;
+        }
+
+        pBuilder->pStrings        = pNewStrings;
+        pBuilder->stringsCapacity = (uint32_t)newCapacity;
+    }
+
+    uint32_t offset = pBuilder->stringsSize;
+    memcpy(pBuilder->pStrings + offset, str, length);
+    pBuilder->stringsSize += (uint32_t)length;
+
+    *pSlot = offset + 1;
+    pBuilder->stringCount += 1;
+
+    return offset;
+}
+
+// Compiles the given layout item and all of it's children. Returns false if we run out of memory.
+static bool ak_layout_cache_builder_add_node(ak_layout_cache_builder* pBuilder, ak_layout* pLayout)
+{
+    assert(pBuilder != NULL);
+    assert(pLayout  != NULL);
+
+    if (pBuilder->nodeCount == pBuilder->nodeCapacity)
+    {
+        uint32_t newCapacity = (pBuilder->nodeCapacity == 0) ? 64 : pBuilder->nodeCapacity * 2;
+        ak_layout_cache_node* pNewNodes = realloc(pBuilder->pNodes, newCapacity * sizeof(*pNewNodes));
+        if (pNewNodes == NULL) {
+            return false;
+        }
+
+        pBuilder->pNodes       = pNewNodes;
+        pBuilder->nodeCapacity = newCapacity;
+    }
+
+    // The node array may be reallocated when the children are added, so the node needs to be referenced by index.
+    uint32_t nodeIndex = pBuilder->nodeCount;
+    pBuilder->nodeCount += 1;
+
+    ak_layout_cache_node node;
+    memset(&node, 0, sizeof(node));
+    node.type = ak_layout_cache_node_type_invalid;
+
+    uint32_t name = 0;
+    uint32_t text = 0;
+
+    if (strcmp(pLayout->type, AK_LAYOUT_TYPE_LAYOUT) == 0)
+    {
+        node.type = ak_layout_cache_node_type_layout;
+        name = ak_layout_cache_builder_add_string(pBuilder, pLayout->attributes);
+    }
+    else if (strcmp(pLayout->type, AK_LAYOUT_TYPE_WINDOW) == 0)
+    {
+        ak_window_layout_attributes attr;
+        if (ak_parse_window_layout_attributes(pLayout->attributes, &attr))
+        {
+            node.type        = ak_layout_cache_node_type_window;
+            node.windowType  = (uint32_t)attr.type;
+            node.posX        = attr.posX;
+            node.posY        = attr.posY;
+            node.width       = attr.width;
+            node.height      = attr.height;
+            node.isMaximized = attr.maximized;
+
+            name = ak_layout_cache_builder_add_string(pBuilder, attr.name);
+            text = ak_layout_cache_builder_add_string(pBuilder, attr.title);
+        }
+    }
+    else if (strcmp(pLayout->type, AK_LAYOUT_TYPE_PANEL) == 0)
+    {
+        ak_panel_layout_attributes attr;
+        if (ak_parse_panel_layout_attributes(pLayout->attributes, &attr))
+        {
+            node.type      = ak_layout_cache_node_type_panel;
+            node.splitAxis = (uint32_t)attr.splitAxis;
+            node.splitPos  = attr.splitPos;
+
+            name = ak_layout_cache_builder_add_string(pBuilder, attr.type);
+        }
+    }
+    else if (strcmp(pLayout->type, AK_LAYOUT_TYPE_TOOL) == 0)
+    {
+        // The type is the first token of the attributes and the tool's own attributes are the remainder.
+        node.type = ak_layout_cache_node_type_tool;
+
+        char toolType[AK_MAX_TOOL_TYPE_LENGTH];
+        const char* toolAttributes = dr_first_non_whitespace(dr_next_token(pLayout->attributes, toolType, sizeof(toolType)));
+        if (toolAttributes != NULL) {
+            name = ak_layout_cache_builder_add_string(pBuilder, toolType);
+            text = ak_layout_cache_builder_add_string(pBuilder, toolAttributes);
+        }
+    }
+
+    if (name == (uint32_t)-1 || text == (uint32_t)-1) {
+        return false;
+    }
+
+    node.name = name;
+    node.text = text;
+
+    for (ak_layout* pChild = pLayout->pFirstChild; pChild != NULL; pChild = pChild->pNextSibling)
+    {
+        if (!ak_layout_cache_builder_add_node(pBuilder, pChild)) {
+            return false;
+        }
+
+        node.childCount += 1;
+    }
+
+    node.subtreeSize = pBuilder->nodeCount - nodeIndex;
+    pBuilder->pNodes[nodeIndex] = node;
+
+    return true;
+}
+
+
+ak_layout_cache* ak_compile_layout_cache(ak_config* pConfig)
+{
+    if (pConfig == NULL || pConfig->pRootLayout == NULL) {
+        return NULL;
+    }
+
+    ak_layout_cache_builder builder;
+    memset(&builder, 0, sizeof(builder));
+
+    // The string table always starts with the empty string.
+    builder.pStrings = malloc(256);
+    if (builder.pStrings == NULL) {
+        return NULL;
+    }
+
+    builder.pStrings[0]     = '\0';
+    builder.stringsSize     = 1;
+    builder.stringsCapacity = 256;
+
+
+    uint32_t initialLayoutName = ak_layout_cache_builder_add_string(&builder, pConfig->currentLayoutName);
+    if (initialLayoutName == (uint32_t)-1) {
+        ak_layout_cache_builder_uninit(&builder);
+        return NULL;
+    }
+
+    // The shortcuts are compiled into a temporary buffer since their final position isn't known until the string
+    // table is complete.
+    ak_layout_cache_shortcut* pShortcuts = NULL;
+    if (pConfig->shortcutCount > 0)
+    {
+        pShortcuts = malloc(pConfig->shortcutCount * sizeof(*pShortcuts));
+        if (pShortcuts == NULL) {
+            ak_layout_cache_builder_uninit(&builder);
+            return NULL;
+        }
+
+        for (size_t i = 0; i < pConfig->shortcutCount; ++i)
+        {
+            pShortcuts[i].keys       = ak_layout_cache_builder_add_string(&builder, pConfig->pShortcuts[i].keys);
+            pShortcuts[i].actionName = ak_layout_cache_builder_add_string(&builder, pConfig->pShortcuts[i].actionName);
+
+            if (pShortcuts[i].keys == (uint32_t)-1 || pShortcuts[i].actionName == (uint32_t)-1) {
+                free(pShortcuts);
+                ak_layout_cache_builder_uninit(&builder);
+                return NULL;
+            }
+        }
+    }
+
+    for (ak_layout* pLayout = pConfig->pRootLayout->pFirstChild; pLayout != NULL; pLayout = pLayout->pNextSibling)
+    {
+        if (!ak_config_is_layout_loaded(pConfig, pLayout)) {
+            continue;
+        }
+
+        if (!ak_layout_cache_builder_add_node(&builder, pLayout)) {
+            free(pShortcuts);
+            ak_layout_cache_builder_uninit(&builder);
+            return NULL;
+        }
+    }
+
+
+    // Now everything can be put together into a single allocation. The string table goes last since it's the only
+    // part that isn't made up of 4 byte values.
+    uint64_t shortcutsOffset = sizeof(ak_layout_cache);
+    uint64_t nodesOffset     = shortcutsOffset + pConfig->shortcutCount * sizeof(ak_layout_cache_shortcut);
+    uint64_t stringsOffset   = nodesOffset + builder.nodeCount * sizeof(ak_layout_cache_node);
+    uint64_t totalSize       = stringsOffset + builder.stringsSize;
+    if (totalSize > UINT32_MAX) {
+        free(pShortcuts);
+        ak_layout_cache_builder_uninit(&builder);
+        return NULL;
+    }
+
+    ak_layout_cache* pCache = malloc((size_t)totalSize);
+    if (pCache == NULL) {
+        free(pShortcuts);
+        ak_layout_cache_builder_uninit(&builder);
+        return NULL;
+    }
+
+    memset(pCache, 0, sizeof(*pCache));
+    pCache->magic             = AK_LAYOUT_CACHE_MAGIC;
+    pCache->version           = AK_LAYOUT_CACHE_VERSION;
+    pCache->totalSize         = (uint32_t)totalSize;
+    pCache->initialLayoutName = initialLayoutName;
+    pCache->shortcutCount     = (uint32_t)pConfig->shortcutCount;
+    pCache->shortcutsOffset   = (uint32_t)shortcutsOffset;
+    pCache->nodeCount         = builder.nodeCount;
+    pCache->nodesOffset       = (uint32_t)nodesOffset;
+    pCache->stringsOffset     = (uint32_t)stringsOffset;
+    pCache->stringsSize       = builder.stringsSize;
+
+    if (pShortcuts != NULL) {
+        memcpy((char*)pCache + shortcutsOffset, pShortcuts, pConfig->shortcutCount * sizeof(*pShortcuts));
+    }
+
+    if (builder.nodeCount > 0) {
+        memcpy((char*)pCache + nodesOffset, builder.pNodes, builder.nodeCount * sizeof(*builder.pNodes));
+    }
+
+    memcpy((char*)pCache + stringsOffset, builder.pStrings, builder.stringsSize);
+
+
+    free(pShortcuts);
+    ak_layout_cache_builder_uninit(&builder);
+
+    return pCache;
+}
+
+
+// Checks that every offset and index in the given cache is in range so that nothing needs to be checked when it's used.
+static bool ak_layout_cache_validate(const ak_layout_cache* pCache, size_t sizeInBytes)
+{
+    assert(pCache != NULL);
+
+    if (sizeInBytes < sizeof(*pCache) || pCache->magic != AK_LAYOUT_CACHE_MAGIC || pCache->version != AK_LAYOUT_CACHE_VERSION || pCache->totalSize != sizeInBytes) {
+        return false;
+    }
+
+
+    // String table. This must start with the empty string and end with a null terminator.
+    if (pCache->stringsSize == 0 || pCache->stringsOffset < sizeof(*pCache) || (uint64_t)pCache->stringsOffset + pCache->stringsSize > sizeInBytes) {
+        return false;
+    }
+
+    const char* pStrings = (const char*)pCache + pCache->stringsOffset;
+    if (pStrings[0] != '\0' || pStrings[pCache->stringsSize - 1] != '\0') {
+        return false;
+    }
+
+    if (pCache->initialLayoutName >= pCache->stringsSize) {
+        return false;
+    }
+
+
+    // Shortcuts.
+    if ((pCache->shortcutsOffset % 4) != 0 || pCache->shortcutsOffset < sizeof(*pCache) || pCache->shortcutsOffset + (uint64_t)pCache->shortcutCount * sizeof(ak_layout_cache_shortcut) > sizeInBytes) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < pCache->shortcutCount; ++i)
+    {
+        const ak_layout_cache_shortcut* pShortcut = ak_layout_cache_get_shortcut(pCache, i);
+        if (pShortcut->keys >= pCache->stringsSize || pShortcut->actionName >= pCache->stringsSize) {
+            return false;
+        }
+    }
+
+
+    // Nodes. Each node's children must exactly fill it's sub-tree, and the top level nodes must exactly fill the array.
+    if ((pCache->nodesOffset % 4) != 0 || pCache->nodesOffset < sizeof(*pCache) || pCache->nodesOffset + (uint64_t)pCache->nodeCount * sizeof(ak_layout_cache_node) > sizeInBytes) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < pCache->nodeCount; ++i)
+    {
+        const ak_layout_cache_node* pNode = ak_layout_cache_get_node(pCache, i);
+        if (pNode->type > ak_layout_cache_node_type_tool || pNode->name >= pCache->stringsSize || pNode->text >= pCache->stringsSize) {
+            return false;
+        }
+
+        if (pNode->windowType > ak_window_type_popup || pNode->splitAxis > ak_panel_split_axis_vertical_right) {
+            return false;
+        }
+
+        if (pNode->subtreeSize == 0 || pNode->subtreeSize > pCache->nodeCount - i) {
+            return false;
+        }
+
+        uint64_t iChild = (uint64_t)i + 1;
+        for (uint32_t iChildCount = 0; iChildCount < pNode->childCount; ++iChildCount)
+        {
+            if (iChild >= i + pNode->subtreeSize) {
+                return false;
+            }
+
+            iChild += ak_layout_cache_get_node(pCache, (uint32_t)iChild)->subtreeSize;
+        }
+
+        if (iChild != i + pNode->subtreeSize) {
+            return false;
+        }
+    }
+
+    uint32_t iTopLevel = 0;
+    while (iTopLevel < pCache->nodeCount) {
+        iTopLevel += ak_layout_cache_get_node(pCache, iTopLevel)->subtreeSize;
+    }
+
+    return iTopLevel == pCache->nodeCount;
+}
+
+ak_layout_cache* ak_load_layout_cache(drfs_context* pVFS, const char* path)
+{
+    if (pVFS == NULL || path == NULL) {
+        return NULL;
+    }
+
+    drfs_file* pFile;
+    if (drfs_open(pVFS, path, DRFS_READ, &pFile) != drfs_success) {
+        return NULL;
+    }
+
+    // The whole file is read with a single read into a single allocation which then becomes the cache itself.
+    uint64_t fileSize = drfs_size(pFile);
+    if (fileSize < sizeof(ak_layout_cache) || fileSize > UINT32_MAX) {
+        drfs_close(pFile);
+        return NULL;
+    }
+
+    ak_layout_cache* pCache = malloc((size_t)fileSize);
+    if (pCache == NULL) {
+        drfs_close(pFile);
+        return NULL;
+    }
+
+    size_t bytesRead;
+    drfs_result result = drfs_read(pFile, pCache, (size_t)fileSize, &bytesRead);
+    drfs_close(pFile);
+
+    if (result != drfs_success || bytesRead != fileSize || !ak_layout_cache_validate(pCache, (size_t)fileSize)) {
+        free(pCache);
+        return NULL;
+    }
+
+    return pCache;
+}
+
+bool ak_save_layout_cache(ak_layout_cache* pCache, drfs_context* pVFS, const char* path)
+{
+    if (pCache == NULL || pVFS == NULL || path == NULL) {
+        return false;
+    }
+
+    drfs_file* pFile;
+    if (drfs_open(pVFS, path, DRFS_WRITE | DRFS_TRUNCATE, &pFile) != drfs_success) {
+        return false;
+    }
+
+    // If this fails part way through the file will be left truncated, which will be picked up when it's validated.
+    size_t bytesWritten;
+    drfs_result result = drfs_write(pFile, pCache, pCache->totalSize, &bytesWritten);
+    drfs_close(pFile);
+
+    return result == drfs_success && bytesWritten == pCache->totalSize;
+}
+
+void ak_delete_layout_cache(ak_layout_cache* pCache)
+{
+    free(pCache);
+}
+
+
+void ak_layout_cache_set_source_info(ak_layout_cache* pCache, uint64_t modifiedTime, uint64_t sizeInBytes, uint32_t hash)
+{
+    assert(pCache != NULL);
+
+    pCache->sourceModifiedTime = modifiedTime;
+    pCache->sourceSizeInBytes  = sizeInBytes;
+    pCache->sourceHash         = hash;
+}
+
+void ak_layout_cache_get_source_info(const ak_layout_cache* pCache, uint64_t* pModifiedTimeOut, uint64_t* pSizeInBytesOut, uint32_t* pHashOut)
+{
+    assert(pCache != NULL);
+
+    if (pModifiedTimeOut) *pModifiedTimeOut = pCache->sourceModifiedTime;
+    if (pSizeInBytesOut)  *pSizeInBytesOut  = pCache->sourceSizeInBytes;
+    if (pHashOut)         *pHashOut         = pCache->sourceHash;
+}
+
+
+const char* ak_layout_cache_get_string(const ak_layout_cache* pCache, uint32_t offset)
+{
+    assert(pCache != NULL);
+    assert(offset < pCache->stringsSize);
+
+    return (const char*)pCache + pCache->stringsOffset + offset;
+}
+
+const char* ak_layout_cache_get_initial_layout_name(const ak_layout_cache* pCache)
+{
+    assert(pCache != NULL);
+    return ak_layout_cache_get_string(pCache, pCache->initialLayoutName);
+}
+
+uint32_t ak_layout_cache_get_shortcut_count(const ak_layout_cache* pCache)
+{
+    assert(pCache != NULL);
+    return pCache->shortcutCount;
+}
+
+const ak_layout_cache_shortcut* ak_layout_cache_get_shortcut(const ak_layout_cache* pCache, uint32_t index)
+{
+    assert(pCache != NULL);
+    assert(index < pCache->shortcutCount);
+
+    return (const ak_layout_cache_shortcut*)((const char*)pCache + pCache->shortcutsOffset) + index;
+}
+
+uint32_t ak_layout_cache_get_node_count(const ak_layout_cache* pCache)
+{
+    assert(pCache != NULL);
+    return pCache->nodeCount;
+}
+
+const ak_layout_cache_node* ak_layout_cache_get_node(const ak_layout_cache* pCache, uint32_t index)
+{
+    assert(pCache != NULL);
+    assert(index < pCache->nodeCount);
+
+    return (const ak_layout_cache_node*)((const char*)pCache + pCache->nodesOffset) + index;
+}
+
+uint32_t ak_layout_cache_find_layout(const ak_layout_cache* pCache, const char* name)
+{
+    if (pCache == NULL || name == NULL) {
+        return (uint32_t)-1;
+    }
+
+    // Only the top level nodes are searched, which we can step over a whole sub-tree at a time.
+    for (uint32_t i = 0; i < pCache->nodeCount; i += ak_layout_cache_get_node(pCache, i)->subtreeSize)
+    {
+        const ak_layout_cache_node* pNode = ak_layout_cache_get_node(pCache, i);
+        if (pNode->type == ak_layout_cache_node_type_layout && strcmp(ak_layout_cache_get_string(pCache, pNode->name), name) == 0) {
+            return i;
+        }
+    }
+
+    return (uint32_t)-1;
+}
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
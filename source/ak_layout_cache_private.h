@@ -0,0 +1,185 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+//
+// QUICK NOTES
+//
+// - A layout cache is a compiled form of a config. It's a single block of memory made up of a header, an array of
+//   shortcuts, an array of layout nodes and a string table. Everything is referenced by offset or index rather than by
+//   pointer, so a cache can be written straight to disk and loaded back without any fix ups.
+// - Attributes are parsed when the cache is compiled. Applying a layout from a cache therefore does no tokenizing and
+//   no allocations of it's own.
+// - Nodes are stored in pre-order. The first child of a node is the node straight after it, and the next sibling is
+//   <subtreeSize> nodes along. The top level items of the config are stored the same way, starting at node 0.
+// - Strings are null terminated and de-duplicated. Offset 0 is always the empty string.
+// - The header records the modification time, size and hash of the config it was compiled from so the application can
+//   tell whether or not it's stale. Caches are validated when they are loaded, so a truncated or corrupt file is just
+//   treated as a cache miss.
+//
+
+#ifndef ak_layout_cache_private_h
+#define ak_layout_cache_private_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ak_layout_cache ak_layout_cache;
+
+typedef enum
+{
+    /// The item's attributes could not be parsed. Applying this is an error.
+    ak_layout_cache_node_type_invalid,
+
+    /// A "Layout" item. <name> is the name of the layout.
+    ak_layout_cache_node_type_layout,
+
+    /// A "Window" item. Every window attribute is used.
+    ak_layout_cache_node_type_window,
+
+    /// A "Panel" item. <name> is the panel type, which may be empty.
+    ak_layout_cache_node_type_panel,
+
+    /// A "Tool" item. <name> is the tool type and <text> is the tool's attributes. Tools with an empty type are ignored.
+    ak_layout_cache_node_type_tool
+
+} ak_layout_cache_node_type;
+
+typedef struct
+{
+    /// The node type. This is an ak_layout_cache_node_type value.
+    uint32_t type;
+
+    /// The number of nodes making up the sub-tree starting at this node, including itself.
+    uint32_t subtreeSize;
+
+    /// The number of direct children.
+    uint32_t childCount;
+
+    /// The offset of the name in the string table. What this is depends on the node type.
+    uint32_t name;
+
+    /// The offset of the window title or tool attributes in the string table.
+    uint32_t text;
+
+    /// The window type. This is an ak_window_type value.
+    uint32_t windowType;
+
+    /// The position of the window.
+    int32_t posX;
+    int32_t posY;
+
+    /// The size of the window.
+    uint32_t width;
+    uint32_t height;
+
+    /// Whether or not the window is maximized.
+    uint32_t isMaximized;
+
+    /// The panel's split axis. This is an ak_panel_split_axis value.
+    uint32_t splitAxis;
+
+    /// The position of the panel's split.
+    float splitPos;
+
+} ak_layout_cache_node;
+
+typedef struct
+{
+    /// The offset of the shortcut's keys in the string table.
+    uint32_t keys;
+
+    /// The offset of the name of the action in the string table.
+    uint32_t actionName;
+
+} ak_layout_cache_shortcut;
+
+
+/// Compiles the given config into a layout cache.
+///
+/// @remarks
+///     The source information of the returned cache is all 0. Items whose attributes fail to parse are compiled as
+///     invalid nodes rather than failing the whole config since they will only matter if the layout they're part of
+///     is applied.
+///     @par
+///     Root level layouts that have not been loaded, or that failed to load, are left out. Use
+///     ak_config_load_all_layouts() first to compile the whole config.
+ak_layout_cache* ak_compile_layout_cache(ak_config* pConfig);
+
+/// Loads a layout cache from a file.
+///
+/// @remarks
+///     This returns null if the file does not exist or is not a valid cache for this build.
+ak_layout_cache* ak_load_layout_cache(drfs_context* pVFS, const char* path);
+
+/// Saves the given layout cache to a file.
+bool ak_save_layout_cache(ak_layout_cache* pCache, drfs_context* pVFS, const char* path);
+
+/// Deletes the given layout cache.
+void ak_delete_layout_cache(ak_layout_cache* pCache);
+
+
+/// Sets the information about the config the given cache was compiled from.
+void ak_layout_cache_set_source_info(ak_layout_cache* pCache, uint64_t modifiedTime, uint64_t sizeInBytes, uint32_t hash);
+
+/// Retrieves the information about the config the given cache was compiled from.
+void ak_layout_cache_get_source_info(const ak_layout_cache* pCache, uint64_t* pModifiedTimeOut, uint64_t* pSizeInBytesOut, uint32_t* pHashOut);
+
+
+/// Retrieves a string from the string table.
+const char* ak_layout_cache_get_string(const ak_layout_cache* pCache, uint32_t offset);
+
+/// Retrieves the name of the initial layout.
+const char* ak_layout_cache_get_initial_layout_name(const ak_layout_cache* pCache);
+
+/// Retrieves the number of shortcuts.
+uint32_t ak_layout_cache_get_shortcut_count(const ak_layout_cache* pCache);
+
+/// Retrieves the shortcut at the given index.
+const ak_layout_cache_shortcut* ak_layout_cache_get_shortcut(const ak_layout_cache* pCache, uint32_t index);
+
+/// Retrieves the total number of nodes.
+uint32_t ak_layout_cache_get_node_count(const ak_layout_cache* pCache);
+
+/// Retrieves the node at the given index.
+const ak_layout_cache_node* ak_layout_cache_get_node(const ak_layout_cache* pCache, uint32_t index);
+
+/// Finds the first top level layout with the given name.
+///
+/// @remarks
+///     This returns the index of the layout's node, or (uint32_t)-1 if it could not be found.
+uint32_t ak_layout_cache_find_layout(const ak_layout_cache* pCache, const char* name);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
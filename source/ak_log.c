@@ -0,0 +1,668 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+#if (AK_LOG_RING_BUFFER_SIZE & (AK_LOG_RING_BUFFER_SIZE - 1)) != 0
+#error "AK_LOG_RING_BUFFER_SIZE must be a power of 2."
+#endif
+
+/// The maximum number of loggers that can be drained when the process crashes.
+#define AK_MAX_CRASH_LOGGERS    8
+
+/// The size of the buffer the timestamp of a message is formatted into.
+#define AK_LOG_TIMESTAMP_BUFFER_SIZE    64
+
+/// The size of the text of an entry. This is big enough for the "[<timestamp>]" prefix, the message and the new line.
+#define AK_LOG_ENTRY_TEXT_SIZE          (AK_LOG_TIMESTAMP_BUFFER_SIZE + AK_MAX_LOG_MESSAGE_LENGTH + 2)
+
+#ifdef _WIN32
+typedef HANDLE ak_log_crash_file;
+#define AK_INVALID_LOG_CRASH_FILE       INVALID_HANDLE_VALUE
+#else
+typedef int ak_log_crash_file;
+#define AK_INVALID_LOG_CRASH_FILE       -1
+#endif
+
+typedef struct
+{
+    /// The sequence number of the entry. This is what synchronizes the producers with the consumer. When it is equal to
+    /// the write cursor the entry is free, and when it's equal to the read cursor + 1 it's ready to be written.
+    volatile size_t sequence;
+
+    /// The level of the message. One of the AK_LOG_LEVEL_* constants.
+    int level;
+
+    /// The length of the text in bytes.
+    size_t textLength;
+
+    /// The line exactly as it's written to the file, including the timestamp and the new line character. This is not
+    /// null terminated. It's formatted by the producer so that the crash handler can write it out as-is.
+    char text[AK_LOG_ENTRY_TEXT_SIZE];
+
+} ak_log_entry;
+
+struct ak_logger
+{
+    /// The file to write messages to.
+    drfs_file* pFile;
+
+    /// The path of the file. This is only used for opening the crash file and is an empty string if it's unknown.
+    char filePath[DRFS_MAX_PATH];
+
+    /// A native handle to the file, opened for appending. The crash handler can't safely use drfs, so this is what it
+    /// writes to instead. This is opened the first time AK_LOG_FLUSH_ON_CRASH is set.
+    ak_log_crash_file crashFile;
+
+    /// The policy controlling when the file is flushed. Each part of the policy is stored separately so that it can be
+    /// changed with atomics while the background thread and producers are reading it.
+    volatile size_t flushFlags;
+    volatile size_t flushIntervalInMilliseconds;
+    volatile size_t flushSizeThresholdInBytes;
+
+    /// The ring buffer. This is always AK_LOG_RING_BUFFER_SIZE entries.
+    ak_log_entry* pEntries;
+
+    /// The position of the next entry to be claimed by a producer. This wraps naturally. The index into the ring
+    /// buffer is found by masking.
+    volatile size_t writeCursor;
+
+    /// The position of the next entry to be written to the file. This is only modified while holding the consumer lock,
+    /// but producers read it to determine how full the ring buffer is.
+    volatile size_t readCursor;
+
+    /// The number of bytes that have been posted since the last flush. This is used for size based flushing.
+    volatile size_t unflushedBytes;
+
+    /// The lock that must be held when writing to the file. This is a spinlock rather than a mutex so that it can be
+    /// acquired with a timeout when the process is crashing.
+    volatile size_t consumerLock;
+
+    /// Set to non-zero when the background thread needs to terminate.
+    volatile size_t isTerminating;
+
+    /// The event for waking up the background thread.
+    ak_event wakeEvent;
+
+    /// The background thread.
+    ak_thread thread;
+};
+
+
+/// The loggers to drain when the process crashes.
+static volatile size_t g_AKCrashLoggers[AK_MAX_CRASH_LOGGERS];
+
+/// Set to non-zero after the crash handlers have been installed.
+static volatile size_t g_AKCrashHandlersInstalled = 0;
+
+
+static bool ak_logger_should_flush_immediately(ak_logger* pLogger, int level)
+{
+    assert(pLogger != NULL);
+
+    size_t flags = ak_atomic_load(&pLogger->flushFlags);
+    if (level >= AK_LOG_LEVEL_ERROR && (flags & AK_LOG_FLUSH_ON_ERROR) != 0) {
+        return true;
+    }
+    if (level >= AK_LOG_LEVEL_WARNING && (flags & AK_LOG_FLUSH_ON_WARNING) != 0) {
+        return true;
+    }
+
+    return false;
+}
+
+static void ak_logger_lock_consumer(ak_logger* pLogger)
+{
+    assert(pLogger != NULL);
+
+    while (!ak_atomic_compare_exchange(&pLogger->consumerLock, 0, 1)) {
+        ak_yield_thread();
+    }
+}
+
+static void ak_logger_unlock_consumer(ak_logger* pLogger)
+{
+    assert(pLogger != NULL);
+    ak_atomic_store(&pLogger->consumerLock, 0);
+}
+
+static void ak_logger_flush_file(ak_logger* pLogger)
+{
+    assert(pLogger != NULL);
+
+    drfs_flush(pLogger->pFile);
+    ak_atomic_store(&pLogger->unflushedBytes, 0);
+}
+
+/// Writes every published entry to the file. The consumer lock must be held.
+///
+/// @return True if an entry was written that requires the file to be flushed straight away.
+static bool ak_logger_drain_locked(ak_logger* pLogger)
+{
+    assert(pLogger != NULL);
+
+    bool needsFlush = false;
+    for (;;)
+    {
+        size_t position = pLogger->readCursor;
+        ak_log_entry* pEntry = &pLogger->pEntries[position & (AK_LOG_RING_BUFFER_SIZE - 1)];
+
+        // If the entry has not been published it means either the buffer is empty or a producer is still in the middle
+        // of writing it. In both cases we need to stop here in order to keep messages in order.
+        if (ak_atomic_load(&pEntry->sequence) != position + 1) {
+            break;
+        }
+
+        size_t bytesWritten;
+        drfs_write(pLogger->pFile, pEntry->text, pEntry->textLength, &bytesWritten);
+
+        if (ak_logger_should_flush_immediately(pLogger, pEntry->level)) {
+            needsFlush = true;
+        }
+
+        // Hand the entry back to the producers for the next lap around the ring.
+        ak_atomic_store(&pEntry->sequence, position + AK_LOG_RING_BUFFER_SIZE);
+        ak_atomic_store(&pLogger->readCursor, position + 1);
+    }
+
+    return needsFlush;
+}
+
+static bool ak_logger_try_enqueue(ak_logger* pLogger, int level, const char* prefix, size_t prefixLength, const char* message, size_t messageLength)
+{
+    assert(pLogger != NULL);
+    assert(prefixLength + messageLength + 1 <= AK_LOG_ENTRY_TEXT_SIZE);
+
+    ak_log_entry* pEntry;
+
+    size_t position = ak_atomic_load(&pLogger->writeCursor);
+    for (;;)
+    {
+        pEntry = &pLogger->pEntries[position & (AK_LOG_RING_BUFFER_SIZE - 1)];
+
+        size_t sequence = ak_atomic_load(&pEntry->sequence);
+        if (sequence == position) {
+            // The entry is free. Try claiming it, and if another producer beats us to it just try the next one.
+            if (ak_atomic_compare_exchange(&pLogger->writeCursor, position, position + 1)) {
+                break;
+            }
+        } else if ((ptrdiff_t)(sequence - position) < 0) {
+            // The entry from the previous lap has not yet been written which means the buffer is full.
+            return false;
+        }
+
+        position = ak_atomic_load(&pLogger->writeCursor);
+    }
+
+    memcpy(pEntry->text, prefix, prefixLength);
+    memcpy(pEntry->text + prefixLength, message, messageLength);
+    pEntry->text[prefixLength + messageLength] = '\n';
+
+    pEntry->level      = level;
+    pEntry->textLength = prefixLength + messageLength + 1;
+
+    // Publish.
+    ak_atomic_store(&pEntry->sequence, position + 1);
+    return true;
+}
+
+static void ak_logger_thread_proc(void* pData)
+{
+    ak_logger* pLogger = pData;
+    assert(pLogger != NULL);
+
+    for (;;)
+    {
+        unsigned int timeoutInMilliseconds = AK_INFINITE;
+        if ((ak_atomic_load(&pLogger->flushFlags) & AK_LOG_FLUSH_ON_INTERVAL) != 0) {
+            timeoutInMilliseconds = (unsigned int)ak_atomic_load(&pLogger->flushIntervalInMilliseconds);
+        }
+
+        bool wasSignaled   = ak_wait_event(&pLogger->wakeEvent, timeoutInMilliseconds);
+        bool isTerminating = ak_atomic_load(&pLogger->isTerminating) != 0;
+
+        ak_logger_lock_consumer(pLogger);
+        {
+            bool needsFlush = ak_logger_drain_locked(pLogger);
+
+            // If the wait timed out it means the flush interval has elapsed.
+            if (!wasSignaled || isTerminating) {
+                needsFlush = true;
+            }
+
+            if ((ak_atomic_load(&pLogger->flushFlags) & AK_LOG_FLUSH_ON_SIZE) != 0 && ak_atomic_load(&pLogger->unflushedBytes) >= ak_atomic_load(&pLogger->flushSizeThresholdInBytes)) {
+                needsFlush = true;
+            }
+
+            if (needsFlush) {
+                ak_logger_flush_file(pLogger);
+            }
+        }
+        ak_logger_unlock_consumer(pLogger);
+
+        if (isTerminating) {
+            break;
+        }
+    }
+}
+
+
+#ifdef _WIN32
+static ak_log_crash_file ak_open_log_crash_file(const char* filePath)
+{
+    return CreateFileA(filePath, FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+}
+
+static void ak_close_log_crash_file(ak_log_crash_file file)
+{
+    CloseHandle(file);
+}
+
+static void ak_write_log_crash_file(ak_log_crash_file file, const char* pData, size_t dataSize)
+{
+    while (dataSize > 0)
+    {
+        DWORD bytesWritten;
+        if (!WriteFile(file, pData, (DWORD)dataSize, &bytesWritten, NULL) || bytesWritten == 0) {
+            return;
+        }
+
+        pData    += bytesWritten;
+        dataSize -= bytesWritten;
+    }
+}
+#else
+static ak_log_crash_file ak_open_log_crash_file(const char* filePath)
+{
+    return open(filePath, O_WRONLY | O_APPEND);
+}
+
+static void ak_close_log_crash_file(ak_log_crash_file file)
+{
+    close(file);
+}
+
+static void ak_write_log_crash_file(ak_log_crash_file file, const char* pData, size_t dataSize)
+{
+    while (dataSize > 0)
+    {
+        ssize_t bytesWritten = write(file, pData, dataSize);
+        if (bytesWritten < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesWritten <= 0) {
+            return;
+        }
+
+        pData    += bytesWritten;
+        dataSize -= (size_t)bytesWritten;
+    }
+}
+#endif
+
+/// Writes every pending message of every registered logger straight to it's crash file.
+///
+/// @remarks
+///     On POSIX platforms this is run from inside a signal handler which means it can only use async-signal-safe
+///     functions. That's why the entries are formatted by the producers and written here with nothing but write().
+static void ak_logger_on_crash()
+{
+    for (size_t i = 0; i < AK_MAX_CRASH_LOGGERS; ++i)
+    {
+        ak_logger* pLogger = (ak_logger*)ak_atomic_load(&g_AKCrashLoggers[i]);
+        if (pLogger == NULL) {
+            continue;
+        }
+
+        // The background thread could be holding the lock. We want to give it a chance to finish what it's doing, but
+        // we don't want to hang forever because it may well be the thread that crashed.
+        bool isLocked = false;
+        for (int iAttempt = 0; iAttempt < 1000; ++iAttempt) {
+            if (ak_atomic_compare_exchange(&pLogger->consumerLock, 0, 1)) {
+                isLocked = true;
+                break;
+            }
+
+            ak_yield_thread();
+        }
+
+        // If the lock couldn't be taken the background thread is still in the middle of writing to the file. Writing
+        // alongside it would mangle the file, so this logger's pending messages are given up on.
+        if (!isLocked) {
+            continue;
+        }
+
+        for (;;)
+        {
+            size_t position = pLogger->readCursor;
+            ak_log_entry* pEntry = &pLogger->pEntries[position & (AK_LOG_RING_BUFFER_SIZE - 1)];
+            if (ak_atomic_load(&pEntry->sequence) != position + 1) {
+                break;
+            }
+
+            ak_write_log_crash_file(pLogger->crashFile, pEntry->text, pEntry->textLength);
+
+            ak_atomic_store(&pEntry->sequence, position + AK_LOG_RING_BUFFER_SIZE);
+            ak_atomic_store(&pLogger->readCursor, position + 1);
+        }
+
+        ak_logger_unlock_consumer(pLogger);
+    }
+}
+
+#ifdef _WIN32
+static LPTOP_LEVEL_EXCEPTION_FILTER g_AKPrevExceptionFilter = NULL;
+
+static LONG WINAPI ak_logger_exception_filter_win32(EXCEPTION_POINTERS* pExceptionInfo)
+{
+    ak_logger_on_crash();
+
+    if (g_AKPrevExceptionFilter != NULL) {
+        return g_AKPrevExceptionFilter(pExceptionInfo);
+    }
+
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+
+static void ak_logger_install_crash_handlers()
+{
+    g_AKPrevExceptionFilter = SetUnhandledExceptionFilter(ak_logger_exception_filter_win32);
+}
+#else
+static const int g_AKCrashSignals[] = {SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL};
+static struct sigaction g_AKPrevCrashActions[sizeof(g_AKCrashSignals) / sizeof(g_AKCrashSignals[0])];
+
+static void ak_logger_crash_signal_handler_posix(int sig)
+{
+    ak_logger_on_crash();
+
+    // Restore the previous handler and re-raise so that the default behaviour (core dump, etc.) still happens.
+    for (size_t i = 0; i < sizeof(g_AKCrashSignals) / sizeof(g_AKCrashSignals[0]); ++i) {
+        if (g_AKCrashSignals[i] == sig) {
+            sigaction(sig, &g_AKPrevCrashActions[i], NULL);
+            break;
+        }
+    }
+
+    raise(sig);
+}
+
+static void ak_logger_install_crash_handlers()
+{
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = ak_logger_crash_signal_handler_posix;
+    sigemptyset(&action.sa_mask);
+
+    for (size_t i = 0; i < sizeof(g_AKCrashSignals) / sizeof(g_AKCrashSignals[0]); ++i) {
+        sigaction(g_AKCrashSignals[i], &action, &g_AKPrevCrashActions[i]);
+    }
+}
+#endif
+
+static void ak_logger_register_for_crash(ak_logger* pLogger)
+{
+    assert(pLogger != NULL);
+
+    for (size_t i = 0; i < AK_MAX_CRASH_LOGGERS; ++i) {
+        if (ak_atomic_load(&g_AKCrashLoggers[i]) == (size_t)pLogger) {
+            return;     // Already registered.
+        }
+    }
+
+    // The handlers are process-wide so they're only installed once the first logger opts in.
+    if (ak_atomic_compare_exchange(&g_AKCrashHandlersInstalled, 0, 1)) {
+        ak_logger_install_crash_handlers();
+    }
+
+    for (size_t i = 0; i < AK_MAX_CRASH_LOGGERS; ++i) {
+        if (ak_atomic_compare_exchange(&g_AKCrashLoggers[i], 0, (size_t)pLogger)) {
+            return;
+        }
+    }
+
+    // If we get here it means there's too many loggers. It's not a big deal - the messages of this logger just won't be
+    // drained if the process crashes.
+}
+
+static void ak_logger_unregister_for_crash(ak_logger* pLogger)
+{
+    assert(pLogger != NULL);
+
+    for (size_t i = 0; i < AK_MAX_CRASH_LOGGERS; ++i) {
+        if (ak_atomic_compare_exchange(&g_AKCrashLoggers[i], (size_t)pLogger, 0)) {
+            return;
+        }
+    }
+}
+
+/// Registers or unregisters the given logger for crash draining depending on whether or not AK_LOG_FLUSH_ON_CRASH is set.
+static void ak_logger_update_crash_registration(ak_logger* pLogger)
+{
+    assert(pLogger != NULL);
+
+    if ((ak_atomic_load(&pLogger->flushFlags) & AK_LOG_FLUSH_ON_CRASH) == 0) {
+        ak_logger_unregister_for_crash(pLogger);
+        return;
+    }
+
+    // Files can't be opened from inside the crash handler so it needs to be done up front. If it fails the messages just
+    // won't be drained when the process crashes.
+    if (pLogger->crashFile == AK_INVALID_LOG_CRASH_FILE)
+    {
+        if (pLogger->filePath[0] == '\0') {
+            return;
+        }
+
+        pLogger->crashFile = ak_open_log_crash_file(pLogger->filePath);
+        if (pLogger->crashFile == AK_INVALID_LOG_CRASH_FILE) {
+            return;
+        }
+    }
+
+    ak_logger_register_for_crash(pLogger);
+}
+
+
+ak_logger* ak_create_logger(drfs_file* pFile, const char* filePath, ak_log_flush_policy policy)
+{
+    if (pFile == NULL) {
+        return NULL;
+    }
+
+    ak_logger* pLogger = malloc(sizeof(*pLogger));
+    if (pLogger == NULL) {
+        return NULL;
+    }
+
+    pLogger->pEntries = malloc(sizeof(*pLogger->pEntries) * AK_LOG_RING_BUFFER_SIZE);
+    if (pLogger->pEntries == NULL) {
+        free(pLogger);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < AK_LOG_RING_BUFFER_SIZE; ++i) {
+        pLogger->pEntries[i].sequence = i;
+    }
+
+    pLogger->pFile                       = pFile;
+    pLogger->crashFile                   = AK_INVALID_LOG_CRASH_FILE;
+    pLogger->flushFlags                  = policy.flags;
+    pLogger->flushIntervalInMilliseconds = policy.intervalInMilliseconds;
+    pLogger->flushSizeThresholdInBytes   = policy.sizeThresholdInBytes;
+    pLogger->writeCursor                 = 0;
+    pLogger->readCursor                  = 0;
+    pLogger->unflushedBytes              = 0;
+    pLogger->consumerLock                = 0;
+    pLogger->isTerminating               = 0;
+
+    if (filePath != NULL) {
+        strcpy_s(pLogger->filePath, sizeof(pLogger->filePath), filePath);
+    } else {
+        pLogger->filePath[0] = '\0';
+    }
+
+    if (!ak_init_event(&pLogger->wakeEvent)) {
+        free(pLogger->pEntries);
+        free(pLogger);
+        return NULL;
+    }
+
+    if (!ak_create_thread(&pLogger->thread, ak_logger_thread_proc, pLogger)) {
+        ak_uninit_event(&pLogger->wakeEvent);
+        free(pLogger->pEntries);
+        free(pLogger);
+        return NULL;
+    }
+
+    ak_logger_update_crash_registration(pLogger);
+
+    return pLogger;
+}
+
+void ak_delete_logger(ak_logger* pLogger)
+{
+    if (pLogger == NULL) {
+        return;
+    }
+
+    ak_logger_unregister_for_crash(pLogger);
+
+    // The background thread will drain and flush the file before returning.
+    ak_atomic_store(&pLogger->isTerminating, 1);
+    ak_signal_event(&pLogger->wakeEvent);
+    ak_wait_thread(&pLogger->thread);
+
+    if (pLogger->crashFile != AK_INVALID_LOG_CRASH_FILE) {
+        ak_close_log_crash_file(pLogger->crashFile);
+    }
+
+    ak_uninit_event(&pLogger->wakeEvent);
+    free(pLogger->pEntries);
+    free(pLogger);
+}
+
+
+void ak_logger_post(ak_logger* pLogger, int level, const char* message)
+{
+    if (pLogger == NULL || message == NULL) {
+        return;
+    }
+
+    // Messages formatted by the application already fit in an entry, so this only truncates messages that were passed
+    // in pre-formatted.
+    size_t messageLength = strlen(message);
+    if (messageLength >= AK_MAX_LOG_MESSAGE_LENGTH) {
+        messageLength = AK_MAX_LOG_MESSAGE_LENGTH - 1;
+    }
+
+    // The timestamp is formatted here rather than on the background thread so that the entry can be written as-is by
+    // the crash handler, which can't call anything that isn't async-signal-safe.
+    char dateTime[AK_LOG_TIMESTAMP_BUFFER_SIZE];
+    dr_datetime_short(dr_now(), dateTime, sizeof(dateTime));
+
+    char prefix[AK_LOG_TIMESTAMP_BUFFER_SIZE + 1];
+    int prefixLength = snprintf(prefix, sizeof(prefix), "[%s]", dateTime);
+    if (prefixLength < 0) {
+        prefixLength = 0;
+    } else if ((size_t)prefixLength >= sizeof(prefix)) {
+        prefixLength = (int)sizeof(prefix) - 1;
+    }
+
+    // The writer is woken up well before the buffer fills, so it should only be full if messages are being posted
+    // faster than they can be written. In that case we wait for the writer to make room rather than writing the
+    // message ourselves, since that would put disk I/O on the posting thread.
+    while (!ak_logger_try_enqueue(pLogger, level, prefix, (size_t)prefixLength, message, messageLength)) {
+        ak_signal_event(&pLogger->wakeEvent);
+        ak_yield_thread();
+    }
+
+    size_t unflushedBytes = ak_atomic_add(&pLogger->unflushedBytes, messageLength);
+
+    bool wakeWriter = ak_logger_should_flush_immediately(pLogger, level);
+    if ((ak_atomic_load(&pLogger->flushFlags) & AK_LOG_FLUSH_ON_SIZE) != 0 && unflushedBytes >= ak_atomic_load(&pLogger->flushSizeThresholdInBytes)) {
+        wakeWriter = true;
+    }
+
+    // Once the buffer is half full the writer needs to start draining it regardless of the flush policy.
+    if (ak_atomic_load(&pLogger->writeCursor) - ak_atomic_load(&pLogger->readCursor) >= AK_LOG_RING_BUFFER_SIZE/2) {
+        wakeWriter = true;
+    }
+
+    if (wakeWriter) {
+        ak_signal_event(&pLogger->wakeEvent);
+    }
+}
+
+void ak_logger_flush(ak_logger* pLogger)
+{
+    if (pLogger == NULL) {
+        return;
+    }
+
+    ak_logger_lock_consumer(pLogger);
+    {
+        ak_logger_drain_locked(pLogger);
+        ak_logger_flush_file(pLogger);
+    }
+    ak_logger_unlock_consumer(pLogger);
+}
+
+
+void ak_logger_set_flush_policy(ak_logger* pLogger, ak_log_flush_policy policy)
+{
+    if (pLogger == NULL) {
+        return;
+    }
+
+    // The flags are stored last so that a newly enabled interval or size threshold is never seen with a stale value.
+    ak_atomic_store(&pLogger->flushIntervalInMilliseconds, policy.intervalInMilliseconds);
+    ak_atomic_store(&pLogger->flushSizeThresholdInBytes, policy.sizeThresholdInBytes);
+    ak_atomic_store(&pLogger->flushFlags, policy.flags);
+
+    ak_logger_update_crash_registration(pLogger);
+
+    // Wake up the background thread so it picks up the new interval.
+    ak_signal_event(&pLogger->wakeEvent);
+}
+
+ak_log_flush_policy ak_logger_get_flush_policy(ak_logger* pLogger)
+{
+    ak_log_flush_policy policy;
+    memset(&policy, 0, sizeof(policy));
+
+    if (pLogger == NULL) {
+        return policy;
+    }
+
+    policy.flags                  = (unsigned int)ak_atomic_load(&pLogger->flushFlags);
+    policy.intervalInMilliseconds = (unsigned int)ak_atomic_load(&pLogger->flushIntervalInMilliseconds);
+    policy.sizeThresholdInBytes   = ak_atomic_load(&pLogger->flushSizeThresholdInBytes);
+
+    return policy;
+}
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
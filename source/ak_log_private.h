@@ -0,0 +1,102 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+//
+// QUICK NOTES
+//
+// - The logger is what sits between ak_log() and the log file. Messages are pushed onto a lock-free ring buffer by any
+//   thread and written to the file by a background thread.
+// - The logger does not own the file. It must be deleted before the file is closed.
+// - Deleting a logger will block until every posted message has been written and flushed.
+// - Crashes (SIGSEGV, SIGABRT, etc. or an unhandled exception on Win32) will drain every logger that has
+//   AK_LOG_FLUSH_ON_CRASH set before the process goes down. This is a best effort thing. The crash handler writes to a
+//   separate native handle of the file since drfs is not async-signal-safe, which is why messages are formatted into
+//   their final form when they're posted.
+//
+
+#ifndef ak_log_private_h
+#define ak_log_private_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ak_logger ak_logger;
+
+
+/// Creates a logger which writes to the given file on a background thread.
+///
+/// @remarks
+///     This will return null if the background thread could not be created, in which case the caller should fall
+///     back to writing to the file directly.
+///     @par
+///     <filePath> is the absolute path of the file. It's only used for draining the logger when the process crashes
+///     (see AK_LOG_FLUSH_ON_CRASH) and can be null, in which case that is not supported.
+ak_logger* ak_create_logger(drfs_file* pFile, const char* filePath, ak_log_flush_policy policy);
+
+/// Deletes the given logger.
+///
+/// @remarks
+///     This will block until every posted message has been written to the file and flushed.
+void ak_delete_logger(ak_logger* pLogger);
+
+
+/// Posts a message to the logger.
+///
+/// @remarks
+///     <level> is one of the AK_LOG_LEVEL_* constants and is only used for determining whether or not the file needs
+///     to be flushed straight away. The message itself should already have any level and category tags.
+///     @par
+///     This is thread-safe and will not block unless the ring buffer is full, in which case it waits for the background
+///     thread to make room. The background thread is woken up once the buffer is half full so this should be rare.
+///     Disk I/O never happens on the calling thread.
+///     @par
+///     Messages longer than AK_MAX_LOG_MESSAGE_LENGTH (including the null terminator) are truncated.
+void ak_logger_post(ak_logger* pLogger, int level, const char* message);
+
+/// Writes every pending message to the file and flushes it.
+///
+/// @remarks
+///     This is synchronous.
+void ak_logger_flush(ak_logger* pLogger);
+
+
+/// Sets the policy controlling when the log file is flushed.
+void ak_logger_set_flush_policy(ak_logger* pLogger, ak_log_flush_policy policy);
+
+/// Retrieves the policy controlling when the log file is flushed.
+ak_log_flush_policy ak_logger_get_flush_policy(ak_logger* pLogger);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
@@ -140,6 +140,17 @@ struct ak_menu_item
     /// The shortcut text of the item.
     char shortcutText[AK_MAX_MENU_ITEM_TEXT_LENGTH];
 
+    /// The action that's handled when the item is picked, or 0 if the item does not have one.
+    ak_action_id actionID;
+
+    /// Whether or not the shortcut text is generated from the shortcut that's bound to the item's action. This is
+    /// cleared when the shortcut text is set explicitly.
+    bool isShortcutTextFromAction;
+
+    /// The shortcut generation of the application at the time the shortcut text was last generated. When this is
+    /// different to the application's the text is stale.
+    unsigned int shortcutTextGeneration;
+
     /// Whether or not the item is a separator.
     bool isSeparator;
 
@@ -178,6 +189,9 @@ static void ak_menu_update_item_layout_info(ak_window* pMenuWindow);
 /// Resizes the menu based on the size of it's menu items.
 static void ak_menu_resize_by_items(ak_window* pMenuWindow);
 
+/// Regenerates the shortcut text of the given item from the shortcut bound to it's action if it's stale. Returns true if the text was changed.
+static bool ak_mi_refresh_shortcut_text(ak_menu_item* pMI);
+
 /// Finds the item under the given point.
 static ak_menu_item* ak_menu_find_item_under_point(ak_window* pMenuWindow, float relativePosX, float relativePosY);
 
@@ -680,6 +694,16 @@ bool ak_menu_on_show(ak_window* pMenuWindow)
         return false;
     }
 
+    // Shortcuts may have been rebound since the menu was last shown.
+    bool isShortcutTextChanged = false;
+    for (ak_menu_item* pMI = pMenu->pFirstItem; pMI != NULL; pMI = pMI->pNextItem) {
+        isShortcutTextChanged = ak_mi_refresh_shortcut_text(pMI) || isShortcutTextChanged;
+    }
+
+    if (isShortcutTextChanged) {
+        ak_menu_resize_by_items(pMenuWindow);
+    }
+
     if (pMenu->onShow) {
         pMenu->onShow(pMenuWindow, pMenu->pOnShowData);
     }
@@ -1022,16 +1046,19 @@ ak_menu_item* ak_create_menu_item(ak_window* pMenuWindow, size_t extraDataSize,
         return NULL;
     }
 
-    pMI->pMenuWindow     = NULL;
-    pMI->pNextItem       = NULL;
-    pMI->pPrevItem       = NULL;
-    pMI->pIcon           = NULL;
-    pMI->iconTintColor   = drgui_rgb(255, 255, 255);
-    pMI->text[0]         = '\0';
-    pMI->shortcutText[0] = '\0';
-    pMI->isSeparator     = false;
-    pMI->isDisabled      = false;
-    pMI->onPicked        = NULL;
+    pMI->pMenuWindow              = NULL;
+    pMI->pNextItem                = NULL;
+    pMI->pPrevItem                = NULL;
+    pMI->pIcon                    = NULL;
+    pMI->iconTintColor            = drgui_rgb(255, 255, 255);
+    pMI->text[0]                  = '\0';
+    pMI->shortcutText[0]          = '\0';
+    pMI->actionID                 = 0;
+    pMI->isShortcutTextFromAction = false;
+    pMI->shortcutTextGeneration   = 0;
+    pMI->isSeparator              = false;
+    pMI->isDisabled               = false;
+    pMI->onPicked                 = NULL;
 
     pMI->extraDataSize = extraDataSize;
     if (pExtraData != NULL) {
@@ -1201,6 +1228,8 @@ void ak_mi_set_shortcut_text(ak_menu_item* pMI, const char* text)
         pMI->shortcutText[0] = '\0';
     }
 
+    pMI->isShortcutTextFromAction = false;
+
     ak_menu_resize_by_items(pMI->pMenuWindow);
 }
 
@@ -1214,6 +1243,33 @@ const char* ak_mi_get_shortcut_text(ak_menu_item* pMI)
 }
 
 
+
+void ak_mi_set_action(ak_menu_item* pMI, ak_action_id actionID)
+{
+    if (pMI == NULL) {
+        return;
+    }
+
+    ak_application* pApplication = ak_get_window_application(pMI->pMenuWindow);
+
+    pMI->actionID                 = actionID;
+    pMI->isShortcutTextFromAction = true;
+    pMI->shortcutTextGeneration   = (pApplication != NULL) ? ak_application_get_shortcut_generation(pApplication) : 0;
+
+    ak_get_action_shortcut_text(pApplication, actionID, pMI->shortcutText, sizeof(pMI->shortcutText));
+    ak_menu_resize_by_items(pMI->pMenuWindow);
+}
+
+ak_action_id ak_mi_get_action(ak_menu_item* pMI)
+{
+    if (pMI == NULL) {
+        return 0;
+    }
+
+    return pMI->actionID;
+}
+
+
 void ak_mi_disable(ak_menu_item* pMI)
 {
     if (pMI == NULL) {
@@ -1267,10 +1323,36 @@ void ak_mi_on_picked(ak_menu_item* pMI)
 
     if (pMI->onPicked) {
         pMI->onPicked(pMI);
+    } else if (pMI->actionID != 0) {
+        ak_handle_action_by_id(ak_get_window_application(pMI->pMenuWindow), pMI->actionID);
     }
 }
 
 
+static bool ak_mi_refresh_shortcut_text(ak_menu_item* pMI)
+{
+    assert(pMI != NULL);
+
+    if (!pMI->isShortcutTextFromAction) {
+        return false;
+    }
+
+    ak_application* pApplication = ak_get_window_application(pMI->pMenuWindow);
+    if (pApplication == NULL) {
+        return false;
+    }
+
+    unsigned int generation = ak_application_get_shortcut_generation(pApplication);
+    if (pMI->shortcutTextGeneration == generation) {
+        return false;
+    }
+
+    pMI->shortcutTextGeneration = generation;
+    ak_get_action_shortcut_text(pApplication, pMI->actionID, pMI->shortcutText, sizeof(pMI->shortcutText));
+
+    return true;
+}
+
 static void ak_mi_append(ak_menu_item* pMI, ak_window* pMenuWindow)
 {
     assert(pMI != NULL);
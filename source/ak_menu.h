@@ -226,6 +226,18 @@ void ak_mi_set_shortcut_text(ak_menu_item* pMI, const char* text);
 /// Retrieves the shortcut text of the given menu item.
 const char* ak_mi_get_shortcut_text(ak_menu_item* pMI);
 
+/// Sets the action to handle when the given menu item is picked.
+///
+/// @remarks
+///     The shortcut text of the item is generated from the shortcut that's bound to the action, and is kept up to date
+///     when shortcuts are rebound. Calling ak_mi_set_shortcut_text() afterwards will override it.
+///     @par
+///     The action is only handled if the item does not have an on_picked handler.
+void ak_mi_set_action(ak_menu_item* pMI, ak_action_id actionID);
+
+/// Retrieves the action of the given menu item.
+ak_action_id ak_mi_get_action(ak_menu_item* pMI);
+
 
 /// Disables the given menu item.
 void ak_mi_disable(ak_menu_item* pMI);
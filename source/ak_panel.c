@@ -1,7 +1,13 @@
 // Public domain. See "unlicense" statement at the end of this file.
 
+// Stored at the start of every panel's data so that panels can be told apart from other elements.
+#define AK_PANEL_TAG    0x4C4E4150      // "PANL"
+
 typedef struct
 {
+    /// Always set to AK_PANEL_TAG. See ak_is_panel().
+    uint32_t tag;
+
     /// A pointer to the main application.
     ak_application* pApplication;
 
@@ -53,6 +59,71 @@ typedef struct
     drgui_element* pActiveTool;
 
 
+    /// The tools attached to the panel in the order they were attached. Since tools are prepended to the tab bar, the
+    /// tool at index 0 is the last one in this list.
+    drgui_element** ppTools;
+
+    /// The number of tools in ppTools.
+    size_t toolCount;
+
+    /// The number of tools ppTools can hold before it needs to be reallocated.
+    size_t toolBufferSize;
+
+    /// The index of the first tool that has a tab. Every tool has a tab unless tab overflow is enabled, in which case
+    /// it's only the tools in the visible window.
+    size_t firstVisibleIndex;
+
+    /// The number of tools that have a tab, starting from firstVisibleIndex.
+    size_t visibleToolCount;
+
+    /// Whether or not there are more tools than there is room for tabs, in which case the overflow button is shown.
+    bool isOverflowing;
+
+    /// Set while the tabs are being replaced so that the tab bar's activation events are ignored.
+    bool isSyncingTabs;
+
+    /// The button at the end of the tab bar for showing the overflow menu. This is created the first time the tab bar
+    /// overflows.
+    drgui_element* pOverflowButton;
+
+    /// The menu listing the tools when the tab bar is overflowing. This is rebuilt each time it's shown.
+    ak_window* pOverflowMenu;
+
+
+    /// Whether or not the layout of the panel's children needs to be refreshed. This is only used for panels in the
+    /// main hierarchy, which are laid out just before their window is painted.
+    bool isLayoutDirty;
+
+    /// Incremented whenever something other than the size of the panel changes that affects the layout of the tab bar
+    /// and tool container. This is the option flags, the tab bar orientation and the number of tools.
+    unsigned int tabGeneration;
+
+    /// The value of tabGeneration when the tab bar and tool container were last laid out.
+    unsigned int laidOutGeneration;
+
+    /// The size of the panel when the tab bar and tool container were last laid out.
+    float laidOutWidth;
+    float laidOutHeight;
+
+
+    /// Whether or not the panel is part of the main hierarchy, which is the root panel of a window and every panel split
+    /// from it. Only panels in the main hierarchy are indexed by type.
+    bool isInMainHierarchy;
+
+    /// The window that owns the panel. This is only set for panels in the main hierarchy, since those are the only
+    /// ones whose window is known at the time they're created. Everything else is resolved by ak_get_panel_window().
+    ak_window* pWindow;
+
+    /// The interned type of the panel. This is null if the panel is not indexed.
+    ak_panel_type_atom* pTypeAtom;
+
+    /// The previous panel in the atom's list of panels.
+    drgui_element* pPrevPanelOfType;
+
+    /// The next panel in the atom's list of panels.
+    drgui_element* pNextPanelOfType;
+
+
     /// The size of the panel's extra data, in bytes.
     size_t extraDataSize;
 
@@ -65,6 +136,67 @@ typedef struct
 ////////////////////////////////////////////////
 // Private API
 
+/// Adds the given panel to the list of panels of it's type, if it's in the main hierarchy and has a type.
+static void ak_panel_index_type(drgui_element* pPanel)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    assert(pPanelData != NULL);
+    assert(pPanelData->pTypeAtom == NULL);
+
+    const char* type = drgui_get_type(pPanel);
+    if (!pPanelData->isInMainHierarchy || type == NULL || type[0] == '\0') {
+        return;
+    }
+
+    ak_panel_type_atom* pAtom = ak_application_intern_panel_type(pPanelData->pApplication, type);
+    if (pAtom == NULL) {
+        return;
+    }
+
+    pPanelData->pTypeAtom        = pAtom;
+    pPanelData->pPrevPanelOfType = pAtom->pLastPanel;
+    pPanelData->pNextPanelOfType = NULL;
+
+    if (pAtom->pLastPanel != NULL) {
+        ak_panel_data* pLastPanelData = drgui_get_extra_data(pAtom->pLastPanel);
+        pLastPanelData->pNextPanelOfType = pPanel;
+    } else {
+        pAtom->pFirstPanel = pPanel;
+    }
+
+    pAtom->pLastPanel = pPanel;
+}
+
+/// Removes the given panel from the list of panels of it's type.
+static void ak_panel_unindex_type(drgui_element* pPanel)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    assert(pPanelData != NULL);
+
+    ak_panel_type_atom* pAtom = pPanelData->pTypeAtom;
+    if (pAtom == NULL) {
+        return;
+    }
+
+    if (pPanelData->pPrevPanelOfType != NULL) {
+        ak_panel_data* pPrevPanelData = drgui_get_extra_data(pPanelData->pPrevPanelOfType);
+        pPrevPanelData->pNextPanelOfType = pPanelData->pNextPanelOfType;
+    } else {
+        pAtom->pFirstPanel = pPanelData->pNextPanelOfType;
+    }
+
+    if (pPanelData->pNextPanelOfType != NULL) {
+        ak_panel_data* pNextPanelData = drgui_get_extra_data(pPanelData->pNextPanelOfType);
+        pNextPanelData->pPrevPanelOfType = pPanelData->pPrevPanelOfType;
+    } else {
+        pAtom->pLastPanel = pPanelData->pPrevPanelOfType;
+    }
+
+    pPanelData->pTypeAtom        = NULL;
+    pPanelData->pPrevPanelOfType = NULL;
+    pPanelData->pNextPanelOfType = NULL;
+}
+
 /// Refreshes the alignment of the child panels of the given panel.
 static void ak_panel_refresh_child_alignments(drgui_element* pPanel)
 {
@@ -82,6 +214,8 @@ static void ak_panel_refresh_child_alignments(drgui_element* pPanel)
     drgui_element* pChildPanel1 = pPanel->pFirstChild;
     drgui_element* pChildPanel2 = pPanel->pFirstChild->pNextSibling;
 
+    ak_application_count_panel_layout(pPanelData->pApplication);
+
     float borderWidth = 0;
     float splitPos = pPanelData->splitPos;
 
@@ -171,6 +305,501 @@ static void ak_panel_refresh_tool_container_layout(drgui_element* pPanel)
     }
 }
 
+/// Retrieves the tool at the given index, where index 0 is the tool at the front of the tab bar.
+static drgui_element* ak_panel_get_tool_at(ak_panel_data* pPanelData, size_t index)
+{
+    assert(pPanelData != NULL);
+    assert(index < pPanelData->toolCount);
+
+    return pPanelData->ppTools[pPanelData->toolCount - 1 - index];
+}
+
+/// Retrieves the index of the given tool, which must be attached to the panel.
+static size_t ak_panel_get_tool_index_internal(ak_panel_data* pPanelData, drgui_element* pTool)
+{
+    assert(pPanelData != NULL);
+    assert(ak_get_tool_panel_slot(pTool) < pPanelData->toolCount);
+    assert(pPanelData->ppTools[ak_get_tool_panel_slot(pTool)] == pTool);
+
+    return pPanelData->toolCount - 1 - ak_get_tool_panel_slot(pTool);
+}
+
+/// Makes sure there is room in the panel's list of tools for another one.
+static bool ak_panel_reserve_tool(ak_panel_data* pPanelData)
+{
+    assert(pPanelData != NULL);
+
+    if (pPanelData->toolCount < pPanelData->toolBufferSize) {
+        return true;
+    }
+
+    size_t newBufferSize = (pPanelData->toolBufferSize == 0) ? 16 : pPanelData->toolBufferSize * 2;
+    drgui_element** ppNewTools = realloc(pPanelData->ppTools, newBufferSize * sizeof(*ppNewTools));
+    if (ppNewTools == NULL) {
+        return false;
+    }
+
+    pPanelData->ppTools        = ppNewTools;
+    pPanelData->toolBufferSize = newBufferSize;
+
+    return true;
+}
+
+/// Adds the given tool to the panel's list of tools, which makes it index 0. There must already be room for it.
+static void ak_panel_push_tool(ak_panel_data* pPanelData, drgui_element* pTool)
+{
+    assert(pPanelData != NULL);
+    assert(pPanelData->toolCount < pPanelData->toolBufferSize);
+
+    ak_set_tool_panel_slot(pTool, pPanelData->toolCount);
+    pPanelData->ppTools[pPanelData->toolCount] = pTool;
+    pPanelData->toolCount += 1;
+}
+
+/// Removes the given tool from the panel's list of tools. The tool's tab must already have been deleted.
+static void ak_panel_remove_tool(ak_panel_data* pPanelData, drgui_element* pTool)
+{
+    assert(pPanelData != NULL);
+
+    size_t index = ak_panel_get_tool_index_internal(pPanelData, pTool);
+    size_t slot  = ak_get_tool_panel_slot(pTool);
+
+    for (size_t i = slot + 1; i < pPanelData->toolCount; ++i) {
+        pPanelData->ppTools[i - 1] = pPanelData->ppTools[i];
+        ak_set_tool_panel_slot(pPanelData->ppTools[i - 1], i - 1);
+    }
+
+    pPanelData->toolCount -= 1;
+
+
+    // The visible window needs to stay on the same tools.
+    if (index < pPanelData->firstVisibleIndex) {
+        pPanelData->firstVisibleIndex -= 1;
+    } else if (index < pPanelData->firstVisibleIndex + pPanelData->visibleToolCount) {
+        pPanelData->visibleToolCount -= 1;
+    }
+
+
+    if (pPanelData->toolCount == 0)
+    {
+        free(pPanelData->ppTools);
+        pPanelData->ppTools           = NULL;
+        pPanelData->toolBufferSize    = 0;
+        pPanelData->firstVisibleIndex = 0;
+        pPanelData->visibleToolCount  = 0;
+
+        if (pPanelData->pOverflowMenu != NULL) {
+            ak_delete_menu(pPanelData->pOverflowMenu);
+            pPanelData->pOverflowMenu = NULL;
+        }
+    }
+}
+
+
+/// Measures the tab of the given tool along the axis the tabs are laid out on.
+///
+/// @remarks
+///     The tab bar does not expose it's own measurements, so this is an estimate based on the theme. It's only used to
+///     decide which tabs will fit when tab overflow is enabled, so it does not need to be exact.
+static float ak_panel_measure_tab(drgui_element* pPanel, drgui_element* pTool)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    assert(pPanelData != NULL);
+
+    ak_theme* pTheme = ak_get_application_theme(pPanelData->pApplication);
+    assert(pTheme != NULL);
+
+    float titleWidth;
+    float titleHeight;
+    ak_get_tool_title_size(pTool, pTheme->pUIFont, &titleWidth, &titleHeight);
+
+    if (pPanelData->tabBarOrientation == drgui_tabbar_orientation_left || pPanelData->tabBarOrientation == drgui_tabbar_orientation_right) {
+        return pTheme->tabPaddingTop + titleHeight + pTheme->tabPaddingBottom;
+    }
+
+    float length = pTheme->tabPaddingLeft + titleWidth + pTheme->tabPaddingRight;
+    if ((pPanelData->optionFlags & AK_PANEL_OPTION_SHOW_CLOSE_BUTTON_ON_TABS) != 0) {
+        length += titleHeight + pTheme->tabPaddingRight;    // The close button is about the same size as the text.
+    }
+
+    return length;
+}
+
+/// Retrieves the size of the overflow button along the axis the tabs are laid out on. The button is square, so this
+/// is the thickness of the tab bar.
+static float ak_panel_get_overflow_button_size(drgui_element* pPanel, drgui_element* pTool)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    assert(pPanelData != NULL);
+
+    ak_theme* pTheme = ak_get_application_theme(pPanelData->pApplication);
+    assert(pTheme != NULL);
+
+    float titleWidth;
+    float titleHeight;
+    ak_get_tool_title_size(pTool, pTheme->pUIFont, &titleWidth, &titleHeight);
+
+    // The tab bar sizes itself to fit it's tabs, but it may not have any yet.
+    float size;
+    if (pPanelData->tabBarOrientation == drgui_tabbar_orientation_left || pPanelData->tabBarOrientation == drgui_tabbar_orientation_right)
+    {
+        size = pTheme->tabPaddingLeft + titleWidth + pTheme->tabPaddingRight;
+        if (size < drgui_get_width(pPanelData->pTabBar)) {
+            size = drgui_get_width(pPanelData->pTabBar);
+        }
+    }
+    else
+    {
+        size = pTheme->tabPaddingTop + titleHeight + pTheme->tabPaddingBottom;
+        if (size < drgui_get_height(pPanelData->pTabBar)) {
+            size = drgui_get_height(pPanelData->pTabBar);
+        }
+    }
+
+    return size;
+}
+
+/// Finds the window of tools whose tabs fit in the given length, making sure the tool at <anchorIndex> is in it.
+///
+/// @remarks
+///     The window starts from where it currently is if it can, so that the tabs do not jump around while the user is
+///     switching between them. Only the tabs in and around the window are measured.
+static void ak_panel_find_visible_tools(drgui_element* pPanel, size_t anchorIndex, float length, size_t* pFirstIndexOut, size_t* pCountOut)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    assert(pPanelData != NULL);
+    assert(anchorIndex < pPanelData->toolCount);
+
+    size_t firstIndex = pPanelData->firstVisibleIndex;
+    if (firstIndex > anchorIndex) {
+        firstIndex = anchorIndex;
+    }
+
+
+    // Fill forward from the start of the window. There is always at least one tab, even if it doesn't fit.
+    float  usedLength = 0;
+    size_t endIndex   = firstIndex;
+    while (endIndex < pPanelData->toolCount)
+    {
+        float tabLength = ak_panel_measure_tab(pPanel, ak_panel_get_tool_at(pPanelData, endIndex));
+        if (endIndex > firstIndex && usedLength + tabLength > length) {
+            break;
+        }
+
+        usedLength += tabLength;
+        endIndex   += 1;
+    }
+
+    if (anchorIndex >= endIndex)
+    {
+        // The anchor did not fit, so fill backward from it instead such that it's the last visible tab.
+        usedLength = 0;
+        endIndex   = anchorIndex + 1;
+        firstIndex = endIndex;
+        while (firstIndex > 0)
+        {
+            float tabLength = ak_panel_measure_tab(pPanel, ak_panel_get_tool_at(pPanelData, firstIndex - 1));
+            if (firstIndex <= anchorIndex && usedLength + tabLength > length) {
+                break;
+            }
+
+            usedLength += tabLength;
+            firstIndex -= 1;
+        }
+    }
+    else if (endIndex == pPanelData->toolCount)
+    {
+        // We've reached the last tool, so any room left over is filled with the tools before the window.
+        while (firstIndex > 0)
+        {
+            float tabLength = ak_panel_measure_tab(pPanel, ak_panel_get_tool_at(pPanelData, firstIndex - 1));
+            if (usedLength + tabLength > length) {
+                break;
+            }
+
+            usedLength += tabLength;
+            firstIndex -= 1;
+        }
+    }
+
+    *pFirstIndexOut = firstIndex;
+    *pCountOut      = endIndex - firstIndex;
+}
+
+/// Replaces the tabs on the tab bar with tabs for the tools in the given range.
+static void ak_panel_set_visible_tools(drgui_element* pPanel, size_t firstIndex, size_t count)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    assert(pPanelData != NULL);
+    assert(firstIndex + count <= pPanelData->toolCount);
+
+    if (pPanelData->firstVisibleIndex == firstIndex && pPanelData->visibleToolCount == count) {
+        return;
+    }
+
+
+    // If the active tool is not going to have a tab it needs to be deactivated properly before it's tab is deleted.
+    if (pPanelData->pActiveTool != NULL)
+    {
+        size_t activeIndex = ak_panel_get_tool_index_internal(pPanelData, pPanelData->pActiveTool);
+        if (activeIndex < firstIndex || activeIndex >= firstIndex + count) {
+            drgui_tabbar_activate_tab(pPanelData->pTabBar, NULL);
+        }
+    }
+
+
+    // The tab bar's activation events are ignored while the tabs are being replaced. The active tool keeps it's state
+    // and is just given it's new tab.
+    pPanelData->isSyncingTabs = true;
+    {
+        for (size_t i = 0; i < pPanelData->visibleToolCount; ++i)
+        {
+            drgui_element* pTool = ak_panel_get_tool_at(pPanelData, pPanelData->firstVisibleIndex + i);
+            drgui_tab_delete(ak_get_tool_tab(pTool));
+            ak_set_tool_tab(pTool, NULL);
+        }
+
+        // Tabs are prepended, so they're created back to front.
+        for (size_t i = count; i > 0; --i)
+        {
+            drgui_element* pTool = ak_panel_get_tool_at(pPanelData, firstIndex + i - 1);
+            drgui_tab* pToolTab = drgui_tabbar_create_and_prepend_tab(pPanelData->pTabBar, ak_get_tool_title(pTool), sizeof(&pTool), &pTool);
+            ak_set_tool_tab(pTool, pToolTab);
+        }
+
+        if (pPanelData->pActiveTool != NULL) {
+            drgui_tabbar_activate_tab(pPanelData->pTabBar, ak_get_tool_tab(pPanelData->pActiveTool));
+        }
+    }
+    pPanelData->isSyncingTabs = false;
+
+    pPanelData->firstVisibleIndex = firstIndex;
+    pPanelData->visibleToolCount  = count;
+}
+
+/// Updates which tools have a tab such that the tab of the given tool is visible.
+///
+/// @remarks
+///     When tab overflow is not enabled every tool has a tab.
+static void ak_panel_refresh_visible_tools(drgui_element* pPanel, drgui_element* pAnchorTool)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    assert(pPanelData != NULL);
+
+    if (pPanelData->toolCount == 0 || (pPanelData->optionFlags & AK_PANEL_OPTION_TAB_OVERFLOW) == 0)
+    {
+        pPanelData->isOverflowing = false;
+        ak_panel_set_visible_tools(pPanel, 0, pPanelData->toolCount);
+        return;
+    }
+
+
+    size_t anchorIndex = pPanelData->firstVisibleIndex;
+    if (pAnchorTool != NULL) {
+        anchorIndex = ak_panel_get_tool_index_internal(pPanelData, pAnchorTool);
+    }
+    if (anchorIndex >= pPanelData->toolCount) {
+        anchorIndex = pPanelData->toolCount - 1;
+    }
+
+    float length;
+    if (pPanelData->tabBarOrientation == drgui_tabbar_orientation_left || pPanelData->tabBarOrientation == drgui_tabbar_orientation_right) {
+        length = drgui_get_height(pPanel);
+    } else {
+        length = drgui_get_width(pPanel);
+    }
+
+
+    // If every tab does not fit, the window needs to be found again with room left for the overflow button.
+    size_t firstIndex;
+    size_t count;
+    ak_panel_find_visible_tools(pPanel, anchorIndex, length, &firstIndex, &count);
+
+    pPanelData->isOverflowing = count < pPanelData->toolCount;
+    if (pPanelData->isOverflowing) {
+        ak_panel_find_visible_tools(pPanel, anchorIndex, length - ak_panel_get_overflow_button_size(pPanel, ak_panel_get_tool_at(pPanelData, anchorIndex)), &firstIndex, &count);
+    }
+
+    ak_panel_set_visible_tools(pPanel, firstIndex, count);
+}
+
+
+static void ak_panel_on_overflow_menu_item_picked(ak_menu_item* pMI)
+{
+    ak_window* pMenuWindow = ak_mi_get_menu(pMI);
+    assert(pMenuWindow != NULL);
+
+    drgui_element* pPanel = *(drgui_element**)ak_menu_get_extra_data(pMenuWindow);
+    assert(pPanel != NULL);
+
+    // The item stores the index of the tool rather than the tool itself so that it can't be left dangling if the tool
+    // is deleted while the menu is open.
+    size_t index = *(size_t*)ak_mi_get_extra_data(pMI);
+
+    ak_menu_hide(pMenuWindow);
+
+    drgui_element* pTool = ak_panel_get_tool_by_index(pPanel, index);
+    if (pTool != NULL) {
+        ak_panel_activate_tool(pPanel, pTool);
+    }
+}
+
+/// Shows the menu listing the tools of the given panel below it's overflow button.
+static void ak_panel_show_overflow_menu(drgui_element* pPanel)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    assert(pPanelData != NULL);
+
+    ak_theme* pTheme = ak_get_application_theme(pPanelData->pApplication);
+    if (pTheme == NULL) {
+        return;
+    }
+
+    if (pPanelData->toolCount == 0 || pPanelData->pOverflowButton == NULL) {
+        return;
+    }
+
+
+    // The tools may have changed since the menu was last shown, so it's created from scratch.
+    if (pPanelData->pOverflowMenu != NULL) {
+        ak_delete_menu(pPanelData->pOverflowMenu);
+    }
+
+    pPanelData->pOverflowMenu = ak_create_menu(pPanelData->pApplication, ak_get_panel_window(pPanel), sizeof(&pPanel), &pPanel);
+    if (pPanelData->pOverflowMenu == NULL) {
+        return;
+    }
+
+    ak_menu_set_font(pPanelData->pOverflowMenu, pTheme->pUIFont);
+
+
+    // There could be thousands of tools, so only the ones around the active tool are listed. If there isn't an active
+    // tool it's the ones around the visible window.
+    size_t centerIndex = pPanelData->firstVisibleIndex;
+    if (pPanelData->pActiveTool != NULL) {
+        centerIndex = ak_panel_get_tool_index_internal(pPanelData, pPanelData->pActiveTool);
+    }
+
+    size_t firstIndex = 0;
+    if (centerIndex > AK_MAX_PANEL_OVERFLOW_MENU_ITEMS/2) {
+        firstIndex = centerIndex - AK_MAX_PANEL_OVERFLOW_MENU_ITEMS/2;
+    }
+
+    size_t endIndex = firstIndex + AK_MAX_PANEL_OVERFLOW_MENU_ITEMS;
+    if (endIndex > pPanelData->toolCount)
+    {
+        endIndex   = pPanelData->toolCount;
+        firstIndex = (endIndex > AK_MAX_PANEL_OVERFLOW_MENU_ITEMS) ? endIndex - AK_MAX_PANEL_OVERFLOW_MENU_ITEMS : 0;
+    }
+
+    for (size_t i = firstIndex; i < endIndex; ++i)
+    {
+        ak_menu_item* pMI = ak_create_menu_item(pPanelData->pOverflowMenu, sizeof(i), &i);
+        if (pMI == NULL) {
+            break;
+        }
+
+        char text[AK_MAX_MENU_ITEM_TEXT_LENGTH];
+        strncpy_s(text, sizeof(text), ak_get_tool_title(ak_panel_get_tool_at(pPanelData, i)), _TRUNCATE);
+
+        ak_mi_set_text(pMI, text);
+        ak_mi_set_on_picked(pMI, ak_panel_on_overflow_menu_item_picked);
+    }
+
+
+    float buttonPosX;
+    float buttonPosY;
+    drgui_get_absolute_position(pPanelData->pOverflowButton, &buttonPosX, &buttonPosY);
+
+    ak_menu_set_position(pPanelData->pOverflowMenu, (int)buttonPosX, (int)(buttonPosY + drgui_get_height(pPanelData->pOverflowButton)));
+    ak_menu_show(pPanelData->pOverflowMenu);
+}
+
+static void ak_panel_on_overflow_button_paint(drgui_element* pButton, drgui_rect relativeRect, void* pPaintData)
+{
+    (void)relativeRect;
+
+    drgui_element* pPanel = *(drgui_element**)drgui_get_extra_data(pButton);
+    assert(pPanel != NULL);
+
+    ak_theme* pTheme = ak_get_application_theme(ak_get_panel_application(pPanel));
+    if (pTheme == NULL) {
+        return;
+    }
+
+    drgui_draw_rect(pButton, drgui_get_local_rect(pButton), pTheme->tabColor, pPaintData);
+
+    float textWidth;
+    float textHeight;
+    drgui_measure_string(pTheme->pUIFont, "...", 3, 1, 1, &textWidth, &textHeight);
+
+    float textPosX = (drgui_get_width(pButton)  - textWidth)  / 2;
+    float textPosY = (drgui_get_height(pButton) - textHeight) / 2;
+    drgui_draw_text(pButton, pTheme->pUIFont, "...", 3, textPosX, textPosY, pTheme->uiFontColor, pTheme->tabColor, pPaintData);
+}
+
+static void ak_panel_on_overflow_button_mouse_button_down(drgui_element* pButton, int mouseButton, int relativeMousePosX, int relativeMousePosY, int stateFlags)
+{
+    (void)relativeMousePosX;
+    (void)relativeMousePosY;
+    (void)stateFlags;
+
+    if (mouseButton != DRGUI_MOUSE_BUTTON_LEFT) {
+        return;
+    }
+
+    drgui_element* pPanel = *(drgui_element**)drgui_get_extra_data(pButton);
+    assert(pPanel != NULL);
+
+    ak_panel_show_overflow_menu(pPanel);
+}
+
+/// Shows or hides the overflow button and places it at the end of the tab bar.
+static void ak_panel_refresh_overflow_button(drgui_element* pPanel, float buttonSize)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    assert(pPanelData != NULL);
+
+    if (!pPanelData->isOverflowing || !drgui_is_visible(pPanelData->pTabBar))
+    {
+        if (pPanelData->pOverflowButton != NULL) {
+            drgui_hide(pPanelData->pOverflowButton);
+        }
+
+        return;
+    }
+
+    if (pPanelData->pOverflowButton == NULL)
+    {
+        pPanelData->pOverflowButton = drgui_create_element(pPanel->pContext, pPanel, sizeof(&pPanel), &pPanel);
+        if (pPanelData->pOverflowButton == NULL) {
+            return;
+        }
+
+        drgui_set_on_paint(pPanelData->pOverflowButton, ak_panel_on_overflow_button_paint);
+        drgui_set_on_mouse_button_down(pPanelData->pOverflowButton, ak_panel_on_overflow_button_mouse_button_down);
+    }
+
+    float tabbarPosX   = drgui_get_relative_position_x(pPanelData->pTabBar);
+    float tabbarPosY   = drgui_get_relative_position_y(pPanelData->pTabBar);
+    float tabbarWidth  = drgui_get_width(pPanelData->pTabBar);
+    float tabbarHeight = drgui_get_height(pPanelData->pTabBar);
+
+    if (pPanelData->tabBarOrientation == drgui_tabbar_orientation_left || pPanelData->tabBarOrientation == drgui_tabbar_orientation_right)
+    {
+        drgui_set_relative_position(pPanelData->pOverflowButton, tabbarPosX, tabbarPosY + tabbarHeight);
+        drgui_set_size(pPanelData->pOverflowButton, tabbarWidth, buttonSize);
+    }
+    else
+    {
+        drgui_set_relative_position(pPanelData->pOverflowButton, tabbarPosX + tabbarWidth, tabbarPosY);
+        drgui_set_size(pPanelData->pOverflowButton, buttonSize, tabbarHeight);
+    }
+
+    drgui_show(pPanelData->pOverflowButton);
+}
+
+
 static void ak_panel_refresh_tabs(drgui_element* pPanel)
 {
     assert(pPanel != NULL);
@@ -181,6 +810,22 @@ static void ak_panel_refresh_tabs(drgui_element* pPanel)
     ak_theme* pTheme = ak_get_application_theme(ak_get_panel_application(pPanel));
     assert(pTheme != NULL);
 
+    ak_application_count_panel_layout(pPanelData->pApplication);
+
+    pPanelData->laidOutGeneration = pPanelData->tabGeneration;
+    pPanelData->laidOutWidth      = drgui_get_width(pPanel);
+    pPanelData->laidOutHeight     = drgui_get_height(pPanel);
+
+
+    // With tab overflow enabled only the tabs that fit are put on the tab bar. This needs to be done first since the
+    // tab bar sizes itself based on it's tabs.
+    ak_panel_refresh_visible_tools(pPanel, pPanelData->pActiveTool);
+
+    float overflowButtonSize = 0;
+    if (pPanelData->isOverflowing) {
+        overflowButtonSize = ak_panel_get_overflow_button_size(pPanel, ak_panel_get_tool_at(pPanelData, pPanelData->firstVisibleIndex));
+    }
+
 
     // The layout of the tab bar needs to be refreshed. We only adjust the width OR height, which depends on the orientation.
     float panelWidth   = drgui_get_width(pPanel);
@@ -194,20 +839,20 @@ static void ak_panel_refresh_tabs(drgui_element* pPanel)
     {
         if (pPanelData->tabBarOrientation == drgui_tabbar_orientation_top)
         {
-            tabbarWidth = panelWidth;
+            tabbarWidth = panelWidth - overflowButtonSize;
         }
         else if (pPanelData->tabBarOrientation == drgui_tabbar_orientation_bottom)
         {
-            tabbarWidth = panelWidth;
+            tabbarWidth = panelWidth - overflowButtonSize;
             tabbarPosY  = panelHeight - tabbarHeight;
         }
         else if (pPanelData->tabBarOrientation == drgui_tabbar_orientation_left)
         {
-            tabbarHeight = panelHeight;
+            tabbarHeight = panelHeight - overflowButtonSize;
         }
         else if (pPanelData->tabBarOrientation == drgui_tabbar_orientation_right)
         {
-            tabbarHeight = panelHeight;
+            tabbarHeight = panelHeight - overflowButtonSize;
             tabbarPosX   = panelWidth - tabbarWidth;
         }
     }
@@ -231,11 +876,111 @@ static void ak_panel_refresh_tabs(drgui_element* pPanel)
         drgui_tabbar_enable_close_on_middle_click(pPanelData->pTabBar);
     }
 
+    ak_panel_refresh_overflow_button(pPanel, overflowButtonSize);
+
 
     // The layout of the tool container needs to be updated first.
     ak_panel_refresh_tool_container_layout(pPanel);
 }
 
+/// Refreshes the layout of the children of the given panel, which is either the two split panels or the tab bar and
+/// tool container.
+static void ak_panel_refresh_layout(drgui_element* pPanel)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    assert(pPanelData != NULL);
+
+    pPanelData->isLayoutDirty = false;
+
+    if (pPanelData->splitAxis == ak_panel_split_axis_none)
+    {
+        // It's not a split panel. We need to resize the tool container, and then each tool. This is only done if
+        // something has actually changed since the last time.
+        if (pPanelData->pToolContainer != NULL)
+        {
+            if (pPanelData->tabGeneration != pPanelData->laidOutGeneration ||
+                pPanelData->laidOutWidth  != drgui_get_width(pPanel) ||
+                pPanelData->laidOutHeight != drgui_get_height(pPanel))
+            {
+                ak_panel_refresh_tabs(pPanel);
+            }
+        }
+    }
+    else
+    {
+        // It's a split panel.
+        ak_panel_refresh_child_alignments(pPanel);
+    }
+}
+
+/// Marks the layout of the given panel's children as needing to be refreshed.
+///
+/// @remarks
+///     Panels in the main hierarchy are not laid out straight away. Instead, every panel in a window is laid out in a
+///     single top-down pass just before the window is painted. This way resizing a window only lays out each panel
+///     once per frame rather than cascading through the whole split tree each time a child is resized. Other panels
+///     have no window to do this for them, so they're laid out straight away.
+///     @par
+///     <needsRepaint> should be true when nothing else is going to cause the window to be painted. This is not needed
+///     when the panel has been resized since that already invalidates it.
+static void ak_panel_invalidate_layout(drgui_element* pPanel, bool needsRepaint)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    assert(pPanelData != NULL);
+
+    if (!pPanelData->isInMainHierarchy) {
+        ak_panel_refresh_layout(pPanel);
+        return;
+    }
+
+    pPanelData->isLayoutDirty = true;
+
+    if (needsRepaint) {
+        drgui_dirty(pPanel, drgui_get_local_rect(pPanel));
+    }
+}
+
+/// Called when something other than the size of the panel changes that affects the layout of the tab bar and tool
+/// container.
+static void ak_panel_invalidate_tab_layout(drgui_element* pPanel)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    assert(pPanelData != NULL);
+
+    pPanelData->tabGeneration += 1;
+    ak_panel_invalidate_layout(pPanel, true);
+}
+
+
+static void ak_panel_on_delete(drgui_element* pPanel)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    assert(pPanelData != NULL);
+
+    // The tools are deleted along with the tool container after this. They're not detached here since that would leave
+    // them orphaned, but they need to forget about the panel so they don't try detaching themselves from it one by one.
+    for (size_t i = 0; i < pPanelData->toolCount; ++i) {
+        ak_set_tool_panel(pPanelData->ppTools[i], NULL);
+        ak_set_tool_tab(pPanelData->ppTools[i], NULL);
+    }
+
+    free(pPanelData->ppTools);
+    pPanelData->ppTools           = NULL;
+    pPanelData->toolCount         = 0;
+    pPanelData->toolBufferSize    = 0;
+    pPanelData->firstVisibleIndex = 0;
+    pPanelData->visibleToolCount  = 0;
+    pPanelData->pActiveTool       = NULL;
+    pPanelData->pHoveredTool      = NULL;
+
+    // The overflow menu is it's own window so it's not deleted with the panel.
+    if (pPanelData->pOverflowMenu != NULL) {
+        ak_delete_menu(pPanelData->pOverflowMenu);
+        pPanelData->pOverflowMenu = NULL;
+    }
+
+    ak_panel_unindex_type(pPanel);
+}
 
 static void ak_panel_on_paint(drgui_element* pPanel, drgui_rect relativeRect, void* pPaintData)
 {
@@ -260,21 +1005,7 @@ static void ak_panel_on_size(drgui_element* pElement, float newWidth, float newH
     (void)newWidth;
     (void)newHeight;
 
-    ak_panel_data* pPanelData = drgui_get_extra_data(pElement);
-    assert(pPanelData != NULL);
-
-    if (pPanelData->splitAxis == ak_panel_split_axis_none)
-    {
-        // It's not a split panel. We need to resize the tool container, and then each tool.
-        if (pPanelData->pToolContainer != NULL) {
-            ak_panel_refresh_tabs(pElement);
-        }
-    }
-    else
-    {
-        // It's a split panel.
-        ak_panel_refresh_child_alignments(pElement);
-    }
+    ak_panel_invalidate_layout(pElement, false);
 }
 
 static void ak_panel_on_mouse_enter(drgui_element* pElement)
@@ -291,8 +1022,6 @@ static void ak_panel_on_mouse_leave(drgui_element* pElement)
     assert(pPanelData != NULL);
 
     pPanelData->isMouseOver = false;
-
-    ak_panel_refresh_tabs(pElement);
 }
 
 static void ak_panel_on_mouse_move(drgui_element* pElement, int relativeMousePosX, int relativeMousePosY, int stateFlags)
@@ -339,6 +1068,11 @@ static void ak_panel_on_tab_deactivated(drgui_element* pTBElement, drgui_tab* pT
     drgui_element* pPanel = *(drgui_element**)drgui_tabbar_get_extra_data(pTBElement);
     assert(pPanel != NULL);
 
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData->isSyncingTabs) {
+        return;
+    }
+
     drgui_element* pTool = *(drgui_element**)drgui_tab_get_extra_data(pTab);
     assert(pTool != NULL);
 
@@ -346,7 +1080,6 @@ static void ak_panel_on_tab_deactivated(drgui_element* pTBElement, drgui_tab* pT
     // The tool needs to be hidden.
     drgui_hide(pTool);
 
-    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
     pPanelData->pActiveTool = NULL;
 
     ak_application_on_tool_deactivated(pPanelData->pApplication, pTool);
@@ -357,14 +1090,30 @@ static void ak_panel_on_tab_activated(drgui_element* pTBElement, drgui_tab* pTab
     drgui_element* pPanel = *(drgui_element**)drgui_tabbar_get_extra_data(pTBElement);
     assert(pPanel != NULL);
 
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData->isSyncingTabs) {
+        return;
+    }
+
     drgui_element* pTool = *(drgui_element**)drgui_tab_get_extra_data(pTab);
     assert(pTool != NULL);
 
+    // If the tool is a placeholder, this is the first time it's been activated which means the real tool needs to be
+    // created. If that fails the placeholder is left in it's place.
+    if (ak_is_placeholder_tool(pTool)) {
+        pTool = ak_panel_realize_tool(pPanel, pTool);
+    }
+
+    // A hibernated tool needs to recreate everything it released before it's shown. If that fails it's still shown so
+    // that the tab is not left blank, and restoring it is tried again the next time it's activated.
+    if (ak_is_tool_hibernating(pTool)) {
+        ak_restore_tool(pTool);
+    }
+
 
     // The tool needs to be shown.
     drgui_show(pTool);
 
-    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
     pPanelData->pActiveTool = pTool;
 
     ak_application_on_tool_activated(pPanelData->pApplication, pTool);
@@ -391,6 +1140,7 @@ drgui_element* ak_create_panel(ak_application* pApplication, drgui_element* pPar
         ak_panel_data* pPanelData = drgui_get_extra_data(pElement);
         assert(pPanelData != NULL);
 
+        pPanelData->tag                = AK_PANEL_TAG;
         pPanelData->pApplication       = pApplication;
         pPanelData->splitAxis          = ak_panel_split_axis_none;
         pPanelData->splitPos           = 0;
@@ -406,11 +1156,31 @@ drgui_element* ak_create_panel(ak_application* pApplication, drgui_element* pPar
         pPanelData->relativeMousePosY  = 0;
         pPanelData->pActiveTool        = NULL;
         pPanelData->pHoveredTool       = NULL;
+        pPanelData->ppTools            = NULL;
+        pPanelData->toolCount          = 0;
+        pPanelData->toolBufferSize     = 0;
+        pPanelData->firstVisibleIndex  = 0;
+        pPanelData->visibleToolCount   = 0;
+        pPanelData->isOverflowing      = false;
+        pPanelData->isSyncingTabs      = false;
+        pPanelData->pOverflowButton    = NULL;
+        pPanelData->pOverflowMenu      = NULL;
+        pPanelData->isLayoutDirty      = false;
+        pPanelData->tabGeneration      = 0;
+        pPanelData->laidOutGeneration  = 0;
+        pPanelData->laidOutWidth       = 0;
+        pPanelData->laidOutHeight      = 0;
+        pPanelData->isInMainHierarchy  = false;
+        pPanelData->pWindow            = NULL;
+        pPanelData->pTypeAtom          = NULL;
+        pPanelData->pPrevPanelOfType   = NULL;
+        pPanelData->pNextPanelOfType   = NULL;
         pPanelData->extraDataSize      = extraDataSize;
         if (pExtraData != NULL) {
             memcpy(pPanelData->pExtraData, pExtraData, extraDataSize);
         }
 
+        drgui_set_on_delete(pElement, ak_panel_on_delete);
         drgui_set_on_paint(pElement, ak_panel_on_paint);
         drgui_set_on_size(pElement, ak_panel_on_size);
         drgui_set_on_mouse_enter(pElement, ak_panel_on_mouse_enter);
@@ -460,7 +1230,14 @@ void* ak_panel_get_extra_data(drgui_element* pPanel)
 
 void ak_panel_set_type(drgui_element* pPanel, const char* type)
 {
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return;
+    }
+
+    ak_panel_unindex_type(pPanel);
     drgui_set_type(pPanel, type);
+    ak_panel_index_type(pPanel);
 }
 
 const char* ak_panel_get_type(drgui_element* pPanel)
@@ -480,6 +1257,29 @@ drgui_element* ak_panel_find_by_type_recursive(drgui_element* pPanel, const char
     }
 
 
+    // Panels in the main hierarchy are indexed by type, in which case we can just look for a panel of that type that
+    // is a descendant of this one rather than searching every descendant.
+    if (pPanelData->isInMainHierarchy)
+    {
+        ak_panel_type_atom* pAtom = ak_application_find_panel_type(pPanelData->pApplication, type);
+        if (pAtom == NULL) {
+            return NULL;
+        }
+
+        for (drgui_element* pCandidate = pAtom->pFirstPanel; pCandidate != NULL; pCandidate = ak_panel_get_next_panel_of_same_type(pCandidate))
+        {
+            for (drgui_element* pAncestor = pCandidate; pAncestor != NULL; pAncestor = pAncestor->pParent)
+            {
+                if (pAncestor == pPanel) {
+                    return pCandidate;
+                }
+            }
+        }
+
+        return NULL;
+    }
+
+
     if (strcmp(drgui_get_type(pPanel), type) == 0) {
         return pPanel;
     }
@@ -516,9 +1316,31 @@ bool ak_panel_split(drgui_element* pPanel, ak_panel_split_axis splitAxis, float
         return false;
     }
 
-    // It's an error for a panel to be split while it has tools attached.
-    if (pPanelData->pToolContainer != NULL) {
-        return false;
+    // It's an error for a panel to be split while it has tools attached. If every tool has been detached, the tab bar
+    // and tool container are left behind, so they need to be deleted.
+    if (pPanelData->pToolContainer != NULL)
+    {
+        if (pPanelData->pToolContainer->pFirstChild != NULL) {
+            return false;
+        }
+
+        if (pPanelData->pOverflowButton != NULL) {
+            drgui_delete_element(pPanelData->pOverflowButton);
+        }
+        if (pPanelData->pOverflowMenu != NULL) {
+            ak_delete_menu(pPanelData->pOverflowMenu);
+        }
+
+        drgui_delete_element(pPanelData->pToolContainer);
+        drgui_delete_tab_bar(pPanelData->pTabBar);
+
+        pPanelData->pToolContainer  = NULL;
+        pPanelData->pTabBar         = NULL;
+        pPanelData->pActiveTool     = NULL;
+        pPanelData->pHoveredTool    = NULL;
+        pPanelData->pOverflowButton = NULL;
+        pPanelData->pOverflowMenu   = NULL;
+        pPanelData->isOverflowing   = false;
     }
 
 
@@ -530,6 +1352,16 @@ bool ak_panel_split(drgui_element* pPanel, ak_panel_split_axis splitAxis, float
     {
         pChildPanel1 = ak_create_panel(pPanelData->pApplication, pPanel, 0, NULL);
         pChildPanel2 = ak_create_panel(pPanelData->pApplication, pPanel, 0, NULL);
+
+        // Split panels are in the same hierarchy and window as their parent.
+        if (pChildPanel1 != NULL) {
+            ((ak_panel_data*)drgui_get_extra_data(pChildPanel1))->isInMainHierarchy = pPanelData->isInMainHierarchy;
+            ((ak_panel_data*)drgui_get_extra_data(pChildPanel1))->pWindow           = pPanelData->pWindow;
+        }
+        if (pChildPanel2 != NULL) {
+            ((ak_panel_data*)drgui_get_extra_data(pChildPanel2))->isInMainHierarchy = pPanelData->isInMainHierarchy;
+            ((ak_panel_data*)drgui_get_extra_data(pChildPanel2))->pWindow           = pPanelData->pWindow;
+        }
     }
     else
     {
@@ -564,6 +1396,9 @@ void ak_panel_unsplit(drgui_element* pPanel)
     }
 
 
+    ak_panel_unindex_recursive(pPanel->pFirstChild->pNextSibling);
+    ak_panel_unindex_recursive(pPanel->pFirstChild);
+
     drgui_delete_element(pPanel->pFirstChild->pNextSibling);
     drgui_delete_element(pPanel->pFirstChild);
 
@@ -659,7 +1494,8 @@ void ak_panel_disable_ratio_split(drgui_element* pPanel)
 }
 
 
-bool ak_panel_attach_tool(drgui_element* pPanel, drgui_element* pTool)
+/// Adds the given tool and it's tab to the panel without activating it or refreshing the layout of the panel.
+static bool ak_panel_insert_tool(drgui_element* pPanel, drgui_element* pTool)
 {
     ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
     if (pPanelData == NULL) {
@@ -686,6 +1522,10 @@ bool ak_panel_attach_tool(drgui_element* pPanel, drgui_element* pTool)
         ak_panel_detach_tool(ak_get_tool_panel(pTool), pTool);
     }
 
+    if (!ak_panel_reserve_tool(pPanelData)) {
+        return false;
+    }
+
 
     float innerScaleX;
     float innerScaleY;
@@ -759,6 +1599,7 @@ bool ak_panel_attach_tool(drgui_element* pPanel, drgui_element* pTool)
 
     drgui_prepend(pTool, pPanelData->pToolContainer);
     ak_set_tool_panel(pTool, pPanel);
+    ak_panel_push_tool(pPanelData, pTool);
 
 
     // Initial size and position.
@@ -766,20 +1607,82 @@ bool ak_panel_attach_tool(drgui_element* pPanel, drgui_element* pTool)
     drgui_set_size(pTool, drgui_get_width(pPanelData->pToolContainer) / innerScaleX, drgui_get_height(pPanelData->pToolContainer) / innerScaleY);
 
 
-    // We need to create and prepend a tab for the tool.
-    drgui_tab* pToolTab = drgui_tabbar_create_and_prepend_tab(pPanelData->pTabBar, ak_get_tool_title(pTool), sizeof(&pTool), &pTool);
-    ak_set_tool_tab(pTool, pToolTab);
+    // We need to create and prepend a tab for the tool. With tab overflow enabled the tool does not get a tab until the
+    // visible window is refreshed, and the window is moved along by one so that it stays on the same tools. The same
+    // applies if the window has not been refreshed since tab overflow was disabled.
+    if ((pPanelData->optionFlags & AK_PANEL_OPTION_TAB_OVERFLOW) == 0 && pPanelData->firstVisibleIndex == 0)
+    {
+        drgui_tab* pToolTab = drgui_tabbar_create_and_prepend_tab(pPanelData->pTabBar, ak_get_tool_title(pTool), sizeof(&pTool), &pTool);
+        ak_set_tool_tab(pTool, pToolTab);
+
+        pPanelData->visibleToolCount += 1;
+    }
+    else
+    {
+        pPanelData->firstVisibleIndex += 1;
+    }
+
+
+    // The tool is not active yet, so it needs to be hidden in case it was visible in the panel it was previously
+    // attached to.
+    drgui_hide(pTool);
+
+    return true;
+}
 
+static bool ak_panel_attach_tool_internal(drgui_element* pPanel, drgui_element* pTool, bool activate)
+{
+    if (!ak_panel_insert_tool(pPanel, pTool)) {
+        return false;
+    }
 
-    // Activate the new tool.
-    ak_panel_activate_tool(pPanel, pTool);
+    if (activate) {
+        ak_panel_activate_tool(pPanel, pTool);
+    }
 
     // The tab bar might need to be refreshed.
-    ak_panel_refresh_tabs(pPanel);
+    ak_panel_invalidate_tab_layout(pPanel);
 
     return true;
 }
 
+bool ak_panel_attach_tool(drgui_element* pPanel, drgui_element* pTool)
+{
+    return ak_panel_attach_tool_internal(pPanel, pTool, true);
+}
+
+bool ak_panel_attach_tools(drgui_element* pPanel, drgui_element** ppTools, size_t count, size_t activeIndex)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return false;
+    }
+
+    if (ppTools == NULL || count == 0) {
+        return false;
+    }
+
+
+    // Every tool is inserted before anything is activated or laid out. That way there's only a single activation and
+    // the layout is only invalidated once for the whole lot.
+    bool result = true;
+    for (size_t i = 0; i < count; ++i) {
+        if (!ak_panel_insert_tool(pPanel, ppTools[i])) {
+            result = false;
+        }
+    }
+
+    // Activating a placeholder replaces it with the real tool, so the caller's list is updated to match.
+    if (activeIndex < count && ppTools[activeIndex] != NULL && ak_get_tool_panel(ppTools[activeIndex]) == pPanel) {
+        ak_panel_activate_tool(pPanel, ppTools[activeIndex]);
+        ppTools[activeIndex] = ak_panel_get_active_tool(pPanel);
+    }
+
+    ak_panel_invalidate_tab_layout(pPanel);
+
+    return result;
+}
+
 void ak_panel_detach_tool(drgui_element* pPanel, drgui_element* pTool)
 {
     ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
@@ -802,28 +1705,81 @@ void ak_panel_detach_tool(drgui_element* pPanel, drgui_element* pTool)
     }
 
 
-    // If the tab is the active one we need to switch to another.
-    drgui_tab* pTab = ak_get_tool_tab(pTool);
-    if (drgui_tabbar_get_active_tab(pPanelData->pTabBar) == pTab)
+    // If the tool is the active one we need to switch to the one after it, or the one before it if it's the last one.
+    if (pPanelData->pActiveTool == pTool)
     {
-        drgui_tab* pNextTab = drgui_tab_get_next_tab(pTab);
-        if (pNextTab == NULL) {
-            pNextTab = drgui_tab_get_prev_tab(pTab);
+        size_t index = ak_panel_get_tool_index_internal(pPanelData, pTool);
+
+        drgui_element* pNextTool = NULL;
+        if (index + 1 < pPanelData->toolCount) {
+            pNextTool = ak_panel_get_tool_at(pPanelData, index + 1);
+        } else if (index > 0) {
+            pNextTool = ak_panel_get_tool_at(pPanelData, index - 1);
         }
 
-        drgui_tabbar_activate_tab(pPanelData->pTabBar, pNextTab);
+        ak_panel_activate_tool(pPanel, pNextTool);
     }
 
 
     drgui_detach(pTool);
     ak_set_tool_panel(pTool, NULL);
 
-    drgui_tab_delete(ak_get_tool_tab(pTool));
-    ak_set_tool_tab(pTool, NULL);
+    if (ak_get_tool_tab(pTool) != NULL) {
+        drgui_tab_delete(ak_get_tool_tab(pTool));
+        ak_set_tool_tab(pTool, NULL);
+    }
+
+    ak_panel_remove_tool(pPanelData, pTool);
+
+    if (pPanelData->pHoveredTool == pTool) {
+        pPanelData->pHoveredTool = NULL;
+    }
+
+
+    // The tab bar might need to be refreshed.
+    ak_panel_invalidate_tab_layout(pPanel);
+}
+
+void ak_panel_detach_all_tools(drgui_element* pPanel)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return;
+    }
+
+    if (pPanelData->splitAxis != ak_panel_split_axis_none) {
+        return;
+    }
+    if (pPanelData->pToolContainer == NULL || pPanelData->pToolContainer->pFirstChild == NULL) {
+        return;
+    }
+
+
+    // The active tool is deactivated first so that removing it does not activate another tab. The deactivation event
+    // is what hides it.
+    drgui_tabbar_activate_tab(pPanelData->pTabBar, NULL);
+
+    // Tools are removed from the end of the list so that nothing needs to be moved along.
+    while (pPanelData->toolCount > 0)
+    {
+        drgui_element* pTool = ak_panel_get_tool_at(pPanelData, 0);
+
+        drgui_detach(pTool);
+        ak_set_tool_panel(pTool, NULL);
+
+        if (ak_get_tool_tab(pTool) != NULL) {
+            drgui_tab_delete(ak_get_tool_tab(pTool));
+            ak_set_tool_tab(pTool, NULL);
+        }
+
+        ak_panel_remove_tool(pPanelData, pTool);
+    }
+
+    pPanelData->pHoveredTool = NULL;
 
 
     // The tab bar might need to be refreshed.
-    ak_panel_refresh_tabs(pPanel);
+    ak_panel_invalidate_tab_layout(pPanel);
 }
 
 
@@ -838,6 +1794,14 @@ bool ak_panel_activate_tool(drgui_element* pPanel, drgui_element* pTool)
         return false;
     }
 
+    // With tab overflow enabled the tool may not have a tab, in which case the visible window needs to be moved so
+    // that it does. The overflow button may need to be shown or hidden as a result, so the layout is refreshed.
+    if (pTool != NULL && ak_get_tool_tab(pTool) == NULL)
+    {
+        ak_panel_refresh_visible_tools(pPanel, pTool);
+        ak_panel_invalidate_tab_layout(pPanel);
+    }
+
     // To activate a tool we just activate the associated tab on the tab bar control which will in turn post
     // activate and deactivate events which is where the actual swith will occur.
     drgui_tabbar_activate_tab(pPanelData->pTabBar, ak_get_tool_tab(pTool));
@@ -888,6 +1852,226 @@ drgui_element* ak_panel_get_next_tool(drgui_element* pPanel, drgui_element* pToo
     return pTool->pNextSibling;
 }
 
+size_t ak_panel_get_tool_count(drgui_element* pPanel)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return 0;
+    }
+
+    return pPanelData->toolCount;
+}
+
+drgui_element* ak_panel_get_tool_by_index(drgui_element* pPanel, size_t index)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return NULL;
+    }
+
+    if (index >= pPanelData->toolCount) {
+        return NULL;
+    }
+
+    return ak_panel_get_tool_at(pPanelData, index);
+}
+
+size_t ak_panel_get_tool_index(drgui_element* pPanel, drgui_element* pTool)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return (size_t)-1;
+    }
+
+    if (pTool == NULL || ak_get_tool_panel(pTool) != pPanel) {
+        return (size_t)-1;
+    }
+
+    return ak_panel_get_tool_index_internal(pPanelData, pTool);
+}
+
+
+
+bool ak_panel_attach_inactive_tool(drgui_element* pPanel, drgui_element* pTool)
+{
+    return ak_panel_attach_tool_internal(pPanel, pTool, false);
+}
+
+drgui_element* ak_panel_realize_tool(drgui_element* pPanel, drgui_element* pPlaceholder)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return NULL;
+    }
+
+    if (pPlaceholder == NULL || pPlaceholder->pParent != pPanelData->pToolContainer) {
+        return NULL;
+    }
+
+    if (!ak_is_placeholder_tool(pPlaceholder)) {
+        return pPlaceholder;
+    }
+
+
+    drgui_element* pTool = ak_create_tool_by_type_and_attributes(pPanelData->pApplication, ak_get_panel_window(pPanel), ak_get_tool_layout_type(pPlaceholder), ak_get_tool_layout_attributes(pPlaceholder));
+    if (pTool == NULL) {
+        ak_warningf(pPanelData->pApplication, "Failed to create tool of type \"%s\".", ak_get_tool_layout_type(pPlaceholder));
+        return pPlaceholder;
+    }
+
+
+    float innerScaleX;
+    float innerScaleY;
+    drgui_get_absolute_inner_scale(pPanel, &innerScaleX, &innerScaleY);
+
+    // The real tool takes the placeholder's place in the container so the order of the tools does not change.
+    drgui_append_sibling(pTool, pPlaceholder);
+    ak_set_tool_panel(pTool, pPanel);
+
+    drgui_set_relative_position(pTool, 0, 0);
+    drgui_set_size(pTool, drgui_get_width(pPanelData->pToolContainer) / innerScaleX, drgui_get_height(pPanelData->pToolContainer) / innerScaleY);
+
+
+    // The real tool also takes the placeholder's place in the list of tools so that it keeps the same index.
+    size_t slot = ak_get_tool_panel_slot(pPlaceholder);
+    pPanelData->ppTools[slot] = pTool;
+    ak_set_tool_panel_slot(pTool, slot);
+
+
+    // The placeholder's tab is reused rather than creating a new one so that it stays in the same place on the tab bar.
+    // It won't have a tab if it's outside the visible window.
+    drgui_tab* pTab = ak_get_tool_tab(pPlaceholder);
+    if (pTab != NULL)
+    {
+        *(drgui_element**)drgui_tab_get_extra_data(pTab) = pTool;
+        drgui_tab_set_text(pTab, ak_get_tool_title(pTool));
+        ak_set_tool_tab(pTool, pTab);
+    }
+
+    if (pPanelData->pHoveredTool == pPlaceholder) {
+        pPanelData->pHoveredTool = pTool;
+    }
+
+
+    drgui_detach(pPlaceholder);
+    ak_set_tool_panel(pPlaceholder, NULL);
+    ak_set_tool_tab(pPlaceholder, NULL);
+    ak_delete_tool(pPlaceholder);
+
+    // The number of tools is the same, so the layout of the panel does not need to be refreshed. The tab bar takes care
+    // of itself if the title has changed, but with tab overflow enabled it might change which tabs fit.
+    ak_panel_on_tool_title_changed(pPanel, pTool);
+
+    return pTool;
+}
+
+
+void ak_panel_on_tool_title_changed(drgui_element* pPanel, drgui_element* pTool)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return;
+    }
+
+    (void)pTool;
+
+    // The tab bar takes care of itself when the title of a tab changes, but with tab overflow enabled the new title
+    // might change which tabs fit.
+    if ((pPanelData->optionFlags & AK_PANEL_OPTION_TAB_OVERFLOW) != 0) {
+        ak_panel_invalidate_tab_layout(pPanel);
+    }
+}
+
+
+void ak_panel_mark_as_window_root(drgui_element* pPanel, ak_window* pWindow)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return;
+    }
+
+    pPanelData->isInMainHierarchy = true;
+    pPanelData->pWindow           = pWindow;
+}
+
+void ak_panel_unindex_recursive(drgui_element* pPanel)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return;
+    }
+
+    ak_panel_unindex_type(pPanel);
+
+    if (pPanelData->splitAxis != ak_panel_split_axis_none) {
+        ak_panel_unindex_recursive(ak_panel_get_split_panel_1(pPanel));
+        ak_panel_unindex_recursive(ak_panel_get_split_panel_2(pPanel));
+    }
+}
+
+ak_panel_type_atom* ak_panel_get_type_atom(drgui_element* pPanel)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return NULL;
+    }
+
+    return pPanelData->pTypeAtom;
+}
+
+bool ak_is_panel(drgui_element* pElement)
+{
+    if (pElement == NULL) {
+        return false;
+    }
+
+    // The size is checked first so that the tag is never read from outside of a smaller element's data.
+    if (drgui_get_extra_data_size(pElement) < sizeof(ak_panel_data) - sizeof(char)) {
+        return false;
+    }
+
+    ak_panel_data* pPanelData = drgui_get_extra_data(pElement);
+    return pPanelData != NULL && pPanelData->tag == AK_PANEL_TAG;
+}
+
+ak_window* ak_panel_get_cached_window(drgui_element* pPanel)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return NULL;
+    }
+
+    return pPanelData->pWindow;
+}
+
+drgui_element* ak_panel_get_next_panel_of_same_type(drgui_element* pPanel)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return NULL;
+    }
+
+    return pPanelData->pNextPanelOfType;
+}
+
+void ak_panel_update_layout(drgui_element* pPanel)
+{
+    ak_panel_data* pPanelData = drgui_get_extra_data(pPanel);
+    if (pPanelData == NULL) {
+        return;
+    }
+
+    if (pPanelData->isLayoutDirty) {
+        ak_panel_refresh_layout(pPanel);
+    }
+
+    // The split panels are done after their parent since that's what sets their size.
+    if (pPanelData->splitAxis != ak_panel_split_axis_none) {
+        ak_panel_update_layout(ak_panel_get_split_panel_1(pPanel));
+        ak_panel_update_layout(ak_panel_get_split_panel_2(pPanel));
+    }
+}
+
 
 void ak_panel_set_tab_options(drgui_element* pPanel, unsigned int options)
 {
@@ -896,10 +2080,14 @@ void ak_panel_set_tab_options(drgui_element* pPanel, unsigned int options)
         return;
     }
 
+    if (pPanelData->optionFlags == options) {
+        return;
+    }
+
     pPanelData->optionFlags = options;
 
     // The tabs need to be refreshed in order to reflect the new options.
-    ak_panel_refresh_tabs(pPanel);
+    ak_panel_invalidate_tab_layout(pPanel);
 }
 
 void ak_panel_set_tab_close_button_image(drgui_element* pPanel, drgui_image* pImage)
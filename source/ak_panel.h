@@ -20,6 +20,10 @@
 //   "ak_tool" object - they are just drgui_element objects.
 // - Tools and panels should be deleted with drgui_delete_element(), however they should be first
 //   disassociated with the relevant parts of the application.
+// - The tools of a panel are indexed, with index 0 being the tool at the front of the tab bar.
+// - Panels that can have a very large number of tools should enable AK_PANEL_OPTION_TAB_OVERFLOW. With this
+//   option only the tools whose tabs fit on the tab bar are given a tab. The rest are accessed from a dropdown
+//   that's shown with the button at the end of the tab bar.
 // 
 
 #ifndef ak_panel_h
@@ -38,6 +42,11 @@ typedef struct ak_application ak_application;
 #define AK_PANEL_OPTION_ALLOW_TAB_PINNING          4
 #define AK_PANEL_OPTION_ALLOW_TAB_MOVE             8
 #define AK_PANEL_OPTION_EXPANDABLE                 16
+#define AK_PANEL_OPTION_TAB_OVERFLOW               32
+
+#ifndef AK_MAX_PANEL_OVERFLOW_MENU_ITEMS
+#define AK_MAX_PANEL_OVERFLOW_MENU_ITEMS           32
+#endif
 
 typedef enum
 {
@@ -53,6 +62,9 @@ typedef enum
 ///
 /// @remarks
 ///     An empty panel contains no children and no tools.
+///     @par
+///     The panel's list of tools and it's overflow menu are freed by the element's on_delete event, so it should not be
+///     replaced with drgui_set_on_delete().
 drgui_element* ak_create_panel(ak_application* pApplication, drgui_element* pParent, size_t extraDataSize, const void* pExtraData);
 
 
@@ -73,7 +85,10 @@ size_t ak_panel_get_extra_data_size(drgui_element* pPanel);
 void* ak_panel_get_extra_data(drgui_element* pPanel);
 
 
-/// Sets the name of the panel.
+/// Sets the type of the panel.
+///
+/// @remarks
+///     This keeps the application's type index up to date, so always use this rather than drgui_set_type().
 void ak_panel_set_type(drgui_element* pPanel, const char* type);
 
 /// Retrieves the type of the panel.
@@ -83,6 +98,10 @@ void ak_panel_set_type(drgui_element* pPanel, const char* type);
 const char* ak_panel_get_type(drgui_element* pPanel);
 
 /// Recursively searches for a panel with the given type, including <pPanel>.
+///
+/// @remarks
+///     Unlike ak_panel_is_of_type(), this looks for an exact match. For panels in the main hierarchy this uses the
+///     application's type index rather than searching every descendant.
 drgui_element* ak_panel_find_by_type_recursive(drgui_element* pPanel, const char* type);
 
 /// Determines if the given panel is of the given type.
@@ -143,8 +162,23 @@ void ak_panel_disable_ratio_split(drgui_element* pPanel);
 ///     This will fail if the given panel is a split panel.
 ///     @par
 ///     If the tool is already attached to another tool it will be detached first.
+///     @par
+///     The tool is activated, so if it's a placeholder it will be replaced and deleted. See ak_panel_activate_tool().
 bool ak_panel_attach_tool(drgui_element* pPanel, drgui_element* pTool);
 
+/// Attaches a list of tools to the given panel.
+///
+/// @remarks
+///     This is the same as calling ak_panel_attach_tool() for each tool in order, except that only the tool at
+///     <activeIndex> is activated and the panel's layout is only refreshed once. Pass an index that's out of range to
+///     leave the active tool as-is.
+///     @par
+///     This returns false if any of the tools failed to be attached. The others are still attached.
+///     @par
+///     If the tool at <activeIndex> is a placeholder it's replaced when it's activated, in which case it's entry in
+///     <ppTools> is updated to point to the real tool.
+bool ak_panel_attach_tools(drgui_element* pPanel, drgui_element** ppTools, size_t count, size_t activeIndex);
+
 /// Detaches the given tool from the given panel.
 ///
 /// @remarks
@@ -154,6 +188,13 @@ bool ak_panel_attach_tool(drgui_element* pPanel, drgui_element* pTool);
 ///     it from this one.
 void ak_panel_detach_tool(drgui_element* pPanel, drgui_element* pTool);
 
+/// Detaches every tool from the given panel.
+///
+/// @remarks
+///     This is the same as calling ak_panel_detach_tool() for each tool, except that no other tool is activated as
+///     the active one is removed, and the panel's layout is only refreshed once.
+void ak_panel_detach_all_tools(drgui_element* pPanel);
+
 
 /// Activates the given tool by deactivating the previously active tool and then activating this one.
 ///
@@ -161,6 +202,9 @@ void ak_panel_detach_tool(drgui_element* pPanel, drgui_element* pTool);
 ///     Activating a tab involves activating the tab and showing the tool.
 ///     @par
 ///     This will fail is <pTool> is not attached to <pPanel>.
+///     @par
+///     If <pTool> is a placeholder, it's replaced with the real tool and deleted, so <pTool> must not be used afterwards.
+///     Use ak_panel_get_active_tool() to retrieve the tool that replaced it.
 bool ak_panel_activate_tool(drgui_element* pPanel, drgui_element* pTool);
 
 /// Retrieves a pointer to the active tool in the given panel, if any.
@@ -173,6 +217,19 @@ drgui_element* ak_panel_get_first_tool(drgui_element* pPanel);
 /// Retrieves a pointer to the next tool that's attached to the given panel.
 drgui_element* ak_panel_get_next_tool(drgui_element* pPanel, drgui_element* pTool);
 
+/// Retrieves the number of tools that are attached to the given panel.
+size_t ak_panel_get_tool_count(drgui_element* pPanel);
+
+/// Retrieves the tool at the given index.
+///
+/// @remarks
+///     Index 0 is the same tool as ak_panel_get_first_tool(), and each index after that is the same as calling
+///     ak_panel_get_next_tool() on the previous one. This does not need to walk the list of tools.
+drgui_element* ak_panel_get_tool_by_index(drgui_element* pPanel, size_t index);
+
+/// Retrieves the index of the given tool, or (size_t)-1 if it's not attached to the given panel.
+size_t ak_panel_get_tool_index(drgui_element* pPanel, drgui_element* pTool);
+
 
 /// Sets the option flags to use for the tab bar.
 ///
@@ -0,0 +1,129 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+//
+// QUICK NOTES
+//
+// - The application keeps an index of every typed panel in the main hierarchy, which is the tree of panels made up of
+//   the root panel of each window and the panels that are split from them. Panels inside custom tools are not indexed.
+// - Each type is interned as an ak_panel_type_atom, and each atom has an intrusive list of the panels of that exact
+//   type. Sub-types are children of the atom for their parent type, so "My.Panel.Type" is a child of "My.Panel".
+// - The index is updated by ak_panel_set_type(), so panels in the main hierarchy must not have their type set with
+//   drgui_set_type() directly.
+// - Panels in the main hierarchy also cache the window that owns them. Panels never move between windows, so this is
+//   set once when the window's root panel is created and copied to each panel as it is split off.
+// - Panels in the main hierarchy are not laid out as soon as they're resized. They're marked as dirty instead, and the
+//   window lays out every dirty panel in a single top-down pass with ak_panel_update_layout() just before it's painted.
+// - Each panel keeps an array of it's tools in the order they were attached, and each tool stores it's position in that
+//   array. This is what makes index lookups constant time. The tab bar shows them in reverse order.
+// - With AK_PANEL_OPTION_TAB_OVERFLOW, only the tools in the visible window have a tab. The tab of every other tool is
+//   null. The window always includes the active tool, and is moved when a tool outside of it is activated.
+//
+
+#ifndef ak_panel_private_h
+#define ak_panel_private_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct drgui_element drgui_element;
+typedef struct ak_panel_type_atom ak_panel_type_atom;
+typedef struct ak_window ak_window;
+
+/// Marks the given panel as the root panel of the given window.
+///
+/// @remarks
+///     This puts the panel and every panel that is later split from it in the main hierarchy, and caches the window
+///     on each of them. This is only used by windows when their root panel is created, and must be called before the
+///     panel's type is set.
+void ak_panel_mark_as_window_root(drgui_element* pPanel, ak_window* pWindow);
+
+/// Removes the given panel and every panel that has been split from it from the application's panel type index.
+///
+/// @remarks
+///     This must be called before deleting a panel in the main hierarchy.
+void ak_panel_unindex_recursive(drgui_element* pPanel);
+
+/// Retrieves the interned type of the given panel.
+///
+/// @remarks
+///     This will return null if the panel does not have a type or is not in the main hierarchy.
+ak_panel_type_atom* ak_panel_get_type_atom(drgui_element* pPanel);
+
+/// Determines whether or not the given element is a panel that was created with ak_create_panel().
+///
+/// @remarks
+///     This is safe to call on any element. It checks a tag in the element's data rather than it's type, which can be
+///     anything.
+bool ak_is_panel(drgui_element* pElement);
+
+/// Retrieves the window that was cached on the given panel when it was put in the main hierarchy.
+///
+/// @remarks
+///     This will return null if the panel is not in the main hierarchy. Use ak_get_panel_window() for the general case.
+ak_window* ak_panel_get_cached_window(drgui_element* pPanel);
+
+/// Retrieves the next panel with the exact same type as the given panel.
+drgui_element* ak_panel_get_next_panel_of_same_type(drgui_element* pPanel);
+
+/// Lays out every panel in the given panel's split tree whose layout has been invalidated.
+///
+/// @remarks
+///     This is done top-down so that each panel is laid out after it's parent has set it's size. This is called by
+///     windows on their root panel just before they're painted.
+void ak_panel_update_layout(drgui_element* pPanel);
+
+
+/// Attaches a tool to the given panel without activating it.
+///
+/// @remarks
+///     This is the same as ak_panel_attach_tool(), except the tool is left hidden and the active tool does not change.
+bool ak_panel_attach_inactive_tool(drgui_element* pPanel, drgui_element* pTool);
+
+/// Replaces the given placeholder tool with the real tool it's standing in for.
+///
+/// @remarks
+///     The real tool is created with ak_create_tool_by_type_and_attributes() and takes over the placeholder's tab, after
+///     which the placeholder is deleted. The real tool is not shown or activated.
+///     @par
+///     This returns the real tool, or the placeholder if the real tool could not be created. If <pPlaceholder> is not
+///     a placeholder it is returned as-is.
+drgui_element* ak_panel_realize_tool(drgui_element* pPanel, drgui_element* pPlaceholder);
+
+/// Called by tools when their title changes while they're attached to the given panel.
+void ak_panel_on_tool_title_changed(drgui_element* pPanel, drgui_element* pTool);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
@@ -6,6 +6,19 @@ unsigned int ak_get_caret_blink_rate()
     return GetCaretBlinkTime();
 }
 
+uint64_t ak_get_time_in_microseconds()
+{
+    static LARGE_INTEGER frequency = {{0}};
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+
+    return (uint64_t)((counter.QuadPart / frequency.QuadPart) * 1000000 + ((counter.QuadPart % frequency.QuadPart) * 1000000) / frequency.QuadPart);
+}
+
 const char*  defaultUIFontFamily = "Segoe UI";
     unsigned int defaultUIFontSize   = 12;
 
@@ -35,6 +48,11 @@ unsigned int ak_get_caret_blink_rate()
     return (unsigned int)blinkTime / 2;
 }
 
+uint64_t ak_get_time_in_microseconds()
+{
+    return (uint64_t)g_get_monotonic_time();
+}
+
 void ak_platform_get_default_font(char* familyOut, size_t familyOutSize, float* sizeOut, drgui_font_weight* weightOut, drgui_font_slant* slantOut)
 {
     char family[256] = {'\0'};
@@ -151,6 +169,156 @@ void ak_platform_get_default_font(char* familyOut, size_t familyOutSize, float*
 }
 #endif
 
+#ifdef AK_USE_HEADLESS
+unsigned int ak_get_caret_blink_rate()
+{
+    return 600;     // Same as GTK's default.
+}
+
+uint64_t ak_get_time_in_microseconds()
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency = {{0}};
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+
+    return (uint64_t)((counter.QuadPart / frequency.QuadPart) * 1000000 + ((counter.QuadPart % frequency.QuadPart) * 1000000) / frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+#endif
+}
+
+void ak_platform_get_default_font(char* familyOut, size_t familyOutSize, float* sizeOut, drgui_font_weight* weightOut, drgui_font_slant* slantOut)
+{
+    // There's no desktop settings to query so we just use a fixed font. This keeps rendering consistent between runs
+    // which is important for anything comparing the contents of a window's surface.
+    if (familyOut) {
+        strcpy_s(familyOut, familyOutSize, "Sans");
+    }
+    if (sizeOut) {
+        *sizeOut = 10 * (96.0f/72.0f);
+    }
+    if (weightOut) {
+        *weightOut = drgui_font_weight_normal;
+    }
+    if (slantOut) {
+        *slantOut = drgui_font_slant_none;
+    }
+}
+#endif
+
+
+
+//// Functions below are cross-platform ////
+
+uint64_t ak_get_process_uptime_in_microseconds()
+{
+#ifdef _WIN32
+    FILETIME creationTime;
+    FILETIME exitTime;
+    FILETIME kernelTime;
+    FILETIME userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0;
+    }
+
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+
+    // FILETIME is in 100 nanosecond intervals.
+    uint64_t creation64 = ((uint64_t)creationTime.dwHighDateTime << 32) | creationTime.dwLowDateTime;
+    uint64_t now64      = ((uint64_t)now.dwHighDateTime << 32)          | now.dwLowDateTime;
+    if (now64 < creation64) {
+        return 0;
+    }
+
+    return (now64 - creation64) / 10;
+#elif defined(__linux__)
+    // The start time is the 22nd field of /proc/self/stat and is measured in clock ticks since boot. The second field
+    // is the executable name in parentheses which may itself contain spaces, so we start scanning after the last ')'.
+    FILE* pFile = fopen("/proc/self/stat", "r");
+    if (pFile == NULL) {
+        return 0;
+    }
+
+    char stat[1024];
+    size_t statLength = fread(stat, 1, sizeof(stat) - 1, pFile);
+    fclose(pFile);
+    stat[statLength] = '\0';
+
+    const char* pFields = strrchr(stat, ')');
+    if (pFields == NULL) {
+        return 0;
+    }
+
+    unsigned long long startTimeInTicks;
+    if (sscanf(pFields + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %*d %*d %*d %llu", &startTimeInTicks) != 1) {
+        return 0;
+    }
+
+    long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    if (ticksPerSecond <= 0) {
+        return 0;
+    }
+
+    struct timespec uptime;
+    if (clock_gettime(CLOCK_BOOTTIME, &uptime) != 0) {
+        return 0;
+    }
+
+    uint64_t nowInMicroseconds   = (uint64_t)uptime.tv_sec * 1000000 + (uint64_t)uptime.tv_nsec / 1000;
+    uint64_t startInMicroseconds = (uint64_t)startTimeInTicks * 1000000 / (uint64_t)ticksPerSecond;
+    if (nowInMicroseconds < startInMicroseconds) {
+        return 0;
+    }
+
+    return nowInMicroseconds - startInMicroseconds;
+#else
+    return 0;
+#endif
+}
+
+size_t ak_get_process_memory_usage()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+
+    return counters.WorkingSetSize;
+#elif defined(__linux__)
+    // The second field of /proc/self/statm is the resident set size in pages.
+    FILE* pFile = fopen("/proc/self/statm", "r");
+    if (pFile == NULL) {
+        return 0;
+    }
+
+    unsigned long residentPageCount;
+    int fieldCount = fscanf(pFile, "%*s %lu", &residentPageCount);
+    fclose(pFile);
+
+    if (fieldCount != 1) {
+        return 0;
+    }
+
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (pageSize <= 0) {
+        return 0;
+    }
+
+    return (size_t)residentPageCount * (size_t)pageSize;
+#else
+    return 0;
+#endif
+}
 
 /*
 This is free and unencumbered software released into the public domain.
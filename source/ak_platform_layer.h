@@ -6,6 +6,26 @@
 /// Retrieves the blink rate in milliseconds for text cursors/carets.
 unsigned int ak_get_caret_blink_rate();
 
+/// Retrieves the current time in microseconds.
+///
+/// @remarks
+///     This is a monotonic clock with an arbitrary starting point. It's only useful for measuring time intervals.
+uint64_t ak_get_time_in_microseconds();
+
+/// Retrieves the amount of time in microseconds that has passed since the process was started.
+///
+/// @remarks
+///     This returns 0 if it cannot be determined. The resolution depends on the platform. On Linux it's the kernel's
+///     clock tick, which is usually 10 milliseconds.
+uint64_t ak_get_process_uptime_in_microseconds();
+
+/// Retrieves the amount of physical memory in bytes that's currently being used by the process.
+///
+/// @remarks
+///     This returns 0 if it cannot be determined. On Windows this is the working set, and on Linux it's the resident
+///     set size.
+size_t ak_get_process_memory_usage();
+
 /// Retrieves information about the default font to use for things like menus, etc.
 void ak_platform_get_default_font(char* familyOut, size_t familyOutSize, float* sizeOut, drgui_font_weight* weightOut, drgui_font_slant* slantOut);
 
@@ -8,7 +8,7 @@ ak_text_theme ak_init_text_theme(ak_application* pApplication, const char* famil
 
     result.pFont = drgui_create_font(ak_get_application_gui(pApplication), family, size, weight, slant, 0);
     if (result.pFont == NULL) {
-        ak_logf(pApplication, "[ERROR] Failed to load font \"%s\"", family);
+        ak_errorf(pApplication, "Failed to load font \"%s\"", family);
     }
 
     return result;
@@ -37,7 +37,7 @@ void ak_theme_load_defaults(ak_application* pApplication, ak_theme* pTheme)
     const char*  defaultMonospaceFontFamily = "Consolas";
     unsigned int defaultMonospaceFontSize   = 13;
 #endif
-#ifdef AK_USE_GTK
+#if defined(AK_USE_GTK) || defined(AK_USE_HEADLESS)
     ak_platform_get_default_font(defaultUIFontFamily, sizeof(defaultUIFontFamily), &defaultUIFontSize, &defaultUIFontWeight, &defaultUIFontSlant);
 
     const char*  defaultMonospaceFontFamily = "Monospace";      // TODO: Use GTK theme.
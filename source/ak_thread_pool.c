@@ -0,0 +1,383 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+typedef struct
+{
+    /// The items, stored as a ring buffer. The top of the deque is at <head> and the bottom is at <head + count - 1>.
+    ak_work_item* pItems;
+
+    /// The capacity of the ring buffer. This is always a power of 2.
+    size_t capacity;
+
+    /// The index of the item at the top of the deque.
+    size_t head;
+
+    /// The number of items in the deque.
+    size_t count;
+
+    /// The lock protecting the deque.
+    ak_mutex lock;
+
+} ak_work_deque;
+
+typedef struct
+{
+    /// The pool that owns the worker.
+    ak_thread_pool* pPool;
+
+    /// The worker's deque.
+    ak_work_deque deque;
+
+    /// The worker's thread.
+    ak_thread thread;
+
+} ak_worker;
+
+struct ak_thread_pool
+{
+    /// The application that owns the pool. This is passed to every work item.
+    ak_application* pApplication;
+
+    /// The workers.
+    ak_worker* pWorkers;
+
+    /// The number of workers.
+    unsigned int workerCount;
+
+    /// The index of the worker that will receive the next item submitted from outside of the pool. This is just a
+    /// hint for spreading work out and doesn't need to be exact.
+    volatile size_t nextWorkerIndex;
+
+    /// The number of items that have been submitted but not yet taken by a worker, plus one for each worker when the
+    /// pool is being terminated.
+    ak_semaphore pendingItems;
+
+    /// Set to non-zero when the pool is being deleted.
+    volatile size_t isTerminating;
+};
+
+
+/// The worker the calling thread belongs to, if any.
+static AK_THREAD_LOCAL ak_worker* g_pAKCurrentWorker = NULL;
+
+
+static bool ak_work_deque_init(ak_work_deque* pDeque)
+{
+    assert(pDeque != NULL);
+
+    pDeque->capacity = 64;
+    pDeque->head     = 0;
+    pDeque->count    = 0;
+    pDeque->pItems   = malloc(sizeof(*pDeque->pItems) * pDeque->capacity);
+    if (pDeque->pItems == NULL) {
+        return false;
+    }
+
+    if (!ak_init_mutex(&pDeque->lock)) {
+        free(pDeque->pItems);
+        return false;
+    }
+
+    return true;
+}
+
+static void ak_work_deque_uninit(ak_work_deque* pDeque)
+{
+    assert(pDeque != NULL);
+
+    ak_uninit_mutex(&pDeque->lock);
+    free(pDeque->pItems);
+}
+
+static bool ak_work_deque_push_bottom(ak_work_deque* pDeque, ak_work_item item)
+{
+    assert(pDeque != NULL);
+
+    bool result = true;
+    ak_lock_mutex(&pDeque->lock);
+    {
+        if (pDeque->count == pDeque->capacity)
+        {
+            // The buffer needs to grow. The items are unwrapped into the new buffer so the top is at index 0.
+            size_t newCapacity = pDeque->capacity * 2;
+            ak_work_item* pNewItems = malloc(sizeof(*pNewItems) * newCapacity);
+            if (pNewItems != NULL)
+            {
+                for (size_t i = 0; i < pDeque->count; ++i) {
+                    pNewItems[i] = pDeque->pItems[(pDeque->head + i) & (pDeque->capacity - 1)];
+                }
+
+                free(pDeque->pItems);
+                pDeque->pItems   = pNewItems;
+                pDeque->capacity = newCapacity;
+                pDeque->head     = 0;
+            }
+            else
+            {
+                result = false;
+            }
+        }
+
+        if (result) {
+            pDeque->pItems[(pDeque->head + pDeque->count) & (pDeque->capacity - 1)] = item;
+            pDeque->count += 1;
+        }
+    }
+    ak_unlock_mutex(&pDeque->lock);
+
+    return result;
+}
+
+static bool ak_work_deque_pop_bottom(ak_work_deque* pDeque, ak_work_item* pItemOut)
+{
+    assert(pDeque != NULL);
+    assert(pItemOut != NULL);
+
+    bool result = false;
+    ak_lock_mutex(&pDeque->lock);
+    {
+        if (pDeque->count > 0) {
+            pDeque->count -= 1;
+            *pItemOut = pDeque->pItems[(pDeque->head + pDeque->count) & (pDeque->capacity - 1)];
+            result = true;
+        }
+    }
+    ak_unlock_mutex(&pDeque->lock);
+
+    return result;
+}
+
+static bool ak_work_deque_steal_top(ak_work_deque* pDeque, ak_work_item* pItemOut)
+{
+    assert(pDeque != NULL);
+    assert(pItemOut != NULL);
+
+    bool result = false;
+    ak_lock_mutex(&pDeque->lock);
+    {
+        if (pDeque->count > 0) {
+            *pItemOut = pDeque->pItems[pDeque->head];
+            pDeque->head   = (pDeque->head + 1) & (pDeque->capacity - 1);
+            pDeque->count -= 1;
+            result = true;
+        }
+    }
+    ak_unlock_mutex(&pDeque->lock);
+
+    return result;
+}
+
+
+/// Takes an item for the given worker, first from the bottom of it's own deque and then from the top of the others.
+static bool ak_worker_take_item(ak_worker* pWorker, ak_work_item* pItemOut)
+{
+    assert(pWorker != NULL);
+    assert(pItemOut != NULL);
+
+    if (ak_work_deque_pop_bottom(&pWorker->deque, pItemOut)) {
+        return true;
+    }
+
+    ak_thread_pool* pPool = pWorker->pPool;
+    size_t workerIndex = (size_t)(pWorker - pPool->pWorkers);
+    for (unsigned int i = 1; i < pPool->workerCount; ++i)
+    {
+        ak_worker* pVictim = &pPool->pWorkers[(workerIndex + i) % pPool->workerCount];
+        if (ak_work_deque_steal_top(&pVictim->deque, pItemOut)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void ak_worker_thread_proc(void* pData)
+{
+    ak_worker* pWorker = pData;
+    assert(pWorker != NULL);
+
+    g_pAKCurrentWorker = pWorker;
+
+    ak_thread_pool* pPool = pWorker->pPool;
+    for (;;)
+    {
+        ak_wait_semaphore(&pPool->pendingItems);
+
+        // Every count in the semaphore corresponds to an item that has been pushed to one of the deques, so if we get
+        // here there must be an item somewhere. The only exception is when the pool is terminating, in which case there
+        // is one extra count per worker and we can stop once everything has been taken.
+        ak_work_item item;
+        bool foundItem = false;
+        while (!foundItem)
+        {
+            foundItem = ak_worker_take_item(pWorker, &item);
+            if (!foundItem)
+            {
+                if (ak_atomic_load(&pPool->isTerminating) != 0) {
+                    break;
+                }
+
+                ak_yield_thread();
+            }
+        }
+
+        if (!foundItem) {
+            break;
+        }
+
+        item.proc(pPool->pApplication, item.pUserData);
+    }
+
+    g_pAKCurrentWorker = NULL;
+}
+
+
+ak_thread_pool* ak_create_thread_pool(ak_application* pApplication, unsigned int threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = ak_get_cpu_core_count();
+    }
+
+    ak_thread_pool* pPool = malloc(sizeof(*pPool));
+    if (pPool == NULL) {
+        return NULL;
+    }
+
+    pPool->pWorkers = malloc(sizeof(*pPool->pWorkers) * threadCount);
+    if (pPool->pWorkers == NULL) {
+        free(pPool);
+        return NULL;
+    }
+
+    if (!ak_init_semaphore(&pPool->pendingItems, 0)) {
+        free(pPool->pWorkers);
+        free(pPool);
+        return NULL;
+    }
+
+    pPool->pApplication    = pApplication;
+    pPool->workerCount     = 0;
+    pPool->nextWorkerIndex = 0;
+    pPool->isTerminating   = 0;
+
+    // Every deque needs to be initialized before any thread is started because the threads will steal from each other.
+    unsigned int dequeCount = 0;
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        pPool->pWorkers[i].pPool = pPool;
+        if (!ak_work_deque_init(&pPool->pWorkers[i].deque)) {
+            break;
+        }
+
+        dequeCount += 1;
+    }
+
+    for (unsigned int i = 0; i < dequeCount; ++i) {
+        if (!ak_create_thread(&pPool->pWorkers[i].thread, ak_worker_thread_proc, &pPool->pWorkers[i])) {
+            break;
+        }
+
+        pPool->workerCount += 1;
+    }
+
+    // Deques belonging to threads that failed to start are never used.
+    for (unsigned int i = pPool->workerCount; i < dequeCount; ++i) {
+        ak_work_deque_uninit(&pPool->pWorkers[i].deque);
+    }
+
+    if (pPool->workerCount == 0) {
+        ak_uninit_semaphore(&pPool->pendingItems);
+        free(pPool->pWorkers);
+        free(pPool);
+        return NULL;
+    }
+
+    return pPool;
+}
+
+void ak_delete_thread_pool(ak_thread_pool* pPool)
+{
+    if (pPool == NULL) {
+        return;
+    }
+
+    // Each worker will keep running until every deque is empty, after which it'll consume one of these extra counts
+    // and terminate.
+    ak_atomic_store(&pPool->isTerminating, 1);
+    for (unsigned int i = 0; i < pPool->workerCount; ++i) {
+        ak_release_semaphore(&pPool->pendingItems);
+    }
+
+    for (unsigned int i = 0; i < pPool->workerCount; ++i) {
+        ak_wait_thread(&pPool->pWorkers[i].thread);
+    }
+
+    for (unsigned int i = 0; i < pPool->workerCount; ++i) {
+        ak_work_deque_uninit(&pPool->pWorkers[i].deque);
+    }
+
+    ak_uninit_semaphore(&pPool->pendingItems);
+    free(pPool->pWorkers);
+    free(pPool);
+}
+
+bool ak_thread_pool_submit(ak_thread_pool* pPool, ak_work_proc proc, void* pUserData)
+{
+    if (pPool == NULL || proc == NULL) {
+        return false;
+    }
+
+    ak_work_item item;
+    item.proc      = proc;
+    item.pUserData = pUserData;
+
+    // Work submitted from one of our own workers goes to the bottom of that worker's deque. Everything else is spread
+    // out between the workers.
+    ak_worker* pWorker = g_pAKCurrentWorker;
+    if (pWorker == NULL || pWorker->pPool != pPool) {
+        size_t workerIndex = ak_atomic_add(&pPool->nextWorkerIndex, 1) % pPool->workerCount;
+        pWorker = &pPool->pWorkers[workerIndex];
+    }
+
+    if (!ak_work_deque_push_bottom(&pWorker->deque, item)) {
+        return false;
+    }
+
+    ak_release_semaphore(&pPool->pendingItems);
+    return true;
+}
+
+unsigned int ak_thread_pool_get_thread_count(ak_thread_pool* pPool)
+{
+    if (pPool == NULL) {
+        return 0;
+    }
+
+    return pPool->workerCount;
+}
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
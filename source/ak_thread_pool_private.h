@@ -0,0 +1,87 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+//
+// QUICK NOTES
+//
+// - Each worker thread has it's own deque of work items. Work submitted from a worker thread is pushed onto the bottom
+//   of that worker's deque and popped from the bottom (LIFO) which is good for cache locality with nested work. Work
+//   submitted from any other thread is distributed between the workers in a round-robin fashion.
+// - An idle worker will steal from the top (FIFO) of the other workers' deques.
+// - The pool keeps a count of outstanding work items in a semaphore so that idle workers sleep rather than spin.
+// - Deleting a pool will block until every submitted work item has been run.
+//
+
+#ifndef ak_thread_pool_private_h
+#define ak_thread_pool_private_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ak_thread_pool ak_thread_pool;
+
+typedef struct
+{
+    /// The function to run.
+    ak_work_proc proc;
+
+    /// The user data to pass to the function.
+    void* pUserData;
+
+} ak_work_item;
+
+/// Creates a thread pool.
+///
+/// @remarks
+///     If <threadCount> is 0 the number of threads will be equal to the number of logical processors.
+ak_thread_pool* ak_create_thread_pool(ak_application* pApplication, unsigned int threadCount);
+
+/// Deletes the given thread pool.
+///
+/// @remarks
+///     This will block until every submitted work item has been run.
+void ak_delete_thread_pool(ak_thread_pool* pPool);
+
+/// Submits a work item to the given pool.
+///
+/// @remarks
+///     This is thread-safe.
+bool ak_thread_pool_submit(ak_thread_pool* pPool, ak_work_proc proc, void* pUserData);
+
+/// Retrieves the number of worker threads in the given pool.
+unsigned int ak_thread_pool_get_thread_count(ak_thread_pool* pPool);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
@@ -0,0 +1,449 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Win32
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifdef AK_USE_WIN32_THREADS
+static DWORD WINAPI ak_thread_entry_proc_win32(LPVOID pData)
+{
+    ak_thread* pThread = pData;
+    assert(pThread != NULL);
+
+    pThread->proc(pThread->pData);
+    return 0;
+}
+
+bool ak_create_thread(ak_thread* pThread, ak_thread_proc proc, void* pData)
+{
+    if (pThread == NULL || proc == NULL) {
+        return false;
+    }
+
+    pThread->proc  = proc;
+    pThread->pData = pData;
+    pThread->hThread = CreateThread(NULL, 0, ak_thread_entry_proc_win32, pThread, 0, NULL);
+
+    return pThread->hThread != NULL;
+}
+
+void ak_wait_thread(ak_thread* pThread)
+{
+    if (pThread == NULL || pThread->hThread == NULL) {
+        return;
+    }
+
+    WaitForSingleObject(pThread->hThread, INFINITE);
+    CloseHandle(pThread->hThread);
+    pThread->hThread = NULL;
+}
+
+void ak_yield_thread()
+{
+    SwitchToThread();
+}
+
+unsigned int ak_get_cpu_core_count()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+
+    return (info.dwNumberOfProcessors > 0) ? (unsigned int)info.dwNumberOfProcessors : 1;
+}
+
+
+bool ak_init_mutex(ak_mutex* pMutex)
+{
+    if (pMutex == NULL) {
+        return false;
+    }
+
+    InitializeCriticalSection(&pMutex->cs);
+    return true;
+}
+
+void ak_uninit_mutex(ak_mutex* pMutex)
+{
+    if (pMutex == NULL) {
+        return;
+    }
+
+    DeleteCriticalSection(&pMutex->cs);
+}
+
+void ak_lock_mutex(ak_mutex* pMutex)
+{
+    assert(pMutex != NULL);
+    EnterCriticalSection(&pMutex->cs);
+}
+
+void ak_unlock_mutex(ak_mutex* pMutex)
+{
+    assert(pMutex != NULL);
+    LeaveCriticalSection(&pMutex->cs);
+}
+
+
+bool ak_init_semaphore(ak_semaphore* pSemaphore, unsigned int initialCount)
+{
+    if (pSemaphore == NULL) {
+        return false;
+    }
+
+    pSemaphore->hSemaphore = CreateSemaphoreA(NULL, (LONG)initialCount, LONG_MAX, NULL);
+    return pSemaphore->hSemaphore != NULL;
+}
+
+void ak_uninit_semaphore(ak_semaphore* pSemaphore)
+{
+    if (pSemaphore == NULL) {
+        return;
+    }
+
+    CloseHandle(pSemaphore->hSemaphore);
+}
+
+void ak_wait_semaphore(ak_semaphore* pSemaphore)
+{
+    assert(pSemaphore != NULL);
+    WaitForSingleObject(pSemaphore->hSemaphore, INFINITE);
+}
+
+void ak_release_semaphore(ak_semaphore* pSemaphore)
+{
+    assert(pSemaphore != NULL);
+    ReleaseSemaphore(pSemaphore->hSemaphore, 1, NULL);
+}
+
+
+bool ak_init_event(ak_event* pEvent)
+{
+    if (pEvent == NULL) {
+        return false;
+    }
+
+    pEvent->hEvent = CreateEventA(NULL, FALSE, FALSE, NULL);
+    return pEvent->hEvent != NULL;
+}
+
+void ak_uninit_event(ak_event* pEvent)
+{
+    if (pEvent == NULL) {
+        return;
+    }
+
+    CloseHandle(pEvent->hEvent);
+}
+
+void ak_signal_event(ak_event* pEvent)
+{
+    assert(pEvent != NULL);
+    SetEvent(pEvent->hEvent);
+}
+
+bool ak_wait_event(ak_event* pEvent, unsigned int timeoutInMilliseconds)
+{
+    assert(pEvent != NULL);
+    return WaitForSingleObject(pEvent->hEvent, (timeoutInMilliseconds == AK_INFINITE) ? INFINITE : timeoutInMilliseconds) == WAIT_OBJECT_0;
+}
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// POSIX
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifdef AK_USE_POSIX_THREADS
+static void* ak_thread_entry_proc_posix(void* pData)
+{
+    ak_thread* pThread = pData;
+    assert(pThread != NULL);
+
+    pThread->proc(pThread->pData);
+    return NULL;
+}
+
+bool ak_create_thread(ak_thread* pThread, ak_thread_proc proc, void* pData)
+{
+    if (pThread == NULL || proc == NULL) {
+        return false;
+    }
+
+    pThread->proc  = proc;
+    pThread->pData = pData;
+
+    return pthread_create(&pThread->thread, NULL, ak_thread_entry_proc_posix, pThread) == 0;
+}
+
+void ak_wait_thread(ak_thread* pThread)
+{
+    if (pThread == NULL) {
+        return;
+    }
+
+    pthread_join(pThread->thread, NULL);
+}
+
+void ak_yield_thread()
+{
+    sched_yield();
+}
+
+unsigned int ak_get_cpu_core_count()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (unsigned int)count : 1;
+}
+
+
+bool ak_init_mutex(ak_mutex* pMutex)
+{
+    if (pMutex == NULL) {
+        return false;
+    }
+
+    return pthread_mutex_init(&pMutex->mutex, NULL) == 0;
+}
+
+void ak_uninit_mutex(ak_mutex* pMutex)
+{
+    if (pMutex == NULL) {
+        return;
+    }
+
+    pthread_mutex_destroy(&pMutex->mutex);
+}
+
+void ak_lock_mutex(ak_mutex* pMutex)
+{
+    assert(pMutex != NULL);
+    pthread_mutex_lock(&pMutex->mutex);
+}
+
+void ak_unlock_mutex(ak_mutex* pMutex)
+{
+    assert(pMutex != NULL);
+    pthread_mutex_unlock(&pMutex->mutex);
+}
+
+
+bool ak_init_semaphore(ak_semaphore* pSemaphore, unsigned int initialCount)
+{
+    if (pSemaphore == NULL) {
+        return false;
+    }
+
+    if (pthread_mutex_init(&pSemaphore->mutex, NULL) != 0) {
+        return false;
+    }
+
+    if (pthread_cond_init(&pSemaphore->cond, NULL) != 0) {
+        pthread_mutex_destroy(&pSemaphore->mutex);
+        return false;
+    }
+
+    pSemaphore->count = initialCount;
+    return true;
+}
+
+void ak_uninit_semaphore(ak_semaphore* pSemaphore)
+{
+    if (pSemaphore == NULL) {
+        return;
+    }
+
+    pthread_cond_destroy(&pSemaphore->cond);
+    pthread_mutex_destroy(&pSemaphore->mutex);
+}
+
+void ak_wait_semaphore(ak_semaphore* pSemaphore)
+{
+    assert(pSemaphore != NULL);
+
+    pthread_mutex_lock(&pSemaphore->mutex);
+    {
+        while (pSemaphore->count == 0) {
+            pthread_cond_wait(&pSemaphore->cond, &pSemaphore->mutex);
+        }
+
+        pSemaphore->count -= 1;
+    }
+    pthread_mutex_unlock(&pSemaphore->mutex);
+}
+
+void ak_release_semaphore(ak_semaphore* pSemaphore)
+{
+    assert(pSemaphore != NULL);
+
+    pthread_mutex_lock(&pSemaphore->mutex);
+    {
+        pSemaphore->count += 1;
+        pthread_cond_signal(&pSemaphore->cond);
+    }
+    pthread_mutex_unlock(&pSemaphore->mutex);
+}
+
+
+bool ak_init_event(ak_event* pEvent)
+{
+    if (pEvent == NULL) {
+        return false;
+    }
+
+    if (pthread_mutex_init(&pEvent->mutex, NULL) != 0) {
+        return false;
+    }
+
+    if (pthread_cond_init(&pEvent->cond, NULL) != 0) {
+        pthread_mutex_destroy(&pEvent->mutex);
+        return false;
+    }
+
+    pEvent->isSignaled = false;
+    return true;
+}
+
+void ak_uninit_event(ak_event* pEvent)
+{
+    if (pEvent == NULL) {
+        return;
+    }
+
+    pthread_cond_destroy(&pEvent->cond);
+    pthread_mutex_destroy(&pEvent->mutex);
+}
+
+void ak_signal_event(ak_event* pEvent)
+{
+    assert(pEvent != NULL);
+
+    pthread_mutex_lock(&pEvent->mutex);
+    {
+        pEvent->isSignaled = true;
+        pthread_cond_signal(&pEvent->cond);
+    }
+    pthread_mutex_unlock(&pEvent->mutex);
+}
+
+bool ak_wait_event(ak_event* pEvent, unsigned int timeoutInMilliseconds)
+{
+    assert(pEvent != NULL);
+
+    struct timespec deadline;
+    if (timeoutInMilliseconds != AK_INFINITE) {
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec  += timeoutInMilliseconds / 1000;
+        deadline.tv_nsec += (long)(timeoutInMilliseconds % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec  += 1;
+            deadline.tv_nsec -= 1000000000;
+        }
+    }
+
+    bool wasSignaled;
+    pthread_mutex_lock(&pEvent->mutex);
+    {
+        while (!pEvent->isSignaled)
+        {
+            int result;
+            if (timeoutInMilliseconds == AK_INFINITE) {
+                result = pthread_cond_wait(&pEvent->cond, &pEvent->mutex);
+            } else {
+                result = pthread_cond_timedwait(&pEvent->cond, &pEvent->mutex, &deadline);
+            }
+
+            if (result == ETIMEDOUT) {
+                break;
+            }
+        }
+
+        wasSignaled = pEvent->isSignaled;
+        pEvent->isSignaled = false;
+    }
+    pthread_mutex_unlock(&pEvent->mutex);
+
+    return wasSignaled;
+}
+#endif
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Atomics
+//
+///////////////////////////////////////////////////////////////////////////////
+#if defined(_MSC_VER)
+size_t ak_atomic_load(volatile size_t* pValue)
+{
+    return (size_t)InterlockedCompareExchangePointer((PVOID volatile*)pValue, NULL, NULL);
+}
+
+void ak_atomic_store(volatile size_t* pValue, size_t value)
+{
+    InterlockedExchangePointer((PVOID volatile*)pValue, (PVOID)value);
+}
+
+size_t ak_atomic_add(volatile size_t* pValue, size_t value)
+{
+#ifdef _WIN64
+    return (size_t)InterlockedExchangeAdd64((LONG64 volatile*)pValue, (LONG64)value) + value;
+#else
+    return (size_t)InterlockedExchangeAdd((LONG volatile*)pValue, (LONG)value) + value;
+#endif
+}
+
+bool ak_atomic_compare_exchange(volatile size_t* pValue, size_t expected, size_t desired)
+{
+    return InterlockedCompareExchangePointer((PVOID volatile*)pValue, (PVOID)desired, (PVOID)expected) == (PVOID)expected;
+}
+#else
+size_t ak_atomic_load(volatile size_t* pValue)
+{
+    return __atomic_load_n(pValue, __ATOMIC_SEQ_CST);
+}
+
+void ak_atomic_store(volatile size_t* pValue, size_t value)
+{
+    __atomic_store_n(pValue, value, __ATOMIC_SEQ_CST);
+}
+
+size_t ak_atomic_add(volatile size_t* pValue, size_t value)
+{
+    return __atomic_add_fetch(pValue, value, __ATOMIC_SEQ_CST);
+}
+
+bool ak_atomic_compare_exchange(volatile size_t* pValue, size_t expected, size_t desired)
+{
+    return __atomic_compare_exchange_n(pValue, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+#endif
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
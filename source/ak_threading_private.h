@@ -0,0 +1,191 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+//
+// QUICK NOTES
+//
+// - This is a very thin wrapper around the threading APIs of each platform. It only implements what is needed internally.
+// - Events are auto-reset. A successful wait will reset the event back to the unsignaled state.
+// - The atomic functions are full barriers unless stated otherwise.
+//
+
+#ifndef ak_threading_private_h
+#define ak_threading_private_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// The value to pass to ak_wait_event() to wait indefinitely.
+#define AK_INFINITE     0xFFFFFFFF
+
+/// Storage class specifier for thread-local variables.
+#if defined(_MSC_VER)
+#define AK_THREAD_LOCAL __declspec(thread)
+#else
+#define AK_THREAD_LOCAL __thread
+#endif
+
+typedef void (* ak_thread_proc)(void* pData);
+
+typedef struct
+{
+#ifdef AK_USE_WIN32_THREADS
+    /// The Win32 thread handle.
+    HANDLE hThread;
+#endif
+#ifdef AK_USE_POSIX_THREADS
+    /// The pthread handle.
+    pthread_t thread;
+#endif
+
+    /// The function to run on the thread.
+    ak_thread_proc proc;
+
+    /// The user data to pass to the thread's entry point.
+    void* pData;
+
+} ak_thread;
+
+typedef struct
+{
+#ifdef AK_USE_WIN32_THREADS
+    CRITICAL_SECTION cs;
+#endif
+#ifdef AK_USE_POSIX_THREADS
+    pthread_mutex_t mutex;
+#endif
+} ak_mutex;
+
+typedef struct
+{
+#ifdef AK_USE_WIN32_THREADS
+    HANDLE hSemaphore;
+#endif
+#ifdef AK_USE_POSIX_THREADS
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    unsigned int count;
+#endif
+} ak_semaphore;
+
+typedef struct
+{
+#ifdef AK_USE_WIN32_THREADS
+    HANDLE hEvent;
+#endif
+#ifdef AK_USE_POSIX_THREADS
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    bool isSignaled;
+#endif
+} ak_event;
+
+
+/// Creates and starts a thread.
+///
+/// @remarks
+///     <pThread> must remain valid until ak_wait_thread() has returned.
+bool ak_create_thread(ak_thread* pThread, ak_thread_proc proc, void* pData);
+
+/// Waits for the given thread to terminate and releases it's handle.
+void ak_wait_thread(ak_thread* pThread);
+
+/// Yields the remainder of the calling thread's time slice.
+void ak_yield_thread();
+
+/// Retrieves the number of logical processors available to the process.
+unsigned int ak_get_cpu_core_count();
+
+
+/// Initializes a mutex.
+bool ak_init_mutex(ak_mutex* pMutex);
+
+/// Uninitializes a mutex.
+void ak_uninit_mutex(ak_mutex* pMutex);
+
+/// Locks the given mutex.
+void ak_lock_mutex(ak_mutex* pMutex);
+
+/// Unlocks the given mutex.
+void ak_unlock_mutex(ak_mutex* pMutex);
+
+
+/// Initializes a counting semaphore.
+bool ak_init_semaphore(ak_semaphore* pSemaphore, unsigned int initialCount);
+
+/// Uninitializes the given semaphore.
+void ak_uninit_semaphore(ak_semaphore* pSemaphore);
+
+/// Waits for the given semaphore's count to be above zero and then decrements it.
+void ak_wait_semaphore(ak_semaphore* pSemaphore);
+
+/// Increments the count of the given semaphore.
+void ak_release_semaphore(ak_semaphore* pSemaphore);
+
+
+/// Initializes an auto-reset event. The event is initially unsignaled.
+bool ak_init_event(ak_event* pEvent);
+
+/// Uninitializes the given event.
+void ak_uninit_event(ak_event* pEvent);
+
+/// Puts the given event into the signaled state.
+void ak_signal_event(ak_event* pEvent);
+
+/// Waits for the given event to become signaled.
+///
+/// @return True if the event was signaled; false if the wait timed out.
+///
+/// @remarks
+///     Pass AK_INFINITE to wait indefinitely.
+bool ak_wait_event(ak_event* pEvent, unsigned int timeoutInMilliseconds);
+
+
+/// Atomically loads the given value.
+size_t ak_atomic_load(volatile size_t* pValue);
+
+/// Atomically stores the given value.
+void ak_atomic_store(volatile size_t* pValue, size_t value);
+
+/// Atomically adds <value> to the given variable and returns the new value.
+size_t ak_atomic_add(volatile size_t* pValue, size_t value);
+
+/// Atomically replaces <*pValue> with <desired> if it is equal to <expected>.
+///
+/// @return True if the exchange took place; false otherwise.
+bool ak_atomic_compare_exchange(volatile size_t* pValue, size_t expected, size_t desired);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
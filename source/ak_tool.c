@@ -1,28 +1,98 @@
 // Public domain. See "unlicense" statement at the end of this file.
 
+// Stored at the start of every tool's data so that tools can be told apart from other elements.
+#define AK_TOOL_TAG     0x4C4F4F54      // "TOOL"
+
 typedef struct
 {
+    /// Always set to AK_TOOL_TAG. See ak_is_tool().
+    uint32_t tag;
+
     /// A pointer to the application that owns this tool.
     ak_application* pApplication;
 
     /// The tools type.
     char type[AK_MAX_TOOL_TYPE_LENGTH];
 
+    /// The tool's type as it's been interned by the application's action registry. This is used to find the action
+    /// handlers that have been set for the tool's type, and is 0 if the tool does not have a type.
+    uint32_t typeID;
+
+    /// The type the tool was created from with ak_create_tool_by_type_and_attributes(). This can be different to
+    /// <type>, since that's up to whoever created the tool.
+    char layoutType[AK_MAX_TOOL_TYPE_LENGTH];
+
+    /// The attributes the tool was created from with ak_create_tool_by_type_and_attributes().
+    char layoutAttributes[AK_MAX_TOOL_ATTRIBUTES_LENGTH];
+
+    /// Whether or not layoutType and layoutAttributes are set. This is false if the tool was not created from a
+    /// layout, or if it's type or attributes were too long to store.
+    bool hasLayoutInfo;
+
+    /// Whether or not the tool is a placeholder standing in for the tool described by layoutType and layoutAttributes.
+    bool isPlaceholder;
+
+    /// Whether or not the tool is in the application's placeholder queue. Placeholders are queued while they're
+    /// attached to a panel.
+    bool isQueuedPlaceholder;
+
+    /// The previous and next placeholders in the application's placeholder queue.
+    drgui_element* pPrevQueuedPlaceholder;
+    drgui_element* pNextQueuedPlaceholder;
+
 
     /// The tool's title. This is what will show up on the tool's tab.
     char title[256];
 
+    /// The font the title was last measured with. This is null if the title has not been measured since it was last
+    /// changed.
+    drgui_font* pTitleSizeFont;
+
+    /// The size of the title when it's measured with pTitleSizeFont.
+    float titleWidth;
+    float titleHeight;
+
     /// The tool's tab that will be shown on the tab bar.
     drgui_tab* pTab;
 
     /// The panel the tab is attached to, if any.
     drgui_element* pPanel;
 
+    /// The position of the tool in the list of tools of the panel it's attached to.
+    size_t panelSlot;
+
+    /// The window of the panel the tab is attached to. This is only cached when the panel is in the main hierarchy of
+    /// it's window, and is null otherwise.
+    ak_window* pWindow;
+
 
     /// The function to call when the tool needs to handle an action.
     ak_tool_on_handle_action_proc onHandleAction;
 
 
+    /// The function to call when the tool is hibernated.
+    ak_tool_on_hibernate_proc onHibernate;
+
+    /// The function to call when the tool is restored after being hibernated.
+    ak_tool_on_restore_proc onRestore;
+
+    /// Whether or not the tool is hibernating.
+    bool isHibernating;
+
+    /// The state returned by the onHibernate callback. This is null when the tool is not hibernating, or when the state
+    /// has been written to a file and not yet read back.
+    void* pHibernationState;
+
+    /// The size of the hibernation state, in bytes.
+    size_t hibernationStateSize;
+
+    /// The path of the file the hibernation state was written to, or null if it's only kept in memory.
+    char* pHibernationFilePath;
+
+    /// The time the tool was last deactivated, or created if it has never been deactivated.
+    uint64_t deactivationTime;
+
+
     /// The size of the tool's extra data, in bytes.
     size_t extraDataSize;
 
@@ -32,28 +102,75 @@ typedef struct
 } ak_tool_data;
 
 
+static void ak_discard_tool_hibernation_state(ak_tool_data* pToolData);
+
+/// Called when the tool's element is deleted, however that's done.
+static void ak_tool_on_delete(drgui_element* pTool)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    assert(pToolData != NULL);
+
+    // Tools are usually deleted while they're still attached, in which case the panel needs to forget about it or else
+    // it'll be left in the panel's list of tools. drgui calls this before the element is detached from it's parent.
+    if (pToolData->pPanel != NULL) {
+        ak_panel_detach_tool(pToolData->pPanel, pTool);
+    }
+
+    // The host application may delete the tool with drgui_delete_element() rather than ak_delete_tool(), so this is
+    // the only place the hibernation state can be reliably released.
+    ak_discard_tool_hibernation_state(pToolData);
+}
+
+
 drgui_element* ak_create_tool(ak_application* pApplication, drgui_element* pParent, const char* type, size_t extraDataSize, const void* pExtraData)
 {
     drgui_element* pElement = drgui_create_element(ak_get_application_gui(pApplication), pParent, sizeof(ak_tool_data) - sizeof(char) + extraDataSize, NULL);
     if (pElement != NULL)
     {
         drgui_hide(pElement);
+        drgui_set_on_delete(pElement, ak_tool_on_delete);
 
 
         ak_tool_data* pToolData = drgui_get_extra_data(pElement);
         assert(pToolData != NULL);
 
-        pToolData->pApplication   = pApplication;
-        pToolData->type[0]        = '\0';
-        pToolData->title[0]       = '\0';
-        pToolData->pTab           = NULL;
-        pToolData->pPanel         = NULL;
-        pToolData->onHandleAction = NULL;
+        pToolData->tag                 = AK_TOOL_TAG;
+        pToolData->pApplication        = pApplication;
+        pToolData->type[0]             = '\0';
+        pToolData->layoutType[0]       = '\0';
+        pToolData->layoutAttributes[0] = '\0';
+        pToolData->hasLayoutInfo       = false;
+        pToolData->isPlaceholder       = false;
+        pToolData->title[0]            = '\0';
+        pToolData->pTitleSizeFont      = NULL;
+        pToolData->titleWidth          = 0;
+        pToolData->titleHeight         = 0;
+        pToolData->pTab                = NULL;
+        pToolData->pPanel              = NULL;
+        pToolData->panelSlot           = 0;
+        pToolData->pWindow             = NULL;
+        pToolData->onHandleAction      = NULL;
+
+        // Placeholder queue.
+        pToolData->isQueuedPlaceholder    = false;
+        pToolData->pPrevQueuedPlaceholder = NULL;
+        pToolData->pNextQueuedPlaceholder = NULL;
+
+        // Hibernation.
+        pToolData->onHibernate          = NULL;
+        pToolData->onRestore            = NULL;
+        pToolData->isHibernating        = false;
+        pToolData->pHibernationState    = NULL;
+        pToolData->hibernationStateSize = 0;
+        pToolData->pHibernationFilePath = NULL;
+        pToolData->deactivationTime     = ak_get_time_in_microseconds();
 
         if (type != NULL) {
             strcpy_s(pToolData->type, sizeof(pToolData->type), type);
         }
 
+        pToolData->typeID = ak_application_intern_tool_type(pApplication, pToolData->type);
+
 
         pToolData->extraDataSize = extraDataSize;
         if (pExtraData != NULL) {
@@ -64,6 +181,26 @@ drgui_element* ak_create_tool(ak_application* pApplication, drgui_element* pPare
     return pElement;
 }
 
+/// Frees the hibernation state of the given tool, including it's file if it has one, and marks it as not hibernating.
+static void ak_discard_tool_hibernation_state(ak_tool_data* pToolData)
+{
+    assert(pToolData != NULL);
+
+    free(pToolData->pHibernationState);
+    pToolData->pHibernationState    = NULL;
+    pToolData->hibernationStateSize = 0;
+
+    if (pToolData->pHibernationFilePath != NULL)
+    {
+        drfs_delete_file(ak_get_application_vfs(pToolData->pApplication), pToolData->pHibernationFilePath);
+
+        free(pToolData->pHibernationFilePath);
+        pToolData->pHibernationFilePath = NULL;
+    }
+
+    pToolData->isHibernating = false;
+}
+
 void ak_delete_tool(drgui_element* pTool)
 {
     drgui_delete_element(pTool);
@@ -130,6 +267,16 @@ bool ak_is_tool_of_type(drgui_element* pTool, const char* type)
     return strncmp(pToolData->type, type, strlen(type)) == 0;
 }
 
+bool ak_is_placeholder_tool(drgui_element* pTool)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    if (pToolData == NULL) {
+        return false;
+    }
+
+    return pToolData->isPlaceholder;
+}
+
 
 drgui_tab* ak_get_tool_tab(drgui_element* pTool)
 {
@@ -151,6 +298,47 @@ drgui_element* ak_get_tool_panel(drgui_element* pTool)
     return pToolData->pPanel;
 }
 
+bool ak_is_tool(drgui_element* pElement)
+{
+    if (pElement == NULL) {
+        return false;
+    }
+
+    // The size is checked first so that the tag is never read from outside of a smaller element's data.
+    if (drgui_get_extra_data_size(pElement) < sizeof(ak_tool_data) - sizeof(char)) {
+        return false;
+    }
+
+    ak_tool_data* pToolData = drgui_get_extra_data(pElement);
+    return pToolData != NULL && pToolData->tag == AK_TOOL_TAG;
+}
+
+ak_window* ak_get_tool_cached_window(drgui_element* pTool)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    if (pToolData == NULL) {
+        return NULL;
+    }
+
+    return pToolData->pWindow;
+}
+
+ak_window* ak_get_tool_window(drgui_element* pTool)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    if (pToolData == NULL) {
+        return NULL;
+    }
+
+    if (pToolData->pWindow != NULL) {
+        return pToolData->pWindow;
+    }
+
+    // The window is not cached if the tool is not attached to a panel in the main hierarchy. In this case we need to
+    // fall back to the slow path.
+    return ak_get_element_window(pTool);
+}
+
 
 void ak_set_tool_title(drgui_element* pTool, const char* title)
 {
@@ -160,8 +348,13 @@ void ak_set_tool_title(drgui_element* pTool, const char* title)
     }
 
     strncpy_s(pToolData->title, sizeof(pToolData->title), (title != NULL) ? title : "", _TRUNCATE);
+    pToolData->pTitleSizeFont = NULL;
 
     drgui_tab_set_text(pToolData->pTab, title);
+
+    if (pToolData->pPanel != NULL) {
+        ak_panel_on_tool_title_changed(pToolData->pPanel, pTool);
+    }
 }
 
 const char* ak_get_tool_title(drgui_element* pTool)
@@ -182,6 +375,33 @@ void ak_tool_handle_action(drgui_element* pTool, const char* pActionName)
         return;
     }
 
+    // If the action has not been registered there can't be a handler for it so we can go straight to the tool.
+    ak_action_id actionID = ak_find_action(pToolData->pApplication, pActionName);
+    if (actionID != 0 && ak_application_handle_tool_action(pToolData->pApplication, pTool, pToolData->typeID, actionID)) {
+        return;
+    }
+
+    if (pToolData->onHandleAction) {
+        pToolData->onHandleAction(pTool, pActionName);
+    }
+}
+
+void ak_tool_handle_action_by_id(drgui_element* pTool, ak_action_id actionID)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    if (pToolData == NULL) {
+        return;
+    }
+
+    if (ak_application_handle_tool_action(pToolData->pApplication, pTool, pToolData->typeID, actionID)) {
+        return;
+    }
+
+    const char* pActionName = ak_get_action_name(pToolData->pApplication, actionID);
+    if (pActionName == NULL) {
+        return;
+    }
+
     if (pToolData->onHandleAction) {
         pToolData->onHandleAction(pTool, pActionName);
     }
@@ -198,6 +418,196 @@ void ak_tool_set_on_handle_action(drgui_element* pTool, ak_tool_on_handle_action
 }
 
 
+void ak_tool_set_on_hibernate(drgui_element* pTool, ak_tool_on_hibernate_proc proc)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    if (pToolData == NULL) {
+        return;
+    }
+
+    pToolData->onHibernate = proc;
+}
+
+void ak_tool_set_on_restore(drgui_element* pTool, ak_tool_on_restore_proc proc)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    if (pToolData == NULL) {
+        return;
+    }
+
+    pToolData->onRestore = proc;
+}
+
+/// Writes the given hibernation state to a new file in the application's hibernation folder and returns a copy of the
+/// file's path. This returns null if the application does not have a hibernation folder or the file can't be written.
+static char* ak_write_tool_hibernation_file(ak_application* pApplication, const void* pState, size_t stateSize)
+{
+    assert(pApplication != NULL);
+    assert(pState != NULL);
+
+    char path[DRFS_MAX_PATH];
+    if (!ak_application_get_tool_hibernation_file_path(pApplication, path, sizeof(path))) {
+        return NULL;
+    }
+
+    drfs_context* pVFS = ak_get_application_vfs(pApplication);
+
+    drfs_file* pFile;
+    if (drfs_open(pVFS, path, DRFS_WRITE | DRFS_TRUNCATE | DRFS_CREATE_DIRS, &pFile) != drfs_success) {
+        return NULL;
+    }
+
+    size_t bytesWritten;
+    drfs_result result = drfs_write(pFile, pState, stateSize, &bytesWritten);
+    drfs_close(pFile);
+
+    size_t pathSize = strlen(path) + 1;
+    char* pPath = NULL;
+    if (result == drfs_success && bytesWritten == stateSize) {
+        pPath = malloc(pathSize);
+    }
+
+    if (pPath == NULL) {
+        drfs_delete_file(pVFS, path);
+        return NULL;
+    }
+
+    memcpy(pPath, path, pathSize);
+    return pPath;
+}
+
+/// Reads the hibernation state of the given tool back into memory from it's file.
+static bool ak_read_tool_hibernation_file(ak_tool_data* pToolData)
+{
+    assert(pToolData != NULL);
+    assert(pToolData->pHibernationFilePath != NULL);
+    assert(pToolData->pHibernationState == NULL);
+
+    drfs_file* pFile;
+    if (drfs_open(ak_get_application_vfs(pToolData->pApplication), pToolData->pHibernationFilePath, DRFS_READ, &pFile) != drfs_success) {
+        return false;
+    }
+
+    // The file is only ever written by ak_write_tool_hibernation_file(), so if it's size is different it's been
+    // tampered with or truncated.
+    if (drfs_size(pFile) != pToolData->hibernationStateSize) {
+        drfs_close(pFile);
+        return false;
+    }
+
+    void* pState = malloc(pToolData->hibernationStateSize);
+    if (pState == NULL) {
+        drfs_close(pFile);
+        return false;
+    }
+
+    size_t bytesRead;
+    drfs_result result = drfs_read(pFile, pState, pToolData->hibernationStateSize, &bytesRead);
+    drfs_close(pFile);
+
+    if (result != drfs_success || bytesRead != pToolData->hibernationStateSize) {
+        free(pState);
+        return false;
+    }
+
+    pToolData->pHibernationState = pState;
+    return true;
+}
+
+bool ak_hibernate_tool(drgui_element* pTool)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    if (pToolData == NULL) {
+        return false;
+    }
+
+    if (pToolData->isHibernating) {
+        return true;
+    }
+
+    // Placeholders have nothing to release, and the active tool is visible so it needs to stay as it is.
+    if (pToolData->onHibernate == NULL || pToolData->onRestore == NULL || pToolData->isPlaceholder) {
+        return false;
+    }
+    if (pToolData->pPanel != NULL && ak_panel_get_active_tool(pToolData->pPanel) == pTool) {
+        return false;
+    }
+
+
+    void* pState = NULL;
+    size_t stateSize = 0;
+    if (!pToolData->onHibernate(pTool, &pState, &stateSize)) {
+        return false;
+    }
+
+    if (pState == NULL) {
+        stateSize = 0;
+    }
+
+    pToolData->isHibernating        = true;
+    pToolData->pHibernationState    = pState;
+    pToolData->hibernationStateSize = stateSize;
+
+    // The state is moved out of memory if the application has somewhere to put it. If that fails it's just kept in
+    // memory instead.
+    if (stateSize > 0)
+    {
+        pToolData->pHibernationFilePath = ak_write_tool_hibernation_file(pToolData->pApplication, pState, stateSize);
+        if (pToolData->pHibernationFilePath != NULL) {
+            free(pToolData->pHibernationState);
+            pToolData->pHibernationState = NULL;
+        }
+    }
+
+    return true;
+}
+
+bool ak_restore_tool(drgui_element* pTool)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    if (pToolData == NULL) {
+        return false;
+    }
+
+    if (!pToolData->isHibernating) {
+        return true;
+    }
+
+    if (pToolData->onRestore == NULL) {
+        return false;
+    }
+
+
+    if (pToolData->pHibernationFilePath != NULL && pToolData->pHibernationState == NULL)
+    {
+        if (!ak_read_tool_hibernation_file(pToolData)) {
+            ak_warningf(pToolData->pApplication, "Failed to read the hibernation state of tool \"%s\" from \"%s\".", pToolData->title, pToolData->pHibernationFilePath);
+            return false;
+        }
+    }
+
+    // If this fails the state is kept so that it can be tried again, which is why the state read from the file above is
+    // not discarded until this succeeds.
+    if (!pToolData->onRestore(pTool, pToolData->pHibernationState, pToolData->hibernationStateSize)) {
+        ak_warningf(pToolData->pApplication, "Failed to restore tool \"%s\".", pToolData->title);
+        return false;
+    }
+
+    ak_discard_tool_hibernation_state(pToolData);
+    return true;
+}
+
+bool ak_is_tool_hibernating(drgui_element* pTool)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    if (pToolData == NULL) {
+        return false;
+    }
+
+    return pToolData->isHibernating;
+}
+
+
 
 void ak_set_tool_tab(drgui_element* pTool, drgui_tab* pTab)
 {
@@ -209,6 +619,78 @@ void ak_set_tool_tab(drgui_element* pTool, drgui_tab* pTab)
     pToolData->pTab = pTab;
 }
 
+/// Adds the given placeholder tool to the end of the application's placeholder queue.
+static void ak_queue_placeholder_tool(drgui_element* pTool)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    assert(pToolData != NULL);
+    assert(pToolData->isPlaceholder);
+
+    if (pToolData->isQueuedPlaceholder) {
+        return;
+    }
+
+    ak_placeholder_queue* pQueue = ak_get_application_placeholder_queue(pToolData->pApplication);
+    assert(pQueue != NULL);
+
+    pToolData->pPrevQueuedPlaceholder = pQueue->pLastTool;
+    pToolData->pNextQueuedPlaceholder = NULL;
+    pToolData->isQueuedPlaceholder    = true;
+
+    if (pQueue->pLastTool != NULL) {
+        ((ak_tool_data*)drgui_get_extra_data(pQueue->pLastTool))->pNextQueuedPlaceholder = pTool;
+    } else {
+        pQueue->pFirstTool = pTool;
+    }
+
+    pQueue->pLastTool = pTool;
+
+    ak_application_on_placeholder_queued(pToolData->pApplication);
+}
+
+/// Removes the given tool from the application's placeholder queue if it's in it.
+static void ak_unqueue_placeholder_tool(drgui_element* pTool)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    assert(pToolData != NULL);
+
+    if (!pToolData->isQueuedPlaceholder) {
+        return;
+    }
+
+    ak_placeholder_queue* pQueue = ak_get_application_placeholder_queue(pToolData->pApplication);
+    assert(pQueue != NULL);
+
+    if (pToolData->pPrevQueuedPlaceholder != NULL) {
+        ((ak_tool_data*)drgui_get_extra_data(pToolData->pPrevQueuedPlaceholder))->pNextQueuedPlaceholder = pToolData->pNextQueuedPlaceholder;
+    } else {
+        pQueue->pFirstTool = pToolData->pNextQueuedPlaceholder;
+    }
+
+    if (pToolData->pNextQueuedPlaceholder != NULL) {
+        ((ak_tool_data*)drgui_get_extra_data(pToolData->pNextQueuedPlaceholder))->pPrevQueuedPlaceholder = pToolData->pPrevQueuedPlaceholder;
+    } else {
+        pQueue->pLastTool = pToolData->pPrevQueuedPlaceholder;
+    }
+
+    pToolData->pPrevQueuedPlaceholder = NULL;
+    pToolData->pNextQueuedPlaceholder = NULL;
+    pToolData->isQueuedPlaceholder    = false;
+}
+
+drgui_element* ak_dequeue_placeholder_tool(ak_application* pApplication)
+{
+    ak_placeholder_queue* pQueue = ak_get_application_placeholder_queue(pApplication);
+    assert(pQueue != NULL);
+
+    drgui_element* pTool = pQueue->pFirstTool;
+    if (pTool != NULL) {
+        ak_unqueue_placeholder_tool(pTool);
+    }
+
+    return pTool;
+}
+
 void ak_set_tool_panel(drgui_element* pTool, drgui_element* pPanel)
 {
     ak_tool_data* pToolData = drgui_get_extra_data(pTool);
@@ -216,10 +698,148 @@ void ak_set_tool_panel(drgui_element* pTool, drgui_element* pPanel)
         return;
     }
 
-    pToolData->pPanel = pPanel;
+    pToolData->pPanel  = pPanel;
+    pToolData->pWindow = (pPanel != NULL) ? ak_panel_get_cached_window(pPanel) : NULL;
+
+    // Placeholders are queued for pre-creation for as long as they're attached to a panel.
+    if (pToolData->isPlaceholder)
+    {
+        if (pPanel != NULL) {
+            ak_queue_placeholder_tool(pTool);
+        } else {
+            ak_unqueue_placeholder_tool(pTool);
+        }
+    }
+}
+
+void ak_set_tool_panel_slot(drgui_element* pTool, size_t slot)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    assert(pToolData != NULL);
+
+    pToolData->panelSlot = slot;
+}
+
+size_t ak_get_tool_panel_slot(drgui_element* pTool)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    assert(pToolData != NULL);
+
+    return pToolData->panelSlot;
+}
+
+void ak_get_tool_title_size(drgui_element* pTool, drgui_font* pFont, float* pWidthOut, float* pHeightOut)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    assert(pToolData != NULL);
+    assert(pWidthOut != NULL);
+    assert(pHeightOut != NULL);
+
+    if (pToolData->pTitleSizeFont != pFont || pFont == NULL)
+    {
+        pToolData->titleWidth  = 0;
+        pToolData->titleHeight = 0;
+        drgui_measure_string(pFont, pToolData->title, strlen(pToolData->title), 1, 1, &pToolData->titleWidth, &pToolData->titleHeight);
+
+        pToolData->pTitleSizeFont = pFont;
+    }
+
+    *pWidthOut  = pToolData->titleWidth;
+    *pHeightOut = pToolData->titleHeight;
+}
+
+void ak_set_tool_layout_info(drgui_element* pTool, const char* type, const char* attributes)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    if (pToolData == NULL) {
+        return;
+    }
+
+    if (attributes == NULL) {
+        attributes = "";
+    }
+
+    pToolData->hasLayoutInfo =
+        type != NULL &&
+        strcpy_s(pToolData->layoutType,       sizeof(pToolData->layoutType),       type)       == 0 &&
+        strcpy_s(pToolData->layoutAttributes, sizeof(pToolData->layoutAttributes), attributes) == 0;
+}
+
+bool ak_is_tool_from_layout(drgui_element* pTool, const char* type, const char* attributes)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    if (pToolData == NULL || type == NULL) {
+        return false;
+    }
+
+    if (attributes == NULL) {
+        attributes = "";
+    }
+
+    return pToolData->hasLayoutInfo && strcmp(pToolData->layoutType, type) == 0 && strcmp(pToolData->layoutAttributes, attributes) == 0;
+}
+
+const char* ak_get_tool_layout_type(drgui_element* pTool)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    if (pToolData == NULL || !pToolData->hasLayoutInfo) {
+        return NULL;
+    }
+
+    return pToolData->layoutType;
+}
+
+const char* ak_get_tool_layout_attributes(drgui_element* pTool)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    if (pToolData == NULL || !pToolData->hasLayoutInfo) {
+        return NULL;
+    }
+
+    return pToolData->layoutAttributes;
 }
 
 
+drgui_element* ak_create_placeholder_tool(ak_application* pApplication, const char* type, const char* attributes, const char* title)
+{
+    drgui_element* pTool = ak_create_tool(pApplication, NULL, AK_TOOL_TYPE_PLACEHOLDER, 0, NULL);
+    if (pTool == NULL) {
+        return NULL;
+    }
+
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    assert(pToolData != NULL);
+
+    // A placeholder is useless if it can't remember what it's standing in for.
+    ak_set_tool_layout_info(pTool, type, attributes);
+    if (!pToolData->hasLayoutInfo) {
+        ak_delete_tool(pTool);
+        return NULL;
+    }
+
+    pToolData->isPlaceholder = true;
+    ak_set_tool_title(pTool, title);
+
+    return pTool;
+}
+
+
+void ak_set_tool_deactivation_time(drgui_element* pTool, uint64_t time)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    assert(pToolData != NULL);
+
+    pToolData->deactivationTime = time;
+}
+
+uint64_t ak_get_tool_deactivation_time(drgui_element* pTool)
+{
+    ak_tool_data* pToolData = drgui_get_extra_data(pTool);
+    assert(pToolData != NULL);
+
+    return pToolData->deactivationTime;
+}
+
 
 /*
 This is free and unencumbered software released into the public domain.
@@ -6,6 +6,14 @@
 // - A type of a tool is defined by a string, which can be in a format such as "Editor.Text.CPP". The function
 //   ak_is_tool_of_type() can be used to determine whether or not the given tool is of a particular type. With
 //   the example above, true will be returned for a call such as ak_is_tool_of_type(pMyTool, "Editor.Text").
+// - When a layout is applied, tools in inactive tabs can be represented by placeholders until their tab is first
+//   activated, at which point the placeholder is replaced with the real tool. Placeholders are only used when the
+//   application has set a callback with ak_set_on_get_tool_title(), and are never passed to the application's
+//   onDeleteTool callback.
+// - A tool that's not active can be hibernated to free the memory it's using. The tool's onHibernate callback saves
+//   whatever it needs into a blob and releases everything else, such as it's child elements, buffers and timers. The
+//   onRestore callback recreates them from the blob when the tool's tab is next activated. Only tools that have set
+//   both callbacks are ever hibernated.
 //
 
 #ifndef ak_tool_h
@@ -17,9 +25,15 @@ extern "C" {
 
 typedef struct drgui_element drgui_element;
 typedef struct ak_application ak_application;
+typedef struct ak_window ak_window;
 typedef struct drgui_tab drgui_tab;
 
+/// The type of placeholder tools.
+#define AK_TOOL_TYPE_PLACEHOLDER    "AK.Placeholder"
+
 typedef void (* ak_tool_on_handle_action_proc)(drgui_element* pTool, const char* pActionName);
+typedef bool (* ak_tool_on_hibernate_proc)(drgui_element* pTool, void** ppStateOut, size_t* pStateSizeOut);
+typedef bool (* ak_tool_on_restore_proc)(drgui_element* pTool, const void* pState, size_t stateSize);
 
 /// Creates a tool.
 ///
@@ -31,6 +45,9 @@ drgui_element* ak_create_tool(ak_application* pApplication, drgui_element* pPare
 ///
 /// @remarks
 ///     This is equivalent to drgui_delete_element(), but is included for consistency with ak_delete_tool().
+///     @par
+///     The tool is detached from it's panel and it's hibernation state is released by the element's on_delete event, so
+///     tools should not replace it with drgui_set_on_delete().
 void ak_delete_tool(drgui_element* pTool);
 
 /// Retrieves a pointer to the application that owns the given tool.
@@ -56,6 +73,9 @@ bool ak_is_of_tool_type(const char* pToolType, const char* pBaseToolType);
 ///     if this function is called with a type of "Editor.Text".
 bool ak_is_tool_of_type(drgui_element* pTool, const char* type);
 
+/// Determines whether or not the given tool is a placeholder for a tool that has not been created yet.
+bool ak_is_placeholder_tool(drgui_element* pTool);
+
 
 /// Retrieves the tab associated with the given tool.
 drgui_tab* ak_get_tool_tab(drgui_element* pTool);
@@ -63,6 +83,13 @@ drgui_tab* ak_get_tool_tab(drgui_element* pTool);
 /// Retrieves the panel the tool is attached to, if any.
 drgui_element* ak_get_tool_panel(drgui_element* pTool);
 
+/// Retrieves the window the tool is in, if any.
+///
+/// @remarks
+///     This is constant time when the tool is attached to a panel in the main hierarchy of a window. Otherwise it will
+///     walk up to the root panel of the window.
+ak_window* ak_get_tool_window(drgui_element* pTool);
+
 
 /// Sets the title of the tool.
 ///
@@ -75,12 +102,59 @@ const char* ak_get_tool_title(drgui_element* pTool);
 
 
 /// Allows the tool to handle the given action.
+///
+/// @remarks
+///     If a handler has been set for the action and the tool's type, or one of it's base types, with
+///     ak_set_tool_type_action_handler() it will be called. Otherwise the action is passed to the function that was set
+///     with ak_tool_set_on_handle_action().
 void ak_tool_handle_action(drgui_element* pTool, const char* pActionName);
 
+/// Allows the tool to handle the action with the given ID.
+///
+/// @remarks
+///     This is the same as ak_tool_handle_action(), only that the name does not need to be looked up.
+void ak_tool_handle_action_by_id(drgui_element* pTool, ak_action_id actionID);
+
 /// Sets the function to call when an action needs to be handled.
 void ak_tool_set_on_handle_action(drgui_element* pTool, ak_tool_on_handle_action_proc proc);
 
 
+/// Sets the function to call when the tool is hibernated.
+///
+/// @remarks
+///     The callback should release as much of the tool's memory as it can and return the state it needs to restore
+///     itself in a buffer allocated with malloc(), which the application takes ownership of. It can return a null
+///     buffer if there's nothing to save. Return false to keep the tool as it is, in which case the buffer is ignored.
+void ak_tool_set_on_hibernate(drgui_element* pTool, ak_tool_on_hibernate_proc proc);
+
+/// Sets the function to call when the tool is restored after being hibernated.
+///
+/// @remarks
+///     The callback is given the state that was returned by the onHibernate callback. The state is freed afterwards,
+///     so it needs to be copied if it's needed later. Return false if the tool could not be restored, in which case it
+///     remains hibernated and restoring it will be tried again the next time it's activated.
+void ak_tool_set_on_restore(drgui_element* pTool, ak_tool_on_restore_proc proc);
+
+/// Hibernates the given tool.
+///
+/// @remarks
+///     This fails if the tool has not set both an onHibernate and an onRestore callback, or if it's the active tool of
+///     it's panel. If the application has a hibernation folder (see ak_set_tool_hibernation_folder()) the state is
+///     written to a file in it. Otherwise it's kept in memory.
+///     @par
+///     A hibernated tool is restored automatically when it's tab is activated.
+bool ak_hibernate_tool(drgui_element* pTool);
+
+/// Restores the given tool if it's hibernating.
+///
+/// @remarks
+///     This returns true if the tool is not hibernating.
+bool ak_restore_tool(drgui_element* pTool);
+
+/// Determines whether or not the given tool is hibernating.
+bool ak_is_tool_hibernating(drgui_element* pTool);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,9 +18,81 @@ void ak_set_tool_tab(drgui_element* pTool, drgui_tab* pTab);
 /// Sets the panel the tool is attached to.
 ///
 /// @remarks
-///     This is only used by panels when the tool is attached to it. This is just a basic setter.
+///     This is only used by panels when the tool is attached to or detached from it. This also updates the tool's
+///     cached window.
 void ak_set_tool_panel(drgui_element* pTool, drgui_element* pPanel);
 
+/// Determines whether or not the given element is a tool that was created with ak_create_tool().
+///
+/// @remarks
+///     This is safe to call on any element.
+bool ak_is_tool(drgui_element* pElement);
+
+/// Retrieves the window that's cached on the given tool.
+///
+/// @remarks
+///     This will return null if the tool is not attached to a panel in the main hierarchy. Use ak_get_tool_window() for
+///     the general case.
+ak_window* ak_get_tool_cached_window(drgui_element* pTool);
+
+/// Sets the position of the tool in the list of tools of the panel it's attached to.
+///
+/// @remarks
+///     This is only used by panels, which use it to find a tool's index without searching.
+void ak_set_tool_panel_slot(drgui_element* pTool, size_t slot);
+
+/// Removes the first placeholder tool from the application's placeholder queue and returns it.
+///
+/// @remarks
+///     This returns null if the queue is empty. Placeholders are queued in the order they're attached to panels, and
+///     leave the queue when they're detached.
+drgui_element* ak_dequeue_placeholder_tool(ak_application* pApplication);
+
+/// Retrieves the position of the tool in the list of tools of the panel it's attached to.
+size_t ak_get_tool_panel_slot(drgui_element* pTool);
+
+/// Retrieves the size of the given tool's title when it's drawn with the given font at a scale of 1.
+///
+/// @remarks
+///     The size is cached on the tool, so the title is only measured again when it or the font changes.
+void ak_get_tool_title_size(drgui_element* pTool, drgui_font* pFont, float* pWidthOut, float* pHeightOut);
+
+/// Records the layout type and attributes the given tool was created from.
+///
+/// @remarks
+///     This is used by ak_create_tool_by_type_and_attributes() so that the tool can be matched up with the items of
+///     another layout when the application switches layouts.
+void ak_set_tool_layout_info(drgui_element* pTool, const char* type, const char* attributes);
+
+/// Determines whether or not the given tool was created from the given layout type and attributes.
+bool ak_is_tool_from_layout(drgui_element* pTool, const char* type, const char* attributes);
+
+/// Retrieves the layout type the given tool was created from, or null if it's not known.
+const char* ak_get_tool_layout_type(drgui_element* pTool);
+
+/// Retrieves the layout attributes the given tool was created from, or null if they're not known.
+const char* ak_get_tool_layout_attributes(drgui_element* pTool);
+
+
+/// Creates a placeholder for the tool with the given layout type and attributes.
+///
+/// @remarks
+///     The placeholder has the given title so that it's tab looks the same as the real tool's would. The real tool is
+///     created with ak_panel_realize_tool().
+///     @par
+///     This returns null if the type or attributes are too long to be stored.
+drgui_element* ak_create_placeholder_tool(ak_application* pApplication, const char* type, const char* attributes, const char* title);
+
+
+/// Sets the time the given tool was last deactivated.
+///
+/// @remarks
+///     This is used by the application's hibernation policy to determine how long a tool has been inactive for.
+void ak_set_tool_deactivation_time(drgui_element* pTool, uint64_t time);
+
+/// Retrieves the time the given tool was last deactivated, or created if it has never been deactivated.
+uint64_t ak_get_tool_deactivation_time(drgui_element* pTool);
+
 
 #ifdef __cplusplus
 }
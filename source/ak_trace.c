@@ -0,0 +1,437 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+typedef struct
+{
+    /// The name of the event. This is not copied.
+    const char* name;
+
+    /// The category of the event. This is not copied.
+    const char* category;
+
+    /// The time the event began, in microseconds.
+    uint64_t beginTime;
+
+    /// The duration of the event, in microseconds.
+    uint64_t duration;
+
+    /// Additional information about the event, such as the name of an action. This is written to the event's args.
+    char detail[AK_MAX_TRACE_DETAIL_LENGTH];
+
+} ak_trace_event;
+
+typedef struct ak_trace_chunk ak_trace_chunk;
+struct ak_trace_chunk
+{
+    /// The number of events in the chunk. This is only incremented by the thread that owns the chunk, and only after
+    /// the event has been fully written.
+    volatile size_t count;
+
+    /// A pointer to the next chunk, stored as a size_t so it can be published atomically. This is set by the owning
+    /// thread once the chunk is full, after which the owning thread never touches this chunk again.
+    volatile size_t next;
+
+    /// The events.
+    ak_trace_event events[AK_TRACE_CHUNK_SIZE];
+};
+
+typedef struct ak_trace_buffer ak_trace_buffer;
+struct ak_trace_buffer
+{
+    /// The ID of the thread that owns the buffer.
+    size_t threadID;
+
+    /// The chunk events are being recorded to. This is only accessed by the owning thread.
+    ak_trace_chunk* pTailChunk;
+
+    /// The oldest chunk that has not yet been freed. This is only accessed while the tracer's lock is held.
+    ak_trace_chunk* pHeadChunk;
+
+    /// The number of events in the head chunk that have already been written. This is only accessed while the
+    /// tracer's lock is held.
+    size_t writtenCount;
+
+    /// The next buffer in the tracer's list.
+    ak_trace_buffer* pNextBuffer;
+};
+
+struct ak_tracer
+{
+    /// A unique identifier for the tracer. This is what the thread-local buffer cache is keyed on so that a stale
+    /// cache entry is never dereferenced, even if a new tracer ends up at the same address as a deleted one.
+    size_t id;
+
+    /// Non-zero when events are being recorded.
+    volatile size_t isEnabled;
+
+    /// The lock protecting the buffer list and the file.
+    ak_mutex lock;
+
+    /// The first buffer in the list of per-thread buffers.
+    ak_trace_buffer* pFirstBuffer;
+
+    /// The file events are written to. This is null when tracing is stopped.
+    drfs_file* pFile;
+
+    /// Whether or not an event has been written to the file. This is used for placing commas between events.
+    bool hasWrittenEvent;
+};
+
+
+static volatile size_t g_AKNextTracerID = 0;
+static volatile size_t g_AKNextTraceThreadID = 0;
+
+/// The ID of the calling thread, for the purpose of tracing. This is assigned the first time the thread records an event.
+static AK_THREAD_LOCAL size_t g_AKTraceThreadID = 0;
+
+/// The calling thread's buffer for the tracer whose ID is g_AKTraceBufferTracerID.
+static AK_THREAD_LOCAL ak_trace_buffer* g_pAKTraceBuffer = NULL;
+static AK_THREAD_LOCAL size_t g_AKTraceBufferTracerID = 0;
+
+
+static ak_trace_buffer* ak_tracer_get_thread_buffer(ak_tracer* pTracer)
+{
+    assert(pTracer != NULL);
+
+    if (g_AKTraceBufferTracerID == pTracer->id) {
+        return g_pAKTraceBuffer;
+    }
+
+    if (g_AKTraceThreadID == 0) {
+        g_AKTraceThreadID = ak_atomic_add(&g_AKNextTraceThreadID, 1);
+    }
+
+    ak_trace_buffer* pBuffer = NULL;
+    ak_lock_mutex(&pTracer->lock);
+    {
+        // The thread may have recorded to this tracer before, with another tracer in between.
+        for (pBuffer = pTracer->pFirstBuffer; pBuffer != NULL; pBuffer = pBuffer->pNextBuffer) {
+            if (pBuffer->threadID == g_AKTraceThreadID) {
+                break;
+            }
+        }
+
+        if (pBuffer == NULL)
+        {
+            pBuffer = malloc(sizeof(*pBuffer));
+            if (pBuffer != NULL)
+            {
+                pBuffer->pTailChunk = calloc(1, sizeof(*pBuffer->pTailChunk));
+                if (pBuffer->pTailChunk != NULL)
+                {
+                    pBuffer->threadID     = g_AKTraceThreadID;
+                    pBuffer->pHeadChunk   = pBuffer->pTailChunk;
+                    pBuffer->writtenCount = 0;
+                    pBuffer->pNextBuffer  = pTracer->pFirstBuffer;
+                    pTracer->pFirstBuffer = pBuffer;
+                }
+                else
+                {
+                    free(pBuffer);
+                    pBuffer = NULL;
+                }
+            }
+        }
+    }
+    ak_unlock_mutex(&pTracer->lock);
+
+    if (pBuffer != NULL) {
+        g_pAKTraceBuffer        = pBuffer;
+        g_AKTraceBufferTracerID = pTracer->id;
+    }
+
+    return pBuffer;
+}
+
+static void ak_tracer_write_escaped_string(drfs_file* pFile, const char* str)
+{
+    assert(pFile != NULL);
+
+    char escaped[AK_MAX_TRACE_DETAIL_LENGTH*2 + 1];
+    size_t length = 0;
+
+    for (const char* pChar = str; *pChar != '\0'; ++pChar)
+    {
+        if (length + 2 >= sizeof(escaped)) {
+            escaped[length] = '\0';
+            drfs_write_string(pFile, escaped);
+            length = 0;
+        }
+
+        char c = *pChar;
+        if (c == '"' || c == '\\') {
+            escaped[length++] = '\\';
+            escaped[length++] = c;
+        } else if ((unsigned char)c < 32) {
+            escaped[length++] = ' ';        // Control characters are not allowed in JSON strings.
+        } else {
+            escaped[length++] = c;
+        }
+    }
+
+    escaped[length] = '\0';
+    drfs_write_string(pFile, escaped);
+}
+
+static void ak_tracer_write_event(ak_tracer* pTracer, size_t threadID, const ak_trace_event* pEvent)
+{
+    assert(pTracer != NULL);
+    assert(pTracer->pFile != NULL);
+    assert(pEvent != NULL);
+
+    drfs_write_string(pTracer->pFile, (pTracer->hasWrittenEvent) ? ",\n{\"name\":\"" : "{\"name\":\"");
+    ak_tracer_write_escaped_string(pTracer->pFile, pEvent->name);
+    drfs_write_string(pTracer->pFile, "\",\"cat\":\"");
+    ak_tracer_write_escaped_string(pTracer->pFile, pEvent->category);
+
+    char timing[128];
+    snprintf(timing, sizeof(timing), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"dur\":%llu", (unsigned int)threadID, (unsigned long long)pEvent->beginTime, (unsigned long long)pEvent->duration);
+    drfs_write_string(pTracer->pFile, timing);
+
+    if (pEvent->detail[0] != '\0') {
+        drfs_write_string(pTracer->pFile, ",\"args\":{\"detail\":\"");
+        ak_tracer_write_escaped_string(pTracer->pFile, pEvent->detail);
+        drfs_write_string(pTracer->pFile, "\"}");
+    }
+
+    drfs_write_string(pTracer->pFile, "}");
+    pTracer->hasWrittenEvent = true;
+}
+
+/// Walks over every event that has been recorded since the last call, writing them to the file if <write> is true.
+/// Chunks that have been fully consumed are freed. The tracer's lock must be held.
+static void ak_tracer_consume_events(ak_tracer* pTracer, bool write)
+{
+    assert(pTracer != NULL);
+
+    for (ak_trace_buffer* pBuffer = pTracer->pFirstBuffer; pBuffer != NULL; pBuffer = pBuffer->pNextBuffer)
+    {
+        for (;;)
+        {
+            ak_trace_chunk* pChunk = pBuffer->pHeadChunk;
+
+            size_t count = ak_atomic_load(&pChunk->count);
+            if (write) {
+                for (size_t i = pBuffer->writtenCount; i < count; ++i) {
+                    ak_tracer_write_event(pTracer, pBuffer->threadID, &pChunk->events[i]);
+                }
+            }
+            pBuffer->writtenCount = count;
+
+            // A full chunk with a successor will never be touched by the owning thread again so it's safe to free.
+            if (count < AK_TRACE_CHUNK_SIZE) {
+                break;
+            }
+
+            ak_trace_chunk* pNextChunk = (ak_trace_chunk*)ak_atomic_load(&pChunk->next);
+            if (pNextChunk == NULL) {
+                break;
+            }
+
+            pBuffer->pHeadChunk   = pNextChunk;
+            pBuffer->writtenCount = 0;
+            free(pChunk);
+        }
+    }
+}
+
+
+ak_tracer* ak_create_tracer()
+{
+    ak_tracer* pTracer = malloc(sizeof(*pTracer));
+    if (pTracer == NULL) {
+        return NULL;
+    }
+
+    if (!ak_init_mutex(&pTracer->lock)) {
+        free(pTracer);
+        return NULL;
+    }
+
+    pTracer->id              = ak_atomic_add(&g_AKNextTracerID, 1);
+    pTracer->isEnabled       = 0;
+    pTracer->pFirstBuffer    = NULL;
+    pTracer->pFile           = NULL;
+    pTracer->hasWrittenEvent = false;
+
+    return pTracer;
+}
+
+void ak_delete_tracer(ak_tracer* pTracer)
+{
+    if (pTracer == NULL) {
+        return;
+    }
+
+    assert(pTracer->pFile == NULL);     // <-- If you've hit this assert it means tracing was not stopped.
+
+    ak_trace_buffer* pBuffer = pTracer->pFirstBuffer;
+    while (pBuffer != NULL)
+    {
+        ak_trace_chunk* pChunk = pBuffer->pHeadChunk;
+        while (pChunk != NULL) {
+            ak_trace_chunk* pNextChunk = (ak_trace_chunk*)pChunk->next;
+            free(pChunk);
+            pChunk = pNextChunk;
+        }
+
+        ak_trace_buffer* pNextBuffer = pBuffer->pNextBuffer;
+        free(pBuffer);
+        pBuffer = pNextBuffer;
+    }
+
+    ak_uninit_mutex(&pTracer->lock);
+    free(pTracer);
+}
+
+
+bool ak_tracer_start(ak_tracer* pTracer, drfs_file* pFile)
+{
+    if (pTracer == NULL || pFile == NULL) {
+        return false;
+    }
+
+    bool result = false;
+    ak_lock_mutex(&pTracer->lock);
+    {
+        if (pTracer->pFile == NULL)
+        {
+            // Anything a thread managed to record just after the previous session was stopped is thrown away so it
+            // doesn't end up in this session.
+            ak_tracer_consume_events(pTracer, false);
+
+            pTracer->pFile           = pFile;
+            pTracer->hasWrittenEvent = false;
+            drfs_write_string(pTracer->pFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+            ak_atomic_store(&pTracer->isEnabled, 1);
+            result = true;
+        }
+    }
+    ak_unlock_mutex(&pTracer->lock);
+
+    return result;
+}
+
+drfs_file* ak_tracer_stop(ak_tracer* pTracer)
+{
+    if (pTracer == NULL) {
+        return NULL;
+    }
+
+    ak_atomic_store(&pTracer->isEnabled, 0);
+
+    drfs_file* pFile = NULL;
+    ak_lock_mutex(&pTracer->lock);
+    {
+        if (pTracer->pFile != NULL)
+        {
+            ak_tracer_consume_events(pTracer, true);
+            drfs_write_string(pTracer->pFile, "\n]}\n");
+            drfs_flush(pTracer->pFile);
+
+            pFile = pTracer->pFile;
+            pTracer->pFile = NULL;
+        }
+    }
+    ak_unlock_mutex(&pTracer->lock);
+
+    return pFile;
+}
+
+void ak_tracer_drain(ak_tracer* pTracer)
+{
+    if (pTracer == NULL) {
+        return;
+    }
+
+    ak_lock_mutex(&pTracer->lock);
+    {
+        if (pTracer->pFile != NULL) {
+            ak_tracer_consume_events(pTracer, true);
+            drfs_flush(pTracer->pFile);
+        }
+    }
+    ak_unlock_mutex(&pTracer->lock);
+}
+
+bool ak_tracer_is_enabled(ak_tracer* pTracer)
+{
+    if (pTracer == NULL) {
+        return false;
+    }
+
+    return ak_atomic_load(&pTracer->isEnabled) != 0;
+}
+
+
+void ak_tracer_record(ak_tracer* pTracer, const char* name, const char* category, const char* detail, uint64_t beginTime, uint64_t endTime)
+{
+    if (pTracer == NULL || name == NULL || !ak_tracer_is_enabled(pTracer)) {
+        return;
+    }
+
+    ak_trace_buffer* pBuffer = ak_tracer_get_thread_buffer(pTracer);
+    if (pBuffer == NULL) {
+        return;
+    }
+
+    ak_trace_chunk* pChunk = pBuffer->pTailChunk;
+    size_t count = pChunk->count;       // <-- Only this thread changes this so it doesn't need to be an atomic load.
+    if (count == AK_TRACE_CHUNK_SIZE)
+    {
+        ak_trace_chunk* pNewChunk = calloc(1, sizeof(*pNewChunk));
+        if (pNewChunk == NULL) {
+            return;
+        }
+
+        // Once the new chunk is published the old one may be freed by ak_tracer_drain() at any moment, so it must not
+        // be touched after this point.
+        ak_atomic_store(&pChunk->next, (size_t)pNewChunk);
+        pBuffer->pTailChunk = pNewChunk;
+
+        pChunk = pNewChunk;
+        count  = 0;
+    }
+
+    ak_trace_event* pEvent = &pChunk->events[count];
+    pEvent->name      = name;
+    pEvent->category  = (category != NULL) ? category : "";
+    pEvent->beginTime = beginTime;
+    pEvent->duration  = (endTime > beginTime) ? endTime - beginTime : 0;
+
+    if (detail != NULL) {
+        strncpy_s(pEvent->detail, sizeof(pEvent->detail), detail, _TRUNCATE);
+    } else {
+        pEvent->detail[0] = '\0';
+    }
+
+    ak_atomic_store(&pChunk->count, count + 1);
+}
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
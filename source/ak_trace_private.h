@@ -0,0 +1,105 @@
+// Public domain. See "unlicense" statement at the end of this file.
+
+//
+// QUICK NOTES
+//
+// - The tracer records complete ("X" phase) events in the Chrome trace event format, which can be loaded into
+//   chrome://tracing or Perfetto.
+// - Each thread records into it's own buffer, which is a list of fixed size chunks. Recording an event does not take
+//   any locks. The only time a lock is taken is the first time a thread records an event for a given tracer.
+// - Events are written to the file by ak_tracer_drain(), which the application calls periodically from a worker thread,
+//   and by ak_tracer_stop(). The chunks that have been written are freed at that point so memory usage stays bounded
+//   however long tracing runs for.
+// - When tracing is disabled, recording an event is a single atomic load.
+// - Event names and categories are not copied, so they must be string literals or otherwise outlive the tracer. The
+//   detail string is copied and truncated to AK_MAX_TRACE_DETAIL_LENGTH.
+//
+
+#ifndef ak_trace_private_h
+#define ak_trace_private_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ak_tracer ak_tracer;
+
+
+/// Creates a tracer. Tracing is initially stopped.
+ak_tracer* ak_create_tracer();
+
+/// Deletes the given tracer.
+///
+/// @remarks
+///     Tracing must be stopped first, and no other thread may be recording events.
+void ak_delete_tracer(ak_tracer* pTracer);
+
+
+/// Starts recording events to the given file.
+///
+/// @remarks
+///     The tracer does not take ownership of the file. It is returned by ak_tracer_stop().
+///     @par
+///     This will return false if tracing has already been started.
+bool ak_tracer_start(ak_tracer* pTracer, drfs_file* pFile);
+
+/// Stops recording events and writes everything that has been recorded to the file.
+///
+/// @remarks
+///     This returns the file that was passed to ak_tracer_start() so the caller can close it, or null if tracing was
+///     not started.
+drfs_file* ak_tracer_stop(ak_tracer* pTracer);
+
+/// Writes every event that has been recorded since the last drain to the file and frees the chunks that held them.
+///
+/// @remarks
+///     This can be called from any thread, and does nothing if tracing is stopped. The tracer's lock is held while the
+///     events are written, which only blocks threads that are recording their first event.
+void ak_tracer_drain(ak_tracer* pTracer);
+
+/// Determines whether or not events are being recorded.
+bool ak_tracer_is_enabled(ak_tracer* pTracer);
+
+
+/// Records an event on the calling thread.
+///
+/// @remarks
+///     Times are in microseconds, as returned by ak_get_time_in_microseconds(). <detail> can be null.
+///     @par
+///     This is thread-safe and does nothing if tracing is disabled.
+void ak_tracer_record(ak_tracer* pTracer, const char* name, const char* category, const char* detail, uint64_t beginTime, uint64_t endTime);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
+/*
+This is free and unencumbered software released into the public domain.
+
+Anyone is free to copy, modify, publish, use, compile, sell, or
+distribute this software, either in source code form or as a compiled
+binary, for any purpose, commercial or non-commercial, and by any
+means.
+
+In jurisdictions that recognize copyright laws, the author or authors
+of this software dedicate any and all copyright interest in the
+software to the public domain. We make this dedication for the benefit
+of the public at large and to the detriment of our heirs and
+successors. We intend this dedication to be an overt act of
+relinquishment in perpetuity of all present and future rights to this
+software under copyright law.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+For more information, please refer to <http://unlicense.org/>
+*/
\ No newline at end of file
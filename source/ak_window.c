@@ -45,6 +45,37 @@ struct ak_window
     int absoluteClientPosY;
 #endif
 
+#ifdef AK_USE_HEADLESS
+    /// The position of the window, relative to the parent.
+    int posX;
+    int posY;
+
+    /// The size of the window.
+    int width;
+    int height;
+
+    /// The title of the window.
+    char title[AK_MAX_WINDOW_TITLE_LENGTH];
+
+    /// The cursor to use with this window.
+    ak_cursor_type cursor;
+
+    /// Keeps track of whether or not the window is visible.
+    bool isVisible;
+
+    /// Keeps track of whether or not the cursor is over this window.
+    bool isCursorOver;
+
+    /// Keeps track of whether or not the window is marked as deleted.
+    bool isMarkedAsDeleted;
+
+    /// Keeps track of whether or not any part of the window has been invalidated since it was last painted.
+    bool isDirty;
+
+    /// The union of every rectangle that has been invalidated since the window was last painted.
+    drgui_rect dirtyRect;
+#endif
+
 
     /// A pointer to the application that owns this window.
     ak_application* pApplication;
@@ -66,6 +97,10 @@ struct ak_window
     unsigned int onHideFlags;
 
 
+    /// The window's statistics. See ak_get_window_stats().
+    ak_window_stats stats;
+
+
     /// The function to call when the window is wanting to close.
     ak_window_on_close_proc onClose;
 
@@ -112,6 +147,10 @@ struct ak_window
     /// A pointer to the parent window.
     ak_window* pParent;
 
+    /// The number of ancestors this window has. This is 0 for top level windows and is used to avoid walking the
+    /// parent chain in ak_is_window_ancestor().
+    unsigned int depth;
+
     /// The first child window.
     ak_window* pFirstChild;
 
@@ -136,6 +175,8 @@ static void ak_detach_window(ak_window* pWindow)
 {
     if (pWindow->pParent != NULL)
     {
+        ak_application_unindex_window(pWindow);
+
         if (pWindow->pParent->pFirstChild == pWindow) {
             pWindow->pParent->pFirstChild = pWindow->pNextSibling;
         }
@@ -157,6 +198,7 @@ static void ak_detach_window(ak_window* pWindow)
     pWindow->pParent      = NULL;
     pWindow->pPrevSibling = NULL;
     pWindow->pNextSibling = NULL;
+    pWindow->depth        = 0;
 }
 
 static void ak_append_window(ak_window* pWindow, ak_window* pParent)
@@ -177,6 +219,88 @@ static void ak_append_window(ak_window* pWindow, ak_window* pParent)
     }
 
     pWindow->pParent->pLastChild = pWindow;
+    pWindow->depth = pParent->depth + 1;
+
+    ak_application_index_window(pWindow);
+}
+
+
+// The statistics of every window are also added to the application's running totals so that they survive the window
+// being deleted. Everything here is only ever called from the main thread, so plain increments are fine.
+//
+// Painting is also where trace events for paints and blits are recorded since the timestamps are already on hand. When
+// there's no separate blit, <blitStartTime> should be equal to <endTime>.
+static void ak_window_count_paint(ak_window* pWindow, uint64_t paintStartTime, uint64_t blitStartTime, uint64_t endTime)
+{
+    assert(pWindow != NULL);
+
+    uint64_t paintTimeInMicroseconds = blitStartTime - paintStartTime;
+    uint64_t blitTimeInMicroseconds  = endTime - blitStartTime;
+
+    ak_trace_record(pWindow->pApplication, "paint", AK_TRACE_CATEGORY_PAINT, pWindow->name, paintStartTime, blitStartTime);
+    if (blitTimeInMicroseconds > 0) {
+        ak_trace_record(pWindow->pApplication, "blit", AK_TRACE_CATEGORY_PAINT, pWindow->name, blitStartTime, endTime);
+    }
+
+    ak_window_stats* pTotals = ak_get_application_window_stats_totals(pWindow->pApplication);
+
+    pWindow->stats.paintCount              += 1;
+    pWindow->stats.paintTimeInMicroseconds += paintTimeInMicroseconds;
+    pWindow->stats.blitTimeInMicroseconds  += blitTimeInMicroseconds;
+    pTotals->paintCount                    += 1;
+    pTotals->paintTimeInMicroseconds       += paintTimeInMicroseconds;
+    pTotals->blitTimeInMicroseconds        += blitTimeInMicroseconds;
+
+    ak_application_on_window_painted(pWindow, endTime);
+}
+
+void ak_update_window_layout(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    // Layouts are left alone in the middle of a batch update since whatever's being updated may be half done.
+    if (ak_application_is_in_batch_update(pWindow->pApplication)) {
+        return;
+    }
+
+    ak_panel_update_layout(pWindow->pPanel);
+}
+
+static void ak_window_count_dirty_rect(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    pWindow->stats.dirtyRectCount += 1;
+    ak_get_application_window_stats_totals(pWindow->pApplication)->dirtyRectCount += 1;
+}
+
+static void ak_window_count_surface_recreation(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    pWindow->stats.surfaceRecreationCount += 1;
+    ak_get_application_window_stats_totals(pWindow->pApplication)->surfaceRecreationCount += 1;
+}
+
+/// Finds the root panel of the window the given element is in, or null if it's not in a window.
+///
+/// @remarks
+///     This is called for every dirty rectangle, cursor change and capture, so it uses the window cached on the
+///     element or it's nearest panel or tool. The whole tree is only walked if that fails, which is the case while a
+///     window's root panel is still being created.
+static drgui_element* ak_find_element_root_panel(drgui_element* pElement)
+{
+    ak_window* pWindow = ak_get_element_window(pElement);
+    if (pWindow != NULL && pWindow->pPanel != NULL) {
+        return pWindow->pPanel;
+    }
+
+    drgui_element* pTopLevelElement = drgui_find_top_level_element(pElement);
+    if (!ak_panel_is_of_type(pTopLevelElement, "AK.RootWindowPanel")) {
+        return NULL;
+    }
+
+    return pTopLevelElement;
 }
 
 
@@ -203,10 +327,12 @@ typedef struct
 
 static void ak_on_global_capture_mouse(drgui_element* pElement)
 {
-    drgui_element* pTopLevelElement = drgui_find_top_level_element(pElement);
-    assert(pTopLevelElement != NULL);
+    drgui_element* pRootPanel = ak_find_element_root_panel(pElement);
+    if (pRootPanel == NULL) {
+        return;
+    }
 
-    ak_element_user_data* pElementData = ak_panel_get_extra_data(pTopLevelElement);
+    ak_element_user_data* pElementData = ak_panel_get_extra_data(pRootPanel);
     if (pElementData != NULL) {
         SetCapture(pElementData->hWnd);
     }
@@ -214,23 +340,23 @@ static void ak_on_global_capture_mouse(drgui_element* pElement)
 
 static void ak_on_global_release_mouse(drgui_element* pElement)
 {
-    drgui_element* pTopLevelElement = drgui_find_top_level_element(pElement);
-    assert(pTopLevelElement != NULL);
+    (void)pElement;
 
-    ak_element_user_data* pElementData = ak_panel_get_extra_data(pTopLevelElement);
-    if (pElementData != NULL) {
-        ReleaseCapture();
-    }
+    // The capture doesn't belong to any particular window so there's no need to look it up. This also means the capture
+    // is still released if the element has already been removed from it's window.
+    ReleaseCapture();
 }
 
 static void ak_on_global_capture_keyboard(drgui_element* pElement, drgui_element* pPrevCapturedElement)
 {
     (void)pPrevCapturedElement;
 
-    drgui_element* pTopLevelElement = drgui_find_top_level_element(pElement);
-    assert(pTopLevelElement != NULL);
+    drgui_element* pRootPanel = ak_find_element_root_panel(pElement);
+    if (pRootPanel == NULL) {
+        return;
+    }
 
-    ak_element_user_data* pElementData = ak_panel_get_extra_data(pTopLevelElement);
+    ak_element_user_data* pElementData = ak_panel_get_extra_data(pRootPanel);
     if (pElementData != NULL) {
         SetFocus(pElementData->hWnd);
     }
@@ -238,23 +364,21 @@ static void ak_on_global_capture_keyboard(drgui_element* pElement, drgui_element
 
 static void ak_on_global_release_keyboard(drgui_element* pElement, drgui_element* pNewCapturedElement)
 {
+    (void)pElement;
     (void)pNewCapturedElement;
 
-    drgui_element* pTopLevelElement = drgui_find_top_level_element(pElement);
-    assert(pTopLevelElement != NULL);
-
-    ak_element_user_data* pElementData = ak_panel_get_extra_data(pTopLevelElement);
-    if (pElementData != NULL) {
-        SetFocus(NULL);
-    }
+    // As with the mouse, the focus is released without looking up the window.
+    SetFocus(NULL);
 }
 
 static void ak_on_global_dirty(drgui_element* pElement, drgui_rect relativeRect)
 {
-    drgui_element* pTopLevelElement = drgui_find_top_level_element(pElement);
-    assert(pTopLevelElement != NULL);
+    drgui_element* pRootPanel = ak_find_element_root_panel(pElement);
+    if (pRootPanel == NULL) {
+        return;
+    }
 
-    ak_element_user_data* pElementData = ak_panel_get_extra_data(pTopLevelElement);
+    ak_element_user_data* pElementData = ak_panel_get_extra_data(pRootPanel);
     if (pElementData != NULL)
     {
         drgui_rect absoluteRect = relativeRect;
@@ -267,6 +391,8 @@ static void ak_on_global_dirty(drgui_element* pElement, drgui_rect relativeRect)
         rect.right  = (LONG)absoluteRect.right;
         rect.bottom = (LONG)absoluteRect.bottom;
         InvalidateRect(pElementData->hWnd, &rect, FALSE);
+
+        ak_window_count_dirty_rect(pElementData->pWindow);
     }
 }
 
@@ -278,6 +404,7 @@ static drgui_element* ak_create_window_panel(ak_application* pApplication, ak_wi
         return NULL;
     }
 
+    ak_panel_mark_as_window_root(pElement, pWindow);
     ak_panel_set_type(pElement, "AK.RootWindowPanel");
 
 
@@ -306,6 +433,7 @@ static drgui_element* ak_create_window_panel(ak_application* pApplication, ak_wi
 
 static void ak_delete_window_panel(drgui_element* pTopLevelElement)
 {
+    ak_panel_unindex_recursive(pTopLevelElement);
     drgui_delete_element(pTopLevelElement);
 }
 
@@ -373,11 +501,13 @@ ak_window* ak_alloc_and_init_window_win32(ak_application* pApplication, ak_windo
     pWindow->onKeyUp               = NULL;
     pWindow->onPrintableKeyDown    = NULL;
     pWindow->pParent               = NULL;
+    pWindow->depth                 = 0;
     pWindow->pFirstChild           = NULL;
     pWindow->pLastChild            = NULL;
     pWindow->pNextSibling          = NULL;
     pWindow->pPrevSibling          = NULL;
     pWindow->extraDataSize         = extraDataSize;
+    memset(&pWindow->stats, 0, sizeof(pWindow->stats));
 
     if (pExtraData != NULL) {
         memcpy(pWindow->pExtraData, pExtraData, extraDataSize);
@@ -401,6 +531,9 @@ ak_window* ak_alloc_and_init_window_win32(ak_application* pApplication, ak_windo
 
 void ak_uninit_and_free_window_win32(ak_window* pWindow)
 {
+    // A visible popup needs to be removed from the application's popup set since it won't necessarily get a hide event.
+    ak_application_untrack_visible_popup(pWindow);
+
     if (pWindow->pParent == NULL) {
         ak_application_untrack_top_level_window(pWindow);
     } else {
@@ -945,9 +1078,18 @@ LRESULT CALLBACK GenericWindowProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lP
 
             case WM_PAINT:
             {
+                // The layout is updated before getting the update rectangle so that anything it invalidates is
+                // painted in this frame.
+                ak_update_window_layout(pWindow);
+
                 RECT rect;
                 if (GetUpdateRect(hWnd, &rect, FALSE)) {
+                    uint64_t paintStartTime = ak_get_time_in_microseconds();
                     drgui_draw(pWindow->pPanel, drgui_make_rect((float)rect.left, (float)rect.top, (float)rect.right, (float)rect.bottom), pWindow->pSurface);
+
+                    // GDI draws straight to the window so there's no separate blit.
+                    uint64_t paintEndTime = ak_get_time_in_microseconds();
+                    ak_window_count_paint(pWindow, paintStartTime, paintEndTime, paintEndTime);
                 }
 
                 break;
@@ -1508,54 +1650,6 @@ void ak_hide_window(ak_window* pWindow, unsigned int flags)
 }
 
 
-bool ak_is_window_descendant(ak_window* pDescendant, ak_window* pAncestor)
-{
-    if (pDescendant == NULL || pAncestor == NULL) {
-        return false;
-    }
-
-    return IsChild(pAncestor->hWnd, pDescendant->hWnd);
-}
-
-bool ak_is_window_ancestor(ak_window* pAncestor, ak_window* pDescendant)
-{
-    if (pAncestor == NULL || pDescendant == NULL) {
-        return false;
-    }
-
-    ak_window* pParent = ak_get_parent_window(pDescendant);
-    if (pParent != NULL)
-    {
-        if (pParent == pAncestor) {
-            return true;
-        } else {
-            return ak_is_window_ancestor(pAncestor, pParent);
-        }
-    }
-
-    return false;
-}
-
-
-ak_window* ak_get_panel_window(drgui_element* pPanel)
-{
-    drgui_element* pTopLevelPanel = drgui_find_top_level_element(pPanel);
-    if (pTopLevelPanel == NULL) {
-        return NULL;
-    }
-
-    if (!ak_panel_is_of_type(pTopLevelPanel, "AK.RootWindowPanel")) {
-        return NULL;
-    }
-
-    ak_element_user_data* pWindowData = ak_panel_get_extra_data(pTopLevelPanel);
-    assert(pWindowData != NULL);
-
-    assert(ak_panel_get_extra_data_size(pTopLevelPanel) == sizeof(ak_element_user_data));      // A loose check to help ensure we're working with the right kind of panel.
-    return pWindowData->pWindow;
-}
-
-
 void ak_set_window_cursor(ak_window* pWindow, ak_cursor_type cursor)
 {
     assert(pWindow != NULL);
@@ -1846,7 +1940,8 @@ static drgui_element* ak_create_window_panel(ak_application* pApplication, ak_wi
 
     pUserData->pWindow = pWindow;
 
-    drgui_set_type(pElement, "AK.RootWindowPanel");
+    ak_panel_mark_as_window_root(pElement, pWindow);
+    ak_panel_set_type(pElement, "AK.RootWindowPanel");
 
 
     float dpiScaleX;
@@ -1860,6 +1955,7 @@ static drgui_element* ak_create_window_panel(ak_application* pApplication, ak_wi
 
 static void ak_delete_window_panel(drgui_element* pTopLevelElement)
 {
+    ak_panel_unindex_recursive(pTopLevelElement);
     drgui_delete_element(pTopLevelElement);
 }
 
@@ -1979,6 +2075,10 @@ static void ak_gtk_on_paint(GtkWidget* pGTKWindow, cairo_t* pCairoContext, gpoin
     // NOTE: Because we are using dr_2d to draw the GUI, the last argument to drgui_draw() must be a pointer
     //       to the relevant dr2d_surface object.
 
+    // Anything that's invalidated by updating the layout outside of the clipping rectangle is painted in the next
+    // frame.
+    ak_update_window_layout(pWindow);
+
     double clipLeft;
     double clipTop;
     double clipRight;
@@ -1990,7 +2090,10 @@ static void ak_gtk_on_paint(GtkWidget* pGTKWindow, cairo_t* pCairoContext, gpoin
     drawRect.top    = (float)clipTop;
     drawRect.right  = (float)clipRight;
     drawRect.bottom = (float)clipBottom;
+
+    uint64_t paintStartTime = ak_get_time_in_microseconds();
     drgui_draw(pWindow->pPanel, drawRect, pWindow->pSurface);
+    uint64_t blitStartTime = ak_get_time_in_microseconds();
 
     // At this point the GUI has been drawn, however nothing has been drawn to the window yet. To do this we will
     // use cairo directly with a cairo_set_source_surface() / cairo_paint() pair. We can get a pointer to dr_2d's
@@ -2001,6 +2104,8 @@ static void ak_gtk_on_paint(GtkWidget* pGTKWindow, cairo_t* pCairoContext, gpoin
         cairo_set_source_surface(pCairoContext, pCairoSurface, 0, 0);
         cairo_paint(pCairoContext);
     }
+
+    ak_window_count_paint(pWindow, paintStartTime, blitStartTime, ak_get_time_in_microseconds());
 }
 
 static void ak_gtk_on_configure(GtkWidget* pGTKWindow, GdkEventConfigure* pEvent, gpointer pUserData)
@@ -2018,6 +2123,7 @@ static void ak_gtk_on_configure(GtkWidget* pGTKWindow, GdkEventConfigure* pEvent
         // dr_2d does not support dynamic resizing of surfaces. Thus, we need to delete and recreate it.
         if (pWindow->pSurface != NULL) {
             dr2d_delete_surface(pWindow->pSurface);
+            ak_window_count_surface_recreation(pWindow);
         }
         pWindow->pSurface = dr2d_create_surface(ak_get_application_drawing_context(pWindow->pApplication), (float)pEvent->width, (float)pEvent->height);
 
@@ -2213,7 +2319,7 @@ static gboolean ak_gtk_on_receive_focus(GtkWidget* pGTKWindow, GdkEventFocus* pE
         return true;
     }
 
-    printf("Receive Focus\n");
+    ak_log_trace(pWindow->pApplication, AK_LOG_CATEGORY_WINDOW, "Receive Focus (%s)", pWindow->name);
     ak_application_on_focus_window(pWindow);
     return true;
 }
@@ -2228,7 +2334,7 @@ static gboolean ak_gtk_on_lose_focus(GtkWidget* pGTKWindow, GdkEventFocus* pEven
         return true;
     }
 
-    printf("Lose Focus\n");
+    ak_log_trace(pWindow->pApplication, AK_LOG_CATEGORY_WINDOW, "Lose Focus (%s)", pWindow->name);
     ak_application_on_unfocus_window(pWindow);
     return true;
 }
@@ -2270,11 +2376,13 @@ ak_window* ak_alloc_and_init_window_gtk(ak_application* pApplication, ak_window*
     pWindow->onKeyUp               = NULL;
     pWindow->onPrintableKeyDown    = NULL;
     pWindow->pParent               = NULL;
+    pWindow->depth                 = 0;
     pWindow->pFirstChild           = NULL;
     pWindow->pLastChild            = NULL;
     pWindow->pNextSibling          = NULL;
     pWindow->pPrevSibling          = NULL;
     pWindow->extraDataSize         = extraDataSize;
+    memset(&pWindow->stats, 0, sizeof(pWindow->stats));
 
     if (pExtraData != NULL) {
         memcpy(pWindow->pExtraData, pExtraData, extraDataSize);
@@ -2346,6 +2454,8 @@ ak_window* ak_alloc_and_init_window_gtk(ak_application* pApplication, ak_window*
 
 void ak_uninit_and_free_window_gtk(ak_window* pWindow)
 {
+    ak_application_untrack_visible_popup(pWindow);
+
     if (pWindow->pParent == NULL) {
         ak_application_untrack_top_level_window(pWindow);
     } else {
@@ -2624,54 +2734,6 @@ void ak_hide_window(ak_window* pWindow, unsigned int flags)
 }
 
 
-bool ak_is_window_descendant(ak_window* pDescendant, ak_window* pAncestor)
-{
-    if (pDescendant == NULL || pAncestor == NULL) {
-        return false;
-    }
-
-    return ak_is_window_ancestor(pAncestor, pDescendant);
-}
-
-bool ak_is_window_ancestor(ak_window* pAncestor, ak_window* pDescendant)
-{
-    if (pAncestor == NULL || pDescendant == NULL) {
-        return false;
-    }
-
-    ak_window* pParent = ak_get_parent_window(pDescendant);
-    if (pParent != NULL)
-    {
-        if (pParent == pAncestor) {
-            return true;
-        } else {
-            return ak_is_window_ancestor(pAncestor, pParent);
-        }
-    }
-
-    return false;
-}
-
-
-ak_window* ak_get_panel_window(drgui_element* pPanel)
-{
-    drgui_element* pTopLevelPanel = drgui_find_top_level_element(pPanel);
-    if (pTopLevelPanel == NULL) {
-        return NULL;
-    }
-
-    if (!ak_panel_is_of_type(pTopLevelPanel, "AK.RootWindowPanel")) {
-        return NULL;
-    }
-
-    ak_element_user_data* pWindowData = ak_panel_get_extra_data(pTopLevelPanel);
-    assert(pWindowData != NULL);
-
-    assert(ak_panel_get_extra_data_size(pTopLevelPanel) == sizeof(ak_element_user_data));      // A loose check to help ensure we're working with the right kind of panel.
-    return pWindowData->pWindow;
-}
-
-
 void ak_set_window_cursor(ak_window* pWindow, ak_cursor_type cursor)
 {
     assert(pWindow != NULL);
@@ -2746,10 +2808,12 @@ void ak_get_window_dpi_scale(ak_window* pWindow, float* pDPIScaleXOut, float* pD
 
 static void ak_on_global_capture_mouse(drgui_element* pElement)
 {
-    drgui_element* pTopLevelElement = drgui_find_top_level_element(pElement);
-    assert(pTopLevelElement != NULL);
+    drgui_element* pRootPanel = ak_find_element_root_panel(pElement);
+    if (pRootPanel == NULL) {
+        return;
+    }
 
-    ak_element_user_data* pElementData = ak_panel_get_extra_data(pTopLevelElement);
+    ak_element_user_data* pElementData = ak_panel_get_extra_data(pRootPanel);
     if (pElementData != NULL) {
         gdk_device_grab(gdk_device_manager_get_client_pointer(gdk_display_get_device_manager(gdk_display_get_default())),
             gtk_widget_get_window(pElementData->pWindow->pGTKWindow), GDK_OWNERSHIP_APPLICATION, false, GDK_POINTER_MOTION_MASK | GDK_BUTTON_PRESS_MASK | GDK_BUTTON_RELEASE_MASK | GDK_SCROLL_MASK, NULL, GDK_CURRENT_TIME);
@@ -2758,23 +2822,23 @@ static void ak_on_global_capture_mouse(drgui_element* pElement)
 
 static void ak_on_global_release_mouse(drgui_element* pElement)
 {
-    drgui_element* pTopLevelElement = drgui_find_top_level_element(pElement);
-    assert(pTopLevelElement != NULL);
+    (void)pElement;
 
-    ak_element_user_data* pElementData = ak_panel_get_extra_data(pTopLevelElement);
-    if (pElementData != NULL) {
-        gdk_device_ungrab(gdk_device_manager_get_client_pointer(gdk_display_get_device_manager(gdk_display_get_default())), GDK_CURRENT_TIME);
-    }
+    // The grab doesn't belong to any particular window so there's no need to look it up. This also means the grab is
+    // still released if the element has already been removed from it's window.
+    gdk_device_ungrab(gdk_device_manager_get_client_pointer(gdk_display_get_device_manager(gdk_display_get_default())), GDK_CURRENT_TIME);
 }
 
 static void ak_on_global_capture_keyboard(drgui_element* pElement, drgui_element* pPrevCapturedElement)
 {
     (void)pPrevCapturedElement;
 
-    drgui_element* pTopLevelElement = drgui_find_top_level_element(pElement);
-    assert(pTopLevelElement != NULL);
+    drgui_element* pRootPanel = ak_find_element_root_panel(pElement);
+    if (pRootPanel == NULL) {
+        return;
+    }
 
-    ak_element_user_data* pElementData = ak_panel_get_extra_data(pTopLevelElement);
+    ak_element_user_data* pElementData = ak_panel_get_extra_data(pRootPanel);
     if (pElementData != NULL) {
         gtk_widget_grab_focus(GTK_WIDGET(pElementData->pWindow->pGTKWindow));
     }
@@ -2782,27 +2846,21 @@ static void ak_on_global_capture_keyboard(drgui_element* pElement, drgui_element
 
 static void ak_on_global_release_keyboard(drgui_element* pElement, drgui_element* pNewCapturedElement)
 {
+    (void)pElement;
     (void)pNewCapturedElement;
 
-    drgui_element* pTopLevelElement = drgui_find_top_level_element(pElement);
-    assert(pTopLevelElement != NULL);
-
-    ak_element_user_data* pElementData = ak_panel_get_extra_data(pTopLevelElement);
-    if (pElementData != NULL) {
-        gtk_widget_grab_focus(NULL);
-    }
+    // As with the mouse, the focus is released without looking up the window.
+    gtk_widget_grab_focus(NULL);
 }
 
 static void ak_on_global_dirty(drgui_element* pElement, drgui_rect relativeRect)
 {
-    drgui_element* pTopLevelElement = drgui_find_top_level_element(pElement);
-    assert(pTopLevelElement != NULL);
-
-    if (!drgui_is_of_type(pTopLevelElement, "AK.RootWindowPanel")) {
+    drgui_element* pRootPanel = ak_find_element_root_panel(pElement);
+    if (pRootPanel == NULL) {
         return;
     }
 
-    ak_element_user_data* pElementData = ak_panel_get_extra_data(pTopLevelElement);
+    ak_element_user_data* pElementData = ak_panel_get_extra_data(pRootPanel);
     if (pElementData != NULL && pElementData->pWindow != NULL && pElementData->pWindow->pGTKWindow != NULL)
     {
         drgui_rect absoluteRect = relativeRect;
@@ -2810,6 +2868,8 @@ static void ak_on_global_dirty(drgui_element* pElement, drgui_rect relativeRect)
 
         gtk_widget_queue_draw_area(pElementData->pWindow->pGTKWindow,
             (gint)absoluteRect.left, (gint)absoluteRect.top, (gint)(absoluteRect.right - absoluteRect.left), (gint)(absoluteRect.bottom - absoluteRect.top));
+
+        ak_window_count_dirty_rect(pElementData->pWindow);
     }
 }
 
@@ -2822,111 +2882,864 @@ void ak_gtk_post_quit_message(int resultCode)
 
 
 
-//// Functions below are cross-platform ////
+#ifdef AK_USE_HEADLESS
+// The window that currently has the keyboard focus. This is only ever changed by ak_headless_inject_focus().
+static ak_window* g_pAKHeadlessFocusedWindow = NULL;
 
-static void ak_on_global_change_cursor(drgui_element* pElement, drgui_cursor_type cursor)
+typedef struct
 {
-    drgui_element* pTopLevelElement = drgui_find_top_level_element(pElement);
-    assert(pTopLevelElement != NULL);
+    /// A pointer to the window object itself.
+    ak_window* pWindow;
 
-    ak_element_user_data* pElementData = ak_panel_get_extra_data(pTopLevelElement);
-    if (pElementData == NULL) {
-        return;
-    }
+} ak_element_user_data;
 
-    switch (cursor)
-    {
-    case drgui_cursor_none:      ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_none);       break;
-    case drgui_cursor_text:      ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_text);       break;
-    case drgui_cursor_cross:     ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_cross);      break;
-    case drgui_cursor_size_ns:   ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_size_ns);    break;
-    case drgui_cursor_size_we:   ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_size_we);    break;
-    case drgui_cursor_size_nesw: ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_size_nesw);  break;
-    case drgui_cursor_size_nwse: ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_size_nwse);  break;
 
-    case drgui_cursor_default:
-    default:
-        {
-            ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_default);
-        } break;
-    }
+void ak_init_platform()
+{
+    // Nothing to do here since there is no windowing system.
 }
 
-ak_application* ak_get_window_application(ak_window* pWindow)
+void ak_uninit_platform()
 {
-    if (pWindow == NULL) {
-        return NULL;
-    }
-
-    return pWindow->pApplication;
 }
 
-ak_window_type ak_get_window_type(ak_window* pWindow)
-{
-    if (pWindow == NULL) {
-        return ak_window_type_unknown;
-    }
 
-    return pWindow->type;
-}
 
-ak_window* ak_get_parent_window(ak_window* pWindow)
+static drgui_element* ak_create_window_panel(ak_application* pApplication, ak_window* pWindow)
 {
-    if (pWindow == NULL) {
+    drgui_element* pElement = ak_create_panel(pApplication, NULL, sizeof(ak_element_user_data), NULL);
+    if (pElement == NULL) {
         return NULL;
     }
 
-    return pWindow->pParent;
-}
+    ak_element_user_data* pUserData = ak_panel_get_extra_data(pElement);
+    assert(pUserData != NULL);
 
-size_t ak_get_window_extra_data_size(ak_window* pWindow)
-{
-    if (pWindow == NULL) {
-        return 0;
-    }
+    pUserData->pWindow = pWindow;
 
-    return pWindow->extraDataSize;
-}
+    ak_panel_mark_as_window_root(pElement, pWindow);
+    ak_panel_set_type(pElement, "AK.RootWindowPanel");
 
-void* ak_get_window_extra_data(ak_window* pWindow)
-{
-    if (pWindow == NULL) {
-        return NULL;
-    }
 
-    return pWindow->pExtraData;
-}
+    float dpiScaleX;
+    float dpiScaleY;
+    ak_get_window_dpi_scale(pWindow, &dpiScaleX, &dpiScaleY);
 
-drgui_element* ak_get_window_panel(ak_window* pWindow)
-{
-    if (pWindow == NULL) {
-        return NULL;
-    }
+    drgui_set_inner_scale(pElement, dpiScaleX, dpiScaleY);
 
-    return pWindow->pPanel;
+    return pElement;
 }
 
-dr2d_surface* ak_get_window_surface(ak_window* pWindow)
+static void ak_delete_window_panel(drgui_element* pTopLevelElement)
 {
-    if (pWindow == NULL) {
-        return NULL;
-    }
-
-    return pWindow->pSurface;
+    ak_panel_unindex_recursive(pTopLevelElement);
+    drgui_delete_element(pTopLevelElement);
 }
 
 
-bool ak_set_window_name(ak_window* pWindow, const char* pName)
+static void ak_headless_invalidate_window(ak_window* pWindow, drgui_rect rect)
 {
-    if (pWindow == NULL) {
+    assert(pWindow != NULL);
+
+    // Clamp to the window so that the painted region is never bigger than the surface.
+    if (rect.left   < 0)                      rect.left   = 0;
+    if (rect.top    < 0)                      rect.top    = 0;
+    if (rect.right  > (float)pWindow->width)  rect.right  = (float)pWindow->width;
+    if (rect.bottom > (float)pWindow->height) rect.bottom = (float)pWindow->height;
+
+    if (rect.right <= rect.left || rect.bottom <= rect.top) {
+        return;
+    }
+
+    if (!pWindow->isDirty)
+    {
+        pWindow->dirtyRect = rect;
+        pWindow->isDirty   = true;
+    }
+    else
+    {
+        if (pWindow->dirtyRect.left   > rect.left)   pWindow->dirtyRect.left   = rect.left;
+        if (pWindow->dirtyRect.top    > rect.top)    pWindow->dirtyRect.top    = rect.top;
+        if (pWindow->dirtyRect.right  < rect.right)  pWindow->dirtyRect.right  = rect.right;
+        if (pWindow->dirtyRect.bottom < rect.bottom) pWindow->dirtyRect.bottom = rect.bottom;
+    }
+}
+
+static void ak_headless_invalidate_entire_window(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+    ak_headless_invalidate_window(pWindow, drgui_make_rect(0, 0, (float)pWindow->width, (float)pWindow->height));
+}
+
+static void ak_headless_paint_window(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    if (!pWindow->isVisible || pWindow->pSurface == NULL) {
+        return;
+    }
+
+    // The layout is updated first so that anything it invalidates is painted in this frame.
+    ak_update_window_layout(pWindow);
+    if (!pWindow->isDirty) {
+        return;
+    }
+
+    // The dirty flag is cleared before drawing so that anything invalidated during the paint is picked up by the
+    // next pump rather than being lost.
+    drgui_rect drawRect = pWindow->dirtyRect;
+    pWindow->isDirty = false;
+
+    uint64_t paintStartTime = ak_get_time_in_microseconds();
+    drgui_draw(pWindow->pPanel, drawRect, pWindow->pSurface);
+
+    // There's no screen to blit to.
+    uint64_t paintEndTime = ak_get_time_in_microseconds();
+    ak_window_count_paint(pWindow, paintStartTime, paintEndTime, paintEndTime);
+}
+
+
+static ak_window* ak_alloc_and_init_window_headless(ak_application* pApplication, ak_window* pParent, ak_window_type type, size_t extraDataSize, const void* pExtraData)
+{
+    assert(pApplication != NULL);
+
+    ak_window* pWindow = malloc(sizeof(*pWindow) + extraDataSize - sizeof(pWindow->pExtraData));
+    if (pWindow == NULL)
+    {
+        ak_errorf(pApplication, "Failed to allocate memory for window.");
+        return NULL;
+    }
+
+    pWindow->posX                  = 0;
+    pWindow->posY                  = 0;
+    pWindow->width                 = 0;
+    pWindow->height                = 0;
+    pWindow->title[0]              = '\0';
+    pWindow->cursor                = ak_cursor_type_default;
+    pWindow->isVisible             = false;
+    pWindow->isCursorOver          = false;
+    pWindow->isMarkedAsDeleted     = false;
+    pWindow->isDirty               = false;
+    pWindow->dirtyRect             = drgui_make_rect(0, 0, 0, 0);
+    pWindow->pApplication          = pApplication;
+    pWindow->type                  = type;
+    pWindow->pSurface              = NULL;
+    pWindow->name[0]               = '\0';
+    pWindow->onHideFlags           = 0;
+    pWindow->onClose               = NULL;
+    pWindow->onHide                = NULL;
+    pWindow->onShow                = NULL;
+    pWindow->onActivate            = NULL;
+    pWindow->onDeactivate          = NULL;
+    pWindow->onMouseEnter          = NULL;
+    pWindow->onMouseLeave          = NULL;
+    pWindow->onMouseButtonDown     = NULL;
+    pWindow->onMouseButtonUp       = NULL;
+    pWindow->onMouseButtonDblClick = NULL;
+    pWindow->onMouseWheel          = NULL;
+    pWindow->onKeyDown             = NULL;
+    pWindow->onKeyUp               = NULL;
+    pWindow->onPrintableKeyDown    = NULL;
+    pWindow->pParent               = NULL;
+    pWindow->depth                 = 0;
+    pWindow->pFirstChild           = NULL;
+    pWindow->pLastChild            = NULL;
+    pWindow->pNextSibling          = NULL;
+    pWindow->pPrevSibling          = NULL;
+    pWindow->extraDataSize         = extraDataSize;
+    memset(&pWindow->stats, 0, sizeof(pWindow->stats));
+
+    if (pExtraData != NULL) {
+        memcpy(pWindow->pExtraData, pExtraData, extraDataSize);
+    }
+
+
+    // All windows have a panel assigned to them which is what we use as the root GUI element. The panel is just
+    // a drgui_element.
+    pWindow->pPanel = ak_create_window_panel(pApplication, pWindow);
+    if (pWindow->pPanel == NULL)
+    {
+        ak_errorf(pApplication, "Failed to create panel element for window.");
+
+        free(pWindow);
+        return NULL;
+    }
+
+
+    // The application needs to track this window.
+    if (pParent == NULL) {
+        ak_application_track_top_level_window(pWindow);
+    } else {
+        ak_append_window(pWindow, pParent);
+    }
+
+
+    // Windows are given the same default size as GTK so that layouts behave the same when a size isn't specified.
+    ak_set_window_size(pWindow, 200, 200);
+
+    return pWindow;
+}
+
+static void ak_uninit_and_free_window_headless(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+
+    ak_application_untrack_visible_popup(pWindow);
+
+    if (pWindow->pParent == NULL) {
+        ak_application_untrack_top_level_window(pWindow);
+    } else {
+        ak_detach_window(pWindow);
+    }
+
+
+    ak_delete_window_panel(pWindow->pPanel);
+    pWindow->pPanel = NULL;
+
+    dr2d_delete_surface(pWindow->pSurface);
+    pWindow->pSurface = NULL;
+
+    free(pWindow);
+}
+
+
+ak_window* ak_create_window(ak_application* pApplication, ak_window_type type, ak_window* pParent, size_t extraDataSize, const void* pExtraData)
+{
+    if (pApplication == NULL || type == ak_window_type_unknown) {
+        return NULL;
+    }
+
+    // A dialog window must always have a parent.
+    if (type == ak_window_type_dialog && pParent == NULL) {
+        ak_errorf(pApplication, "Attempting to create a dialog window without a parent.");
+        return NULL;
+    }
+
+    // Every type of window is the same thing when there's no windowing system.
+    return ak_alloc_and_init_window_headless(pApplication, pParent, type, extraDataSize, pExtraData);
+}
+
+void ak_delete_window(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    assert(pWindow->isMarkedAsDeleted == false);        // <-- If you've hit this assert it means you're trying to delete a window multiple times.
+    pWindow->isMarkedAsDeleted = true;
+
+    // Child windows are destroyed with their parent, just like they are with GTK.
+    while (pWindow->pFirstChild != NULL) {
+        ak_delete_window(pWindow->pFirstChild);
+    }
+
+    if (g_pAKHeadlessFocusedWindow == pWindow) {
+        g_pAKHeadlessFocusedWindow = NULL;
+    }
+
+    ak_uninit_and_free_window_headless(pWindow);
+}
+
+
+
+
+
+void ak_set_window_title(ak_window* pWindow, const char* pTitle)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    if (pTitle == NULL) {
+        pTitle = "";
+    }
+
+    dr_strncpy_s(pWindow->title, sizeof(pWindow->title), pTitle, _TRUNCATE);
+}
+
+void ak_get_window_title(ak_window* pWindow, char* pTitleOut, size_t titleOutSize)
+{
+    if (pTitleOut == NULL || titleOutSize == 0) {
+        return;
+    }
+
+    if (pWindow == NULL) {
+        pTitleOut[0] = '\0';
+        return;
+    }
+
+    dr_strncpy_s(pTitleOut, titleOutSize, pWindow->title, _TRUNCATE);
+}
+
+
+void ak_set_window_size(ak_window* pWindow, int width, int height)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    if (width < 1) {
+        width = 1;
+    }
+    if (height < 1) {
+        height = 1;
+    }
+
+    if (pWindow->width == width && pWindow->height == height && pWindow->pSurface != NULL) {
+        return;
+    }
+
+    pWindow->width  = width;
+    pWindow->height = height;
+
+    // dr_2d does not support dynamic resizing of surfaces. Thus, we need to delete and recreate it.
+    if (pWindow->pSurface != NULL) {
+        dr2d_delete_surface(pWindow->pSurface);
+        ak_window_count_surface_recreation(pWindow);
+    }
+    pWindow->pSurface = dr2d_create_surface(ak_get_application_drawing_context(pWindow->pApplication), (float)width, (float)height);
+
+    // We'll also want to resize the root GUI element so that it's the same size as the window.
+    drgui_set_size(pWindow->pPanel, (float)width, (float)height);
+
+    // The new surface has nothing on it so the whole thing needs to be redrawn.
+    pWindow->isDirty = false;
+    ak_headless_invalidate_entire_window(pWindow);
+}
+
+void ak_get_window_size(ak_window* pWindow, int* pWidthOut, int* pHeightOut)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    if (pWidthOut) {
+        *pWidthOut = pWindow->width;
+    }
+    if (pHeightOut) {
+        *pHeightOut = pWindow->height;
+    }
+}
+
+
+void ak_set_window_position(ak_window* pWindow, int posX, int posY)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    pWindow->posX = posX;
+    pWindow->posY = posY;
+}
+
+void ak_get_window_position(ak_window* pWindow, int* pPosXOut, int* pPosYOut)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    if (pPosXOut) {
+        *pPosXOut = pWindow->posX;
+    }
+    if (pPosYOut) {
+        *pPosYOut = pWindow->posY;
+    }
+}
+
+void ak_center_window(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    // There's no screen, so top-level windows are left where they are.
+    if (pWindow->pParent != NULL) {
+        pWindow->posX = (pWindow->pParent->width  - pWindow->width)  / 2;
+        pWindow->posY = (pWindow->pParent->height - pWindow->height) / 2;
+    }
+}
+
+
+void ak_show_window(ak_window* pWindow)
+{
+    if (pWindow == NULL || pWindow->isVisible) {
+        return;
+    }
+
+    pWindow->isVisible = true;
+    if (!ak_application_on_show_window(pWindow)) {
+        pWindow->isVisible = false;     // The event handler returned false, so prevent the window from being shown.
+        return;
+    }
+
+    ak_headless_invalidate_entire_window(pWindow);
+}
+
+void ak_show_window_maximized(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    ak_show_window(pWindow);
+}
+
+void show_window_sized(ak_window* pWindow, int width, int height)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    // Set the size first.
+    ak_set_window_size(pWindow, width, height);
+
+    // Now show the window in it's default state.
+    ak_show_window(pWindow);
+}
+
+void ak_hide_window(ak_window* pWindow, unsigned int flags)
+{
+    if (pWindow == NULL || !pWindow->isVisible) {
+        return;
+    }
+
+    pWindow->onHideFlags = flags;
+    if (!ak_application_on_hide_window(pWindow, flags)) {
+        return;     // The event handler returned false, so prevent the window from being hidden.
+    }
+
+    pWindow->isVisible = false;
+}
+
+
+void ak_set_window_cursor(ak_window* pWindow, ak_cursor_type cursor)
+{
+    assert(pWindow != NULL);
+    pWindow->cursor = cursor;
+}
+
+bool ak_is_cursor_over_window(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+    return pWindow->isCursorOver;
+}
+
+
+void ak_get_window_dpi(ak_window* pWindow, int* pDPIXOut, int* pDPIYOut)
+{
+    (void)pWindow;
+
+    if (pDPIXOut) {
+        *pDPIXOut = 96;
+    }
+    if (pDPIYOut) {
+        *pDPIYOut = 96;
+    }
+}
+
+void ak_get_window_dpi_scale(ak_window* pWindow, float* pDPIScaleXOut, float* pDPIScaleYOut)
+{
+    (void)pWindow;
+
+    if (pDPIScaleXOut) {
+        *pDPIScaleXOut = 1;
+    }
+    if (pDPIScaleYOut) {
+        *pDPIScaleYOut = 1;
+    }
+}
+
+
+// Mouse and keyboard capture is a request to the windowing system to route input to a particular window. There is
+// no windowing system here and input is injected directly into the relevant window, so these do nothing.
+static void ak_on_global_capture_mouse(drgui_element* pElement)
+{
+    (void)pElement;
+}
+
+static void ak_on_global_release_mouse(drgui_element* pElement)
+{
+    (void)pElement;
+}
+
+static void ak_on_global_capture_keyboard(drgui_element* pElement, drgui_element* pPrevCapturedElement)
+{
+    (void)pElement;
+    (void)pPrevCapturedElement;
+}
+
+static void ak_on_global_release_keyboard(drgui_element* pElement, drgui_element* pNewCapturedElement)
+{
+    (void)pElement;
+    (void)pNewCapturedElement;
+}
+
+static void ak_on_global_dirty(drgui_element* pElement, drgui_rect relativeRect)
+{
+    drgui_element* pRootPanel = ak_find_element_root_panel(pElement);
+    if (pRootPanel == NULL) {
+        return;
+    }
+
+    ak_element_user_data* pElementData = ak_panel_get_extra_data(pRootPanel);
+    if (pElementData != NULL && pElementData->pWindow != NULL)
+    {
+        drgui_rect absoluteRect = relativeRect;
+        drgui_make_rect_absolute(pElement, &absoluteRect);
+
+        ak_headless_invalidate_window(pElementData->pWindow, absoluteRect);
+        ak_window_count_dirty_rect(pElementData->pWindow);
+    }
+}
+
+
+void ak_headless_paint_windows(ak_application* pApplication)
+{
+    assert(pApplication != NULL);
+
+    for (ak_window* pWindow = ak_get_application_first_window(pApplication); pWindow != NULL; pWindow = ak_get_application_next_window(pApplication, pWindow)) {
+        ak_headless_paint_window(pWindow);
+    }
+}
+
+
+void ak_headless_inject_mouse_enter(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    pWindow->isCursorOver = true;
+    ak_application_on_mouse_enter(pWindow);
+}
+
+void ak_headless_inject_mouse_leave(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    pWindow->isCursorOver = false;
+    ak_application_on_mouse_leave(pWindow);
+}
+
+void ak_headless_inject_mouse_move(ak_window* pWindow, int mousePosX, int mousePosY, int stateFlags)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    if (!pWindow->isCursorOver) {
+        ak_headless_inject_mouse_enter(pWindow);
+    }
+
+    ak_application_on_mouse_move(pWindow, mousePosX, mousePosY, stateFlags);
+}
+
+void ak_headless_inject_mouse_button_down(ak_window* pWindow, int mouseButton, int mousePosX, int mousePosY, int stateFlags)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    ak_application_on_mouse_button_down(pWindow, mouseButton, mousePosX, mousePosY, stateFlags);
+}
+
+void ak_headless_inject_mouse_button_up(ak_window* pWindow, int mouseButton, int mousePosX, int mousePosY, int stateFlags)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    ak_application_on_mouse_button_up(pWindow, mouseButton, mousePosX, mousePosY, stateFlags);
+}
+
+void ak_headless_inject_mouse_button_dblclick(ak_window* pWindow, int mouseButton, int mousePosX, int mousePosY, int stateFlags)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    ak_application_on_mouse_button_dblclick(pWindow, mouseButton, mousePosX, mousePosY, stateFlags);
+}
+
+void ak_headless_inject_mouse_wheel(ak_window* pWindow, int delta, int mousePosX, int mousePosY, int stateFlags)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    ak_application_on_mouse_wheel(pWindow, delta, mousePosX, mousePosY, stateFlags);
+}
+
+void ak_headless_inject_key_down(ak_window* pWindow, drgui_key key, int stateFlags)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    ak_application_on_key_down(pWindow, key, stateFlags);
+}
+
+void ak_headless_inject_key_up(ak_window* pWindow, drgui_key key, int stateFlags)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    ak_application_on_key_up(pWindow, key, stateFlags);
+}
+
+void ak_headless_inject_printable_key_down(ak_window* pWindow, unsigned int character, int stateFlags)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    ak_application_on_printable_key_down(pWindow, character, stateFlags);
+}
+
+void ak_headless_inject_focus(ak_window* pWindow)
+{
+    if (pWindow == NULL || g_pAKHeadlessFocusedWindow == pWindow) {
+        return;
+    }
+
+    ak_window* pPrevFocusedWindow = g_pAKHeadlessFocusedWindow;
+    g_pAKHeadlessFocusedWindow = pWindow;
+
+    if (pPrevFocusedWindow != NULL) {
+        ak_log_trace(pPrevFocusedWindow->pApplication, AK_LOG_CATEGORY_WINDOW, "Lose Focus (%s)", pPrevFocusedWindow->name);
+        ak_application_on_unfocus_window(pPrevFocusedWindow);
+    }
+
+    ak_log_trace(pWindow->pApplication, AK_LOG_CATEGORY_WINDOW, "Receive Focus (%s)", pWindow->name);
+    ak_application_on_focus_window(pWindow);
+}
+
+void ak_headless_inject_close(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return;
+    }
+
+    ak_application_on_close_window(pWindow);
+}
+
+
+bool ak_headless_is_window_dirty(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return false;
+    }
+
+    return pWindow->isDirty;
+}
+
+const void* ak_headless_get_window_image_data(ak_window* pWindow, int* pWidthOut, int* pHeightOut, int* pStrideOut)
+{
+    if (pWindow == NULL) {
+        return NULL;
+    }
+
+    cairo_surface_t* pCairoSurface = dr2d_get_cairo_surface_t(pWindow->pSurface);
+    if (pCairoSurface == NULL) {
+        return NULL;
+    }
+
+    // Any pending drawing operations need to be written to the image before the caller looks at it.
+    cairo_surface_flush(pCairoSurface);
+
+    if (pWidthOut) {
+        *pWidthOut = cairo_image_surface_get_width(pCairoSurface);
+    }
+    if (pHeightOut) {
+        *pHeightOut = cairo_image_surface_get_height(pCairoSurface);
+    }
+    if (pStrideOut) {
+        *pStrideOut = cairo_image_surface_get_stride(pCairoSurface);
+    }
+
+    return cairo_image_surface_get_data(pCairoSurface);
+}
+
+ak_cursor_type ak_headless_get_window_cursor(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return ak_cursor_type_default;
+    }
+
+    return pWindow->cursor;
+}
+#endif
+
+
+
+//// Functions below are cross-platform ////
+
+static void ak_on_global_change_cursor(drgui_element* pElement, drgui_cursor_type cursor)
+{
+    drgui_element* pRootPanel = ak_find_element_root_panel(pElement);
+    if (pRootPanel == NULL) {
+        return;
+    }
+
+    ak_element_user_data* pElementData = ak_panel_get_extra_data(pRootPanel);
+    if (pElementData == NULL) {
+        return;
+    }
+
+    switch (cursor)
+    {
+    case drgui_cursor_none:      ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_none);       break;
+    case drgui_cursor_text:      ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_text);       break;
+    case drgui_cursor_cross:     ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_cross);      break;
+    case drgui_cursor_size_ns:   ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_size_ns);    break;
+    case drgui_cursor_size_we:   ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_size_we);    break;
+    case drgui_cursor_size_nesw: ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_size_nesw);  break;
+    case drgui_cursor_size_nwse: ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_size_nwse);  break;
+
+    case drgui_cursor_default:
+    default:
+        {
+            ak_set_window_cursor(pElementData->pWindow, ak_cursor_type_default);
+        } break;
+    }
+}
+
+ak_application* ak_get_window_application(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return NULL;
+    }
+
+    return pWindow->pApplication;
+}
+
+ak_window_type ak_get_window_type(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return ak_window_type_unknown;
+    }
+
+    return pWindow->type;
+}
+
+ak_window* ak_get_parent_window(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return NULL;
+    }
+
+    return pWindow->pParent;
+}
+
+bool ak_is_window_descendant(ak_window* pDescendant, ak_window* pAncestor)
+{
+    if (pDescendant == NULL || pAncestor == NULL) {
+        return false;
+    }
+
+    return ak_is_window_ancestor(pAncestor, pDescendant);
+}
+
+bool ak_is_window_ancestor(ak_window* pAncestor, ak_window* pDescendant)
+{
+    if (pAncestor == NULL || pDescendant == NULL) {
+        return false;
+    }
+
+    // An ancestor must be higher up in the hierarchy, so we can usually early-exit without looking at any parents. If
+    // not, we only need to step up until we're at the same depth as the ancestor.
+    if (pAncestor->depth >= pDescendant->depth) {
+        return false;
+    }
+
+    ak_window* pParent = pDescendant->pParent;
+    for (unsigned int depth = pDescendant->depth - 1; depth > pAncestor->depth; --depth) {
+        pParent = pParent->pParent;
+    }
+
+    return pParent == pAncestor;
+}
+
+size_t ak_get_window_extra_data_size(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return 0;
+    }
+
+    return pWindow->extraDataSize;
+}
+
+void* ak_get_window_extra_data(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return NULL;
+    }
+
+    return pWindow->pExtraData;
+}
+
+drgui_element* ak_get_window_panel(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return NULL;
+    }
+
+    return pWindow->pPanel;
+}
+
+ak_window* ak_get_panel_window(drgui_element* pPanel)
+{
+    if (pPanel == NULL) {
+        return NULL;
+    }
+
+    // Panels in the main hierarchy have their window cached. Anything else, such as a panel inside a tool, goes through
+    // the nearest panel or tool above it that has one.
+    return ak_get_element_window(pPanel);
+}
+
+dr2d_surface* ak_get_window_surface(ak_window* pWindow)
+{
+    if (pWindow == NULL) {
+        return NULL;
+    }
+
+    return pWindow->pSurface;
+}
+
+ak_window_stats ak_get_window_stats(ak_window* pWindow)
+{
+    ak_window_stats stats;
+    if (pWindow == NULL) {
+        memset(&stats, 0, sizeof(stats));
+        return stats;
+    }
+
+    return pWindow->stats;
+}
+
+
+bool ak_set_window_name(ak_window* pWindow, const char* pName)
+{
+    if (pWindow == NULL) {
         return false;
     }
 
+    // The application indexes windows by name so it needs to be kept up to date.
+    ak_application_unindex_window(pWindow);
+
+    bool result;
     if (pName == NULL) {
-        return strcpy_s(pWindow->name, sizeof(pWindow->name), "") == 0;
+        result = strcpy_s(pWindow->name, sizeof(pWindow->name), "") == 0;
     } else {
-        return strcpy_s(pWindow->name, sizeof(pWindow->name), pName) == 0;
+        result = strcpy_s(pWindow->name, sizeof(pWindow->name), pName) == 0;
     }
+
+    ak_application_index_window(pWindow);
+    return result;
 }
 
 const char* ak_get_window_name(ak_window* pWindow)
@@ -3126,6 +3939,22 @@ void ak_window_on_printable_key_down(ak_window* pWindow, unsigned int character,
 }
 
 
+void ak_window_count_event(ak_window* pWindow, ak_event_type type)
+{
+    assert(pWindow != NULL);
+    assert(type < ak_event_type_count);
+
+    pWindow->stats.eventCounts[type] += 1;
+    ak_get_application_window_stats_totals(pWindow->pApplication)->eventCounts[type] += 1;
+}
+
+void ak_reset_window_stats(ak_window* pWindow)
+{
+    assert(pWindow != NULL);
+    memset(&pWindow->stats, 0, sizeof(pWindow->stats));
+}
+
+
 void ak_connect_gui_to_window_system(drgui_context* pGUI)
 {
     assert(pGUI != NULL);
@@ -112,6 +112,12 @@ drgui_element* ak_get_window_panel(ak_window* pWindow);
 /// Retrieves a pointer to the easy_draw surface the window will be drawing to.
 dr2d_surface* ak_get_window_surface(ak_window* pWindow);
 
+/// Retrieves the statistics of the given window.
+///
+/// @remarks
+///     These are reset with ak_reset_application_stats(). See ak_get_application_stats() for the totals of every window.
+ak_window_stats ak_get_window_stats(ak_window* pWindow);
+
 
 /// Sets the name of the window.
 ///
@@ -180,6 +186,12 @@ bool ak_is_window_ancestor(ak_window* pAncestor, ak_window* pDescendant);
 
 
 /// Retrieves a pointer to the window that is associated with the given panel.
+///
+/// @remarks
+///     This is constant time for panels in the main hierarchy of a window, which is the window's root panel and every
+///     panel split from it. For any other panel it will walk up to the root panel of the window.
+///     @par
+///     <pPanel> must be a panel. Use ak_get_element_window() for arbitrary elements.
 ak_window* ak_get_panel_window(drgui_element* pPanel);
 
 
@@ -28,6 +28,26 @@ void ak_win32_post_quit_message(int resultCode);
 void ak_gtk_post_quit_message(int resultCode);
 #endif  //!AK_USE_GTK
 
+#ifdef AK_USE_HEADLESS
+/// Headless Only. Paints every visible window that has been invalidated since it was last painted.
+void ak_headless_paint_windows(ak_application* pApplication);
+#endif  //!AK_USE_HEADLESS
+
+
+/// Counts an event of the given type against the statistics of the given window and it's application.
+void ak_window_count_event(ak_window* pWindow, ak_event_type type);
+
+/// Resets the statistics of the given window.
+void ak_reset_window_stats(ak_window* pWindow);
+
+
+/// Lays out the panels of the given window whose layout has been invalidated.
+///
+/// @remarks
+///     This is done by the window just before it's painted, and by the application at the end of a batch update. It
+///     does nothing while a batch update is in progress.
+void ak_update_window_layout(ak_window* pWindow);
+
 
 /// Connects the given GUI context to the undering windowing system by registering the appropriate global outboud event handlers.
 void ak_connect_gui_to_window_system(drgui_context* pGUI);
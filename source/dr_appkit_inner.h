@@ -15,13 +15,28 @@
 #include "ak_theme.h"
 #include "ak_tool.h"
 #include "ak_textbox.h"
+#include "ak_headless.h"
 
 #ifdef DR_APPKIT_IMPLEMENTATION
+#include "ak_threading_private.h"
+#include "ak_log_private.h"
+#include "ak_thread_pool_private.h"
+#include "ak_trace_private.h"
+#include "ak_action_private.h"
+#include "ak_accelerator_private.h"
+#include "ak_layout_cache_private.h"
 #include "ak_application_private.h"
 #include "ak_tool_private.h"
+#include "ak_panel_private.h"
 #include "ak_window_private.h"
 
 #include "ak_autogen.c"
+#include "ak_threading.c"
+#include "ak_log.c"
+#include "ak_thread_pool.c"
+#include "ak_trace.c"
+#include "ak_action.c"
+#include "ak_accelerator.c"
 #include "ak_application.c"
 #include "ak_window.c"
 #include "ak_platform_layer.c"
@@ -31,6 +46,7 @@
 #include "ak_panel.c"
 #include "ak_layout.c"
 #include "ak_config.c"
+#include "ak_layout_cache.c"
 #include "ak_menu.c"
 #include "ak_menu_bar.c"
 #include "ak_theme.c"